@@ -0,0 +1,136 @@
+#include <stdlib.h>
+
+#include "automata.h"
+#include "globals.h"
+#include "elementaryautomaton.h"
+#include "langtonsant.h"
+#include "booleanautomata.h"
+#include "gameoflife.h"
+#include "munchingsquares.h"
+#include "bmltrafficmodel.h"
+#include "cycliccellularautomaton.h"
+#include "steppingstoneautomaton.h"
+#include "largerthanlifeautomaton.h"
+#include "generationsautomaton.h"
+#include "selectionmenus.h"
+
+/*
+ * The automata of the registry. Only the one running has its cells in
+ * memory (see CellularAutomata::initialize()).
+ */
+static ElementaryAutomaton elementaryAutomaton;
+static LangtonsAnt langtonsAnt;
+static HexagonalAnt hexagonalAnt;
+static SquareBooleanAutomaton squareBooleanAutomaton;
+static HexagonalBooleanAutomaton hexagonalBooleanAutomaton;
+static TriangularBooleanAutomaton triangularBooleanAutomaton;
+static GameOfLife gameOfLife;
+static MunchingSquares munchingSquares;
+static BMLtrafficModel trafficModel;
+static CyclicCellularAutomaton cyclicAutomaton;
+static SteppingStoneAutomaton steppingStoneAutomaton;
+static LargerThanLifeAutomaton largerThanLifeAutomaton;
+static GenerationsAutomaton generationsAutomaton;
+static ColorSelection colorSelection;
+static LanguageSelection languageSelection;
+
+/*
+ * The registry of the automata, in the order of the main menu. The last
+ * entry (type -1) ends it.
+ */
+const AutomatonInfo CellularAutomata::automata[] =
+{
+    {ELEMENTARY_CELLULAR_AUTOMATA,
+     AUTOMATON_SEED,
+     &elementaryAutomaton},
+
+    {LANGTON_ANT,
+     AUTOMATON_VIEW | AUTOMATON_GOVERNOR,
+     &langtonsAnt},
+
+    {LANGTON_HEXAGONAL_ANT,
+     AUTOMATON_GOVERNOR,
+     &hexagonalAnt},
+
+    {BOOLEAN_AUTOMATA,
+     AUTOMATON_VIEW | AUTOMATON_GOVERNOR | AUTOMATON_CYCLES,
+     &squareBooleanAutomaton},
+
+    {BOOLEAN_HEXAGONAL_AUTOMATA,
+     AUTOMATON_GOVERNOR | AUTOMATON_CYCLES,
+     &hexagonalBooleanAutomaton},
+
+    {BOOLEAN_TRIANGULAR_AUTOMATA,
+     AUTOMATON_GOVERNOR | AUTOMATON_CYCLES,
+     &triangularBooleanAutomaton},
+
+    {CONWAYS_GAME_OF_LIFE,
+     AUTOMATON_VIEW | AUTOMATON_GOVERNOR | AUTOMATON_CYCLES,
+     &gameOfLife},
+
+    {MUNCHING_SQUARES,
+     AUTOMATON_VIEW,
+     &munchingSquares},
+
+    {BML_TRAFFIC_MODEL,
+     AUTOMATON_SEED | AUTOMATON_VIEW | AUTOMATON_GOVERNOR |
+     AUTOMATON_CYCLES,
+     &trafficModel},
+
+    {CYCLIC_CELLULAR_AUTOMATA,
+     AUTOMATON_SEED | AUTOMATON_VIEW | AUTOMATON_GOVERNOR |
+     AUTOMATON_CYCLES,
+     &cyclicAutomaton},
+
+    {STEPPING_STONE,
+     AUTOMATON_SEED | AUTOMATON_GOVERNOR,
+     &steppingStoneAutomaton},
+
+    {LARGER_THAN_LIFE,
+     AUTOMATON_SEED | AUTOMATON_VIEW | AUTOMATON_GOVERNOR |
+     AUTOMATON_CYCLES,
+     &largerThanLifeAutomaton},
+
+    {GENERATIONS,
+     AUTOMATON_SEED | AUTOMATON_VIEW | AUTOMATON_GOVERNOR |
+     AUTOMATON_CYCLES,
+     &generationsAutomaton},
+
+    {SELECT_COLORS,
+     0,
+     &colorSelection},
+
+    {SELECT_LANGUAGE,
+     0,
+     &languageSelection},
+
+    {-1, 0, NULL}
+};
+
+/*
+ * Returns the entry of the registry of the type of automata, or NULL if it
+ * isn't registered (the menus)
+ */
+const AutomatonInfo* CellularAutomata::findAutomaton(int type)
+{
+    for (int i = 0; automata[i].type != -1; ++i)
+    {
+        if (automata[i].type == type)
+        {
+            return &automata[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns the features of the type of automata (AUTOMATON_SEED |
+ * AUTOMATON_VIEW...), 0 if it isn't registered
+ */
+int CellularAutomata::getAutomatonFeatures(int type)
+{
+    const AutomatonInfo* info = findAutomaton(type);
+
+    return info == NULL ? 0 : info->features;
+}
@@ -0,0 +1,30 @@
+#ifndef AUTOMATA_H
+#define AUTOMATA_H
+
+#include "cellularautomata.h"
+#include "automaton.h"
+
+/*
+ * What the menu of an automata has besides its options (the features of
+ * AutomatonInfo, combined with |)
+ */
+#define AUTOMATON_SEED 1       // Uses random numbers (see getSeed())
+#define AUTOMATON_VIEW 2       // Its view can be zoomed and panned
+#define AUTOMATON_GOVERNOR 4   // Run by the StepGovernor
+#define AUTOMATON_CYCLES 8     // Its cycles are found (see cycles.h)
+
+/*
+ * An entry of the registry of the automata (see automata.cpp): the type of
+ * automata, its features and the object that runs it and shows its menu
+ * (see automaton.h). CellularAutomata runs the object of its type, so it
+ * doesn't check the type in each step.
+ */
+struct AutomatonInfo
+{
+    int type;     // ELEMENTARY_CELLULAR_AUTOMATA, LANGTON_ANT...
+    int features; // AUTOMATON_SEED | AUTOMATON_VIEW...
+
+    Automaton* automaton;
+};
+
+#endif
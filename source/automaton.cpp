@@ -0,0 +1,458 @@
+#include <nds.h>
+#include <stdio.h>
+
+#include "automaton.h"
+#include "cellularautomata.h"
+#include "framebuffer.h"
+#include "color.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/********************************AUTOMATON************************************/
+
+// Class constructor
+Automaton::Automaton()
+{
+    arrow = 0;
+}
+
+// Class destructor
+Automaton::~Automaton()
+{
+}
+
+/*
+ * Moves the arrow of the menu to the option index
+ */
+int Automaton::moveArrow(int index)
+{
+    printMenuArrow(arrow, true);
+
+    arrow = index;
+
+    printMenuArrow(arrow, false);
+
+    return 0;
+}
+
+/*
+ * Moves the arrow to the previous option of the menu (from the first one
+ * to the last one)
+ */
+int Automaton::previousOption(int last)
+{
+    return moveArrow(arrow == 0 ? last : arrow - 1);
+}
+
+/*
+ * Moves the arrow to the next option of the menu (from the last one to the
+ * first one)
+ */
+int Automaton::nextOption(int last)
+{
+    return moveArrow(arrow == last ? 0 : arrow + 1);
+}
+
+/*
+ * Sets the palette of the 8 bits per pixel framebuffer for the automata
+ * that draw their cells directly in it (see the CELL_* constants)
+ */
+int Automaton::setCellsPalette()
+{
+    unsigned short palette[CELL_NUM_COLORS];
+
+    makeCellsPalette(palette);
+    setIndexedPalette(palette, CELL_NUM_COLORS);
+
+    return 0;
+}
+
+/*
+ * Shows the main framebuffer cleaned. The automata draw their initial state
+ * after it (the automata of the 8 bits per pixel framebuffer show it
+ * instead).
+ */
+int Automaton::initialize(CellularAutomata& automata)
+{
+    showFB();
+    cleanFB(fb);
+
+    return 0;
+}
+
+int Automaton::nextStep(CellularAutomata& automata)
+{
+    return 0;
+}
+
+/*
+ * Returns true if the generations of the automata can be calculated a few
+ * rows at a time (see stepRows())
+ */
+bool Automaton::hasResumableStep()
+{
+    return false;
+}
+
+/*
+ * Calculates the next rows of the generation in progress. Only the
+ * automata with a resumable step have it, the others calculate a whole
+ * step.
+ */
+int Automaton::stepRows(CellularAutomata& automata, int rows)
+{
+    return nextStep(automata);
+}
+
+int Automaton::getStepRow()
+{
+    return 0;
+}
+
+/*
+ * Starts the automata again with the same seed. Only the automata of the
+ * grid have the initial state saved, the others draw it again.
+ */
+int Automaton::restart(CellularAutomata& automata)
+{
+    return automata.initialize();
+}
+
+/*
+ * Returns true if the automata can't go on (the ants reached the border of
+ * their universe)
+ */
+bool Automaton::hasFinished()
+{
+    return false;
+}
+
+/*
+ * Pans the view dx pixels to the right and dy pixels down
+ */
+int Automaton::pan(CellularAutomata& automata, int dx, int dy)
+{
+    return panView(dx, dy);
+}
+
+/*
+ * Frees the memory of the automata when another one starts
+ */
+int Automaton::release()
+{
+    return 0;
+}
+
+/*
+ * Prints the credits and the name of the automata at the top of its menu
+ */
+int Automaton::printTitle()
+{
+    printCredits();
+
+    printf("%s:\n", stringAutomataType.c_str());
+    printf("%s", getName().c_str());
+
+    return 0;
+}
+
+/*
+ * Gives the settings of the automata their initial values, when it's
+ * chosen in the main menu
+ */
+int Automaton::setDefaults()
+{
+    return 0;
+}
+
+/*
+ * Prints the asterisks that mark the options chosen in the menu
+ */
+int Automaton::printMenuAsterisks()
+{
+    return 0;
+}
+
+/*
+ * Prints the counters of the automata below its name
+ */
+int Automaton::printCounters()
+{
+    printNumSteps();
+    printPopulation();
+
+    return 0;
+}
+
+/*
+ * Shows the arrow in the first option of the menu
+ */
+int Automaton::resetArrow()
+{
+    arrow = 0;
+
+    return printMenuArrow(arrow, false);
+}
+
+/*
+ * Runs the steps of the automata of this frame (see StepGovernor) and
+ * prints its counters
+ */
+int Automaton::runFrame(CellularAutomata& automata)
+{
+    governor.runFrame(automata);
+
+    return printCounters();
+}
+
+/******************************GRID AUTOMATON*********************************/
+
+// Class constructor
+GridAutomaton::GridAutomaton()
+{
+    initialPopulation = 0;
+}
+
+/*
+ * Gives the grid the size of the screen, with every cell empty. The initial
+ * state is written straight into it.
+ */
+int GridAutomaton::clearGrid()
+{
+    grid.setSize(SCREEN_WIDTH, SCREEN_HEIGHT);
+    grid.clear(CELL_BG);
+
+    return 0;
+}
+
+/*
+ * Shows the initial state of the grid (written straight into its cells)
+ * and starts flipping the pages of the framebuffer
+ */
+int GridAutomaton::startGrid(CellularAutomata& automata)
+{
+    grid.loadCells();
+
+    // Saved for the restarts (see restart())
+    grid.saveSnapshot();
+    initialPopulation = automata.getPopulation();
+
+    // The first generation of the cycles
+    automata.startCycles(grid.getHash());
+
+    showIndexedFB();
+    setCellsPalette();
+    grid.present(indexedFB);
+
+    // From here on the pages are flipped by the VBlank interrupt
+    automata.getPipeline().start(showIndexedFBPage, 0);
+
+    return 0;
+}
+
+/*
+ * Copies the changes of the grid to the next page of the framebuffer, that
+ * is shown by the VBlank interrupt (the next generation can be computed
+ * meanwhile). Only the rendered steps do it: the changes of the others are
+ * accumulated by the grid.
+ */
+int GridAutomaton::presentGrid(CellularAutomata& automata)
+{
+    if (automata.isStepRendered() == true)
+    {
+        FramePipeline& pipeline = automata.getPipeline();
+
+        grid.present(getIndexedFBPage(pipeline.acquire()));
+        pipeline.submit();
+    }
+
+    return 0;
+}
+
+/*
+ * Makes the generation just calculated the current one and presents it,
+ * unless it's a cycle that starts the automata again or stops it (see
+ * CellularAutomata::checkCycle())
+ */
+int GridAutomaton::swapGrid(CellularAutomata& automata)
+{
+    grid.swap();
+
+    if (automata.checkCycle(grid.getHash()) == false)
+    {
+        presentGrid(automata);
+    }
+
+    return 0;
+}
+
+/*
+ * Starts the automata again from the initial state saved by startGrid():
+ * the cells are copied back while the pages keep being flipped, so nothing
+ * is drawn again and the screen doesn't flash. The settings can't have
+ * changed (initialize() saves the state again).
+ */
+int GridAutomaton::restart(CellularAutomata& automata)
+{
+    if (grid.hasSnapshot() == false)
+    {
+        return automata.initialize();
+    }
+
+    automata.setPopulation(initialPopulation);
+
+    grid.restoreSnapshot();
+    automata.startCycles(grid.getHash());
+
+    presentGrid(automata);
+
+    return 0;
+}
+
+/*
+ * Frees the cells of the grid. clearGrid() allocates them again.
+ */
+int GridAutomaton::release()
+{
+    return grid.release();
+}
+
+/*
+ * Prints the steps, the population and the bytes copied to VRAM in the
+ * last step (only the cells that changed are copied)
+ */
+int GridAutomaton::printCounters()
+{
+    Automaton::printCounters();
+    printBytesPresented(grid.getBytesPresented());
+
+    return 0;
+}
+
+/***************************UNBOUNDED AUTOMATON*******************************/
+
+// Class constructor
+UnboundedAutomaton::UnboundedAutomaton()
+{
+    universeX = 0;
+    universeY = 0;
+}
+
+/*
+ * Saves the initial state loaded in the universe (after startGrid()) for
+ * the restarts, with the screen showing the window whose upper left cell
+ * is (0, 0). The first generation of the cycles is the one of the
+ * universe.
+ */
+int UnboundedAutomaton::startUniverse(CellularAutomata& automata)
+{
+    universe.saveSnapshot();
+
+    universeX = 0;
+    universeY = 0;
+
+    automata.startCycles(universe.getHash());
+
+    return 0;
+}
+
+/*
+ * Draws the window of the universe shown on the screen in the grid and
+ * presents it like presentGrid(). Only the rendered steps do it. The hash
+ * of the grid isn't kept: the cycles are found with the hash of the
+ * universe.
+ */
+int UnboundedAutomaton::presentUniverse(CellularAutomata& automata)
+{
+    if (automata.isStepRendered() == true)
+    {
+        universe.render(grid, universeX >> 8, universeY >> 8, CELL_FG,
+                        CELL_BG);
+        grid.swap();
+
+        presentGrid(automata);
+    }
+
+    return 0;
+}
+
+/*
+ * Makes the generation just calculated in the universe the current one and
+ * presents it, like swapGrid()
+ */
+int UnboundedAutomaton::swapUniverse(CellularAutomata& automata)
+{
+    universe.swap();
+
+    if (automata.checkCycle(universe.getHash()) == false)
+    {
+        presentUniverse(automata);
+    }
+
+    return 0;
+}
+
+/*
+ * Starts the automata again from its own copy of the initial state (the
+ * grid only has the window of the universe). The screen keeps showing the
+ * window chosen with pan().
+ */
+int UnboundedAutomaton::restart(CellularAutomata& automata)
+{
+    if (grid.hasSnapshot() == false)
+    {
+        return automata.initialize();
+    }
+
+    automata.setPopulation(initialPopulation);
+
+    universe.restoreSnapshot();
+    automata.startCycles(universe.getHash());
+
+    presentUniverse(automata);
+
+    return 0;
+}
+
+/*
+ * Moves the window of the universe shown on the screen dx pixels to the
+ * right and dy pixels down (the size of a pixel in cells depends on the
+ * zoom of the view, see panView()) and draws it, even if the automata is
+ * stopped
+ */
+int UnboundedAutomaton::pan(CellularAutomata& automata, int dx, int dy)
+{
+    int scale = (VIEW_ZOOM_ONE * VIEW_ZOOM_ONE) / getViewZoom();
+    int oldX = universeX >> 8;
+    int oldY = universeY >> 8;
+
+    if (grid.hasSnapshot() == false)
+    {
+        return 0;
+    }
+
+    universeX = universeX + dx * scale;
+    universeY = universeY + dy * scale;
+
+    if ((universeX >> 8) != oldX or (universeY >> 8) != oldY)
+    {
+        bool render = automata.isStepRendered();
+
+        automata.setStepRendered(true);
+        presentUniverse(automata);
+        automata.setStepRendered(render);
+    }
+
+    return 0;
+}
+
+/*
+ * Frees the grid and the chunks of the universe
+ */
+int UnboundedAutomaton::release()
+{
+    GridAutomaton::release();
+
+    return universe.release();
+}
@@ -0,0 +1,124 @@
+#ifndef AUTOMATON_H
+#define AUTOMATON_H
+
+#include <stdint.h>
+#include <string>
+
+#include "grid.h"
+#include "chunkeduniverse.h"
+
+class CellularAutomata;
+
+/*
+ * A type of automata of the registry (see automata.cpp): its settings, the
+ * memory of its cells, how it runs and its menu.
+ *
+ * CellularAutomata keeps what every automata has (the steps, the
+ * population, the random numbers, the pages of the framebuffer and the
+ * cycles) and runs the current one: initialize() draws its initial state
+ * and nextStep() calculates a step. The automata with a resumable step
+ * calculate the next rows of the generation in progress in stepRows(), and
+ * getStepRow() returns the first row left of it (0 if there's none in
+ * progress), see CellularAutomata::stepRows(). release() frees its memory
+ * when another automata starts.
+ *
+ * The menu of the automata is shown by main() when it's chosen in the main
+ * menu: printTitle(), setDefaults() and printMenu(), then the automata is
+ * initialized and the arrow is shown in its first option (see
+ * resetArrow()). In each frame runFrame() runs the automata and
+ * updateMenu() reads the keys.
+ *
+ * A new automata only needs its class and an entry in the registry.
+ */
+class Automaton
+{
+    protected:
+        int arrow; // The option of the menu chosen
+
+        int moveArrow(int index);
+        int previousOption(int last);
+        int nextOption(int last);
+
+        static int setCellsPalette();
+
+    public:
+        Automaton();
+        virtual ~Automaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+        virtual bool hasResumableStep();
+        virtual int stepRows(CellularAutomata& automata, int rows);
+        virtual int getStepRow();
+        virtual int restart(CellularAutomata& automata);
+        virtual bool hasFinished();
+        virtual int pan(CellularAutomata& automata, int dx, int dy);
+        virtual int release();
+
+        virtual const std::string& getName() = 0;
+        virtual int printTitle();
+        virtual int setDefaults();
+        virtual int printMenu() = 0;
+        virtual int printMenuArrow(int index, bool boolDelete) = 0;
+        virtual int printMenuAsterisks();
+        virtual int printCounters();
+        int resetArrow();
+
+        virtual int runFrame(CellularAutomata& automata);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released) = 0;
+};
+
+/*
+ * An automata whose cells are in main RAM (see Grid), shown by the 8 bits
+ * per pixel framebuffer. The initial state is saved by startGrid(), so the
+ * automata that stop changing start again without drawing it (see
+ * restart()).
+ */
+class GridAutomaton : public Automaton
+{
+    protected:
+        Grid grid;
+        unsigned int initialPopulation;
+
+        int clearGrid();
+        int startGrid(CellularAutomata& automata);
+        int presentGrid(CellularAutomata& automata);
+        int swapGrid(CellularAutomata& automata);
+
+    public:
+        GridAutomaton();
+
+        virtual int restart(CellularAutomata& automata);
+        virtual int release();
+
+        virtual int printCounters();
+};
+
+/*
+ * An automata of the grid that runs on an unbounded universe (see
+ * ChunkedUniverse). The grid is only the window of the universe shown on
+ * the screen, whose upper left cell is (universeX, universeY) (24.8 fixed
+ * point, see pan()).
+ */
+class UnboundedAutomaton : public GridAutomaton
+{
+    protected:
+        ChunkedUniverse universe;
+        int universeX;
+        int universeY;
+
+        int startUniverse(CellularAutomata& automata);
+        int presentUniverse(CellularAutomata& automata);
+        int swapUniverse(CellularAutomata& automata);
+
+    public:
+        UnboundedAutomaton();
+
+        virtual int restart(CellularAutomata& automata);
+        virtual int pan(CellularAutomata& automata, int dx, int dy);
+        virtual int release();
+};
+
+#endif
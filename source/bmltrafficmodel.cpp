@@ -0,0 +1,220 @@
+#include <vector>
+#include <stdio.h>
+
+#include <nds.h>
+
+#include "bmltrafficmodel.h"
+#include "cellularautomata.h"
+#include "stencil.h"
+#include "random_numbers.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * References:
+ * http://en.wikipedia.org/wiki/Biham-Middleton-Levine_traffic_model
+ * http://www.jasondavies.com/bml/
+ * http://mae.ucdavis.edu/dsouza/bml.html
+ * http://openprocessing.org/sketch/27491
+ */
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Places the cars of the BML traffic model at random in the grid
+ * (density percent of the cells, half of each color)
+ */
+int BMLtrafficModel::drawInitialState(CellularAutomata& automata)
+{
+    unsigned char* cells = grid.getCells();
+    int total_pixels = SCREEN_WIDTH * SCREEN_HEIGHT;
+    double BML_density_percent = (double) density / 100;
+    int vector_length = BML_density_percent * total_pixels;
+
+    std::vector<int> random_pixels =
+        get_random_int_vector(automata.getRandomNumbers(),
+                              vector_length,
+                              0,
+                              total_pixels);
+
+    for (std::vector<int>::size_type i = 0;
+         i != random_pixels.size(); i++)
+    {
+        if (i % 2 == 0)
+        {
+            cells[random_pixels[i]] = CELL_FG;
+        }
+        else
+        {
+            cells[random_pixels[i]] = CELL_FG2;
+        }
+    }
+
+    automata.setPopulation(random_pixels.size());
+
+    return 0;
+}
+
+/*
+ * Prints the current density of the BML traffic model
+ */
+int BMLtrafficModel::printDensity()
+{
+    iprintf("\x1b[%d;%dH%s: < %d > ", BML_MENU_DENSITY_ROW,
+            BML_MENU_DENSITY_COL, stringDensity.c_str(), density);
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+BMLtrafficModel::BMLtrafficModel()
+{
+    density = BML_INITIAL_DENSITY;
+}
+
+/*
+ * Places the cars of the BML traffic model and loads them in the grid
+ */
+int BMLtrafficModel::initialize(CellularAutomata& automata)
+{
+    // The initial state is written straight into the grid
+    clearGrid();
+
+    drawInitialState(automata);
+
+    startGrid(automata);
+
+    return 0;
+}
+
+/*
+ * Moves the cars of the BML traffic model: the FG_color2 cars in the odd
+ * steps and the FG_color cars in the even ones
+ */
+int BMLtrafficModel::nextStep(CellularAutomata& automata)
+{
+    TrafficRule rule;
+    int populationChange;
+
+    automata.countStep();
+
+    // The borders wrap around: the cars that leave the screen come back
+    // on the other side
+    if (automata.getNumSteps() % 2 == 0 and automata.getNumSteps() != 1)
+    {
+        // The FG_color cars move vertically (top to bottom)
+        rule.state = CELL_FG;
+
+        Stencil<SquareLattice, VerticalTrafficNeighborhood,
+                WrapBorder, TrafficRule>::step(grid, rule,
+                                               populationChange);
+    }
+    else
+    {
+        // The FG_color2 cars move horizontally (left to right)
+        rule.state = CELL_FG2;
+
+        Stencil<SquareLattice, HorizontalTrafficNeighborhood,
+                WrapBorder, TrafficRule>::step(grid, rule,
+                                               populationChange);
+    }
+
+    swapGrid(automata);
+
+    return 0;
+}
+
+const std::string& BMLtrafficModel::getName()
+{
+    return stringBMLtrafficModel;
+}
+
+int BMLtrafficModel::printMenu()
+{
+    printString(BML_MENU_RESTART_ROW,
+                BML_MENU_RESTART_COL,
+                stringRestart);
+    printDensity();
+    printString(BML_MENU_BACK_TO_MAIN_ROW,
+                BML_MENU_BACK_TO_MAIN_COL,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+    printString(VIEW_HELP_ROW, VIEW_HELP_COL, stringViewHelp);
+
+    return 0;
+}
+
+int BMLtrafficModel::printMenuArrow(int index, bool boolDelete)
+{
+    // Restart (0), the density (1) or back to main menu (2)
+    if (index == 0)
+    {
+        return printOptionArrow(BML_MENU_RESTART_ROW,
+                                BML_MENU_RESTART_ARROW_COL,
+                                boolDelete);
+    }
+    else if (index == 1)
+    {
+        return printOptionArrow(BML_MENU_DENSITY_ROW,
+                                BML_MENU_DENSITY_ARROW_COL,
+                                boolDelete);
+    }
+
+    return printOptionArrow(BML_MENU_BACK_TO_MAIN_ROW,
+                            BML_MENU_BACK_TO_MAIN_ARROW_COL,
+                            boolDelete);
+}
+
+/*
+ * The density is used when the automata is restarted
+ */
+int BMLtrafficModel::updateMenu(CellularAutomata& automata,
+                                int keys_pressed,
+                                int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 0)
+        {
+            // Restart the automata with a new seed
+            automata.setSeed(makeRandomSeed());
+            automata.initialize();
+            printPopulation();
+            printSeed();
+        }
+        else if (arrow == 2) // Back to main menu
+        {
+            showAutomataTypeMenu();
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(2);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(2);
+    }
+    else if (keys_pressed & KEY_LEFT)
+    {
+        if (arrow == 1 and density > 0)
+        {
+            --density;
+            printDensity();
+        }
+    }
+    else if (keys_pressed & KEY_RIGHT)
+    {
+        if (arrow == 1 and density < 100)
+        {
+            ++density;
+            printDensity();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef BMLTRAFFICMODEL_H
+#define BMLTRAFFICMODEL_H
+
+#include <string>
+
+#include "automaton.h"
+#include "globals.h"
+
+/*
+ * BML traffic model: the cars of the color that moves in this step (state)
+ * go forward if the cell ahead of them is empty
+ */
+struct TrafficRule
+{
+    unsigned char state;
+
+    unsigned char next(unsigned char cell, int neighbors)
+    {
+        unsigned char behind = neighbors & 0xFF;
+        unsigned char ahead = neighbors >> 8;
+
+        // The car leaves its cell
+        if (cell == state and ahead == CELL_BG)
+        {
+            return CELL_BG;
+        }
+
+        // The car behind comes in
+        if (cell == CELL_BG and behind == state)
+        {
+            return state;
+        }
+
+        return cell;
+    }
+};
+
+/*
+ * The Biham-Middleton-Levine traffic model: density percent of the cells
+ * are cars, half of each color, on a grid whose borders wrap around
+ */
+class BMLtrafficModel : public GridAutomaton
+{
+    private:
+        int density;
+
+        int drawInitialState(CellularAutomata& automata);
+        int printDensity();
+
+    public:
+        BMLtrafficModel();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
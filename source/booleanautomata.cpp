@@ -0,0 +1,750 @@
+#include <nds.h>
+
+#include "booleanautomata.h"
+#include "cellularautomata.h"
+#include "hexgrid.h"
+#include "triangulargrid.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * The menus of the boolean automata: where the arrow goes from each option
+ * with the D-pad, and where it's printed. The numbers of neighbors of a
+ * rule are in rows of 3 or 4, at the columns of the arrow 3, 8, 13 and 18
+ * (their asterisks at 5, 10, 15 and 20).
+ */
+
+// Von Neumann (0), its 1 2 3 4 (1-4), Moore (5), its 1 2 3 4 (6-9), its
+// 5 6 7 8 (10-13) and back to main menu (14)
+static const int BA_MENU_UP[] =
+    {14, 0, 0, 0, 0, 1, 5, 5, 5, 5, 6, 7, 8, 9, 10};
+static const int BA_MENU_DOWN[] =
+    {1, 5, 5, 5, 5, 6, 10, 11, 12, 13, 14, 14, 14, 14, 0};
+static const int BA_MENU_LEFT[] =
+    {0, 4, 1, 2, 3, 5, 9, 6, 7, 8, 13, 10, 11, 12, 14};
+static const int BA_MENU_RIGHT[] =
+    {0, 2, 3, 4, 1, 5, 7, 8, 9, 6, 11, 12, 13, 10, 14};
+static const int BA_MENU_ROWS[] =
+    {BA_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW,
+     BA_MENU_VON_NEUMANN_NEIGHBORHOOD_1234_ROW,
+     BA_MENU_VON_NEUMANN_NEIGHBORHOOD_1234_ROW,
+     BA_MENU_VON_NEUMANN_NEIGHBORHOOD_1234_ROW,
+     BA_MENU_VON_NEUMANN_NEIGHBORHOOD_1234_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+     BA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+     BA_MENU_BACK_TO_MAIN_ROW};
+static const int BA_MENU_COLUMNS[] =
+    {0, 3, 8, 13, 18, 0, 3, 8, 13, 18, 3, 8, 13, 18, 0};
+
+// 1 2 3 (0-2), 4 5 6 (3-5) and back to main menu (6)
+static const int BHA_MENU_UP[] = {6, 6, 6, 0, 1, 2, 3};
+static const int BHA_MENU_DOWN[] = {3, 4, 5, 6, 6, 6, 0};
+static const int BHA_MENU_LEFT[] = {2, 0, 1, 5, 3, 4, 6};
+static const int BHA_MENU_RIGHT[] = {1, 2, 0, 4, 5, 3, 6};
+static const int BHA_MENU_ROWS[] =
+    {BHA_MENU_NEIGHBORHOOD_123_ROW,
+     BHA_MENU_NEIGHBORHOOD_123_ROW,
+     BHA_MENU_NEIGHBORHOOD_123_ROW,
+     BHA_MENU_NEIGHBORHOOD_456_ROW,
+     BHA_MENU_NEIGHBORHOOD_456_ROW,
+     BHA_MENU_NEIGHBORHOOD_456_ROW,
+     BHA_MENU_BACK_TO_MAIN_ROW};
+static const int BHA_MENU_COLUMNS[] = {3, 8, 13, 3, 8, 13, 0};
+
+// Von Neumann (0), its 1 2 3 (1-3), Moore (4), its 1 2 3 4 (5-8), its
+// 5 6 7 8 (9-12) and back to main menu (13)
+static const int BTA_MENU_UP[] =
+    {13, 0, 0, 0, 1, 4, 4, 4, 4, 5, 6, 7, 8, 9};
+static const int BTA_MENU_DOWN[] =
+    {1, 4, 4, 4, 5, 9, 10, 11, 12, 13, 13, 13, 13, 0};
+static const int BTA_MENU_LEFT[] =
+    {0, 3, 1, 2, 4, 8, 5, 6, 7, 12, 9, 10, 11, 13};
+static const int BTA_MENU_RIGHT[] =
+    {0, 2, 3, 1, 4, 6, 7, 8, 5, 10, 11, 12, 9, 13};
+static const int BTA_MENU_ROWS[] =
+    {BTA_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW,
+     BTA_MENU_VON_NEUMANN_NEIGHBORHOOD_123_ROW,
+     BTA_MENU_VON_NEUMANN_NEIGHBORHOOD_123_ROW,
+     BTA_MENU_VON_NEUMANN_NEIGHBORHOOD_123_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+     BTA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+     BTA_MENU_BACK_TO_MAIN_ROW};
+static const int BTA_MENU_COLUMNS[] =
+    {0, 3, 8, 13, 0, 3, 8, 13, 18, 3, 8, 13, 18, 0};
+
+/*
+ * Moves the arrow of a boolean automata menu with the D-pad (see the
+ * tables above)
+ */
+static int moveBooleanArrow(int keys_released,
+                            int arrow,
+                            const int* up,
+                            const int* down,
+                            const int* left,
+                            const int* right)
+{
+    if (keys_released & KEY_UP)
+    {
+        return up[arrow];
+    }
+    else if (keys_released & KEY_DOWN)
+    {
+        return down[arrow];
+    }
+    else if (keys_released & KEY_LEFT)
+    {
+        return left[arrow];
+    }
+    else if (keys_released & KEY_RIGHT)
+    {
+        return right[arrow];
+    }
+
+    return arrow;
+}
+
+/****************************BOOLEAN RULE VALUES******************************/
+
+// Class constructor
+BooleanRuleValues::BooleanRuleValues(int neighborhood)
+{
+    setDefaults(neighborhood);
+}
+
+/*
+ * Turns the bits of the boolean rule of the current neighborhood into its
+ * table: the entry n is all ones if the cells with n neighbors with
+ * FG_color are painted (the bit n - 1 of the rule), 0 otherwise. The
+ * kernels read the table instead of checking the bits of the rule for each
+ * cell (see BooleanRule).
+ */
+int BooleanRuleValues::updateTable()
+{
+    int rule = values[typeOfNeighborhood];
+
+    for (int n = 0; n < BOOLEAN_RULE_TABLE_SIZE; ++n)
+    {
+        // No cell has more than 8 neighbors
+        bool painted = n > 0 and n <= 8 and (rule & (1 << (n - 1))) != 0;
+
+        table[n] = painted == true ? 0xFFFFFFFF : 0;
+    }
+
+    return 0;
+}
+
+/*
+ * Sets the default boolean rule values (one neighbor paints a cell) and
+ * the neighborhood
+ */
+int BooleanRuleValues::setDefaults(int neighborhood)
+{
+    values[VON_NEUMANN_NEIGHBORHOOD] = 1;
+    values[MOORE_NEIGHBORHOOD] = 1;
+
+    typeOfNeighborhood = neighborhood;
+    updateTable();
+
+    return 0;
+}
+
+/*
+ * Returns true if ruleIndex + 1 neighbors paint a cell in the neighborhood
+ */
+bool BooleanRuleValues::check(int neighborhood, int ruleIndex)
+{
+    return ((values[neighborhood] & (1 << ruleIndex)) == (1 << ruleIndex));
+}
+
+/*
+ * Toggles the number of neighbors ruleIndex + 1 of the rule of the
+ * neighborhood. Only the table changes: the automata goes on from its
+ * current step with the new rule, the kernels stay the same.
+ */
+int BooleanRuleValues::toggle(int neighborhood, int ruleIndex)
+{
+    /*
+     * As we start with only one square, if the first value is not checked
+     * the automata enters a loop of start, nothing changes, restart and
+     * the screen flashes.
+     */
+    if (ruleIndex != 0)
+    {
+        // Toggle the bit
+        values[neighborhood] ^= 1 << ruleIndex;
+    }
+
+    updateTable();
+
+    return 0;
+}
+
+/*
+ * Changes the neighborhood, the automata goes on with its rule
+ */
+int BooleanRuleValues::setNeighborhood(int neighborhood)
+{
+    typeOfNeighborhood = neighborhood;
+    updateTable();
+
+    return 0;
+}
+
+int BooleanRuleValues::getNeighborhood()
+{
+    return typeOfNeighborhood;
+}
+
+/*
+ * Returns the rule of the current neighborhood for the stencil engine
+ */
+BooleanRule BooleanRuleValues::getRule()
+{
+    BooleanRule rule;
+
+    rule.state = CELL_FG;
+    rule.table = table;
+
+    return rule;
+}
+
+/*
+ * Prints the asterisks of the numbers of neighbors first + 1 to
+ * first + count of the neighborhood in the row (the ones checked)
+ */
+int BooleanRuleValues::printAsterisks(int row,
+                                      int neighborhood,
+                                      int first,
+                                      int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (check(neighborhood, first + i) == true)
+        {
+            printAsterisk(row, 5 + 5 * i);
+        }
+        else
+        {
+            deleteAsterisk(row, 5 + 5 * i);
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Prints the asterisk of the neighborhood used
+ */
+int BooleanRuleValues::printNeighborhoodAsterisks(int vonNeumannRow,
+                                                  int mooreRow)
+{
+    if (typeOfNeighborhood == VON_NEUMANN_NEIGHBORHOOD)
+    {
+        printAsterisk(vonNeumannRow, 2);
+        deleteAsterisk(mooreRow, 2);
+    }
+    else
+    {
+        deleteAsterisk(vonNeumannRow, 2);
+        printAsterisk(mooreRow, 2);
+    }
+
+    return 0;
+}
+
+/**************************SQUARE BOOLEAN AUTOMATA****************************/
+
+// Class constructor
+SquareBooleanAutomaton::SquareBooleanAutomaton() :
+    rule(VON_NEUMANN_NEIGHBORHOOD)
+{
+}
+
+/*
+ * Gives life to the initial cell in the middle of the grid and loads it in
+ * the universe
+ */
+int SquareBooleanAutomaton::initialize(CellularAutomata& automata)
+{
+    // The initial state is written straight into the grid
+    clearGrid();
+
+    // The initial cell in the middle of the screen.
+    grid.getCells()[91 * SCREEN_WIDTH + 127] = CELL_FG;
+    automata.setPopulation(1);
+
+    startGrid(automata);
+
+    // The automata runs on the copy of the initial state in the universe
+    universe.load(grid.getCells(), grid.getWidth(), grid.getHeight(),
+                  CELL_FG);
+    startUniverse(automata);
+
+    return 0;
+}
+
+/*
+ * Calculates and draws the next step: a cell is painted if the number of
+ * its neighbors with FG_color is one of the numbers checked in the boolean
+ * rule. When no cell changes the automata starts again.
+ */
+int SquareBooleanAutomaton::nextStep(CellularAutomata& automata)
+{
+    BooleanRule booleanRule = rule.getRule();
+    int changes;
+    int populationChange;
+
+    automata.countStep();
+
+    if (rule.getNeighborhood() == MOORE_NEIGHBORHOOD)
+    {
+        changes = ChunkedStencil<MooreNeighborhood,
+                                 BooleanRule>::step(universe, booleanRule,
+                                                    populationChange);
+    }
+    else
+    {
+        changes = ChunkedStencil<VonNeumannNeighborhood,
+                                 BooleanRule>::step(universe, booleanRule,
+                                                    populationChange);
+    }
+
+    automata.addPopulation(populationChange);
+
+    // The automata has finished so we are going to reinitiate the cycle
+    // (unless it stops at the fixed points, see checkCycle())
+    if (changes == 0)
+    {
+        if (automata.checkCycle(universe.getHash()) == false)
+        {
+            automata.restart();
+        }
+    }
+    else // the automata has not finished yet
+    {
+        swapUniverse(automata);
+    }
+
+    return 0;
+}
+
+const std::string& SquareBooleanAutomaton::getName()
+{
+    return stringBooleanAutomata;
+}
+
+/*
+ * Von Neumann neighborhood (default)
+ */
+int SquareBooleanAutomaton::setDefaults()
+{
+    return rule.setDefaults(VON_NEUMANN_NEIGHBORHOOD);
+}
+
+int SquareBooleanAutomaton::printMenu()
+{
+    printString(BA_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW, 3,
+                stringVonNeumannNeighborhood);
+    printString(BA_MENU_VON_NEUMANN_NEIGHBORHOOD_1234_ROW, 6,
+                string1234);
+    printString(BA_MENU_MOORE_NEIGHBORHOOD_ROW, 3,
+                stringMooreNeighborhood);
+    printString(BA_MENU_MOORE_NEIGHBORHOOD_1234_ROW, 6,
+                string1234);
+    printString(BA_MENU_MOORE_NEIGHBORHOOD_5678_ROW, 6,
+                string5678);
+    printString(BA_MENU_BACK_TO_MAIN_ROW, 2,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+    printString(VIEW_HELP_ROW, VIEW_HELP_COL, stringViewHelp);
+
+    return 0;
+}
+
+int SquareBooleanAutomaton::printMenuArrow(int index, bool boolDelete)
+{
+    return printOptionArrow(BA_MENU_ROWS[index], BA_MENU_COLUMNS[index],
+                            boolDelete);
+}
+
+int SquareBooleanAutomaton::printMenuAsterisks()
+{
+    rule.printNeighborhoodAsterisks(BA_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW,
+                                    BA_MENU_MOORE_NEIGHBORHOOD_ROW);
+
+    // {1, 2, 3, 4}
+    rule.printAsterisks(BA_MENU_VON_NEUMANN_NEIGHBORHOOD_1234_ROW,
+                        VON_NEUMANN_NEIGHBORHOOD, 0, 4);
+
+    // {1, 2, 3, 4, 5, 6, 7, 8}
+    rule.printAsterisks(BA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+                        MOORE_NEIGHBORHOOD, 0, 4);
+    rule.printAsterisks(BA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+                        MOORE_NEIGHBORHOOD, 4, 4);
+
+    return 0;
+}
+
+int SquareBooleanAutomaton::updateMenu(CellularAutomata& automata,
+                                       int keys_pressed,
+                                       int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 14)
+        {
+            // Go back to the selection of the type of automata
+            showAutomataTypeMenu();
+
+            return 0;
+        }
+
+        if (arrow == 0)
+        {
+            rule.setNeighborhood(VON_NEUMANN_NEIGHBORHOOD);
+        }
+        else if (arrow >= 1 and arrow <= 4)
+        {
+            rule.toggle(VON_NEUMANN_NEIGHBORHOOD, arrow - 1);
+        }
+        else if (arrow == 5)
+        {
+            rule.setNeighborhood(MOORE_NEIGHBORHOOD);
+        }
+        else
+        {
+            rule.toggle(MOORE_NEIGHBORHOOD, arrow - 6);
+        }
+
+        // The generations seen were made by the old rule
+        automata.forgetCycles();
+
+        printMenuAsterisks();
+    }
+    else if (keys_released & (KEY_UP | KEY_DOWN | KEY_LEFT | KEY_RIGHT))
+    {
+        moveArrow(moveBooleanArrow(keys_released, arrow, BA_MENU_UP,
+                                   BA_MENU_DOWN, BA_MENU_LEFT,
+                                   BA_MENU_RIGHT));
+    }
+
+    return 0;
+}
+
+/************************HEXAGONAL BOOLEAN AUTOMATA***************************/
+
+// Class constructor
+HexagonalBooleanAutomaton::HexagonalBooleanAutomaton() :
+    rule(MOORE_NEIGHBORHOOD)
+{
+}
+
+/*
+ * Paints the initial cell in the grid
+ */
+int HexagonalBooleanAutomaton::initialize(CellularAutomata& automata)
+{
+    // The initial state is written straight into the grid
+    clearGrid();
+
+    paintHexCell(124, 93, (unsigned char) CELL_FG, grid.getCells());
+    automata.setPopulation(1);
+
+    startGrid(automata);
+
+    // The lines of the grid are on their own layer, over the cells
+    showHexLattice();
+
+    return 0;
+}
+
+/*
+ * Calculates and draws the next step, like the square boolean automata.
+ * The rule of the 6 neighbors is stored in the Moore neighborhood.
+ */
+int HexagonalBooleanAutomaton::nextStep(CellularAutomata& automata)
+{
+    BooleanRule booleanRule = rule.getRule();
+    int changes;
+    int populationChange;
+
+    automata.countStep();
+
+    changes = Stencil<HexagonalLattice, MooreNeighborhood,
+                      SkipBorder, BooleanRule>::step(grid, booleanRule,
+                                                     populationChange);
+
+    automata.addPopulation(populationChange);
+
+    // The automata has finished so we are going to reinitiate the cycle
+    // (unless it stops at the fixed points, see checkCycle())
+    if (changes == 0)
+    {
+        if (automata.checkCycle(grid.getHash()) == false)
+        {
+            automata.restart();
+        }
+    }
+    else // the automata has not finished yet
+    {
+        swapGrid(automata);
+    }
+
+    return 0;
+}
+
+const std::string& HexagonalBooleanAutomaton::getName()
+{
+    return stringBooleanHexagonalAutomata;
+}
+
+int HexagonalBooleanAutomaton::setDefaults()
+{
+    return rule.setDefaults(MOORE_NEIGHBORHOOD);
+}
+
+int HexagonalBooleanAutomaton::printMenu()
+{
+    printString(BHA_MENU_NEIGHBORHOOD_ROW, 2, stringNeighborhood);
+    printString(BHA_MENU_NEIGHBORHOOD_123_ROW, 6, string123);
+    printString(BHA_MENU_NEIGHBORHOOD_456_ROW, 6, string456);
+    printString(BHA_MENU_BACK_TO_MAIN_ROW, 2, stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+
+    return 0;
+}
+
+int HexagonalBooleanAutomaton::printMenuArrow(int index, bool boolDelete)
+{
+    return printOptionArrow(BHA_MENU_ROWS[index], BHA_MENU_COLUMNS[index],
+                            boolDelete);
+}
+
+int HexagonalBooleanAutomaton::printMenuAsterisks()
+{
+    // {1, 2, 3, 4, 5, 6}
+    rule.printAsterisks(BHA_MENU_NEIGHBORHOOD_123_ROW,
+                        MOORE_NEIGHBORHOOD, 0, 3);
+    rule.printAsterisks(BHA_MENU_NEIGHBORHOOD_456_ROW,
+                        MOORE_NEIGHBORHOOD, 3, 3);
+
+    return 0;
+}
+
+int HexagonalBooleanAutomaton::updateMenu(CellularAutomata& automata,
+                                          int keys_pressed,
+                                          int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 6)
+        {
+            // Go back to the selection of the type of automata
+            showAutomataTypeMenu();
+
+            return 0;
+        }
+
+        rule.toggle(MOORE_NEIGHBORHOOD, arrow);
+        automata.forgetCycles();
+
+        printMenuAsterisks();
+    }
+    else if (keys_released & (KEY_UP | KEY_DOWN | KEY_LEFT | KEY_RIGHT))
+    {
+        moveArrow(moveBooleanArrow(keys_released, arrow, BHA_MENU_UP,
+                                   BHA_MENU_DOWN, BHA_MENU_LEFT,
+                                   BHA_MENU_RIGHT));
+    }
+
+    return 0;
+}
+
+/************************TRIANGULAR BOOLEAN AUTOMATA**************************/
+
+// Class constructor
+TriangularBooleanAutomaton::TriangularBooleanAutomaton() :
+    rule(VON_NEUMANN_NEIGHBORHOOD)
+{
+}
+
+/*
+ * Paints the initial cell in the grid
+ */
+int TriangularBooleanAutomaton::initialize(CellularAutomata& automata)
+{
+    // The initial state is written straight into the grid
+    clearGrid();
+
+    paintTriangularCell(127, 91, (unsigned char) CELL_FG, grid.getCells());
+    automata.setPopulation(1);
+
+    startGrid(automata);
+
+    // The lines of the grid are on their own layer, over the cells
+    showTriangularLattice();
+
+    return 0;
+}
+
+/*
+ * Calculates and draws the next step, like the square boolean automata
+ */
+int TriangularBooleanAutomaton::nextStep(CellularAutomata& automata)
+{
+    BooleanRule booleanRule = rule.getRule();
+    int changes;
+    int populationChange;
+
+    automata.countStep();
+
+    if (rule.getNeighborhood() == MOORE_NEIGHBORHOOD)
+    {
+        changes = Stencil<TriangularLattice, MooreNeighborhood,
+                          SkipBorder, BooleanRule>::step(grid, booleanRule,
+                                                         populationChange);
+    }
+    else
+    {
+        changes = Stencil<TriangularLattice, VonNeumannNeighborhood,
+                          SkipBorder, BooleanRule>::step(grid, booleanRule,
+                                                         populationChange);
+    }
+
+    automata.addPopulation(populationChange);
+
+    // The automata has finished so we are going to reinitiate the cycle
+    // (unless it stops at the fixed points, see checkCycle())
+    if (changes == 0)
+    {
+        if (automata.checkCycle(grid.getHash()) == false)
+        {
+            automata.restart();
+        }
+    }
+    else // the automata has not finished yet
+    {
+        swapGrid(automata);
+    }
+
+    return 0;
+}
+
+const std::string& TriangularBooleanAutomaton::getName()
+{
+    return stringBooleanTriangularAutomata;
+}
+
+/*
+ * Von Neumann neighborhood (default)
+ */
+int TriangularBooleanAutomaton::setDefaults()
+{
+    return rule.setDefaults(VON_NEUMANN_NEIGHBORHOOD);
+}
+
+int TriangularBooleanAutomaton::printMenu()
+{
+    printString(BTA_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW, 3,
+                stringVonNeumannNeighborhood);
+    printString(BTA_MENU_VON_NEUMANN_NEIGHBORHOOD_123_ROW, 6,
+                string123);
+    printString(BTA_MENU_MOORE_NEIGHBORHOOD_ROW, 3,
+                stringMooreNeighborhood);
+    printString(BTA_MENU_MOORE_NEIGHBORHOOD_1234_ROW, 6,
+                string1234);
+    printString(BTA_MENU_MOORE_NEIGHBORHOOD_5678_ROW, 6,
+                string5678);
+    printString(BTA_MENU_BACK_TO_MAIN_ROW, 2,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+
+    return 0;
+}
+
+int TriangularBooleanAutomaton::printMenuArrow(int index, bool boolDelete)
+{
+    return printOptionArrow(BTA_MENU_ROWS[index], BTA_MENU_COLUMNS[index],
+                            boolDelete);
+}
+
+int TriangularBooleanAutomaton::printMenuAsterisks()
+{
+    rule.printNeighborhoodAsterisks(BTA_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW,
+                                    BTA_MENU_MOORE_NEIGHBORHOOD_ROW);
+
+    // {1, 2, 3}
+    rule.printAsterisks(BTA_MENU_VON_NEUMANN_NEIGHBORHOOD_123_ROW,
+                        VON_NEUMANN_NEIGHBORHOOD, 0, 3);
+
+    // {1, 2, 3, 4, 5, 6, 7, 8}
+    rule.printAsterisks(BTA_MENU_MOORE_NEIGHBORHOOD_1234_ROW,
+                        MOORE_NEIGHBORHOOD, 0, 4);
+    rule.printAsterisks(BTA_MENU_MOORE_NEIGHBORHOOD_5678_ROW,
+                        MOORE_NEIGHBORHOOD, 4, 4);
+
+    return 0;
+}
+
+int TriangularBooleanAutomaton::updateMenu(CellularAutomata& automata,
+                                           int keys_pressed,
+                                           int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 13)
+        {
+            // Go back to the selection of the type of automata
+            showAutomataTypeMenu();
+
+            return 0;
+        }
+
+        if (arrow == 0) // Von Neumann neighborhood
+        {
+            rule.setNeighborhood(VON_NEUMANN_NEIGHBORHOOD);
+        }
+        else if (arrow >= 1 and arrow <= 3) // Von Neumann 1, 2, 3
+        {
+            rule.toggle(VON_NEUMANN_NEIGHBORHOOD, arrow - 1);
+        }
+        else if (arrow == 4) // Moore neighborhood
+        {
+            rule.setNeighborhood(MOORE_NEIGHBORHOOD);
+        }
+        else // Moore 1, 2, 3, 4, 5, 6, 7, 8
+        {
+            rule.toggle(MOORE_NEIGHBORHOOD, arrow - 5);
+        }
+
+        // The generations seen were made by the old rule
+        automata.forgetCycles();
+
+        printMenuAsterisks();
+    }
+    else if (keys_released & (KEY_UP | KEY_DOWN | KEY_LEFT | KEY_RIGHT))
+    {
+        moveArrow(moveBooleanArrow(keys_released, arrow, BTA_MENU_UP,
+                                   BTA_MENU_DOWN, BTA_MENU_LEFT,
+                                   BTA_MENU_RIGHT));
+    }
+
+    return 0;
+}
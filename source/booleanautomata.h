@@ -0,0 +1,155 @@
+#ifndef BOOLEANAUTOMATA_H
+#define BOOLEANAUTOMATA_H
+
+#include <stdint.h>
+#include <string>
+
+#include "automaton.h"
+#include "stencil.h"
+#include "globals.h"
+
+/*
+ * Entries of the table of the boolean rule: one per count of neighbors (0
+ * to 8), padded to 1 << STENCIL_COUNT_BITS (see stencil.h)
+ */
+#define BOOLEAN_RULE_TABLE_SIZE 16
+
+/*
+ * Boolean automata: a cell is painted with FG_color if the number of its
+ * neighbors with FG_color is n and the bit n - 1 of the rule is set, that
+ * is, if the entry n of the table of the rule is set (see
+ * BooleanRuleValues::updateTable()). The painted cells never change again.
+ */
+struct BooleanRule
+{
+    unsigned char state;
+    const uint32_t* table;
+
+    unsigned char next(unsigned char cell, int count)
+    {
+        return cell != CELL_FG and table[count] != 0 ? CELL_FG : cell;
+    }
+
+    // The 32 cells of the planes of the counts that are painted (see
+    // BitSlicedStencil)
+    uint32_t nextWord(const uint32_t* planes)
+    {
+        return BitRows::select(table, planes);
+    }
+
+    // The next generation of 32 painted (1) or empty cells (see
+    // ChunkedStencil)
+    uint32_t nextCells(uint32_t cells, const uint32_t* planes)
+    {
+        return cells | BitRows::select(table, planes);
+    }
+};
+
+/*
+ * The settings of a boolean automata: the numbers of neighbors that paint
+ * a cell in each neighborhood (bit n - 1 for n neighbors) and the
+ * neighborhood used
+ */
+class BooleanRuleValues
+{
+    private:
+        int values[2]; // 0: Von Neumann neighborhood
+                       // 1: Moore neighborhood
+        int typeOfNeighborhood;
+
+        // The rule of the current neighborhood, all ones for the counts
+        // that paint a cell (see updateTable())
+        uint32_t table[BOOLEAN_RULE_TABLE_SIZE];
+        int updateTable();
+
+    public:
+        BooleanRuleValues(int neighborhood);
+
+        int setDefaults(int neighborhood);
+        bool check(int neighborhood, int ruleIndex);
+        int toggle(int neighborhood, int ruleIndex);
+        int setNeighborhood(int neighborhood);
+        int getNeighborhood();
+        BooleanRule getRule();
+
+        int printAsterisks(int row, int neighborhood, int first, int count);
+        int printNeighborhoodAsterisks(int vonNeumannRow, int mooreRow);
+};
+
+/*
+ * The boolean automata of the square lattice, on the unbounded universe:
+ * the painted cells grow beyond the screen until the universe is full
+ */
+class SquareBooleanAutomaton : public UnboundedAutomaton
+{
+    private:
+        BooleanRuleValues rule;
+
+    public:
+        SquareBooleanAutomaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int printMenuAsterisks();
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+/*
+ * The boolean automata of the hexagonal lattice (see showHexLattice()).
+ * It always uses the Moore neighborhood: as it's an array of 8 ints there
+ * is enough space for the 6 neighbors of a hexagon.
+ */
+class HexagonalBooleanAutomaton : public GridAutomaton
+{
+    private:
+        BooleanRuleValues rule;
+
+    public:
+        HexagonalBooleanAutomaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int printMenuAsterisks();
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+/*
+ * The boolean automata of the triangular lattice (see
+ * showTriangularLattice())
+ */
+class TriangularBooleanAutomaton : public GridAutomaton
+{
+    private:
+        BooleanRuleValues rule;
+
+    public:
+        TriangularBooleanAutomaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int printMenuAsterisks();
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
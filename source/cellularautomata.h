@@ -1,96 +1,96 @@
 #ifndef CELLULARAUTOMATA_H
 #define CELLULARAUTOMATA_H
 
+#include <stdint.h>
+
+#include "random_numbers.h"
+#include "pipeline.h"
+#include "cycles.h"
+
+struct AutomatonInfo;
+class Automaton;
+
+/*
+ * Runs the current automata (see automaton.h) and keeps what every
+ * automata has: the steps, the population, the random numbers, the pages
+ * of the framebuffer and the cycles
+ */
 class CellularAutomata
 {
     private:
         int type;
-        
+
         unsigned int numSteps;
         unsigned int population;
-        int numStates;
-
-        int paintECAcell(int row, int col, unsigned short color);
-        
-        // For the Elementary Cellular Automata
-        int ECA_initial_state;
-        unsigned short ruleLeft[8];
-        unsigned short ruleCenter[8];
-        unsigned short ruleRight[8];
-        unsigned short ruleDown[8];
-        int updateECAruleColors();
-        int drawAllRules();
-
-        // For the Langton's ants (normal and hexagonal)
-        unsigned short antPosX;
-        unsigned short antPosY;
-        unsigned short antAngle;
-        unsigned short antNumPixels; // Only used by the normal ant
-                                     // not by the hexagonal one
-        bool antFinished;    
-
-        int booleanRuleValues[2]; // 0: Von Neumann neighborhood
-                                  // 1: Moore neighborhood
-        int typeOfNeighborhood;
-
-        int rotateAnt(unsigned char rotateTo);
-        int paintAnt();
-        int forwardAnt();
-
-        int initialState;
-        int drawInitialState();
-
-        int drawMunchingSquare(int column,
-                               int row,
-                               int width,
-                               unsigned short color);
-        //BML traffic model
-        int BML_density; // 0-100
-
-        // For the cyclic cellular automata
-        unsigned short cyclicAutomataColors[4];
+
+        // Seed of the random numbers of the current run
+        uint32_t seed;
+        RandomNumberGenerator rng;
+
+        // Flips the pages of the framebuffer of the automata that compute a
+        // whole generation per step (triple buffering, see pipeline.h)
+        FramePipeline pipeline;
+        bool renderStep; // Draw the step being calculated (see nextStep())
+
+        // The hashes of the last generations, to find the cycles of the
+        // automata (see checkCycle())
+        CycleDetector cycles;
+        int cycleAction;   // What to do when a cycle is found
+        bool cycleStopped; // A cycle was found and cycleAction is stop
+
+        // The registry of the automata (see automata.cpp) and the current
+        // one, chosen by initialize()
+        static const AutomatonInfo automata[];
+        Automaton* automaton;
 
     public:
+        static const AutomatonInfo* findAutomaton(int type);
+        static int getAutomatonFeatures(int type);
 
         CellularAutomata();
 
         int setType(int t);
         int getType();
-        
-        unsigned int getNumSteps();
 
-        int getNumStates();
-        int setNumStates(int n);
+        unsigned int getNumSteps();
+        int setNumSteps(unsigned int steps);
+        int countStep();
 
         unsigned int getPopulation();
-        
-        int drawElementaryCellularAutomata();
-        int getRuleNumber();
-        int drawRule(int nth);
-        int drawArrow(char nth, unsigned short color);
-        unsigned short getRuleDown(int index);
-        int setRuleDown(int index, unsigned short color);
-        int resetECA();
-        int setInitialStateType(int initialStateType);
-        int getInitialStateType();
-
-        int setAntNumPixels(int numPixels);
-        int getAntNumPixels();
-        
+        int setPopulation(unsigned int newPopulation);
+        int addPopulation(int change);
+
+        uint32_t getSeed();
+        int setSeed(uint32_t newSeed);
+        RandomNumberGenerator& getRandomNumbers();
+
+        FramePipeline& getPipeline();
+        bool isStepRendered();
+        int setStepRendered(bool render);
+
         bool hasFinished();
+
+        int startCycles(uint64_t hash);
+        bool checkCycle(uint64_t hash);
+        int forgetCycles();
+        bool hasCycle();
+        int getCyclePeriod();
+        unsigned int getCycleTransient();
+        int setCycleAction(int action);
+        int getCycleAction();
+        int nextCycleAction();
+
         int initialize();
+        int restart();
+        int stopPipeline();
         int nextStep();
-        
-        int setDefaultBooleanRuleValues();
-        bool checkBooleanRuleValue(int neighborhoodType, int ruleIndex);
-        int toggleBooleanRuleValue(int neighborhoodType, int ruleIndex);
-        int setTypeOfNeighborhood(int value);
-        int getTypeOfNeighborhood();
-
-        int getInitialState();
-        int setInitialState(int state);
-
-        int getBMLdensity();
-        int setBMLdensity(int BMLdensity);
+        int nextStep(bool render);
+
+        bool hasResumableStep();
+        bool isStepInProgress();
+        int getStepRowsLeft();
+        int stepRows(int rows, bool render);
+
+        int pan(int dx, int dy);
 };
 #endif
@@ -0,0 +1,592 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "chunkeduniverse.h"
+
+/*
+ * The finalizer of SplitMix64 (see GenerationHash in cycles.h)
+ */
+static uint64_t mix(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+
+    return x ^ (x >> 31);
+}
+
+/*******************************PRIVATE**************************************/
+
+/*
+ * Takes a chunk from the pool (a new slab if there's none free). Returns
+ * its index, -1 if the universe is full.
+ */
+int ChunkedUniverse::allocate()
+{
+    if (numFree == 0)
+    {
+        if (numSlabs == UNIVERSE_MAX_CHUNKS / UNIVERSE_SLAB_CHUNKS)
+        {
+            return -1;
+        }
+
+        slabs[numSlabs] = new UniverseChunk[UNIVERSE_SLAB_CHUNKS];
+
+        // The last chunk of the slab is taken first
+        for (int i = 0; i < UNIVERSE_SLAB_CHUNKS; ++i)
+        {
+            freeChunks[numFree] = numSlabs * UNIVERSE_SLAB_CHUNKS + i;
+            ++numFree;
+        }
+
+        ++numSlabs;
+    }
+
+    --numFree;
+
+    return freeChunks[numFree];
+}
+
+/*
+ * Returns the index of the chunk (x, y), -1 if it isn't in the universe
+ */
+int ChunkedUniverse::findIndex(int x, int y)
+{
+    if (table == NULL)
+    {
+        return -1;
+    }
+
+    for (int slot = getSlot(x, y);
+         table[slot] != -1;
+         slot = (slot + 1) & (UNIVERSE_TABLE_SIZE - 1))
+    {
+        UniverseChunk* chunk = getChunkAt(table[slot]);
+
+        if (chunk->x == x and chunk->y == y)
+        {
+            return table[slot];
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Adds the chunk (x, y) to the universe with all its cells dead. Returns
+ * NULL if the universe is full.
+ */
+UniverseChunk* ChunkedUniverse::create(int x, int y)
+{
+    int index = allocate();
+
+    if (index == -1)
+    {
+        return NULL;
+    }
+
+    UniverseChunk* chunk = getChunkAt(index);
+
+    chunk->x = x;
+    chunk->y = y;
+    memset(chunk->rows, 0, sizeof(chunk->rows));
+
+    int slot = getSlot(x, y);
+
+    while (table[slot] != -1)
+    {
+        slot = (slot + 1) & (UNIVERSE_TABLE_SIZE - 1);
+    }
+
+    table[slot] = index;
+    active[numActive] = index;
+    ++numActive;
+
+    return chunk;
+}
+
+/*
+ * Fills the hash map again with the chunks of the universe (the linear
+ * probing can't remove them one by one)
+ */
+int ChunkedUniverse::rebuildTable()
+{
+    for (int slot = 0; slot < UNIVERSE_TABLE_SIZE; ++slot)
+    {
+        table[slot] = -1;
+    }
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        UniverseChunk* chunk = getChunkAt(active[i]);
+        int slot = getSlot(chunk->x, chunk->y);
+
+        while (table[slot] != -1)
+        {
+            slot = (slot + 1) & (UNIVERSE_TABLE_SIZE - 1);
+        }
+
+        table[slot] = active[i];
+    }
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+ChunkedUniverse::ChunkedUniverse()
+{
+    numSlabs = 0;
+    freeChunks = NULL;
+    numFree = 0;
+    active = NULL;
+    numActive = 0;
+    table = NULL;
+    current = 0;
+
+    snapshot = NULL;
+    numSnapshot = 0;
+}
+
+// Class destructor
+ChunkedUniverse::~ChunkedUniverse()
+{
+    release();
+}
+
+/*
+ * Kills every cell of the universe. The chunks go back to the pool, that
+ * keeps its slabs.
+ */
+int ChunkedUniverse::clear()
+{
+    if (table == NULL)
+    {
+        freeChunks = new int[UNIVERSE_MAX_CHUNKS];
+        active = new int[UNIVERSE_MAX_CHUNKS];
+        table = new int[UNIVERSE_TABLE_SIZE];
+    }
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        freeChunks[numFree] = active[i];
+        ++numFree;
+    }
+
+    numActive = 0;
+    current = 0;
+
+    return rebuildTable();
+}
+
+/*
+ * Frees the chunks, their slabs and the hash map while another automata
+ * runs. clear() allocates the hash map again.
+ */
+int ChunkedUniverse::release()
+{
+    for (int i = 0; i < numSlabs; ++i)
+    {
+        delete[] slabs[i];
+    }
+
+    delete[] freeChunks;
+    delete[] active;
+    delete[] table;
+    delete[] snapshot;
+
+    numSlabs = 0;
+    freeChunks = NULL;
+    numFree = 0;
+    active = NULL;
+    numActive = 0;
+    table = NULL;
+    current = 0;
+
+    snapshot = NULL;
+    numSnapshot = 0;
+
+    return 0;
+}
+
+/*
+ * Clears the universe and gives life to the cells (width x height, row by
+ * row) in state. The cell (0, 0) of the cells is the cell (0, 0) of the
+ * universe.
+ */
+int ChunkedUniverse::load(const unsigned char* cells, int width, int height,
+                          unsigned char state)
+{
+    clear();
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            if (cells[y * width + x] == state)
+            {
+                setCell(x, y);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Gives life to the cell (x, y) of the current generation
+ */
+int ChunkedUniverse::setCell(int x, int y)
+{
+    int chunkX = x >> UNIVERSE_CHUNK_BITS;
+    int chunkY = y >> UNIVERSE_CHUNK_BITS;
+    int index = findIndex(chunkX, chunkY);
+    UniverseChunk* chunk = index == -1 ? create(chunkX, chunkY) :
+                                         getChunkAt(index);
+
+    if (chunk != NULL)
+    {
+        chunk->rows[current][y & (UNIVERSE_CHUNK_SIZE - 1)] |=
+            1u << (x & (UNIVERSE_CHUNK_SIZE - 1));
+    }
+
+    return 0;
+}
+
+/*
+ * Gives life to the length cells of the row y of the current generation
+ * from the cell (x, y), a word of each chunk at a time. Returns the number
+ * of cells that were dead (the ones of the chunks that can't be created
+ * when the universe is full aren't counted).
+ */
+int ChunkedUniverse::setSpan(int x, int y, int length)
+{
+    int chunkY = y >> UNIVERSE_CHUNK_BITS;
+    int r = y & (UNIVERSE_CHUNK_SIZE - 1);
+    int born = 0;
+
+    while (length > 0)
+    {
+        int chunkX = x >> UNIVERSE_CHUNK_BITS;
+        int b = x & (UNIVERSE_CHUNK_SIZE - 1);
+        int n = UNIVERSE_CHUNK_SIZE - b < length ? UNIVERSE_CHUNK_SIZE - b :
+                                                   length;
+        uint32_t bits = (n == 32 ? 0xFFFFFFFFu : (1u << n) - 1) << b;
+        int index = findIndex(chunkX, chunkY);
+        UniverseChunk* chunk = index == -1 ? create(chunkX, chunkY) :
+                                             getChunkAt(index);
+
+        if (chunk != NULL)
+        {
+            uint32_t& row = chunk->rows[current][r];
+
+            born = born + __builtin_popcount(bits & ~row);
+            row = row | bits;
+        }
+
+        x = x + n;
+        length = length - n;
+    }
+
+    return born;
+}
+
+/*
+ * Returns true if the cell (x, y) of the current generation is alive
+ */
+bool ChunkedUniverse::getCell(int x, int y)
+{
+    const uint32_t* rows = findRows(x >> UNIVERSE_CHUNK_BITS,
+                                    y >> UNIVERSE_CHUNK_BITS);
+
+    return rows != NULL and
+           ((rows[y & (UNIVERSE_CHUNK_SIZE - 1)] >>
+             (x & (UNIVERSE_CHUNK_SIZE - 1))) & 1) != 0;
+}
+
+/*
+ * Adds the neighbors of the chunks whose live cells touch their edges
+ * (the sides and the corners), so the cells born next to them have a
+ * chunk. Returns the number of chunks created.
+ */
+int ChunkedUniverse::expand()
+{
+    int created = 0;
+    int numChunks = numActive;
+
+    for (int i = 0; i < numChunks; ++i)
+    {
+        UniverseChunk* chunk = getChunkAt(active[i]);
+        const uint32_t* rows = chunk->rows[current];
+        uint32_t top = rows[0];
+        uint32_t bottom = rows[UNIVERSE_CHUNK_SIZE - 1];
+        uint32_t sides = 0;
+
+        for (int r = 0; r < UNIVERSE_CHUNK_SIZE; ++r)
+        {
+            sides = sides | rows[r];
+        }
+
+        if (sides == 0)
+        {
+            continue;
+        }
+
+        bool west = (sides & 1) != 0;
+        bool east = (sides >> 31) != 0;
+
+        // The neighbors: north west, north, north east, west, east...
+        bool needed[3][3] =
+        {
+            {(top & 1) != 0, top != 0, (top >> 31) != 0},
+            {west, false, east},
+            {(bottom & 1) != 0, bottom != 0, (bottom >> 31) != 0}
+        };
+
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                if (needed[dy + 1][dx + 1] == true and
+                    findIndex(chunk->x + dx, chunk->y + dy) == -1)
+                {
+                    if (create(chunk->x + dx, chunk->y + dy) == NULL)
+                    {
+                        return created;
+                    }
+
+                    ++created;
+                }
+            }
+        }
+    }
+
+    return created;
+}
+
+/*
+ * Makes the next generation (written by ChunkedStencil) the current one
+ * and gives the chunks left empty back to the pool
+ */
+int ChunkedUniverse::swap()
+{
+    int numChunks = 0;
+
+    current = 1 - current;
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        const uint32_t* rows = getChunkAt(active[i])->rows[current];
+        uint32_t cells = 0;
+
+        for (int r = 0; r < UNIVERSE_CHUNK_SIZE; ++r)
+        {
+            cells = cells | rows[r];
+        }
+
+        if (cells == 0)
+        {
+            freeChunks[numFree] = active[i];
+            ++numFree;
+        }
+        else
+        {
+            active[numChunks] = active[i];
+            ++numChunks;
+        }
+    }
+
+    if (numChunks != numActive)
+    {
+        numActive = numChunks;
+        rebuildTable();
+    }
+
+    return 0;
+}
+
+/*
+ * Saves a copy of the chunks of the current generation (the memory is
+ * allocated again when there are more chunks than in the last copy)
+ */
+int ChunkedUniverse::saveSnapshot()
+{
+    if (snapshot == NULL or numActive > numSnapshot)
+    {
+        delete[] snapshot;
+        snapshot = new UniverseSnapshotChunk[numActive > 0 ? numActive : 1];
+    }
+
+    numSnapshot = numActive;
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        UniverseChunk* chunk = getChunkAt(active[i]);
+
+        snapshot[i].x = chunk->x;
+        snapshot[i].y = chunk->y;
+        memcpy(snapshot[i].rows, chunk->rows[current],
+               sizeof(snapshot[i].rows));
+    }
+
+    return 0;
+}
+
+/*
+ * The generation saved by saveSnapshot() becomes the current one
+ */
+int ChunkedUniverse::restoreSnapshot()
+{
+    if (snapshot == NULL)
+    {
+        return 0;
+    }
+
+    clear();
+
+    for (int i = 0; i < numSnapshot; ++i)
+    {
+        UniverseChunk* chunk = create(snapshot[i].x, snapshot[i].y);
+
+        memcpy(chunk->rows[current], snapshot[i].rows,
+               sizeof(snapshot[i].rows));
+    }
+
+    return 0;
+}
+
+/*
+ * Returns true if a generation was saved with saveSnapshot()
+ */
+bool ChunkedUniverse::hasSnapshot()
+{
+    return snapshot != NULL;
+}
+
+int ChunkedUniverse::getNumChunks()
+{
+    return numActive;
+}
+
+// The chunk i of the universe (0 to getNumChunks() - 1)
+UniverseChunk* ChunkedUniverse::getChunk(int i)
+{
+    return getChunkAt(active[i]);
+}
+
+// The rows of the chunks with the current generation (0 or 1)
+int ChunkedUniverse::getCurrent()
+{
+    return current;
+}
+
+/*
+ * Returns the number of live cells
+ */
+long ChunkedUniverse::getPopulation()
+{
+    long population = 0;
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        const uint32_t* rows = getChunkAt(active[i])->rows[current];
+
+        for (int r = 0; r < UNIVERSE_CHUNK_SIZE; ++r)
+        {
+            population = population + __builtin_popcount(rows[r]);
+        }
+    }
+
+    return population;
+}
+
+/*
+ * Returns the bytes taken by the slabs of chunks and the hash map
+ */
+long ChunkedUniverse::getMemory()
+{
+    if (table == NULL)
+    {
+        return 0;
+    }
+
+    return (long) numSlabs * UNIVERSE_SLAB_CHUNKS * sizeof(UniverseChunk) +
+           (2 * UNIVERSE_MAX_CHUNKS + UNIVERSE_TABLE_SIZE) * sizeof(int);
+}
+
+/*
+ * Returns the hash of the current generation, to find its cycles. Each
+ * chunk with live cells adds the hash of its rows and coordinates, so the
+ * order of the chunks and the empty ones don't change it.
+ */
+uint64_t ChunkedUniverse::getHash()
+{
+    uint64_t hash = 0;
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        UniverseChunk* chunk = getChunkAt(active[i]);
+        const uint32_t* rows = chunk->rows[current];
+        uint64_t chunkHash = mix(((uint64_t) (uint32_t) chunk->x << 32) |
+                                 (uint32_t) chunk->y);
+        bool empty = true;
+
+        for (int r = 0; r < UNIVERSE_CHUNK_SIZE; ++r)
+        {
+            chunkHash = mix(chunkHash ^ rows[r]);
+            empty = empty and rows[r] == 0;
+        }
+
+        if (empty == false)
+        {
+            hash = hash + chunkHash;
+        }
+    }
+
+    return hash;
+}
+
+/*
+ * Finds the smallest rectangle (in cells) with every live cell. Returns
+ * false if there's none.
+ */
+bool ChunkedUniverse::getBounds(int& minX, int& minY, int& maxX, int& maxY)
+{
+    bool found = false;
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        UniverseChunk* chunk = getChunkAt(active[i]);
+        const uint32_t* rows = chunk->rows[current];
+
+        for (int r = 0; r < UNIVERSE_CHUNK_SIZE; ++r)
+        {
+            if (rows[r] == 0)
+            {
+                continue;
+            }
+
+            int y = chunk->y * UNIVERSE_CHUNK_SIZE + r;
+            int left = chunk->x * UNIVERSE_CHUNK_SIZE +
+                       __builtin_ctz(rows[r]);
+            int right = chunk->x * UNIVERSE_CHUNK_SIZE + 31 -
+                        __builtin_clz(rows[r]);
+
+            if (found == false)
+            {
+                minX = left;
+                maxX = right;
+                minY = y;
+                maxY = y;
+                found = true;
+            }
+
+            minX = left < minX ? left : minX;
+            maxX = right > maxX ? right : maxX;
+            minY = y < minY ? y : minY;
+            maxY = y > maxY ? y : maxY;
+        }
+    }
+
+    return found;
+}
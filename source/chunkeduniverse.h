@@ -0,0 +1,229 @@
+#ifndef CHUNKEDUNIVERSE_H
+#define CHUNKEDUNIVERSE_H
+
+#include <stdint.h>
+
+#include "grid.h"
+
+/*
+ * Size of the side of a chunk (in cells): one 32 bits word per row
+ */
+#define UNIVERSE_CHUNK_BITS 5
+#define UNIVERSE_CHUNK_SIZE (1 << UNIVERSE_CHUNK_BITS)
+
+/*
+ * Most chunks of a universe (a chunk takes 264 bytes), the chunks allocated
+ * at a time and the slots of the hash map of the chunks (a power of two, at
+ * least twice the chunks so the probes stay short)
+ */
+#define UNIVERSE_MAX_CHUNKS 2048
+#define UNIVERSE_SLAB_CHUNKS 64
+#define UNIVERSE_TABLE_SIZE 4096
+
+/*
+ * Most chunks across a window of render() (one more than the words of a
+ * row of the grid, when the window isn't aligned to the chunks)
+ */
+#define UNIVERSE_MAX_BAND_CHUNKS (GRID_MAX_WIDTH / UNIVERSE_CHUNK_SIZE + 1)
+
+/*
+ * A square of UNIVERSE_CHUNK_SIZE x UNIVERSE_CHUNK_SIZE cells of the
+ * universe, at the chunk coordinates (x, y). The rows of the current and
+ * the next generation are bit rows: the bit b of the row r is the cell
+ * (x * UNIVERSE_CHUNK_SIZE + b, y * UNIVERSE_CHUNK_SIZE + r).
+ */
+struct UniverseChunk
+{
+    int x;
+    int y;
+    uint32_t rows[2][UNIVERSE_CHUNK_SIZE];
+};
+
+/*
+ * The current generation of a chunk saved by saveSnapshot()
+ */
+struct UniverseSnapshotChunk
+{
+    int x;
+    int y;
+    uint32_t rows[UNIVERSE_CHUNK_SIZE];
+};
+
+/*
+ * An unbounded universe of two states (the game of life and the boolean
+ * automata) that only keeps the chunks where something lives.
+ *
+ * The chunks are found by their coordinates in a hash map (open addressing
+ * with linear probing) and taken from a pool that grows by slabs of
+ * UNIVERSE_SLAB_CHUNKS chunks, so the memory follows the live area instead
+ * of its bounding box. expand() creates the neighbors of the chunks whose
+ * cells reach their edges before each step (a cell can only be born next
+ * to a live one), and swap() frees the chunks left empty. When the pool is
+ * full no chunk is created: the cells of the border of the universe see
+ * dead cells beyond it.
+ *
+ * The steps are calculated by ChunkedStencil (see stencil.h) and the
+ * screen is a viewport over the universe: render() writes the cells of the
+ * window that starts at a cell of the universe to a grid.
+ *
+ * The coordinates of the cells are split with shifts and masks, so the
+ * negative ones work too (the shifts of signed ints are arithmetic).
+ *
+ * saveSnapshot() keeps a copy of the chunks of the initial state, so the
+ * automata can start again without loading it from the grid, that only
+ * holds the window shown on the screen.
+ */
+class ChunkedUniverse
+{
+    private:
+        UniverseChunk* slabs[UNIVERSE_MAX_CHUNKS / UNIVERSE_SLAB_CHUNKS];
+        int numSlabs;
+
+        int* freeChunks; // Indexes of the chunks of the slabs not used
+        int numFree;
+        int* active;     // Indexes of the chunks of the universe
+        int numActive;
+        int* table;      // Indexes of the chunks by their coordinates
+
+        int current;     // The rows of the current generation (0 or 1)
+
+        UniverseSnapshotChunk* snapshot; // See saveSnapshot()
+        int numSnapshot;
+
+        UniverseChunk* getChunkAt(int index)
+        {
+            return slabs[index / UNIVERSE_SLAB_CHUNKS] +
+                   index % UNIVERSE_SLAB_CHUNKS;
+        }
+
+        static int getSlot(int x, int y)
+        {
+            uint32_t hash = (uint32_t) x * 0x9E3779B1u ^
+                            (uint32_t) y * 0x85EBCA77u;
+
+            return (hash ^ (hash >> 15)) & (UNIVERSE_TABLE_SIZE - 1);
+        }
+
+        int allocate();
+        int findIndex(int x, int y);
+        UniverseChunk* create(int x, int y);
+        int rebuildTable();
+
+    public:
+        ChunkedUniverse();
+        ~ChunkedUniverse();
+
+        int clear();
+        int release();
+        int load(const unsigned char* cells, int width, int height,
+                 unsigned char state);
+        int setCell(int x, int y);
+        int setSpan(int x, int y, int length);
+        bool getCell(int x, int y);
+
+        int expand();
+        int swap();
+
+        int saveSnapshot();
+        int restoreSnapshot();
+        bool hasSnapshot();
+
+        int getNumChunks();
+        UniverseChunk* getChunk(int i);
+        int getCurrent();
+        long getPopulation();
+        long getMemory();
+        uint64_t getHash();
+        bool getBounds(int& minX, int& minY, int& maxX, int& maxY);
+
+        // The rows of the current generation of the chunk (x, y), NULL if
+        // it isn't in the universe (all its cells are dead)
+        const uint32_t* findRows(int x, int y)
+        {
+            int index = findIndex(x, y);
+
+            return index == -1 ? NULL : getChunkAt(index)->rows[current];
+        }
+
+        /*
+         * Writes the cells of the window of the universe whose upper left
+         * cell is (x0, y0) to the next generation of the store (as many as
+         * its cells, fg for the live ones and bg for the dead ones) and
+         * marks the ones that differ from its current generation, so only
+         * they're presented after swap(). Returns the number of rows that
+         * changed.
+         */
+        template <class Store>
+        int render(Store& store, int x0, int y0,
+                   typename Store::Cell fg, typename Store::Cell bg)
+        {
+            typedef typename Store::Cell Cell;
+
+            // The chunks of the band of rows of the window
+            const uint32_t* band[UNIVERSE_MAX_BAND_CHUNKS];
+
+            int width = store.getWidth();
+            int height = store.getHeight();
+            int numWords = (width + 31) / 32;
+            int shift = x0 & (UNIVERSE_CHUNK_SIZE - 1);
+            int firstChunk = x0 >> UNIVERSE_CHUNK_BITS;
+            int changes = 0;
+
+            const Cell* cells = store.getCells();
+            Cell* newCells = store.getNewCells();
+
+            for (int j = 0; j < height; ++j)
+            {
+                int y = y0 + j;
+                int r = y & (UNIVERSE_CHUNK_SIZE - 1);
+
+                if (j == 0 or r == 0)
+                {
+                    for (int k = 0; k <= numWords; ++k)
+                    {
+                        band[k] = findRows(firstChunk + k,
+                                           y >> UNIVERSE_CHUNK_BITS);
+                    }
+                }
+
+                const Cell* row = cells + width * j;
+                Cell* newRow = newCells + width * j;
+                int first = width;
+                int last = -1;
+
+                for (int w = 0; w < numWords; ++w)
+                {
+                    uint32_t low = band[w] != NULL ? band[w][r] : 0;
+                    uint32_t high = band[w + 1] != NULL ? band[w + 1][r] : 0;
+                    uint32_t bits = shift == 0 ?
+                                    low :
+                                    (low >> shift) | (high << (32 - shift));
+                    int end = width - 32 * w < 32 ? width - 32 * w : 32;
+
+                    for (int b = 0; b < end; ++b)
+                    {
+                        int x = 32 * w + b;
+                        Cell cell = ((bits >> b) & 1) != 0 ? fg : bg;
+
+                        newRow[x] = cell;
+
+                        if (cell != row[x])
+                        {
+                            first = x < first ? x : first;
+                            last = x;
+                        }
+                    }
+                }
+
+                if (last != -1)
+                {
+                    store.markDirty(first, j, last - first + 1, 1);
+                    ++changes;
+                }
+            }
+
+            return changes;
+        }
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include <nds.h>
 
+#include "globals.h"
+
 // Color used on the BackGround (Default: White)
 unsigned short BG_R = 31;
 unsigned short BG_G = 31;
@@ -35,3 +37,87 @@ unsigned short line_R = 15;
 unsigned short line_G = 15;
 unsigned short line_B = 15; 
 unsigned short line_color = RGB15(line_R, line_G, line_B);
+
+/*
+ * Fills palette with the colors of numStates states.
+ * Up to four states use the foreground colors chosen by the user,
+ * more states get colors spread around the color wheel.
+ */
+int makeStatesPalette(unsigned short* palette, int numStates)
+{
+    if (numStates <= 4)
+    {
+        unsigned short colors[4] = { FG_color, FG_color2,
+                                     FG_color3, FG_color4 };
+
+        for (int i = 0; i < numStates; i++)
+        {
+            palette[i] = colors[i];
+        }
+
+        return 0;
+    }
+
+    for (int i = 0; i < numStates; i++)
+    {
+        // Position in the color wheel: 6 sectors of 32 levels
+        int hue = (i * 6 * 32) / numStates;
+        int level = hue % 32;
+        unsigned short r, g, b;
+
+        switch (hue / 32)
+        {
+            case 0: r = 31; g = level; b = 0; break;
+            case 1: r = 31 - level; g = 31; b = 0; break;
+            case 2: r = 0; g = 31; b = level; break;
+            case 3: r = 0; g = 31 - level; b = 31; break;
+            case 4: r = level; g = 0; b = 31; break;
+            default: r = 31; g = 0; b = 31 - level; break;
+        }
+
+        palette[i] = RGB15(r, g, b);
+    }
+
+    return 0;
+}
+
+/*
+ * Fills the palette of the cells of the automata that run on the grid
+ * (CELL_NUM_COLORS colors, see the CELL_* constants of globals.h) with the
+ * colors chosen by the user
+ */
+int makeCellsPalette(unsigned short* palette)
+{
+    palette[CELL_BG] = BG_color;
+    palette[CELL_FG] = FG_color;
+    palette[CELL_FG2] = FG_color2;
+    palette[CELL_LINE] = line_color;
+
+    return 0;
+}
+
+/*
+ * Fills palette with the colors of the numStates states of Generations:
+ * the dead cells get the background color, the firing ones the foreground
+ * color and the dying ones fade from the second foreground color to the
+ * background color
+ */
+int makeGenerationsPalette(unsigned short* palette, int numStates)
+{
+    int numDying = numStates - 2;
+
+    palette[0] = BG_color;
+    palette[1] = FG_color;
+
+    for (int i = 0; i < numDying; i++)
+    {
+        // The last dying state is still a bit brighter than the background
+        int r = FG_R2 + (BG_R - FG_R2) * i / (numDying + 1);
+        int g = FG_G2 + (BG_G - FG_G2) * i / (numDying + 1);
+        int b = FG_B2 + (BG_B - FG_B2) * i / (numDying + 1);
+
+        palette[2 + i] = RGB15(r, g, b);
+    }
+
+    return 0;
+}
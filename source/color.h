@@ -50,4 +50,8 @@ extern unsigned short line_G;
 extern unsigned short line_B; 
 extern unsigned short line_color;
 
+int makeStatesPalette(unsigned short* palette, int numStates);
+int makeCellsPalette(unsigned short* palette);
+int makeGenerationsPalette(unsigned short* palette, int numStates);
+
 #endif
@@ -0,0 +1,163 @@
+#include "cycles.h"
+
+/*
+ * Key of each column (see GenerationHash), filled by the first call
+ */
+static uint64_t columnKeyTable[CYCLE_MAX_WIDTH];
+static bool columnKeysReady = false;
+
+/********************************PUBLIC**************************************/
+
+/*
+ * Returns the keys of the columns (CYCLE_MAX_WIDTH keys)
+ */
+const uint64_t* GenerationHash::columnKeys()
+{
+    if (columnKeysReady == false)
+    {
+        for (int x = 0; x < CYCLE_MAX_WIDTH; ++x)
+        {
+            columnKeyTable[x] =
+                mix(0xD1B54A32D192ED03ULL * (uint64_t) (x + 1)) | 1;
+        }
+
+        columnKeysReady = true;
+    }
+
+    return columnKeyTable;
+}
+
+/*
+ * Returns the hash of all the cells (row by row), when there's no previous
+ * generation to update it from
+ */
+uint64_t GenerationHash::hashCells(const unsigned char* cells, int width,
+                                   int height)
+{
+    const uint64_t* keys = columnKeys();
+    uint64_t hash = 0;
+
+    for (int y = 0; y < height; ++y)
+    {
+        uint64_t sum = 0;
+
+        for (int x = 0; x < width; ++x)
+        {
+            sum = sum + cells[y * width + x] *
+                        keys[x & (CYCLE_MAX_WIDTH - 1)];
+        }
+
+        hash = hash + sum * rowKey(y);
+    }
+
+    return hash;
+}
+
+// Class constructor
+CycleDetector::CycleDetector()
+{
+    maxPeriod = CYCLE_MAX_PERIOD;
+
+    reset();
+}
+
+/*
+ * Forgets the generations of the previous run
+ */
+int CycleDetector::reset()
+{
+    numGenerations = 0;
+    lastGeneration = 0;
+    period = 0;
+    transient = 0;
+
+    return 0;
+}
+
+/*
+ * Adds the hash of the generation (the generations must be consecutive,
+ * starting from any one). Returns true if it's the generation that reveals
+ * the cycle; once a cycle is found nothing else is checked.
+ */
+bool CycleDetector::addGeneration(unsigned int generation, uint64_t hash)
+{
+    if (period != 0)
+    {
+        return false;
+    }
+
+    // A gap (or going back) starts a new history
+    if (numGenerations != 0 and generation != lastGeneration + 1)
+    {
+        numGenerations = 0;
+    }
+
+    int limit = (int) numGenerations < maxPeriod ? numGenerations :
+                                                   maxPeriod;
+
+    for (int p = 1; p <= limit; ++p)
+    {
+        if (history[(generation - p) % CYCLE_MAX_PERIOD] == hash)
+        {
+            period = p;
+            transient = generation - p;
+
+            return true;
+        }
+    }
+
+    history[generation % CYCLE_MAX_PERIOD] = hash;
+    lastGeneration = generation;
+
+    if ((int) numGenerations < CYCLE_MAX_PERIOD)
+    {
+        ++numGenerations;
+    }
+
+    return false;
+}
+
+/*
+ * Sets the longest period that is checked (between 1 and CYCLE_MAX_PERIOD)
+ */
+int CycleDetector::setMaxPeriod(int p)
+{
+    if (p < 1)
+    {
+        p = 1;
+    }
+    else if (p > CYCLE_MAX_PERIOD)
+    {
+        p = CYCLE_MAX_PERIOD;
+    }
+
+    maxPeriod = p;
+
+    return 0;
+}
+
+int CycleDetector::getMaxPeriod()
+{
+    return maxPeriod;
+}
+
+bool CycleDetector::hasCycle()
+{
+    return period != 0;
+}
+
+/*
+ * Returns the period of the cycle found, 0 if none
+ */
+int CycleDetector::getPeriod()
+{
+    return period;
+}
+
+/*
+ * Returns the number of generations before the cycle found
+ */
+unsigned int CycleDetector::getTransient()
+{
+    return transient;
+}
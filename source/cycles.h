@@ -0,0 +1,107 @@
+#ifndef CYCLES_H
+#define CYCLES_H
+
+#include <stdint.h>
+
+/*
+ * Number of keys of the columns (a power of 2), the same as GRID_MAX_WIDTH.
+ * Wider generations reuse them (column x % CYCLE_MAX_WIDTH).
+ */
+#define CYCLE_MAX_WIDTH 256
+
+/*
+ * Maximum period of the cycles that can be detected (the size of the
+ * history of CycleDetector)
+ */
+#define CYCLE_MAX_PERIOD 64
+
+/*
+ * What the automata does when it finds a cycle (see
+ * CellularAutomata::setCycleAction())
+ */
+#define CYCLE_ACTION_GO_ON 0
+#define CYCLE_ACTION_RESTART 1
+#define CYCLE_ACTION_STOP 2
+#define CYCLE_NUM_ACTIONS 3
+
+/*
+ * Rolling hash of the cells of a generation:
+ *
+ *   hash = sum of rowKey(y) * (sum of cell(x, y) * columnKey(x))
+ *
+ * modulo 2^64, where the keys are odd pseudorandom numbers. The hash is
+ * linear, so when a cell changes only the sum of its row changes, by
+ * (next - cell) * columnKey(x): the kernels add up the changes of each row
+ * (see rowChange()) and the hash of the next generation costs a
+ * multiplication per changed cell instead of a pass over all of them.
+ */
+class GenerationHash
+{
+    private:
+        static uint64_t mix(uint64_t x)
+        {
+            // The finalizer of SplitMix64
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+
+            return x ^ (x >> 31);
+        }
+
+    public:
+        static const uint64_t* columnKeys();
+
+        static uint64_t rowKey(int y)
+        {
+            return mix(0x9E3779B97F4A7C15ULL * (uint64_t) (y + 1)) | 1;
+        }
+
+        // The change of the sum of a row when a cell changes
+        static uint64_t rowChange(const uint64_t* keys, int x, int cell,
+                                  int next)
+        {
+            return (uint64_t) (int64_t) (next - cell) *
+                   keys[x & (CYCLE_MAX_WIDTH - 1)];
+        }
+
+        static uint64_t hashCells(const unsigned char* cells, int width,
+                                  int height);
+};
+
+/*
+ * Finds the first generation that repeats one of the last maxPeriod ones.
+ *
+ * The hash of each generation is kept in a small circular history. When a
+ * generation has the same hash as the one period generations before it,
+ * the automata is in a cycle of that period (1: a still life or a fixed
+ * point), and the transient is the number of generations before the cycle
+ * starts. The shortest period is the one reported.
+ *
+ * It doesn't depend on libnds, so it can be used in headless runs.
+ */
+class CycleDetector
+{
+    private:
+        uint64_t history[CYCLE_MAX_PERIOD]; // Hash of generation n at
+                                            // n % CYCLE_MAX_PERIOD
+        unsigned int numGenerations;        // Generations in the history
+        unsigned int lastGeneration;
+        int maxPeriod;
+
+        int period;             // 0 until a cycle is found
+        unsigned int transient; // Generations before the cycle
+
+    public:
+        CycleDetector();
+
+        int reset();
+        bool addGeneration(unsigned int generation, uint64_t hash);
+
+        int setMaxPeriod(int p);
+        int getMaxPeriod();
+
+        bool hasCycle();
+        int getPeriod();
+        unsigned int getTransient();
+};
+
+#endif
@@ -0,0 +1,770 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cyclicautomata.h"
+#include "cycles.h"
+#include "globals.h"
+#include "random_numbers.h"
+
+/*
+ * Cells of padding on each side of the row of the one dimensional automata:
+ * CCA_MAX_RANGE rounded up to a multiple of 4, so the row stays word aligned
+ * and can be copied to VRAM with the DMA
+ */
+#define CCA_1D_PADDING 8
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Frees the memory used by the cells and the counts
+ */
+int CyclicAutomata2D::freeBuffers()
+{
+    delete[] cells;
+    delete[] newCells;
+    delete[] columnCounts;
+    delete[] wrappedColumns;
+    delete[] wrappedRows;
+
+    cells = NULL;
+    newCells = NULL;
+    columnCounts = NULL;
+    wrappedColumns = NULL;
+    wrappedRows = NULL;
+
+    return 0;
+}
+
+/*
+ * Fills the lookup tables of the successor of each state
+ */
+int CyclicAutomata2D::updateSuccessors()
+{
+    for (int i = 0; i < numStates; ++i)
+    {
+        successor[i] = (i + 1) % numStates;
+
+        if (model == CCA_MODEL_GREENBERG_HASTINGS)
+        {
+            // Only the resting cells need excited neighbors
+            needsThreshold[i] = (i == 0);
+        }
+        else
+        {
+            needsThreshold[i] = true;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Calculates the rows from firstRow to lastRow - 1 of the next generation
+ * with the Moore neighborhood.
+ *
+ * The cells of the neighborhood are a square, so the number of neighbors
+ * in a state is the sum of the column counts of that state from x - range
+ * to x + range. The column counts are updated when moving to the next row
+ * (the row that leaves the square is subtracted and the one that enters is
+ * added), so each cell needs 2 * range + 1 reads instead of one per
+ * neighbor. The cell itself is in the square, but it's never in the state
+ * of its successor, so it isn't counted.
+ *
+ * The column counts are kept between calls, so the rows must be calculated
+ * in order starting from row 0.
+ */
+int CyclicAutomata2D::nextRowsMoore(int firstRow, int lastRow)
+{
+    const int* rows = wrappedRows + CCA_MAX_RANGE;
+    const uint64_t* keys = GenerationHash::columnKeys();
+
+    if (firstRow == 0)
+    {
+        memset(columnCounts, 0, numStates * width);
+
+        for (int dy = -range; dy <= range; ++dy)
+        {
+            const unsigned char* row = cells + rows[dy] * width;
+
+            for (int x = 0; x < width; ++x)
+            {
+                ++columnCounts[row[x] * width + x];
+            }
+        }
+    }
+
+    for (int y = firstRow; y < lastRow; ++y)
+    {
+        const unsigned char* row = cells + y * width;
+        unsigned char* out = newCells + y * width;
+        uint64_t rowChange = 0;
+
+        for (int x = 0; x < width; ++x)
+        {
+            unsigned char state = row[x];
+            unsigned char next = successor[state];
+
+            if (needsThreshold[state] == true)
+            {
+                const unsigned char* counts = columnCounts + next * width;
+                const int* columns = wrappedColumns + x + CCA_MAX_RANGE;
+                int count = 0;
+
+                for (int dx = -range; dx <= range; ++dx)
+                {
+                    count = count + counts[columns[dx]];
+                }
+
+                if (count < threshold)
+                {
+                    out[x] = state;
+                    continue;
+                }
+            }
+
+            out[x] = next;
+            rowChange = rowChange +
+                        GenerationHash::rowChange(keys, x, state, next);
+        }
+
+        hashChange = hashChange + rowChange * GenerationHash::rowKey(y);
+
+        // Move the square one row down
+        const unsigned char* leaving = cells + rows[y - range] * width;
+        const unsigned char* entering = cells + rows[y + range + 1] * width;
+
+        for (int x = 0; x < width; ++x)
+        {
+            --columnCounts[leaving[x] * width + x];
+            ++columnCounts[entering[x] * width + x];
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Calculates the rows from firstRow to lastRow - 1 of the next generation
+ * with the Von Neumann neighborhood (the cells at a Manhattan distance of
+ * range or less)
+ */
+int CyclicAutomata2D::nextRowsVonNeumann(int firstRow, int lastRow)
+{
+    const int* rows = wrappedRows + CCA_MAX_RANGE;
+    const uint64_t* keys = GenerationHash::columnKeys();
+
+    for (int y = firstRow; y < lastRow; ++y)
+    {
+        const unsigned char* row = cells + y * width;
+        unsigned char* out = newCells + y * width;
+        uint64_t rowChange = 0;
+
+        for (int x = 0; x < width; ++x)
+        {
+            unsigned char state = row[x];
+            unsigned char next = successor[state];
+
+            if (needsThreshold[state] == true)
+            {
+                const int* columns = wrappedColumns + x + CCA_MAX_RANGE;
+                int count = 0;
+
+                for (int dy = -range; dy <= range; ++dy)
+                {
+                    const unsigned char* neighbors =
+                        cells + rows[y + dy] * width;
+                    int span = range - (dy < 0 ? -dy : dy);
+
+                    for (int dx = -span; dx <= span; ++dx)
+                    {
+                        if (neighbors[columns[dx]] == next)
+                        {
+                            ++count;
+                        }
+                    }
+                }
+
+                if (count < threshold)
+                {
+                    out[x] = state;
+                    continue;
+                }
+            }
+
+            out[x] = next;
+            rowChange = rowChange +
+                        GenerationHash::rowChange(keys, x, state, next);
+        }
+
+        hashChange = hashChange + rowChange * GenerationHash::rowKey(y);
+    }
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+CyclicAutomata2D::CyclicAutomata2D()
+{
+    width = 0;
+    height = 0;
+    numStates = CCA_INITIAL_NUM_STATES;
+    range = CCA_INITIAL_RANGE;
+    threshold = CCA_INITIAL_THRESHOLD;
+    typeOfNeighborhood = MOORE_NEIGHBORHOOD;
+    model = CCA_MODEL_CYCLIC;
+
+    cells = NULL;
+    newCells = NULL;
+    columnCounts = NULL;
+    wrappedColumns = NULL;
+    wrappedRows = NULL;
+
+    stepRow = 0;
+
+    hash = 0;
+    hashChange = 0;
+
+    updateSuccessors();
+}
+
+// Class destructor
+CyclicAutomata2D::~CyclicAutomata2D()
+{
+    freeBuffers();
+}
+
+/*
+ * Sets the size of the grid (in cells) and allocates the memory for it
+ */
+int CyclicAutomata2D::setSize(int w, int h)
+{
+    if (w == width and h == height and cells != NULL)
+    {
+        return 0;
+    }
+
+    freeBuffers();
+
+    width = w;
+    height = h;
+    stepRow = 0;
+
+    cells = new unsigned char[w * h];
+    newCells = new unsigned char[w * h];
+    columnCounts = new unsigned char[CCA_MAX_NUM_STATES * w];
+    wrappedColumns = new int[w + 2 * CCA_MAX_RANGE];
+
+    for (int i = 0; i < w + 2 * CCA_MAX_RANGE; ++i)
+    {
+        wrappedColumns[i] = ((i - CCA_MAX_RANGE) % w + w) % w;
+    }
+
+    // The range can be bigger than the height: a row can wrap more than
+    // once
+    wrappedRows = new int[h + 2 * CCA_MAX_RANGE + 1];
+
+    for (int i = 0; i < h + 2 * CCA_MAX_RANGE + 1; ++i)
+    {
+        wrappedRows[i] = ((i - CCA_MAX_RANGE) % h + h) % h;
+    }
+
+    return 0;
+}
+
+/*
+ * Frees the memory of the cells and the counts while another automata runs. setSize()
+ * allocates it again.
+ */
+int CyclicAutomata2D::release()
+{
+    freeBuffers();
+
+    width = 0;
+    height = 0;
+    stepRow = 0;
+
+    return 0;
+}
+
+int CyclicAutomata2D::getWidth()
+{
+    return width;
+}
+
+int CyclicAutomata2D::getHeight()
+{
+    return height;
+}
+
+/*
+ * Sets the number of states (between 2 and CCA_MAX_NUM_STATES)
+ */
+int CyclicAutomata2D::setNumStates(int n)
+{
+    if (n < 2)
+    {
+        n = 2;
+    }
+    else if (n > CCA_MAX_NUM_STATES)
+    {
+        n = CCA_MAX_NUM_STATES;
+    }
+
+    numStates = n;
+
+    updateSuccessors();
+
+    return 0;
+}
+
+int CyclicAutomata2D::getNumStates()
+{
+    return numStates;
+}
+
+/*
+ * Sets the range of the neighborhood (between 1 and CCA_MAX_RANGE)
+ */
+int CyclicAutomata2D::setRange(int r)
+{
+    if (r < 1)
+    {
+        r = 1;
+    }
+    else if (r > CCA_MAX_RANGE)
+    {
+        r = CCA_MAX_RANGE;
+    }
+
+    range = r;
+
+    return 0;
+}
+
+int CyclicAutomata2D::getRange()
+{
+    return range;
+}
+
+/*
+ * Sets the number of neighbors in the successor state needed to change
+ */
+int CyclicAutomata2D::setThreshold(int t)
+{
+    threshold = t < 1 ? 1 : t;
+
+    return 0;
+}
+
+int CyclicAutomata2D::getThreshold()
+{
+    return threshold;
+}
+
+/*
+ * Sets the neighborhood: VON_NEUMANN_NEIGHBORHOOD or MOORE_NEIGHBORHOOD
+ */
+int CyclicAutomata2D::setTypeOfNeighborhood(int value)
+{
+    typeOfNeighborhood = value;
+
+    return 0;
+}
+
+int CyclicAutomata2D::getTypeOfNeighborhood()
+{
+    return typeOfNeighborhood;
+}
+
+/*
+ * Sets the model: CCA_MODEL_CYCLIC or CCA_MODEL_GREENBERG_HASTINGS
+ */
+int CyclicAutomata2D::setModel(int value)
+{
+    model = value;
+
+    updateSuccessors();
+
+    return 0;
+}
+
+int CyclicAutomata2D::getModel()
+{
+    return model;
+}
+
+/*
+ * Returns the number of neighbors of a cell (the highest useful threshold)
+ */
+int CyclicAutomata2D::getMaxThreshold()
+{
+    if (typeOfNeighborhood == MOORE_NEIGHBORHOOD)
+    {
+        return (2 * range + 1) * (2 * range + 1) - 1;
+    }
+
+    return 2 * range * (range + 1);
+}
+
+/*
+ * Gives each cell a random state
+ */
+int CyclicAutomata2D::initialize(RandomNumberGenerator& rng)
+{
+    for (int i = 0; i < width * height; ++i)
+    {
+        cells[i] = rng.nextBelow(numStates);
+    }
+
+    stepRow = 0;
+
+    hash = GenerationHash::hashCells(cells, width, height);
+    hashChange = 0;
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation
+ */
+int CyclicAutomata2D::nextStep()
+{
+    // The rest of the generation in progress, or a whole one
+    return stepRows(height - stepRow);
+}
+
+/*
+ * Calculates the next rows of the generation in progress, starting a new
+ * one if there isn't any, so a generation can be spread over several
+ * frames. The cells only change when the last row is done.
+ */
+int CyclicAutomata2D::stepRows(int rows)
+{
+    if (rows < 1)
+    {
+        return 0;
+    }
+
+    int lastRow = stepRow + rows < height ? stepRow + rows : height;
+
+    if (typeOfNeighborhood == MOORE_NEIGHBORHOOD)
+    {
+        nextRowsMoore(stepRow, lastRow);
+    }
+    else
+    {
+        nextRowsVonNeumann(stepRow, lastRow);
+    }
+
+    if (lastRow < height)
+    {
+        stepRow = lastRow;
+        return 0;
+    }
+
+    stepRow = 0;
+
+    unsigned char* temp = cells;
+    cells = newCells;
+    newCells = temp;
+
+    hash = hash + hashChange;
+    hashChange = 0;
+
+    return 0;
+}
+
+/*
+ * Returns the next row of the generation in progress (see stepRows()), or 0
+ * if there's none in progress
+ */
+int CyclicAutomata2D::getStepRow()
+{
+    return stepRow;
+}
+
+/*
+ * Returns the cells of the current generation (states, row by row)
+ */
+unsigned char* CyclicAutomata2D::getCells()
+{
+    return cells;
+}
+
+/*
+ * Returns the hash of the current generation (see GenerationHash)
+ */
+uint64_t CyclicAutomata2D::getHash()
+{
+    return hash;
+}
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Frees the memory used by the cells
+ */
+int CyclicAutomata1D::freeBuffers()
+{
+    delete[] cells;
+    delete[] newCells;
+
+    cells = NULL;
+    newCells = NULL;
+
+    return 0;
+}
+
+/*
+ * Fills the lookup tables of the successor of each state
+ */
+int CyclicAutomata1D::updateSuccessors()
+{
+    for (int i = 0; i < numStates; ++i)
+    {
+        successor[i] = (i + 1) % numStates;
+
+        if (model == CCA_MODEL_GREENBERG_HASTINGS)
+        {
+            // Only the resting cells need excited neighbors
+            needsThreshold[i] = (i == 0);
+        }
+        else
+        {
+            needsThreshold[i] = true;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Copies the cells of each end of the row to the padding of the other end
+ */
+int CyclicAutomata1D::updatePadding()
+{
+    unsigned char* row = cells + CCA_1D_PADDING;
+
+    for (int i = 1; i <= range; ++i)
+    {
+        row[-i] = row[((width - i) % width + width) % width];
+        row[width - 1 + i] = row[(i - 1) % width];
+    }
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+CyclicAutomata1D::CyclicAutomata1D()
+{
+    width = 0;
+    numStates = CCA_INITIAL_NUM_STATES;
+    range = 1;
+    threshold = 1;
+    model = CCA_MODEL_CYCLIC;
+
+    cells = NULL;
+    newCells = NULL;
+
+    updateSuccessors();
+}
+
+// Class destructor
+CyclicAutomata1D::~CyclicAutomata1D()
+{
+    freeBuffers();
+}
+
+/*
+ * Sets the width of the row (in cells) and allocates the memory for it
+ */
+int CyclicAutomata1D::setSize(int w)
+{
+    if (w == width and cells != NULL)
+    {
+        return 0;
+    }
+
+    freeBuffers();
+
+    width = w;
+
+    cells = new unsigned char[w + 2 * CCA_1D_PADDING];
+    newCells = new unsigned char[w + 2 * CCA_1D_PADDING];
+
+    return 0;
+}
+
+/*
+ * Frees the memory of the cells while another automata runs. setSize()
+ * allocates it again.
+ */
+int CyclicAutomata1D::release()
+{
+    freeBuffers();
+
+    width = 0;
+
+    return 0;
+}
+
+int CyclicAutomata1D::getWidth()
+{
+    return width;
+}
+
+/*
+ * Sets the number of states (between 2 and CCA_MAX_NUM_STATES)
+ */
+int CyclicAutomata1D::setNumStates(int n)
+{
+    if (n < 2)
+    {
+        n = 2;
+    }
+    else if (n > CCA_MAX_NUM_STATES)
+    {
+        n = CCA_MAX_NUM_STATES;
+    }
+
+    numStates = n;
+
+    updateSuccessors();
+
+    return 0;
+}
+
+int CyclicAutomata1D::getNumStates()
+{
+    return numStates;
+}
+
+/*
+ * Sets the range of the neighborhood (between 1 and CCA_MAX_RANGE)
+ */
+int CyclicAutomata1D::setRange(int r)
+{
+    if (r < 1)
+    {
+        r = 1;
+    }
+    else if (r > CCA_MAX_RANGE)
+    {
+        r = CCA_MAX_RANGE;
+    }
+
+    range = r;
+
+    return 0;
+}
+
+int CyclicAutomata1D::getRange()
+{
+    return range;
+}
+
+/*
+ * Sets the number of neighbors in the successor state needed to change
+ */
+int CyclicAutomata1D::setThreshold(int t)
+{
+    threshold = t < 1 ? 1 : t;
+
+    return 0;
+}
+
+int CyclicAutomata1D::getThreshold()
+{
+    return threshold;
+}
+
+/*
+ * Sets the model: CCA_MODEL_CYCLIC or CCA_MODEL_GREENBERG_HASTINGS
+ */
+int CyclicAutomata1D::setModel(int value)
+{
+    model = value;
+
+    updateSuccessors();
+
+    return 0;
+}
+
+int CyclicAutomata1D::getModel()
+{
+    return model;
+}
+
+/*
+ * Returns the number of neighbors of a cell (the highest useful threshold)
+ */
+int CyclicAutomata1D::getMaxThreshold()
+{
+    return 2 * range;
+}
+
+/*
+ * Gives each cell a random state
+ */
+int CyclicAutomata1D::initialize(RandomNumberGenerator& rng)
+{
+    unsigned char* row = cells + CCA_1D_PADDING;
+
+    for (int i = 0; i < width; ++i)
+    {
+        row[i] = rng.nextBelow(numStates);
+    }
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation
+ */
+int CyclicAutomata1D::nextStep()
+{
+    updatePadding();
+
+    const unsigned char* row = cells + CCA_1D_PADDING;
+    unsigned char* out = newCells + CCA_1D_PADDING;
+
+    for (int x = 0; x < width; ++x)
+    {
+        unsigned char state = row[x];
+        unsigned char next = successor[state];
+
+        if (needsThreshold[state] == true)
+        {
+            int count = 0;
+
+            for (int dx = 1; dx <= range; ++dx)
+            {
+                count = count + (row[x - dx] == next) + (row[x + dx] == next);
+            }
+
+            out[x] = count >= threshold ? next : state;
+        }
+        else
+        {
+            out[x] = next;
+        }
+    }
+
+    unsigned char* temp = cells;
+    cells = newCells;
+    newCells = temp;
+
+    return 0;
+}
+
+/*
+ * Returns the cells of the current generation (states, without padding)
+ */
+unsigned char* CyclicAutomata1D::getCells()
+{
+    return cells + CCA_1D_PADDING;
+}
@@ -0,0 +1,170 @@
+#ifndef CYCLICAUTOMATA_H
+#define CYCLICAUTOMATA_H
+
+#include <stdint.h>
+
+#include "random_numbers.h"
+
+/*
+ * Maximum number of states and range of the neighborhood
+ */
+#define CCA_MAX_NUM_STATES 16
+#define CCA_MAX_RANGE 5
+
+/*
+ * Models of the cyclic cellular automata
+ */
+#define CCA_MODEL_CYCLIC 0
+#define CCA_MODEL_GREENBERG_HASTINGS 1
+
+/*
+ * The two dimensional cyclic cellular automata.
+ *
+ * Each cell has a state between 0 and numStates - 1. A cell changes to its
+ * successor state if at least threshold cells of its neighborhood (Moore or
+ * Von Neumann, of the given range) are in that state. The borders wrap
+ * around (torus).
+ *
+ * Models:
+ * CCA_MODEL_CYCLIC: the successor of k is (k + 1) % numStates.
+ * CCA_MODEL_GREENBERG_HASTINGS: 0 is the resting state, 1 the excited state
+ * and the rest are refractory states. Only the resting cells need the
+ * threshold (of excited neighbors), the rest always change to their
+ * successor.
+ *
+ * The successor of each state and whether it needs the threshold are kept
+ * in lookup tables, so the step doesn't compute any modulo.
+ *
+ * The hash of the current generation (see GenerationHash in cycles.h) is
+ * updated with the cells that change in each row, to find its cycles.
+ *
+ * It doesn't depend on libnds, so it can be used in headless runs.
+ */
+class CyclicAutomata2D
+{
+    private:
+        int width;
+        int height;
+        int numStates;
+        int range;
+        int threshold;
+        int typeOfNeighborhood;
+        int model;
+
+        unsigned char* cells;    // Current generation (states)
+        unsigned char* newCells; // Next generation
+
+        // Number of cells of each state in the column of each cell, counting
+        // range rows above and below it (only for the Moore neighborhood)
+        unsigned char* columnCounts;
+
+        // Column of each neighbor (x + dx + CCA_MAX_RANGE) wrapped around
+        int* wrappedColumns;
+
+        // Row of each neighbor (y + dy + CCA_MAX_RANGE) wrapped around, up
+        // to the row that enters the square of the Moore neighborhood
+        int* wrappedRows;
+
+        unsigned char successor[CCA_MAX_NUM_STATES];
+        bool needsThreshold[CCA_MAX_NUM_STATES];
+
+        int stepRow; // Next row of the generation in progress (see stepRows())
+
+        uint64_t hash;       // Of the current generation
+        uint64_t hashChange; // Of the rows of the generation in progress
+
+        int freeBuffers();
+        int updateSuccessors();
+
+        int nextRowsMoore(int firstRow, int lastRow);
+        int nextRowsVonNeumann(int firstRow, int lastRow);
+
+    public:
+        CyclicAutomata2D();
+        ~CyclicAutomata2D();
+
+        int setSize(int w, int h);
+        int release();
+        int getWidth();
+        int getHeight();
+
+        int setNumStates(int n);
+        int getNumStates();
+        int setRange(int r);
+        int getRange();
+        int setThreshold(int t);
+        int getThreshold();
+        int setTypeOfNeighborhood(int value);
+        int getTypeOfNeighborhood();
+        int setModel(int value);
+        int getModel();
+
+        int getMaxThreshold();
+
+        int initialize(RandomNumberGenerator& rng);
+        int nextStep();
+        int stepRows(int rows);
+        int getStepRow();
+
+        unsigned char* getCells();
+        uint64_t getHash();
+};
+
+/*
+ * The one dimensional cyclic cellular automata.
+ *
+ * The same rule as the two dimensional one, with the range cells on
+ * each side of a cell as its neighborhood. The row wraps around: it's
+ * stored with padding on each side, where the range cells next to each end
+ * are copies of the cells of the other end, so the step doesn't need to
+ * check the ends.
+ *
+ * It doesn't depend on libnds, so it can be used in headless runs.
+ */
+class CyclicAutomata1D
+{
+    private:
+        int width;
+        int numStates;
+        int range;
+        int threshold;
+        int model;
+
+        // Current and next generation (states), with CCA_1D_PADDING cells
+        // of padding on each side (see cyclicautomata.cpp)
+        unsigned char* cells;
+        unsigned char* newCells;
+
+        unsigned char successor[CCA_MAX_NUM_STATES];
+        bool needsThreshold[CCA_MAX_NUM_STATES];
+
+        int freeBuffers();
+        int updateSuccessors();
+        int updatePadding();
+
+    public:
+        CyclicAutomata1D();
+        ~CyclicAutomata1D();
+
+        int setSize(int w);
+        int release();
+        int getWidth();
+
+        int setNumStates(int n);
+        int getNumStates();
+        int setRange(int r);
+        int getRange();
+        int setThreshold(int t);
+        int getThreshold();
+        int setModel(int value);
+        int getModel();
+
+        int getMaxThreshold();
+
+        int initialize(RandomNumberGenerator& rng);
+        int nextStep();
+
+        unsigned char* getCells();
+};
+
+#endif
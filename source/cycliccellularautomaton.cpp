@@ -0,0 +1,524 @@
+#include <stdio.h>
+
+#include <nds.h>
+
+#include "cycliccellularautomaton.h"
+#include "cellularautomata.h"
+#include "framebuffer.h"
+#include "color.h"
+#include "cycles.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * References:
+ * http://en.wikipedia.org/wiki/Cyclic_cellular_automaton
+ * http://psoup.math.wisc.edu/mcell/rullex_cycl.html
+ */
+
+// The rows and the columns of the arrow of the options of the menu
+static const int CCA_MENU_ROWS[] =
+    {CCA_MENU_DIMENSION_ROW,
+     CCA_MENU_NUM_STATES_ROW,
+     CCA_MENU_RANGE_ROW,
+     CCA_MENU_THRESHOLD_ROW,
+     CCA_MENU_NEIGHBORHOOD_ROW,
+     CCA_MENU_MODEL_ROW,
+     CCA_MENU_BACK_TO_MAIN_ROW};
+static const int CCA_MENU_ARROW_COLUMNS[] =
+    {CCA_MENU_DIMENSION_ARROW_COL,
+     CCA_MENU_NUM_STATES_ARROW_COL,
+     CCA_MENU_RANGE_ARROW_COL,
+     CCA_MENU_THRESHOLD_ARROW_COL,
+     CCA_MENU_NEIGHBORHOOD_ARROW_COL,
+     CCA_MENU_MODEL_ARROW_COL,
+     CCA_MENU_BACK_TO_MAIN_ARROW_COL};
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Gives a random state to each cell of the cyclic cellular automata (to
+ * the first row of the one dimensional one)
+ */
+int CyclicCellularAutomaton::drawInitialState(CellularAutomata& automata)
+{
+    if (dimension == 2)
+    {
+        // Give each cell a random state
+        cyclicAutomata2D.setSize(SCREEN_WIDTH, SCREEN_HEIGHT);
+        cyclicAutomata2D.initialize(automata.getRandomNumbers());
+
+        copyToIndexedFB(cyclicAutomata2D.getCells(), indexedFB,
+                        SCREEN_WIDTH * SCREEN_HEIGHT);
+
+        automata.setPopulation(SCREEN_WIDTH * SCREEN_HEIGHT);
+    }
+    else
+    {
+        // Give each cell of the first row a random state
+        cyclicAutomata1D.setSize(SCREEN_WIDTH);
+        cyclicAutomata1D.initialize(automata.getRandomNumbers());
+
+        // The rows are kept in main RAM, the pages of the framebuffer get
+        // them when they're presented. The rows below the screen of the
+        // first page hold the tiles of the lattice, that showLattice()
+        // copies again.
+        waterfall.setSize(SCREEN_WIDTH, SCREEN_HEIGHT,
+                          INDEXED_FB_PAGE_HEIGHT);
+        waterfall.addRow(cyclicAutomata1D.getCells());
+        waterfall.present(indexedFB, 0);
+
+        automata.setPopulation(SCREEN_WIDTH);
+    }
+
+    return 0;
+}
+
+/*
+ * Returns the number of neighbors of a cell with the current dimension,
+ * range and neighborhood (the highest useful threshold)
+ */
+int CyclicCellularAutomaton::getMaxThreshold()
+{
+    if (dimension == 1)
+    {
+        cyclicAutomata1D.setRange(range);
+
+        return cyclicAutomata1D.getMaxThreshold();
+    }
+
+    cyclicAutomata2D.setRange(range);
+    cyclicAutomata2D.setTypeOfNeighborhood(typeOfNeighborhood);
+
+    return cyclicAutomata2D.getMaxThreshold();
+}
+
+/*
+ * Prints the number of states of the cyclic cellular automata
+ */
+int CyclicCellularAutomaton::printNumStates()
+{
+    iprintf("\x1b[%d;%dH%s: < %d > ",
+            CCA_MENU_NUM_STATES_ROW,
+            CCA_MENU_NUM_STATES_COL,
+            stringNumStates.c_str(), numStates);
+
+    return 0;
+}
+
+/*
+ * Prints the dimension of the cyclic cellular automata (1D or 2D)
+ */
+int CyclicCellularAutomaton::printDimension()
+{
+    iprintf("\x1b[%d;%dH%s: < %dD > ",
+            CCA_MENU_DIMENSION_ROW,
+            CCA_MENU_DIMENSION_COL,
+            stringDimension.c_str(), dimension);
+
+    return 0;
+}
+
+/*
+ * Prints the range of the neighborhood of the cyclic cellular automata
+ */
+int CyclicCellularAutomaton::printRange()
+{
+    iprintf("\x1b[%d;%dH%s: < %d > ",
+            CCA_MENU_RANGE_ROW,
+            CCA_MENU_RANGE_COL,
+            stringRange.c_str(), range);
+
+    return 0;
+}
+
+/*
+ * Prints the threshold of the cyclic cellular automata
+ */
+int CyclicCellularAutomaton::printThreshold()
+{
+    iprintf("\x1b[%d;%dH%s: < %d > ",
+            CCA_MENU_THRESHOLD_ROW,
+            CCA_MENU_THRESHOLD_COL,
+            stringThreshold.c_str(), threshold);
+
+    return 0;
+}
+
+/*
+ * Prints the neighborhood of the cyclic cellular automata
+ */
+int CyclicCellularAutomaton::printNeighborhood()
+{
+    iprintf("\x1b[%d;%dH%s < %s >  ",
+            CCA_MENU_NEIGHBORHOOD_ROW,
+            CCA_MENU_NEIGHBORHOOD_COL,
+            stringNeighborhood.c_str(),
+            typeOfNeighborhood == MOORE_NEIGHBORHOOD ?
+            "Moore" : "Von Neumann");
+
+    return 0;
+}
+
+/*
+ * Prints the model of the cyclic cellular automata
+ */
+int CyclicCellularAutomaton::printModel()
+{
+    // Erase the previous model (the names have different lengths)
+    iprintf("\x1b[%d;%dH%s", CCA_MENU_MODEL_ROW, CCA_MENU_MODEL_COL,
+            "                              ");
+
+    iprintf("\x1b[%d;%dH%s: < %s >",
+            CCA_MENU_MODEL_ROW,
+            CCA_MENU_MODEL_COL,
+            stringModel.c_str(),
+            model == CCA_MODEL_GREENBERG_HASTINGS ?
+            "Greenberg-Hastings" : stringCyclic.c_str());
+
+    return 0;
+}
+
+/*
+ * Prints all the options of the cyclic cellular automata
+ */
+int CyclicCellularAutomaton::printOptions()
+{
+    printDimension();
+    printNumStates();
+    printRange();
+    printThreshold();
+    printNeighborhood();
+    printModel();
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+CyclicCellularAutomaton::CyclicCellularAutomaton()
+{
+    dimension = CCA_INITIAL_DIMENSION;
+    numStates = CCA_INITIAL_NUM_STATES;
+    range = CCA_INITIAL_RANGE;
+    threshold = CCA_INITIAL_THRESHOLD;
+    model = CCA_MODEL_CYCLIC;
+    typeOfNeighborhood = MOORE_NEIGHBORHOOD;
+}
+
+/*
+ * Sets the palette and the settings of the cyclic cellular automata and
+ * gives a random state to its cells
+ */
+int CyclicCellularAutomaton::initialize(CellularAutomata& automata)
+{
+    makeStatesPalette(palette, numStates);
+
+    // Color of the rows of the one dimensional automata not drawn yet
+    palette[CCA_BG_INDEX] = BG_color;
+
+    cyclicAutomata1D.setNumStates(numStates);
+    cyclicAutomata1D.setRange(range);
+    cyclicAutomata1D.setThreshold(threshold);
+    cyclicAutomata1D.setModel(model);
+
+    cyclicAutomata2D.setNumStates(numStates);
+    cyclicAutomata2D.setRange(range);
+    cyclicAutomata2D.setThreshold(threshold);
+    cyclicAutomata2D.setTypeOfNeighborhood(typeOfNeighborhood);
+    cyclicAutomata2D.setModel(model);
+
+    // The states are palette indexes: they're shown by the 8 bits per
+    // pixel framebuffer without any conversion
+    showIndexedFB();
+    setIndexedPalette(palette, CCA_BG_INDEX + 1);
+    cleanIndexedFB(indexedFB, CCA_BG_INDEX);
+    cleanIndexedFB(indexedFB2, CCA_BG_INDEX);
+    cleanIndexedFB(indexedFB3, CCA_BG_INDEX);
+
+    drawInitialState(automata);
+
+    if (dimension == 1)
+    {
+        // The waterfall scrolls the pages instead of moving the rows
+        wrapIndexedFB();
+
+        automata.startCycles(GenerationHash::hashCells(
+                                 cyclicAutomata1D.getCells(),
+                                 SCREEN_WIDTH, 1));
+    }
+    else
+    {
+        automata.startCycles(cyclicAutomata2D.getHash());
+    }
+
+    automata.getPipeline().start(showIndexedFBPage, 0);
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation of the two dimensional automata (the rest
+ * of the generation in progress, see stepRows()), or the next row of the
+ * one dimensional automata. The row is added below the previous ones
+ * (scrolling them up when the screen is full) and kept by the waterfall: a
+ * rendered step only copies to the next page the rows it doesn't have and
+ * scrolls it.
+ */
+int CyclicCellularAutomaton::nextStep(CellularAutomata& automata)
+{
+    if (dimension == 2)
+    {
+        // The rest of the generation in progress, or a whole one
+        return stepRows(automata, SCREEN_HEIGHT - getStepRow());
+    }
+
+    automata.countStep();
+
+    cyclicAutomata1D.nextStep();
+    waterfall.addRow(cyclicAutomata1D.getCells());
+
+    if (automata.isStepRendered() == true)
+    {
+        FramePipeline& pipeline = automata.getPipeline();
+        int page = pipeline.acquire();
+
+        setIndexedFBPageScroll(page,
+                               waterfall.present(getIndexedFBPage(page),
+                                                 page));
+        pipeline.submit();
+    }
+
+    // The row is the whole generation
+    automata.checkCycle(GenerationHash::hashCells(
+                            cyclicAutomata1D.getCells(), SCREEN_WIDTH, 1));
+
+    return 0;
+}
+
+/*
+ * Only the generations of the two dimensional automata are resumable
+ */
+bool CyclicCellularAutomaton::hasResumableStep()
+{
+    return dimension == 2;
+}
+
+/*
+ * Calculates the next rows of the two dimensional cyclic cellular automata
+ * (see CellularAutomata::stepRows())
+ */
+int CyclicCellularAutomaton::stepRows(CellularAutomata& automata, int rows)
+{
+    cyclicAutomata2D.stepRows(rows);
+
+    if (cyclicAutomata2D.getStepRow() != 0)
+    {
+        return 0;
+    }
+
+    automata.countStep();
+
+    if (automata.checkCycle(cyclicAutomata2D.getHash()) == true)
+    {
+        return 0;
+    }
+
+    // The states are the palette indexes: copy them as they are
+    if (automata.isStepRendered() == true)
+    {
+        FramePipeline& pipeline = automata.getPipeline();
+
+        copyToIndexedFB(cyclicAutomata2D.getCells(),
+                        getIndexedFBPage(pipeline.acquire()),
+                        SCREEN_WIDTH * SCREEN_HEIGHT);
+        pipeline.submit();
+    }
+
+    return 0;
+}
+
+int CyclicCellularAutomaton::getStepRow()
+{
+    return dimension == 2 ? cyclicAutomata2D.getStepRow() : 0;
+}
+
+/*
+ * Frees the cells of the cyclic cellular automata
+ */
+int CyclicCellularAutomaton::release()
+{
+    cyclicAutomata1D.release();
+    cyclicAutomata2D.release();
+    waterfall.release();
+
+    return 0;
+}
+
+const std::string& CyclicCellularAutomaton::getName()
+{
+    return stringCyclicCellularAutomaton;
+}
+
+/*
+ * The "313" rule
+ */
+int CyclicCellularAutomaton::setDefaults()
+{
+    dimension = CCA_INITIAL_DIMENSION;
+    numStates = CCA_INITIAL_NUM_STATES;
+    range = CCA_INITIAL_RANGE;
+    threshold = CCA_INITIAL_THRESHOLD;
+    typeOfNeighborhood = MOORE_NEIGHBORHOOD;
+    model = CCA_MODEL_CYCLIC;
+
+    return 0;
+}
+
+int CyclicCellularAutomaton::printMenu()
+{
+    printOptions();
+    printString(CCA_MENU_BACK_TO_MAIN_ROW,
+                CCA_MENU_BACK_TO_MAIN_COL,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+    printString(VIEW_HELP_ROW, VIEW_HELP_COL, stringViewHelp);
+
+    return 0;
+}
+
+int CyclicCellularAutomaton::printMenuArrow(int index, bool boolDelete)
+{
+    return printOptionArrow(CCA_MENU_ROWS[index],
+                            CCA_MENU_ARROW_COLUMNS[index],
+                            boolDelete);
+}
+
+/*
+ * LEFT and RIGHT change the option of the arrow and start the automata
+ * again with the new settings
+ */
+int CyclicCellularAutomaton::updateMenu(CellularAutomata& automata,
+                                        int keys_pressed,
+                                        int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 6) // Back to the main menu
+        {
+            showAutomataTypeMenu();
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(6);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(6);
+    }
+    else if (keys_pressed & (KEY_LEFT | KEY_RIGHT))
+    {
+        int delta = (keys_pressed & KEY_LEFT) ? -1 : 1;
+        bool changed = true;
+
+        if (arrow == 0) // Dimension (1D or 2D)
+        {
+            if (dimension == 1)
+            {
+                // The "313" rule
+                dimension = 2;
+                range = CCA_INITIAL_RANGE;
+                threshold = CCA_INITIAL_THRESHOLD;
+            }
+            else
+            {
+                // One neighbor on each side is enough
+                dimension = 1;
+                range = CCA_1D_INITIAL_RANGE;
+                threshold = CCA_1D_INITIAL_THRESHOLD;
+            }
+        }
+        else if (arrow == 1) // Number of states
+        {
+            if (numStates + delta >= CCA_MIN_NUM_STATES and
+                numStates + delta <= CCA_MAX_NUM_STATES)
+            {
+                numStates = numStates + delta;
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else if (arrow == 2) // Range
+        {
+            if (range + delta >= 1 and range + delta <= CCA_MAX_RANGE)
+            {
+                range = range + delta;
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else if (arrow == 3) // Threshold
+        {
+            if (threshold + delta >= 1 and
+                threshold + delta <= getMaxThreshold())
+            {
+                threshold = threshold + delta;
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else if (arrow == 4) // Neighborhood
+        {
+            if (typeOfNeighborhood == MOORE_NEIGHBORHOOD)
+            {
+                typeOfNeighborhood = VON_NEUMANN_NEIGHBORHOOD;
+            }
+            else
+            {
+                typeOfNeighborhood = MOORE_NEIGHBORHOOD;
+            }
+        }
+        else if (arrow == 5) // Model
+        {
+            if (model == CCA_MODEL_CYCLIC)
+            {
+                model = CCA_MODEL_GREENBERG_HASTINGS;
+            }
+            else
+            {
+                model = CCA_MODEL_CYCLIC;
+            }
+        }
+        else
+        {
+            changed = false;
+        }
+
+        if (changed == true)
+        {
+            // The threshold can't be higher than the number of neighbors
+            if (threshold > getMaxThreshold())
+            {
+                threshold = getMaxThreshold();
+            }
+
+            printOptions();
+
+            automata.initialize();
+            printPopulation();
+            printNumSteps();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef CYCLICCELLULARAUTOMATON_H
+#define CYCLICCELLULARAUTOMATON_H
+
+#include <string>
+
+#include "automaton.h"
+#include "cyclicautomata.h"
+#include "waterfall.h"
+
+/*
+ * The cyclic cellular automata, of one or two dimensions. The states are
+ * palette indexes of the 8 bits per pixel framebuffer (CCA_BG_INDEX is the
+ * color of the rows of the one dimensional automata not drawn yet).
+ *
+ * The generations of the two dimensional automata can be calculated a few
+ * rows at a time (see stepRows()). The one dimensional automata adds a row
+ * per step below the previous ones (see Waterfall).
+ */
+class CyclicCellularAutomaton : public Automaton
+{
+    private:
+        int dimension; // 1 or 2
+        int numStates;
+        int range;
+        int threshold; // Neighbors in the successor state to change
+        int model;     // CCA_MODEL_CYCLIC or CCA_MODEL_GREENBERG_HASTINGS
+        int typeOfNeighborhood;
+
+        unsigned short palette[CCA_MAX_NUM_STATES + 1];
+
+        CyclicAutomata1D cyclicAutomata1D;
+        CyclicAutomata2D cyclicAutomata2D;
+        Waterfall waterfall; // The rows of the one dimensional automata
+
+        int drawInitialState(CellularAutomata& automata);
+        int getMaxThreshold();
+
+        int printNumStates();
+        int printDimension();
+        int printRange();
+        int printThreshold();
+        int printNeighborhood();
+        int printModel();
+        int printOptions();
+
+    public:
+        CyclicCellularAutomaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+        virtual bool hasResumableStep();
+        virtual int stepRows(CellularAutomata& automata, int rows);
+        virtual int getStepRow();
+        virtual int release();
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
@@ -0,0 +1,691 @@
+#include <stdint.h>
+
+#include <nds.h>
+
+#include "elementaryautomaton.h"
+#include "cellularautomata.h"
+#include "framebuffer.h"
+#include "color.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+#include "random_numbers.h"
+
+/*
+ * References:
+ * http://mathworld.wolfram.com/ElementaryCellularAutomaton.html
+ * http://atlas.wolfram.com/01/01/
+ * http://en.wikipedia.org/wiki/Cellular_automaton#Elementary_cellular_automata
+ * http://en.wikipedia.org/wiki/Elementary_cellular_automaton
+ */
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Updates the variables used for the colors of the background,
+ * foreground and lines.
+ * It's used to update the colors of the rules of the elementary
+ * cellular automata when new colors are selected in the color selection menu
+ * and to initiliaze the values when the automata is executed for
+ * the first time.
+ *
+ *  xxx xxo xox xoo oxx oxo oox ooo
+ *   o   x   o   x   x   o   x   o  -> Rule 90
+ *
+ * 0*128 + 1*64 + 0*32 + 1*16 + 1*8 + 0*4 + 1*2 + 0*1 = 90
+ *
+ * where x == Foreground color with value 1
+ *       o == Background color with value 0
+ *
+ *       ruleLeft  ruleCenter  ruleRight
+ *                  ruleDown
+ *
+ */
+int ElementaryAutomaton::updateRuleColors()
+{
+    ruleLeft[0] = FG_color;
+    ruleLeft[1] = FG_color;
+    ruleLeft[2] = FG_color;
+    ruleLeft[3] = FG_color;
+    ruleLeft[4] = BG_color;
+    ruleLeft[5] = BG_color;
+    ruleLeft[6] = BG_color;
+    ruleLeft[7] = BG_color;
+
+    ruleCenter[0] = FG_color;
+    ruleCenter[1] = FG_color;
+    ruleCenter[2] = BG_color;
+    ruleCenter[3] = BG_color;
+    ruleCenter[4] = FG_color;
+    ruleCenter[5] = FG_color;
+    ruleCenter[6] = BG_color;
+    ruleCenter[7] = BG_color;
+
+    ruleRight[0] = FG_color;
+    ruleRight[1] = BG_color;
+    ruleRight[2] = FG_color;
+    ruleRight[3] = BG_color;
+    ruleRight[4] = FG_color;
+    ruleRight[5] = BG_color;
+    ruleRight[6] = FG_color;
+    ruleRight[7] = BG_color;
+
+    /*
+     * The rule that will be displayed on start on the Elementary Cellular
+     * Automata: Rule 90 (Default)
+     */
+    ruleDown[0] = BG_color;
+    ruleDown[1] = FG_color;
+    ruleDown[2] = BG_color;
+    ruleDown[3] = FG_color;
+    ruleDown[4] = FG_color;
+    ruleDown[5] = BG_color;
+    ruleDown[6] = FG_color;
+    ruleDown[7] = BG_color;
+
+    return 0;
+}
+
+/*
+ * Calculates the rule number for the current rule of the
+ * Elementary Cellular Automata
+ */
+int ElementaryAutomaton::getRuleNumber()
+{
+    int ruleNumber = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        if (ruleDown[i] == FG_color)
+        {
+            ruleNumber = ruleNumber + (1 << (7 - i));
+        }
+    }
+
+    return ruleNumber;
+}
+
+/*
+ * Paints the Elementary Cellular Automata's cell with the corresponding color
+ * and if the color matches FG_color, increments the population of alive cells
+ */
+int ElementaryAutomaton::paintCell(CellularAutomata& automata,
+                                   int row,
+                                   int col,
+                                   unsigned short color)
+{
+    fb[row * SCREEN_WIDTH + col] = color;
+
+    if (color == FG_color)
+    {
+        automata.addPopulation(1);
+    }
+
+    return 0;
+}
+
+/*
+ * Paints the first row of the Elementary Cellular Automata (one cell in
+ * the center or random cells, see initialStateType)
+ */
+int ElementaryAutomaton::drawInitialState(CellularAutomata& automata)
+{
+    if (initialStateType == ECA_INITIALIZE_ONE_CELL)
+    {
+        fb[128] = FG_color;
+
+        automata.addPopulation(1); // The population of alive cells increases
+    }
+    else if (initialStateType == ECA_INITIALIZE_RANDOM)
+    {
+        // One random bit for each cell of the first row
+        uint32_t randomBits[SCREEN_WIDTH / 32];
+
+        automata.getRandomNumbers().fillBits(randomBits, SCREEN_WIDTH,
+                                             RNG_THRESHOLD_ONE / 2);
+
+        // Move along the cells of the first row (0-255)
+        for (int i = 0; i < SCREEN_WIDTH; ++i)
+        {
+            // If the bit is 1, paint the corresponding cell with
+            // FG_color and add 1 to the population count
+            if (randomBits[i / 32] & (1u << (i % 32)))
+            {
+                fb[i] = FG_color;
+                automata.addPopulation(1);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Draws the current rule of the Elementary Cellular Automata
+ */
+int ElementaryAutomaton::drawRule(int nth)
+{
+
+    const int intTopRow = 136;
+    const int intBottomRow = 168;
+
+    const int intColumn1 = 32;
+    const int intColumn2 = 88;
+    const int intColumn3 = 144;
+    const int intColumn4 = 200;
+
+    const int intLength = 9;
+    const int intWidth = 9;
+
+    unsigned int color = BG_color;
+    int intRowStart = 0;
+    int intColumnStart = 0;
+
+    switch (nth)
+    {
+	case 0 :
+	    intRowStart = intTopRow;
+	    intColumnStart = intColumn1;
+	    break;
+	case 1 :
+	    intRowStart = intTopRow;
+	    intColumnStart = intColumn2;
+	    break;
+	case 2 :
+	    intRowStart = intTopRow;
+	    intColumnStart = intColumn3;
+	    break;
+	case 3 :
+	    intRowStart = intTopRow;
+	    intColumnStart = intColumn4;
+	    break;
+	case 4 :
+	    intRowStart = intBottomRow;
+	    intColumnStart = intColumn1;
+	    break;
+	case 5 :
+	    intRowStart = intBottomRow;
+	    intColumnStart = intColumn2;
+	    break;
+	case 6 :
+	    intRowStart = intBottomRow;
+	    intColumnStart = intColumn3;
+	    break;
+	case 7 :
+	    intRowStart = intBottomRow;
+	    intColumnStart = intColumn4;
+	    break;
+    }
+
+    if(ruleLeft[nth] == FG_color)
+    {
+        color = FG_color;
+    }
+
+    drawRectangle(intRowStart, intColumnStart, intLength, intWidth, color);
+
+    color = BG_color;
+
+    if(ruleCenter[nth] == FG_color)
+    {
+	    color = FG_color;
+    }
+
+    drawRectangle(intRowStart, intColumnStart + intWidth - 1,
+	      intLength, intWidth, color);
+
+    color = BG_color;
+
+    if(ruleRight[nth] == FG_color)
+    {
+        color = FG_color;
+    }
+
+    drawRectangle(intRowStart, intColumnStart + (intWidth - 1) * 2,
+                  intLength, intWidth, color);
+
+    color = BG_color;
+
+    if(ruleDown[nth] == FG_color)
+    {
+        color = FG_color;
+    }
+
+    drawRectangle(intRowStart + intLength - 1, intColumnStart + intWidth -1,
+                  intLength, intWidth, color);
+
+    return 0;
+}
+
+/*
+ * Draws all the rules (0-7) of the Elementary Cellular Automata
+ */
+int ElementaryAutomaton::drawAllRules()
+{
+    for (int i = 0; i < 8; i++)
+    {
+	drawRule(i);
+    }
+
+    return 0;
+}
+
+/*
+ * Draws an arrow in the top screen (0-7) of the Elementary Cellular Automata
+ */
+int ElementaryAutomaton::drawArrow(int nth, unsigned short color)
+{
+
+    const int intTopRow = 149;
+    const int intBottomRow = 181;
+
+    const int intColumn1 = 38;
+    const int intColumn2 = 94;
+    const int intColumn3 = 150;
+    const int intColumn4 = 206;
+
+	int intRow = 0;
+	int intColumn = 0;
+
+	switch (nth)
+	{
+	    case 0 :
+		intRow = intTopRow;
+		intColumn = intColumn1;
+		break;
+	    case 1 :
+		intRow = intTopRow;
+		intColumn = intColumn2;
+		break;
+	    case 2 :
+		intRow = intTopRow;
+		intColumn = intColumn3;
+		break;
+	    case 3 :
+		intRow = intTopRow;
+		intColumn = intColumn4;
+		break;
+	    case 4 :
+		intRow = intBottomRow;
+		intColumn = intColumn1;
+		break;
+	    case 5 :
+		intRow = intBottomRow;
+		intColumn = intColumn2;
+		break;
+	    case 6 :
+		intRow = intBottomRow;
+		intColumn = intColumn3;
+		break;
+	    case 7 :
+		intRow = intBottomRow;
+		intColumn = intColumn4;
+		break;
+	}
+
+	drawHLine(intColumn - 3, intRow - 3, 1, color, fb);
+	drawHLine(intColumn - 3, intRow - 2, 2, color, fb);
+	drawHLine(intColumn - 6, intRow - 1,  6, color, fb);
+	drawHLine(intColumn - 6, intRow, 7, color, fb);
+	drawHLine(intColumn - 6, intRow + 1, 6, color, fb);
+	drawHLine(intColumn - 3, intRow + 2, 2, color, fb);
+	drawHLine(intColumn - 3, intRow + 3, 1, color, fb);
+
+	return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+ElementaryAutomaton::ElementaryAutomaton()
+{
+    initialStateType = ECA_INITIALIZE_ONE_CELL;
+
+    // The colors of the rules are given by setDefaults(), the colors of the
+    // cells may not have their values yet
+    for (int i = 0; i < 8; i++)
+    {
+        ruleLeft[i] = 0;
+        ruleCenter[i] = 0;
+        ruleRight[i] = 0;
+        ruleDown[i] = 0;
+    }
+}
+
+/*
+ * Paints the first row of the Elementary Cellular Automata and draws its
+ * rules below the rows
+ */
+int ElementaryAutomaton::initialize(CellularAutomata& automata)
+{
+    Automaton::initialize(automata);
+
+    // Paint the first row of the automata that corresponds to the
+    // state set using initialStateType
+    drawInitialState(automata);
+
+    // Draw the rules (Rule 90 by default, see setDefaults())
+    drawAllRules();
+
+    return 0;
+}
+
+/*
+ * Calculates and draws the next row of the Elementary Cellular Automata
+ */
+int ElementaryAutomaton::nextStep(CellularAutomata& automata)
+{
+    int column;
+    unsigned char i;
+    unsigned int numSteps;
+
+    automata.countStep();
+
+    // In this case numSteps is equivalent to the actual row
+    numSteps = automata.getNumSteps();
+
+    if (numSteps < 130)
+    {
+        for(column = 0; column < SCREEN_WIDTH; column++)
+        {
+            if(numSteps < 128)
+            {
+                for(i = 0; i <= 7; i++)
+                {
+                    if(column != 0 && column != SCREEN_WIDTH - 1)
+                    {
+                        if (fb[(numSteps - 1) * SCREEN_WIDTH + (column-1)]
+                                == ruleLeft[i] &&
+                            fb[(numSteps - 1) * SCREEN_WIDTH + column] ==
+                                ruleCenter[i] &&
+                            fb[(numSteps - 1) * SCREEN_WIDTH + (column+1)]
+                                == ruleRight[i])
+                        {
+                            // Paint the Elementary Cellular Automata's
+                            // cell with ruleDown[i] color
+                            // and if the color matches FG_color increment
+                            // the population of alive cells
+                            paintCell(automata, numSteps, column,
+                                      ruleDown[i]);
+                        }
+                    }
+                    else if(column == 0)
+                    {
+                        // The left cell is out of the screen, instead
+                        // we'll use the center cell (column 0) to compare
+                        // to ruleLeft
+                        if(fb[(numSteps - 1) * SCREEN_WIDTH + column] ==
+                                ruleLeft[i]
+                           && fb[(numSteps - 1) * SCREEN_WIDTH + column]
+                                == ruleCenter[i]
+                           && fb[(numSteps - 1) * SCREEN_WIDTH +
+                                (column+1)] == ruleRight[i])
+                        {
+                            // Paint the Elementary Cellular Automata's
+                            // cell with ruleDown[i] color
+                            // and if the color matches FG_color increment
+                            // the population of alive cells
+                            paintCell(automata, numSteps, column,
+                                      ruleDown[i]);
+                        }
+                    }
+                    else if(column == SCREEN_WIDTH - 1)
+                    {
+                        // The right cell is out of the screen, instead
+                        // we'll use the center cell (column 255) to
+                        // compare to ruleRight
+                        if(fb[(numSteps - 1) * SCREEN_WIDTH + (column-1)]
+                                == ruleLeft[i]
+                           && fb[(numSteps - 1) * SCREEN_WIDTH + column]
+                                == ruleCenter[i]
+                           && fb[(numSteps - 1) * SCREEN_WIDTH + column]
+                                == ruleRight[i])
+                        {
+                            // Paint the Elementary Cellular Automata's
+                            // cell with ruleDown[i] color
+                            // and if the color matches FG_color increment
+                            // the population of alive cells
+                            paintCell(automata, numSteps, column,
+                                      ruleDown[i]);
+                        }
+                    }
+                }
+            }
+            else if(numSteps == 129)
+            {
+                fb[numSteps * SCREEN_WIDTH + column] = FG_color;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Cleans the rows of the Elementary Cellular Automata and paints the
+ * initial cell distribution (row zero) again, the rules and the arrow stay.
+ * It's used to reset the ECA when the user changes the rules.
+ */
+int ElementaryAutomaton::restart(CellularAutomata& automata)
+{
+    fillRect(fb, 0, 0, SCREEN_WIDTH, 130, BG_color);
+
+    automata.setPopulation(0); // Reset the population of "alive" cells to 0
+
+    drawInitialState(automata);
+
+    return 0;
+}
+
+const std::string& ElementaryAutomaton::getName()
+{
+    return stringElementaryCellularAutomata;
+}
+
+/*
+ * Rule 90 with one cell in the center of the first row
+ */
+int ElementaryAutomaton::setDefaults()
+{
+    updateRuleColors();
+
+    initialStateType = ECA_INITIALIZE_ONE_CELL;
+
+    return 0;
+}
+
+int ElementaryAutomaton::printMenu()
+{
+    printRuleNumber(getRuleNumber());
+
+    printString(ECA_MENU_INITIAL_STATE_ROW,
+                ECA_MENU_INITIAL_STATE_COL,
+                stringInitialState);
+    printString(ECA_MENU_INITIAL_STATE_ONE_CELL_ROW,
+                ECA_MENU_INITIAL_STATE_ONE_CELL_COL,
+                stringOneCell);
+    printString(ECA_MENU_INITIAL_STATE_RANDOM_ROW,
+                ECA_MENU_INITIAL_STATE_RANDOM_COL,
+                stringRandom);
+    printString(ECA_MENU_BACK_TO_MAIN_ROW,
+                ECA_MENU_BACK_TO_MAIN_COL,
+                stringBackToMainMenu);
+
+    return 0;
+}
+
+/*
+ * The arrow of the rules (0-7) is drawn in the top screen, below the rule,
+ * the one of the other options (8-10) is printed in the bottom screen
+ */
+int ElementaryAutomaton::printMenuArrow(int index, bool boolDelete)
+{
+    int row = ECA_MENU_BACK_TO_MAIN_ROW;
+    int column = 0;
+
+    if (index < 8)
+    {
+        return drawArrow(index, boolDelete == true ? BG_color : line_color);
+    }
+
+    if (index == 8)
+    {
+        row = ECA_MENU_INITIAL_STATE_ONE_CELL_ROW;
+        column = ECA_MENU_INITIAL_STATE_ONE_CELL_ARROW_COL;
+    }
+    else if (index == 9)
+    {
+        row = ECA_MENU_INITIAL_STATE_RANDOM_ROW;
+        column = ECA_MENU_INITIAL_STATE_RANDOM_ARROW_COL;
+    }
+
+    return printOptionArrow(row, column, boolDelete);
+}
+
+int ElementaryAutomaton::printMenuAsterisks()
+{
+    if (initialStateType == ECA_INITIALIZE_ONE_CELL)
+    {
+        printAsterisk(ECA_MENU_INITIAL_STATE_ONE_CELL_ROW,
+                      ECA_MENU_INITIAL_STATE_ONE_CELL_ASTERISK_COL);
+        deleteAsterisk(ECA_MENU_INITIAL_STATE_RANDOM_ROW,
+                       ECA_MENU_INITIAL_STATE_RANDOM_ASTERISK_COL);
+    }
+    else
+    {
+        deleteAsterisk(ECA_MENU_INITIAL_STATE_ONE_CELL_ROW,
+                       ECA_MENU_INITIAL_STATE_ONE_CELL_ASTERISK_COL);
+        printAsterisk(ECA_MENU_INITIAL_STATE_RANDOM_ROW,
+                      ECA_MENU_INITIAL_STATE_RANDOM_ASTERISK_COL);
+    }
+
+    return 0;
+}
+
+/*
+ * Only the population: the rule number is printed in the row of the steps
+ */
+int ElementaryAutomaton::printCounters()
+{
+    return printPopulation();
+}
+
+/*
+ * One row per frame, the governor doesn't run it
+ */
+int ElementaryAutomaton::runFrame(CellularAutomata& automata)
+{
+    automata.nextStep();
+
+    return printCounters();
+}
+
+int ElementaryAutomaton::updateMenu(CellularAutomata& automata,
+                                    int keys_pressed,
+                                    int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow < 8) // Top screen (Automata rules)
+        {
+            if (ruleDown[arrow] == FG_color)
+            {
+                ruleDown[arrow] = BG_color;
+            }
+            else
+            {
+                ruleDown[arrow] = FG_color;
+            }
+
+            printRuleNumber(getRuleNumber());
+
+            drawRule(arrow); // Draw the rule that has changed
+
+            automata.restart();
+
+            printPopulation();
+        }
+        // Initial state: One cell
+        else if (arrow == 8)
+        {
+            initialStateType = ECA_INITIALIZE_ONE_CELL;
+
+            automata.restart();
+
+            printPopulation();
+            printMenuAsterisks();
+        }
+        // Initial state: Random
+        else if (arrow == 9)
+        {
+            initialStateType = ECA_INITIALIZE_RANDOM;
+            automata.setSeed(makeRandomSeed());
+
+            automata.restart();
+
+            printPopulation();
+            printSeed();
+            printMenuAsterisks();
+        }
+        // Go back to the selection of the type of automata
+        else if (arrow == 10)
+        {
+            showAutomataTypeMenu();
+        }
+    }
+
+    if (keys_pressed & KEY_RIGHT)
+    {
+        if (arrow < 8)
+        {
+            nextOption(7);
+        }
+    }
+    else if (keys_pressed & KEY_LEFT)
+    {
+        if (arrow < 8)
+        {
+            previousOption(7);
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        if (arrow == 8)
+        {
+            moveArrow(4);
+        }
+        else if (arrow == 9 || arrow == 10)
+        {
+            moveArrow(arrow - 1);
+        }
+        else if (arrow < 4)
+        {
+            moveArrow(10);
+        }
+        else
+        {
+            moveArrow(arrow - 4);
+        }
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        if (arrow == 10)
+        {
+            moveArrow(0);
+        }
+        else if (arrow == 8 || arrow == 9)
+        {
+            moveArrow(arrow + 1);
+        }
+        else if (arrow < 4)
+        {
+            moveArrow(arrow + 4);
+        }
+        else
+        {
+            moveArrow(8);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#ifndef ELEMENTARYAUTOMATON_H
+#define ELEMENTARYAUTOMATON_H
+
+#include <string>
+
+#include "automaton.h"
+
+/*
+ * The Elementary Cellular Automata: one row per step, drawn straight into
+ * the 16 bits per pixel framebuffer, with its 8 rules below the rows. The
+ * options of the top screen (0-7) are the rules, the ones of the bottom
+ * screen (8-10) the initial state and going back to the main menu.
+ */
+class ElementaryAutomaton : public Automaton
+{
+    private:
+        int initialStateType; // ECA_INITIALIZE_ONE_CELL or _RANDOM
+
+        unsigned short ruleLeft[8];
+        unsigned short ruleCenter[8];
+        unsigned short ruleRight[8];
+        unsigned short ruleDown[8];
+
+        int updateRuleColors();
+        int getRuleNumber();
+        int paintCell(CellularAutomata& automata,
+                      int row,
+                      int col,
+                      unsigned short color);
+        int drawInitialState(CellularAutomata& automata);
+        int drawRule(int nth);
+        int drawAllRules();
+        int drawArrow(int nth, unsigned short color);
+
+    public:
+        ElementaryAutomaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+        virtual int restart(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int printMenuAsterisks();
+        virtual int printCounters();
+
+        virtual int runFrame(CellularAutomata& automata);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
@@ -0,0 +1,283 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "fills.h"
+
+/*
+ * Fills bytes bytes (a multiple of 4) of the buffer with the word value.
+ * The buffer must be word aligned. On the DS it's a DMA fill, so a buffer
+ * in main RAM must be flushed from the cache before reading it with the
+ * CPU (VRAM isn't cached).
+ */
+int fillWords(void* buffer, uint32_t value, int bytes)
+{
+#ifdef ARM9
+    dmaFillWords(value, buffer, bytes);
+#else
+    uint32_t* words = (uint32_t*) buffer;
+
+    for (int i = 0; i < bytes / 4; i++)
+    {
+        words[i] = value;
+    }
+#endif
+
+    return 0;
+}
+
+/*
+ * Fills bytes bytes (a multiple of 2) of the buffer with the halfword
+ * value, like fillWords(). The buffer must be halfword aligned. On the host
+ * the pairs of halfwords are written as 32 bit words.
+ */
+int fillHalfWords(void* buffer, unsigned short value, int bytes)
+{
+#ifdef ARM9
+    dmaFillHalfWords(value, buffer, bytes);
+#else
+    unsigned short* halfWords = (unsigned short*) buffer;
+
+    // The first halfword alone if it isn't word aligned
+    if (((uintptr_t) halfWords & 2) != 0 and bytes >= 2)
+    {
+        *halfWords++ = value;
+        bytes = bytes - 2;
+    }
+
+    fillWords(halfWords, value | ((uint32_t) value << 16), bytes & ~3);
+
+    if ((bytes & 2) != 0)
+    {
+        halfWords[bytes / 2 - 1] = value;
+    }
+#endif
+
+    return 0;
+}
+
+/*
+ * Sets the palette index of the pixel (column, row) of a page of the 8 bits
+ * per pixel framebuffer whose rows are width pixels long.
+ * VRAM can't be written a byte at a time, so the halfword with the pixel
+ * and its neighbor is read, changed and written back.
+ */
+int setIndexedPixel(unsigned char* framebuffer,
+                    int width,
+                    int column,
+                    int row,
+                    unsigned char index)
+{
+    int offset = row * width + column;
+    unsigned short* pixels = (unsigned short*) (framebuffer + (offset & ~1));
+
+    if ((offset & 1) == 0)
+    {
+        *pixels = (*pixels & 0xFF00) | index;
+    }
+    else
+    {
+        *pixels = (*pixels & 0x00FF) | (index << 8);
+    }
+
+    return 0;
+}
+
+/*
+ * Clips the span of length pixels that starts at (column, row) to the
+ * screen. Returns false if nothing is left.
+ */
+static bool clipSpan(int& column, int row, int& length)
+{
+    if (row < 0 or row >= SCREEN_HEIGHT)
+    {
+        return false;
+    }
+
+    if (column < 0)
+    {
+        length = length + column;
+        column = 0;
+    }
+
+    if (column + length > SCREEN_WIDTH)
+    {
+        length = SCREEN_WIDTH - column;
+    }
+
+    return length > 0;
+}
+
+/*
+ * Fills a horizontal span of length pixels (clipped to the screen) with the
+ * color. Pairs of pixels are written as 32 bit words.
+ */
+int fillSpan(unsigned short* framebuffer,
+             int column,
+             int row,
+             int length,
+             unsigned short color)
+{
+    if (clipSpan(column, row, length) == false)
+    {
+        return 0;
+    }
+
+    unsigned short* pixel = framebuffer + row * SCREEN_WIDTH + column;
+
+    // The first pixel alone if it isn't word aligned
+    if (((uintptr_t) pixel & 2) != 0)
+    {
+        *pixel++ = color;
+        --length;
+    }
+
+    uint32_t* words = (uint32_t*) pixel;
+    uint32_t pair = color | ((uint32_t) color << 16);
+
+    for (; length >= 2; length = length - 2)
+    {
+        *words++ = pair;
+    }
+
+    if (length == 1)
+    {
+        *(unsigned short*) words = color;
+    }
+
+    return 0;
+}
+
+/*
+ * Fills a horizontal span of length cells (clipped to the screen) of an
+ * 8 bits per pixel framebuffer (or of the cells of a grid in main RAM) with
+ * the palette index.
+ * VRAM can't be written a byte at a time, so the span is written by
+ * halfwords and the pixels at its ends that share a halfword with a pixel
+ * outside it are changed like in setIndexedPixel().
+ */
+int fillSpan(unsigned char* framebuffer,
+             int column,
+             int row,
+             int length,
+             unsigned char index)
+{
+    if (clipSpan(column, row, length) == false)
+    {
+        return 0;
+    }
+
+    int offset = row * SCREEN_WIDTH + column;
+
+    // The first pixel alone if it's the high byte of its halfword
+    if ((offset & 1) != 0)
+    {
+        setIndexedPixel(framebuffer, SCREEN_WIDTH, column, row, index);
+        ++offset;
+        --length;
+    }
+
+    unsigned short* pixels = (unsigned short*) (framebuffer + offset);
+    unsigned short pair = index | (index << 8);
+
+    for (; length >= 2; length = length - 2)
+    {
+        *pixels++ = pair;
+    }
+
+    // The last pixel alone if it's the low byte of its halfword
+    if (length == 1)
+    {
+        *pixels = (*pixels & 0xFF00) | index;
+    }
+
+    return 0;
+}
+
+/*
+ * Fills a rectangle (clipped to the screen) with the color. When it takes
+ * whole rows they're contiguous, so they're filled at once.
+ */
+int fillRect(unsigned short* framebuffer,
+             int column,
+             int row,
+             int width,
+             int height,
+             unsigned short color)
+{
+    if (column <= 0 and column + width >= SCREEN_WIDTH)
+    {
+        int firstRow = row < 0 ? 0 : row;
+        int lastRow = row + height > SCREEN_HEIGHT ? SCREEN_HEIGHT :
+                                                     row + height;
+
+        if (lastRow > firstRow)
+        {
+            fillHalfWords(framebuffer + firstRow * SCREEN_WIDTH, color,
+                          (lastRow - firstRow) * SCREEN_WIDTH * 2);
+        }
+
+        return 0;
+    }
+
+    for (int i = row; i < row + height; i++)
+    {
+        fillSpan(framebuffer, column, i, width, color);
+    }
+
+    return 0;
+}
+
+/*
+ * Paints with the color the pixels of a rectangle (clipped to the screen)
+ * whose cell in the pattern isn't 0. The pattern (patternWidth x
+ * patternHeight cells, row by row) is repeated in both directions from the
+ * top left corner of the rectangle.
+ */
+int blitPattern(unsigned short* framebuffer,
+                int column,
+                int row,
+                int width,
+                int height,
+                const unsigned char* pattern,
+                int patternWidth,
+                int patternHeight,
+                unsigned short color)
+{
+    int firstColumn = column < 0 ? 0 : column;
+    int lastColumn = column + width;
+    int firstRow = row < 0 ? 0 : row;
+    int lastRow = row + height;
+
+    if (lastColumn > SCREEN_WIDTH)
+    {
+        lastColumn = SCREEN_WIDTH;
+    }
+
+    if (lastRow > SCREEN_HEIGHT)
+    {
+        lastRow = SCREEN_HEIGHT;
+    }
+
+    for (int y = firstRow; y < lastRow; y++)
+    {
+        const unsigned char* patternRow =
+            pattern + ((y - row) % patternHeight) * patternWidth;
+        unsigned short* line = framebuffer + y * SCREEN_WIDTH;
+        int patternColumn = (firstColumn - column) % patternWidth;
+
+        for (int x = firstColumn; x < lastColumn; x++)
+        {
+            if (patternRow[patternColumn] != 0)
+            {
+                line[x] = color;
+            }
+
+            if (++patternColumn == patternWidth)
+            {
+                patternColumn = 0;
+            }
+        }
+    }
+
+    return 0;
+}
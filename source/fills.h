@@ -0,0 +1,62 @@
+#ifndef FILLS_H
+#define FILLS_H
+
+#include <stdint.h>
+
+#ifdef ARM9
+#include <nds.h>
+#endif
+
+/*
+ * Size of the screen of the DS, in pixels (libnds defines it on the DS)
+ */
+#ifndef SCREEN_WIDTH
+#define SCREEN_WIDTH 256
+#define SCREEN_HEIGHT 192
+#endif
+
+/*
+ * The fills of the framebuffers (or of any buffer of SCREEN_WIDTH x
+ * SCREEN_HEIGHT pixels). They don't depend on libnds: on the DS the big
+ * fills use the DMA and on the host computer they write 32 bit words, so
+ * they can be checked and benchmarked in headless runs.
+ */
+int fillWords(void* buffer, uint32_t value, int bytes);
+int fillHalfWords(void* buffer, unsigned short value, int bytes);
+
+int setIndexedPixel(unsigned char* framebuffer,
+                    int width,
+                    int column,
+                    int row,
+                    unsigned char index);
+
+int fillSpan(unsigned short* framebuffer,
+             int column,
+             int row,
+             int length,
+             unsigned short color);
+
+int fillSpan(unsigned char* framebuffer,
+             int column,
+             int row,
+             int length,
+             unsigned char index);
+
+int fillRect(unsigned short* framebuffer,
+             int column,
+             int row,
+             int width,
+             int height,
+             unsigned short color);
+
+int blitPattern(unsigned short* framebuffer,
+                int column,
+                int row,
+                int width,
+                int height,
+                const unsigned char* pattern,
+                int patternWidth,
+                int patternHeight,
+                unsigned short color);
+
+#endif
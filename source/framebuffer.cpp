@@ -1,5 +1,8 @@
 #include <nds.h>
+#include <stdint.h>
+#include <string.h>
 #include "color.h"
+#include "framebuffer.h"
 #include "flash.h"  // Include for the header of the flash image
                     // (grit outputs a nice header to reference data)
 
@@ -15,21 +18,39 @@ unsigned short* fb = VRAM_A;
  */ 
 unsigned short* fb2 = VRAM_B;
 
+/*
+ * Pointer to the start of VRAM_D, the memory that we'll use as the third
+ * framebuffer (VRAM_C is used by the console of the sub screen)
+ */
+unsigned short* fb3 = VRAM_D;
+
+/*
+ * Pointers to the three pages of the 8 bits per pixel framebuffer, where
+ * each pixel is an index of the palette of the main background. They're
+ * bitmaps of the background 3. The first two pages are in VRAM_A: the first
+ * one starts at 0 and the second one at 64KB (bitmap base 4, in units of
+ * 16KB). The third one is in VRAM_D, mapped after VRAM_A (bitmap base 8).
+ */
+unsigned char* indexedFB = (unsigned char*) BG_BMP_RAM(0);
+unsigned char* indexedFB2 = (unsigned char*) BG_BMP_RAM(4);
+unsigned char* indexedFB3 = (unsigned char*) BG_BMP_RAM(8);
+
+/*
+ * Fills the whole framebuffer with the color, using the DMA
+ */
+int fillFB(unsigned short* framebuffer, unsigned short color)
+{
+    fillHalfWords(framebuffer, color, SCREEN_WIDTH * SCREEN_HEIGHT * 2);
+
+    return 0;
+}
+
 /*
  * Fills the selected framebuffer with the background color
  */
 int cleanFB(unsigned short* framebuffer)
 {
-	int row, column;
-
-	for(row = 0; row < SCREEN_HEIGHT; row++)
-	{
-	    for(column = 0; column < SCREEN_WIDTH; column++)
-	    {
-		    framebuffer[row * SCREEN_WIDTH + column] = BG_color;
-		}
-    }
-	return 0;
+    return fillFB(framebuffer, BG_color);
 }
 
 /*
@@ -60,6 +81,57 @@ int showFB2()
 	return 0;
 }
 
+/*
+ * Shows the third framebuffer. VRAM_D must be in LCD mode to write it, so
+ * call it before drawing in fb3 for the first time.
+ */
+int showFB3()
+{
+    // Configuration of the main screen
+    REG_DISPCNT = MODE_FB3; // Use MODE_FB3 for VRAM_D
+
+    // Configure the VRAM D block
+    VRAM_D_CR = VRAM_ENABLE | VRAM_D_LCD;
+
+    return 0;
+}
+
+/*
+ * Shows one of the three framebuffers (0: fb, 1: fb2, 2: fb3). It only
+ * writes registers, so it can be called by the VBlank interrupt (see
+ * FramePipeline).
+ */
+int showFBPage(int page)
+{
+    if (page == 0)
+    {
+        return showFB();
+    }
+    else if (page == 1)
+    {
+        return showFB2();
+    }
+
+    return showFB3();
+}
+
+/*
+ * Returns one of the three framebuffers (0: fb, 1: fb2, 2: fb3)
+ */
+unsigned short* getFBPage(int page)
+{
+    if (page == 0)
+    {
+        return fb;
+    }
+    else if (page == 1)
+    {
+        return fb2;
+    }
+
+    return fb3;
+}
+
 /*
  * Show the flash screen on the main screen
  */
@@ -83,7 +155,508 @@ int showFlash()
 }
 
 /*
- * Draws a horizontal line of the specified color
+ * The lattice (the lines of the hexagonal and triangular grids) is shown by
+ * the text background 0, over the cells. Its 8 bits per pixel tiles and its
+ * map use the 16KB of VRAM_A between the two pages of the 8 bits per pixel
+ * framebuffer: the tiles start at 48KB (tile base 3) and the map at 62KB
+ * (map base 31), so there's room for LATTICE_MAX_TILES tiles.
+ */
+#define LATTICE_TILE_BASE 3
+#define LATTICE_MAP_BASE 31
+#define LATTICE_MAX_TILES 224
+
+static int latticeBg = -1;
+static bool latticeVisible = false;
+
+// Tiles and map of the last lattice built, kept in main RAM so restarts
+// don't build it again (VRAM_A is overwritten while the initial states are
+// drawn in the 16 bits framebuffer, so they're copied on each show)
+static unsigned char latticeTiles[LATTICE_MAX_TILES][64];
+static unsigned short latticeMap[32 * 32];
+static int latticeNumTiles = 0;
+static const unsigned char* latticePattern = NULL;
+static int latticeWidth = 0;
+static int latticeHeight = 0;
+
+/*
+ * The view of the 8 bits per pixel framebuffer. The background 3 is an
+ * extended rotation background, so the hardware scales and scrolls it: the
+ * automata draw one pixel per cell and the cells are made bigger by the
+ * zoom, without any cost per cell.
+ * viewX and viewY are the coordinates (24.8 fixed point, in cells) of the
+ * upper left corner of the screen, viewZoom is the number of pixels per
+ * cell (8.8 fixed point, see VIEW_ZOOM_ONE) and viewWidth x viewHeight is
+ * the size of the universe (in cells).
+ */
+static int indexedBg = -1;
+static int viewWidth = SCREEN_WIDTH;
+static int viewHeight = SCREEN_HEIGHT;
+static int viewMinZoom = VIEW_ZOOM_ONE;
+static int viewZoom = VIEW_ZOOM_ONE;
+static int viewX = 0;
+static int viewY = 0;
+
+/*
+ * Row of each page of the 8 bits per pixel framebuffer shown at the top of
+ * the view (see setIndexedFBPageScroll()) and the page shown
+ */
+static volatile int indexedPageScroll[3] = {0, 0, 0};
+static volatile int indexedPage = 0;
+
+/*
+ * Returns the number of cells per pixel (8.8 fixed point), the scale of the
+ * affine background
+ */
+static int getViewScale()
+{
+    return (VIEW_ZOOM_ONE * VIEW_ZOOM_ONE) / viewZoom;
+}
+
+/*
+ * Clamps the position (24.8 fixed point) of the view along one axis: a view
+ * smaller than the universe stays inside it, a bigger one is centered
+ */
+static int clampViewPosition(int position, int size, int screenSize)
+{
+    int span = screenSize * getViewScale();
+
+    if (span >= (size << 8))
+    {
+        return ((size << 8) - span) / 2;
+    }
+
+    if (position < 0)
+    {
+        return 0;
+    }
+
+    if (position > (size << 8) - span)
+    {
+        return (size << 8) - span;
+    }
+
+    return position;
+}
+
+/*
+ * Writes the view to the registers of the background 3
+ */
+static int applyView()
+{
+    viewX = clampViewPosition(viewX, viewWidth, SCREEN_WIDTH);
+    viewY = clampViewPosition(viewY, viewHeight, SCREEN_HEIGHT);
+
+    if (indexedBg != -1)
+    {
+        bgSetScale(indexedBg, getViewScale(), getViewScale());
+        bgSetScrollf(indexedBg, viewX,
+                     viewY + (indexedPageScroll[indexedPage] << 8));
+        bgUpdate();
+    }
+
+    return 0;
+}
+
+/*
+ * Shows the page of the 8 bits per pixel framebuffer that starts at the
+ * bitmap base, and the lattice over it if there's one
+ */
+static int showIndexedPage(int bitmapBase, BgSize size)
+{
+    videoSetMode(MODE_5_2D);
+
+    vramSetBankA(VRAM_A_MAIN_BG);
+    vramSetBankD(VRAM_D_MAIN_BG_0x06020000);
+
+    // bgInit() resets the scale, the scroll and the wraparound
+    for (int i = 0; i < 3; i++)
+    {
+        indexedPageScroll[i] = 0;
+    }
+
+    indexedPage = bitmapBase / 4;
+    indexedBg = bgInit(3, BgType_Bmp8, size, bitmapBase, 0);
+    applyView();
+
+    // With the same priority the background 0 is drawn over the
+    // background 3, and the pixels of index 0 of its tiles are transparent
+    if (latticeVisible == true)
+    {
+        bgShow(latticeBg);
+    }
+
+    return 0;
+}
+
+/*
+ * Shows the first page of the 8 bits per pixel framebuffer
+ */
+int showIndexedFB()
+{
+    return showIndexedPage(0, BgSize_B8_256x256);
+}
+
+/*
+ * Shows the second page of the 8 bits per pixel framebuffer
+ */
+int showIndexedFB2()
+{
+    return showIndexedPage(4, BgSize_B8_256x256);
+}
+
+/*
+ * Shows the third page of the 8 bits per pixel framebuffer
+ */
+int showIndexedFB3()
+{
+    return showIndexedPage(8, BgSize_B8_256x256);
+}
+
+/*
+ * Shows one of the three pages of the 8 bits per pixel framebuffer (0:
+ * indexedFB, 1: indexedFB2, 2: indexedFB3) on the background 3 set up by
+ * showIndexedFB(). It's called by the VBlank interrupt (see FramePipeline),
+ * so it only moves the bitmap base of the background: the mode, the VRAM
+ * banks and the view are written by the main loop, that can be in the
+ * middle of changing them. If the pages scroll (see
+ * setIndexedFBPageScroll()) the vertical reference point of the background
+ * moves with the page, written straight to the register like bgUpdate()
+ * does for the view.
+ */
+int showIndexedFBPage(int page)
+{
+    if (indexedBg != -1)
+    {
+        bgSetMapBase(indexedBg, page * 4);
+
+        if (indexedPageScroll[page] != indexedPageScroll[indexedPage])
+        {
+            bgTransform[indexedBg]->dy = viewY +
+                                         (indexedPageScroll[page] << 8);
+        }
+    }
+
+    indexedPage = page;
+
+    return 0;
+}
+
+/*
+ * Makes the pages of the 8 bits per pixel framebuffer shown by
+ * showIndexedFB() wrap around vertically, so the view can start at any of
+ * their rows (see setIndexedFBPageScroll())
+ */
+int wrapIndexedFB()
+{
+    if (indexedBg != -1)
+    {
+        bgWrapOn(indexedBg);
+    }
+
+    return 0;
+}
+
+/*
+ * Sets the row of the page of the 8 bits per pixel framebuffer shown at
+ * the top of the view. It's applied when the page is shown (see
+ * showIndexedFBPage()), so a page can be scrolled before it's submitted to
+ * the FramePipeline. The rows of the one dimensional automata are a ring
+ * in each page (see Waterfall): the background scrolls instead of the
+ * rows being moved. showIndexedFB() sets them to 0 again.
+ */
+int setIndexedFBPageScroll(int page, int row)
+{
+    indexedPageScroll[page] = row;
+
+    return 0;
+}
+
+/*
+ * Returns one of the three pages of the 8 bits per pixel framebuffer
+ */
+unsigned char* getIndexedFBPage(int page)
+{
+    if (page == 0)
+    {
+        return indexedFB;
+    }
+    else if (page == 1)
+    {
+        return indexedFB2;
+    }
+
+    return indexedFB3;
+}
+
+/*
+ * Shows the first page of the 8 bits per pixel framebuffer as a bitmap of
+ * WIDE_INDEXED_FB_WIDTH x WIDE_INDEXED_FB_HEIGHT pixels. It fills the whole
+ * VRAM_A, so there's no second page (nor lattice).
+ */
+int showWideIndexedFB()
+{
+    return showIndexedPage(0, BgSize_B8_512x256);
+}
+
+/*
+ * Sets the size of the universe (in cells) shown by the 8 bits per pixel
+ * framebuffer and shows it centered with the zoom. The zoom can't be
+ * smaller than the one that fits the whole universe on the screen.
+ */
+int resetView(int width, int height, int zoom)
+{
+    viewWidth = width;
+    viewHeight = height;
+
+    viewMinZoom = (SCREEN_WIDTH * VIEW_ZOOM_ONE) / width;
+
+    if ((SCREEN_HEIGHT * VIEW_ZOOM_ONE) / height < viewMinZoom)
+    {
+        viewMinZoom = (SCREEN_HEIGHT * VIEW_ZOOM_ONE) / height;
+    }
+
+    if (viewMinZoom > VIEW_MAX_ZOOM)
+    {
+        viewMinZoom = VIEW_MAX_ZOOM;
+    }
+
+    // Any position works, the view is centered on the universe below
+    viewZoom = VIEW_ZOOM_ONE;
+    viewX = (width << 8) / 2 - (SCREEN_WIDTH / 2) * getViewScale();
+    viewY = (height << 8) / 2 - (SCREEN_HEIGHT / 2) * getViewScale();
+
+    return setViewZoom(zoom);
+}
+
+/*
+ * Sets the number of pixels per cell (8.8 fixed point), keeping the cell in
+ * the center of the screen where it is
+ */
+int setViewZoom(int zoom)
+{
+    if (zoom < viewMinZoom)
+    {
+        zoom = viewMinZoom;
+    }
+    else if (zoom > VIEW_MAX_ZOOM)
+    {
+        zoom = VIEW_MAX_ZOOM;
+    }
+
+    int centerX = viewX + (SCREEN_WIDTH / 2) * getViewScale();
+    int centerY = viewY + (SCREEN_HEIGHT / 2) * getViewScale();
+
+    viewZoom = zoom;
+
+    viewX = centerX - (SCREEN_WIDTH / 2) * getViewScale();
+    viewY = centerY - (SCREEN_HEIGHT / 2) * getViewScale();
+
+    return applyView();
+}
+
+int getViewZoom()
+{
+    return viewZoom;
+}
+
+/*
+ * Zooms in (steps > 0) or out (steps < 0) by steps fractions of
+ * 1 / VIEW_ZOOM_STEP of the current zoom, so holding a key zooms smoothly
+ */
+int zoomView(int steps)
+{
+    int zoom = viewZoom;
+
+    for (; steps > 0; steps--)
+    {
+        zoom = zoom + zoom / VIEW_ZOOM_STEP + 1;
+    }
+
+    for (; steps < 0; steps++)
+    {
+        zoom = zoom - zoom / (VIEW_ZOOM_STEP + 1) - 1;
+    }
+
+    return setViewZoom(zoom);
+}
+
+/*
+ * Moves the view dx pixels to the right and dy pixels down (the size of a
+ * pixel in cells depends on the zoom)
+ */
+int panView(int dx, int dy)
+{
+    viewX = viewX + dx * getViewScale();
+    viewY = viewY + dy * getViewScale();
+
+    return applyView();
+}
+
+/*
+ * Writes the colors of the palette of the 8 bits per pixel framebuffer.
+ * The colors live only here, so the cells can be recolored without
+ * touching them.
+ */
+int setIndexedPalette(const unsigned short* palette, int numColors)
+{
+    for (int i = 0; i < numColors and i < 256; i++)
+    {
+        BG_PALETTE[i] = palette[i];
+    }
+
+    return 0;
+}
+
+/*
+ * Shows a lattice over the 8 bits per pixel framebuffer. The pixels of the
+ * rectangle (0, 0, width, height) whose cell in the pattern (patternWidth x
+ * patternHeight, repeated as in blitPattern()) isn't 0 get the palette
+ * index, the rest are transparent. The lattice is cut in 8x8 tiles and the
+ * repeated tiles are stored once. If it's the same lattice as the last time
+ * the tiles aren't built again, only copied to VRAM.
+ * The 8 bits per pixel framebuffer must be shown (VRAM_A as background).
+ */
+int showLattice(const unsigned char* pattern,
+                int patternWidth,
+                int patternHeight,
+                int width,
+                int height,
+                unsigned char index)
+{
+    if (latticeBg == -1)
+    {
+        latticeBg = bgInit(0, BgType_Text8bpp, BgSize_T_256x256,
+                           LATTICE_MAP_BASE, LATTICE_TILE_BASE);
+    }
+
+    if (pattern != latticePattern or width != latticeWidth or
+        height != latticeHeight)
+    {
+        int numTiles = 1; // The tile 0 is empty
+
+        memset(latticeTiles[0], 0, 64);
+        memset(latticeMap, 0, sizeof(latticeMap));
+
+        for (int tileRow = 0; tileRow < SCREEN_HEIGHT / 8; tileRow++)
+        {
+            for (int tileColumn = 0; tileColumn < 32; tileColumn++)
+            {
+                unsigned char tile[64];
+
+                for (int y = 0; y < 8; y++)
+                {
+                    for (int x = 0; x < 8; x++)
+                    {
+                        int column = tileColumn * 8 + x;
+                        int row = tileRow * 8 + y;
+
+                        if (column < width and row < height and
+                            pattern[(row % patternHeight) * patternWidth +
+                                    column % patternWidth] != 0)
+                        {
+                            tile[y * 8 + x] = index;
+                        }
+                        else
+                        {
+                            tile[y * 8 + x] = 0;
+                        }
+                    }
+                }
+
+                int found = 0;
+
+                while (found < numTiles and
+                       memcmp(latticeTiles[found], tile, 64) != 0)
+                {
+                    found++;
+                }
+
+                if (found == numTiles and numTiles < LATTICE_MAX_TILES)
+                {
+                    memcpy(latticeTiles[numTiles], tile, 64);
+                    numTiles++;
+                }
+                else if (found == numTiles)
+                {
+                    found = 0;
+                }
+
+                latticeMap[tileRow * 32 + tileColumn] = found;
+            }
+        }
+
+        latticeNumTiles = numTiles;
+        latticePattern = pattern;
+        latticeWidth = width;
+        latticeHeight = height;
+    }
+
+    DC_FlushRange(latticeTiles, latticeNumTiles * 64);
+    DC_FlushRange(latticeMap, sizeof(latticeMap));
+    dmaCopy(latticeTiles, bgGetGfxPtr(latticeBg), latticeNumTiles * 64);
+    dmaCopy(latticeMap, bgGetMapPtr(latticeBg), sizeof(latticeMap));
+
+    latticeVisible = true;
+    bgShow(latticeBg);
+
+    return 0;
+}
+
+/*
+ * Hides the lattice (it stays in VRAM)
+ */
+int hideLattice()
+{
+    latticeVisible = false;
+
+    if (latticeBg != -1)
+    {
+        bgHide(latticeBg);
+    }
+
+    return 0;
+}
+
+/*
+ * Fills a page of the 8 bits per pixel framebuffer with the palette index
+ */
+int cleanIndexedFB(unsigned char* framebuffer, unsigned char index)
+{
+    fillWords(framebuffer, 0x01010101u * (uint8_t) index,
+              SCREEN_WIDTH * SCREEN_HEIGHT);
+
+    return 0;
+}
+
+/*
+ * Fills the whole page of WIDE_INDEXED_FB_WIDTH x WIDE_INDEXED_FB_HEIGHT
+ * pixels (see showWideIndexedFB()) with the palette index
+ */
+int cleanWideIndexedFB(unsigned char index)
+{
+    fillWords(indexedFB, 0x01010101u * (uint8_t) index,
+              WIDE_INDEXED_FB_WIDTH * WIDE_INDEXED_FB_HEIGHT);
+
+    return 0;
+}
+
+/*
+ * Copies length cells (palette indexes) from main RAM to the 8 bits per
+ * pixel framebuffer. The cache is flushed first, because the DMA reads main
+ * RAM directly. The cells must be word aligned.
+ */
+int copyToIndexedFB(const unsigned char* cells,
+                    unsigned char* framebuffer,
+                    int length)
+{
+    DC_FlushRange(cells, length);
+    dmaCopy(cells, framebuffer, length);
+
+    return 0;
+}
+
+/*
+ * Draws a horizontal line of the specified color (clipped to the screen)
  */
 int drawHLine(int column,
               int row,
@@ -91,21 +664,38 @@ int drawHLine(int column,
               unsigned short color,
               unsigned short* framebuffer)
 {
-	for(int i = column; i < column + lenght; i++)
-	{
-		framebuffer[row * SCREEN_WIDTH + i] = color;
-	}
-	return 0;
+    return fillSpan(framebuffer, column, row, lenght, color);
 }
 
 /*
- * Draws a vertical line of the specified color
+ * Draws a horizontal line of the specified palette index in an 8 bits per
+ * pixel framebuffer (or in the cells of a grid), clipped to the screen
+ */
+int drawHLine(int column,
+              int row,
+              int lenght,
+              unsigned char index,
+              unsigned char* framebuffer)
+{
+    return fillSpan(framebuffer, column, row, lenght, index);
+}
+
+/*
+ * Draws a vertical line of the specified color (clipped to the screen)
  */ 
 int drawVLine(int column, int row, int lenght, unsigned short color)
 {
-    for(int i = row; i < row + lenght; i++)
+    if (column < 0 or column >= SCREEN_WIDTH)
     {
-        fb[i * SCREEN_WIDTH + column] = color;
+        return 0;
+    }
+
+    for (int i = row; i < row + lenght; i++)
+    {
+        if (i >= 0 and i < SCREEN_HEIGHT)
+        {
+            fb[i * SCREEN_WIDTH + column] = color;
+        }
     }
     return 0;
 }
@@ -125,9 +715,6 @@ int drawRectangle(int intRowStart,
 {
 	// fill-> true, fill with FG_color		fill -> false, fill with BG_color
 
-	unsigned char column = 0;
-	unsigned char row = 0;
-	
 	/*
 	 * It must be intRowStart + length - 1 and intColumnStart + width - 1
 	 * else we get this:
@@ -168,14 +755,8 @@ int drawRectangle(int intRowStart,
 	drawVLine(intColumnStart, intRowStart, length, line_color);
 	drawVLine(intColumnStart + width - 1, intRowStart, length, line_color);
 	
-	for(column = intColumnStart + 1;
-        column < intColumnStart + width - 1; column++)
-	{
-		for(row = intRowStart + 1; row < intRowStart + length - 1; row++)
-		{
-			fb[row * SCREEN_WIDTH + column] = fill_color;
-		}
-	} 
+	fillRect(fb, intColumnStart + 1, intRowStart + 1,
+	         width - 2, length - 2, fill_color);
 	
 	return 0;
 }
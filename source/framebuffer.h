@@ -1,20 +1,86 @@
 #ifndef FRAMEBUFFER_H
 #define FRAMEBUFFER_H
 
+#include "fills.h"
+
+/*
+ * Size of the page of the 8 bits per pixel framebuffer shown by
+ * showWideIndexedFB()
+ */
+#define WIDE_INDEXED_FB_WIDTH 512
+#define WIDE_INDEXED_FB_HEIGHT 256
+
+/*
+ * Rows of a page of the 8 bits per pixel framebuffer (a 256x256 bitmap, the
+ * screen shows SCREEN_HEIGHT of them)
+ */
+#define INDEXED_FB_PAGE_HEIGHT 256
+
+/*
+ * Zoom of the view of the 8 bits per pixel framebuffer, in pixels per cell
+ * (8.8 fixed point: VIEW_ZOOM_ONE is one pixel per cell). Each step of
+ * zoomView() changes it by 1 / VIEW_ZOOM_STEP.
+ */
+#define VIEW_ZOOM_ONE 256
+#define VIEW_MAX_ZOOM (16 * VIEW_ZOOM_ONE)
+#define VIEW_ZOOM_STEP 32
+
 extern unsigned short* fb;
 extern unsigned short* fb2;
+extern unsigned short* fb3;
+
+extern unsigned char* indexedFB;
+extern unsigned char* indexedFB2;
+extern unsigned char* indexedFB3;
 
+int fillFB(unsigned short* framebuffer, unsigned short color);
 int cleanFB(unsigned short* framebuffer);
 int showFB();
 int showFB2();
+int showFB3();
+int showFBPage(int page);
+unsigned short* getFBPage(int page);
 int showFlash();
 
+int cleanIndexedFB(unsigned char* framebuffer, unsigned char index);
+int showIndexedFB();
+int showIndexedFB2();
+int showIndexedFB3();
+int showIndexedFBPage(int page);
+int wrapIndexedFB();
+int setIndexedFBPageScroll(int page, int row);
+unsigned char* getIndexedFBPage(int page);
+int showWideIndexedFB();
+int cleanWideIndexedFB(unsigned char index);
+int resetView(int width, int height, int zoom);
+int setViewZoom(int zoom);
+int getViewZoom();
+int zoomView(int steps);
+int panView(int dx, int dy);
+int setIndexedPalette(const unsigned short* palette, int numColors);
+int showLattice(const unsigned char* pattern,
+                int patternWidth,
+                int patternHeight,
+                int width,
+                int height,
+                unsigned char index);
+int hideLattice();
+int copyToIndexedFB(const unsigned char* cells,
+                    unsigned char* framebuffer,
+                    int length);
+
 int drawHLine(int column,
               int row,
               int lenght,
               unsigned short color,
               unsigned short* framebuffer);
 
+int drawHLine(int column,
+              int row,
+              int lenght,
+              unsigned char index,
+              unsigned char* framebuffer);
+
 int drawVLine(int column,
               int row,
               int lenght,
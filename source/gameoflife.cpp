@@ -0,0 +1,314 @@
+#include <nds.h>
+#include <stdio.h>
+
+#include "gameoflife.h"
+#include "cellularautomata.h"
+#include "initialConditions.h"
+#include "stencil.h"
+#include "liferule.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * References:
+ * http://en.wikipedia.org/wiki/Conway%27s_Game_of_Life
+ * http://www.conwaylife.com/wiki/Main_Page
+ * Stephen Silver's Life Lexicon:
+ *  http://www.argentum.freeserve.co.uk/lex_home.htm
+ * Eric Weisstein's Treasure Trove of the Life Cellular Automaton:
+ * http://www.ericweisstein.com/encyclopedias/life/
+ */
+
+// The rows of the options of the menu: the initial states (0-5) and back
+// to main menu (6)
+static const int CGL_MENU_ROWS[] =
+    {CGL_MENU_ACORN_ROW,
+     CGL_MENU_FPENTOMINO_ROW,
+     CGL_MENU_FILL_SCREEN_WITH_PULSARS_ROW,
+     CGL_MENU_FILL_SCREEN_WITH_PENTADECATHLONS_ROW,
+     CGL_MENU_RIP_JOHN_CONWAY_ROW, // https://xkcd.com/2293/
+     CGL_MENU_PATTERN_LIBRARY_ROW,
+     CGL_MENU_BACK_TO_MAIN_ROW};
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Draws the initial state chosen in the menu in the grid. The patterns are
+ * decoded straight into the cells of the grid and add their cells to the
+ * population.
+ */
+int GameOfLife::drawInitialState(unsigned int& population)
+{
+    unsigned char* cells = grid.getCells();
+
+    if (initialState == ACORN)
+    {
+        drawAcorn(cells, 120, 90, CELL_FG, population);
+    }
+    else if (initialState == FPENTOMINO)
+    {
+        drawFpentomino(cells, 120, 90, CELL_FG, population);
+    }
+    else if (initialState == FILL_SCREEN_WITH_PULSARS)
+    {
+        fillScreenWithPulsars(cells, CELL_FG, population);
+    }
+    else if (initialState == FILL_SCREEN_WITH_PENTADECATHLONS)
+    {
+        fillScreenWithPentadecathlons(cells, CELL_FG, population);
+    }
+    else if (initialState == RIP_JOHN_CONWAY)
+    {
+        drawRIPJohnConway(cells, 120, 90, CELL_FG, population);
+    }
+
+    return 0;
+}
+
+/*
+ * Chooses the next pattern of the library (the first one after the last)
+ */
+int GameOfLife::nextPattern()
+{
+    if (patternLibrary.getNumPatterns() != 0)
+    {
+        patternIndex = (patternIndex + 1) % patternLibrary.getNumPatterns();
+    }
+
+    return 0;
+}
+
+/*
+ * Chooses the previous pattern of the library (the last one before the
+ * first)
+ */
+int GameOfLife::previousPattern()
+{
+    int numPatterns = patternLibrary.getNumPatterns();
+
+    if (numPatterns != 0)
+    {
+        patternIndex = (patternIndex + numPatterns - 1) % numPatterns;
+    }
+
+    return 0;
+}
+
+/*
+ * Prints the name of the pattern chosen in the library (cut to fit in the
+ * row)
+ */
+int GameOfLife::printPatternLibrary()
+{
+    std::string name = stringNoPatterns;
+    int room = 32 - 3 - stringPatternLibrary.length() - 2;
+
+    if (patternLibrary.getNumPatterns() != 0)
+    {
+        name = patternLibrary.getInfo(patternIndex).name;
+    }
+
+    iprintf("\x1b[%d;%dH%s: %-*.*s", CGL_MENU_PATTERN_LIBRARY_ROW, 3,
+            stringPatternLibrary.c_str(), room, room, name.c_str());
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+GameOfLife::GameOfLife()
+{
+    initialState = ACORN;
+    patternIndex = 0;
+}
+
+/*
+ * Draws the initial state of Conway's game of life and loads it in the
+ * universe
+ */
+int GameOfLife::initialize(CellularAutomata& automata)
+{
+    unsigned int population = 0;
+
+    // The initial state isn't drawn in the framebuffer: it's decoded
+    // straight into the grid
+    clearGrid();
+
+    if (initialState == PATTERN_LIBRARY)
+    {
+        // The patterns of the library can be bigger than the screen:
+        // they're decoded straight into the universe, and the grid gets
+        // the window shown
+        universe.clear();
+        patternLibrary.decode(patternIndex, universe, SCREEN_WIDTH,
+                              SCREEN_HEIGHT, population);
+        universe.render(grid, 0, 0, CELL_FG, CELL_BG);
+        grid.swap();
+    }
+    else
+    {
+        drawInitialState(population);
+
+        universe.load(grid.getCells(), grid.getWidth(), grid.getHeight(),
+                      CELL_FG);
+    }
+
+    automata.setPopulation(population);
+
+    startGrid(automata);
+
+    // The generations are calculated in the universe, the grid shows them
+    startUniverse(automata);
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation of Conway's game of life on the unbounded
+ * universe and draws the window shown on the screen
+ */
+int GameOfLife::nextStep(CellularAutomata& automata)
+{
+    LifeRule rule;
+    int changes;
+    int populationChange;
+
+    rule.state = CELL_FG;
+
+    automata.countStep();
+
+    changes = ChunkedStencil<MooreNeighborhood, LifeRule>::step(
+        universe, rule, populationChange);
+
+    automata.addPopulation(populationChange);
+
+    /*
+     * If every cell is dead and stays dead the automata has finished so
+     * we are going to reinitiate the cycle (the still lifes go on)
+     */
+    if (changes == 0 and automata.getPopulation() == 0)
+    {
+        automata.restart();
+    }
+    else // the automata has not finished yet
+    {
+        // The still lifes and the oscillators are cycles
+        swapUniverse(automata);
+    }
+
+    return 0;
+}
+
+const std::string& GameOfLife::getName()
+{
+    return stringConwaysGameOfLife;
+}
+
+/*
+ * The acorn (default). The pattern chosen in the library is kept.
+ */
+int GameOfLife::setDefaults()
+{
+    initialState = ACORN;
+
+    return 0;
+}
+
+int GameOfLife::printMenu()
+{
+    printString(CGL_MENU_INITIAL_STATE_ROW, 2,
+                stringInitialState);
+    printString(CGL_MENU_ACORN_ROW, 3,
+                stringAcorn);
+    printString(CGL_MENU_FPENTOMINO_ROW, 3,
+                stringFPentomino);
+    printString(CGL_MENU_FILL_SCREEN_WITH_PULSARS_ROW, 3,
+                stringFillScreenWithPulsars);
+    printString(CGL_MENU_FILL_SCREEN_WITH_PENTADECATHLONS_ROW, 3,
+                stringFillScreenWithPentadecathlons);
+    printString(CGL_MENU_RIP_JOHN_CONWAY_ROW, 3,
+                stringRipJohnConway);
+    printPatternLibrary();
+    printString(CGL_MENU_BACK_TO_MAIN_ROW, 2,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+    printString(VIEW_HELP_ROW, VIEW_HELP_COL, stringViewHelp);
+
+    return 0;
+}
+
+int GameOfLife::printMenuArrow(int index, bool boolDelete)
+{
+    return printOptionArrow(CGL_MENU_ROWS[index], 0, boolDelete);
+}
+
+/*
+ * Marks the initial state chosen (the options 0-5 are the initial states
+ * ACORN to PATTERN_LIBRARY)
+ */
+int GameOfLife::printMenuAsterisks()
+{
+    for (int i = ACORN; i <= PATTERN_LIBRARY; ++i)
+    {
+        if (i == initialState)
+        {
+            printAsterisk(CGL_MENU_ROWS[i], 2);
+        }
+        else
+        {
+            deleteAsterisk(CGL_MENU_ROWS[i], 2);
+        }
+    }
+
+    return 0;
+}
+
+int GameOfLife::updateMenu(CellularAutomata& automata,
+                           int keys_pressed,
+                           int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 6)
+        {
+            // Go back to the selection of the type of automata
+            showAutomataTypeMenu();
+        }
+        else
+        {
+            // The library can be empty
+            if (arrow != PATTERN_LIBRARY or
+                patternLibrary.getNumPatterns() != 0)
+            {
+                initialState = arrow;
+                automata.initialize();
+            }
+
+            printMenuAsterisks();
+        }
+    }
+    else if (arrow == 5 and (keys_pressed & KEY_LEFT))
+    {
+        // Browse the library (only its index is read)
+        previousPattern();
+        printPatternLibrary();
+    }
+    else if (arrow == 5 and (keys_pressed & KEY_RIGHT))
+    {
+        nextPattern();
+        printPatternLibrary();
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(6);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(6);
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef GAMEOFLIFE_H
+#define GAMEOFLIFE_H
+
+#include <string>
+
+#include "automaton.h"
+
+/*
+ * Conway's game of life, on the unbounded universe. It starts with one of
+ * the patterns of its menu or with the pattern chosen in the library (see
+ * PatternLibrary), that can be bigger than the screen.
+ */
+class GameOfLife : public UnboundedAutomaton
+{
+    private:
+        int initialState; // ACORN, FPENTOMINO... or PATTERN_LIBRARY
+        int patternIndex; // The pattern chosen in the library
+
+        int drawInitialState(unsigned int& population);
+        int nextPattern();
+        int previousPattern();
+        int printPatternLibrary();
+
+    public:
+        GameOfLife();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int printMenuAsterisks();
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "generations.h"
+
+/*
+ * A rule with a name
+ */
+struct GenerationsPreset
+{
+    const char* name;
+    const char* rule;
+};
+
+/*
+ * The rules of GENERATIONS_PRESET_BRIANS_BRAIN... (from the rules of Golly
+ * and MCell)
+ */
+static const GenerationsPreset presets[GENERATIONS_NUM_PRESETS] =
+{
+    {"Brian's Brain", "/2/3"},
+    {"Star Wars", "345/2/4"},
+    {"Frogs", "12/34/3"},
+    {"Sticks", "3456/2/6"},
+    {"Banners", "2367/3457/5"}
+};
+
+/*
+ * Reads the digits of a list of counts (like 345) up to the separator and
+ * sets their bits. Returns the character after the separator, NULL if
+ * there's something else.
+ */
+static const char* parseCounts(const char* text, char separator, int& counts)
+{
+    counts = 0;
+
+    while (*text >= '0' and *text <= '8')
+    {
+        counts = counts | (1 << (*text - '0'));
+        ++text;
+    }
+
+    if (*text != separator)
+    {
+        return NULL;
+    }
+
+    return text + 1;
+}
+
+/*
+ * Writes the digits of the counts whose bits are set
+ */
+static int formatCounts(int counts, char* text)
+{
+    int length = 0;
+
+    for (int n = 0; n <= 8; ++n)
+    {
+        if ((counts & (1 << n)) != 0)
+        {
+            text[length] = '0' + n;
+            ++length;
+        }
+    }
+
+    text[length] = '\0';
+
+    return length;
+}
+
+/*
+ * Sets the birth, the survival and the number of states of the rule to the
+ * ones of the preset (GENERATIONS_PRESET_BRIANS_BRAIN...)
+ */
+int setGenerationsPreset(GenerationsRule& rule, int preset)
+{
+    if (preset < 0 or preset >= GENERATIONS_NUM_PRESETS)
+    {
+        return 0;
+    }
+
+    parseGenerationsRule(presets[preset].rule, rule);
+
+    return 0;
+}
+
+/*
+ * Returns the name of the preset, NULL for GENERATIONS_PRESET_CUSTOM
+ */
+const char* getGenerationsPresetName(int preset)
+{
+    if (preset < 0 or preset >= GENERATIONS_NUM_PRESETS)
+    {
+        return NULL;
+    }
+
+    return presets[preset].name;
+}
+
+/*
+ * Writes the rule like 345/2/4 in text (size bytes)
+ */
+int formatGenerationsRule(const GenerationsRule& rule, char* text, int size)
+{
+    char survival[10];
+    char birth[10];
+
+    formatCounts(rule.survival, survival);
+    formatCounts(rule.birth, birth);
+
+    snprintf(text, size, "%s/%s/%d", survival, birth, rule.numStates);
+
+    return 0;
+}
+
+/*
+ * Reads a rule like 345/2/4 (survival/birth/states), or the name of a
+ * preset (in any case). Returns false if it isn't a rule of up to
+ * GENERATIONS_MAX_STATES states.
+ */
+bool parseGenerationsRule(const char* text, GenerationsRule& rule)
+{
+    int survival;
+    int birth;
+    int numStates;
+    char end;
+
+    for (int i = 0; i < GENERATIONS_NUM_PRESETS; ++i)
+    {
+        if (strcasecmp(text, presets[i].name) == 0)
+        {
+            return parseGenerationsRule(presets[i].rule, rule);
+        }
+    }
+
+    text = parseCounts(text, '/', survival);
+
+    if (text != NULL)
+    {
+        text = parseCounts(text, '/', birth);
+    }
+
+    if (text == NULL or sscanf(text, "%d%c", &numStates, &end) != 1 or
+        numStates < GENERATIONS_MIN_STATES or
+        numStates > GENERATIONS_MAX_STATES)
+    {
+        return false;
+    }
+
+    // A cell born with no firing neighbors would fill the empty space
+    if ((birth & 1) != 0)
+    {
+        return false;
+    }
+
+    rule.survival = survival;
+    rule.birth = birth;
+    rule.numStates = numStates;
+    rule.updateTables();
+
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef GENERATIONS_H
+#define GENERATIONS_H
+
+#include <stdint.h>
+
+#include "globals.h"
+
+/*
+ * Number of states of the Generations rules: dead, alive (firing) and up
+ * to 14 refractory states, kept in up to 4 bit planes (see StatePlanes)
+ */
+#define GENERATIONS_MIN_STATES 2
+#define GENERATIONS_MAX_STATES 16
+
+/*
+ * Entries of the tables of the birth and the survival: one per count of
+ * firing neighbors (0 to 8), padded to 1 << STENCIL_COUNT_BITS (see
+ * stencil.h)
+ */
+#define GENERATIONS_TABLE_SIZE 16
+
+/*
+ * Rules of Generations with a name (see setGenerationsPreset()).
+ * GENERATIONS_PRESET_CUSTOM is a rule changed in the menu.
+ */
+#define GENERATIONS_PRESET_CUSTOM -1
+#define GENERATIONS_PRESET_BRIANS_BRAIN 0 // /2/3
+#define GENERATIONS_PRESET_STAR_WARS 1    // 345/2/4
+#define GENERATIONS_PRESET_FROGS 2        // 12/34/3
+#define GENERATIONS_PRESET_STICKS 3       // 3456/2/6
+#define GENERATIONS_PRESET_BANNERS 4      // 2367/3457/5
+#define GENERATIONS_NUM_PRESETS 5
+
+/*
+ * The rule of a new run and the percentage of firing cells of its random
+ * initial state
+ */
+#define GENERATIONS_INITIAL_PRESET GENERATIONS_PRESET_BRIANS_BRAIN
+#define GENERATIONS_INITIAL_DENSITY 30
+
+/*
+ * Longest rule written by formatGenerationsRule()
+ */
+#define GENERATIONS_RULE_LENGTH 32
+
+/*
+ * Generations: the game of life with refractory states. The cells are dead
+ * (CELL_BG), alive or firing (state, CELL_FG) or dying (state + 1 up to
+ * numStates - 1). A dead cell is born if the number of its firing Moore
+ * neighbors is in birth, a firing cell survives if it's in survival and
+ * otherwise starts dying, and a dying cell goes on to the next state until
+ * it's dead again. Only the firing cells are counted as neighbors.
+ *
+ * birth and survival have the bit n set for the count n. The rules are
+ * written like Golly does: S/B/C, the counts of the survival and of the
+ * birth and the number of states (/2/3 is Brian's Brain).
+ */
+struct GenerationsRule
+{
+    unsigned char state;
+    int numStates;
+    int birth;
+    int survival;
+
+    // All ones for the counts of the birth and the survival (see
+    // updateTables()), read 32 cells at a time by GenerationsStencil
+    uint32_t birthTable[GENERATIONS_TABLE_SIZE];
+    uint32_t survivalTable[GENERATIONS_TABLE_SIZE];
+
+    unsigned char next(unsigned char cell, int count)
+    {
+        if (cell == CELL_BG)
+        {
+            return (birth & (1 << count)) != 0 ? state : cell;
+        }
+
+        if (cell == state and (survival & (1 << count)) != 0)
+        {
+            return cell;
+        }
+
+        return cell + 1 < numStates ? cell + 1 : CELL_BG;
+    }
+
+    void updateTables()
+    {
+        for (int n = 0; n < GENERATIONS_TABLE_SIZE; ++n)
+        {
+            // No cell has more than 8 neighbors
+            bool born = n <= 8 and (birth & (1 << n)) != 0;
+            bool survives = n <= 8 and (survival & (1 << n)) != 0;
+
+            birthTable[n] = born == true ? 0xFFFFFFFF : 0;
+            survivalTable[n] = survives == true ? 0xFFFFFFFF : 0;
+        }
+    }
+};
+
+int setGenerationsPreset(GenerationsRule& rule, int preset);
+const char* getGenerationsPresetName(int preset);
+int formatGenerationsRule(const GenerationsRule& rule, char* text, int size);
+bool parseGenerationsRule(const char* text, GenerationsRule& rule);
+
+#endif
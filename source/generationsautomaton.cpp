@@ -0,0 +1,321 @@
+#include <stdio.h>
+
+#include <nds.h>
+
+#include "generationsautomaton.h"
+#include "cellularautomata.h"
+#include "framebuffer.h"
+#include "color.h"
+#include "stencil.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * References:
+ * http://www.conwaylife.com/wiki/Generations
+ * http://psoup.math.wisc.edu/mcell/rullex_gene.html
+ */
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Sets the birth, the survival and the number of states to the ones of the
+ * preset
+ */
+int GenerationsAutomaton::setPreset(int newPreset)
+{
+    setGenerationsPreset(rule, newPreset);
+
+    preset = newPreset;
+
+    return 0;
+}
+
+/*
+ * Sets GENERATIONS_INITIAL_DENSITY percent of the cells of the grid
+ * firing, at random. The cells of the border stay dead (they don't change,
+ * see GenerationsStencil).
+ */
+int GenerationsAutomaton::drawInitialState(CellularAutomata& automata)
+{
+    RandomNumberGenerator& rng = automata.getRandomNumbers();
+    unsigned char* cells = grid.getCells();
+    unsigned int population = 0;
+
+    for (int j = 1; j < SCREEN_HEIGHT - 1; ++j)
+    {
+        for (int i = 1; i < SCREEN_WIDTH - 1; ++i)
+        {
+            if (rng.nextBelow(100) < GENERATIONS_INITIAL_DENSITY)
+            {
+                cells[j * SCREEN_WIDTH + i] = CELL_FG;
+                ++population;
+            }
+        }
+    }
+
+    automata.setPopulation(population);
+
+    return 0;
+}
+
+/*
+ * Prints the rule with a name, or custom
+ */
+int GenerationsAutomaton::printPreset()
+{
+    const char* name = getGenerationsPresetName(preset);
+
+    // Erase the previous name (the names have different lengths)
+    iprintf("\x1b[%d;%dH%s", GEN_MENU_PRESET_ROW, GEN_MENU_PRESET_COL,
+            "                              ");
+
+    iprintf("\x1b[%d;%dH%s: < %s >",
+            GEN_MENU_PRESET_ROW,
+            GEN_MENU_PRESET_COL,
+            stringRule.c_str(),
+            name == NULL ? stringCustom.c_str() : name);
+
+    return 0;
+}
+
+/*
+ * Prints the number of states
+ */
+int GenerationsAutomaton::printNumStates()
+{
+    iprintf("\x1b[%d;%dH%s: < %d > ",
+            GEN_MENU_NUM_STATES_ROW,
+            GEN_MENU_NUM_STATES_COL,
+            stringNumStates.c_str(), rule.numStates);
+
+    return 0;
+}
+
+/*
+ * Prints the whole rule (survival/birth/states)
+ */
+int GenerationsAutomaton::printRule()
+{
+    char text[GENERATIONS_RULE_LENGTH];
+
+    formatGenerationsRule(rule, text, sizeof(text));
+
+    iprintf("\x1b[%d;%dH%s", GEN_MENU_RULE_ROW, GEN_MENU_RULE_COL,
+            "                              ");
+    iprintf("\x1b[%d;%dH%s", GEN_MENU_RULE_ROW, GEN_MENU_RULE_COL, text);
+
+    return 0;
+}
+
+/*
+ * Prints all the options of Generations
+ */
+int GenerationsAutomaton::printOptions()
+{
+    printPreset();
+    printNumStates();
+    printRule();
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+GenerationsAutomaton::GenerationsAutomaton()
+{
+    rule.state = CELL_FG;
+
+    setPreset(GENERATIONS_INITIAL_PRESET);
+}
+
+/*
+ * Gives a random state to the grid and shows the states with their palette
+ * (the cells are the states, see makeGenerationsPalette())
+ */
+int GenerationsAutomaton::initialize(CellularAutomata& automata)
+{
+    unsigned short palette[GENERATIONS_MAX_STATES];
+
+    // The initial state is written straight into the grid
+    clearGrid();
+
+    drawInitialState(automata);
+
+    startGrid(automata);
+
+    makeGenerationsPalette(palette, rule.numStates);
+    setIndexedPalette(palette, rule.numStates);
+
+    // The tables of the rule of this run (see GenerationsStencil)
+    rule.updateTables();
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation of Generations on the bit planes of the
+ * states. The cells of the border don't change, like in the game of life.
+ */
+int GenerationsAutomaton::nextStep(CellularAutomata& automata)
+{
+    int changes;
+    int populationChange;
+
+    automata.countStep();
+
+    changes = GenerationsStencil<MooreNeighborhood, GenerationsRule>::step(
+                  grid, rule, statePlanes, populationChange);
+
+    automata.addPopulation(populationChange);
+
+    // Every cell is dead: start again, like the game of life
+    if (changes == 0 and automata.getPopulation() == 0)
+    {
+        automata.restart();
+    }
+    else
+    {
+        swapGrid(automata);
+    }
+
+    return 0;
+}
+
+/*
+ * Frees the grid and the bit planes of the states
+ */
+int GenerationsAutomaton::release()
+{
+    GridAutomaton::release();
+
+    return statePlanes.release();
+}
+
+const std::string& GenerationsAutomaton::getName()
+{
+    return stringGenerations;
+}
+
+int GenerationsAutomaton::setDefaults()
+{
+    return setPreset(GENERATIONS_INITIAL_PRESET);
+}
+
+int GenerationsAutomaton::printMenu()
+{
+    printOptions();
+    printString(GEN_MENU_BACK_TO_MAIN_ROW,
+                GEN_MENU_BACK_TO_MAIN_COL,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+    printString(VIEW_HELP_ROW, VIEW_HELP_COL, stringViewHelp);
+
+    return 0;
+}
+
+int GenerationsAutomaton::printMenuArrow(int index, bool boolDelete)
+{
+    // The preset (0), the number of states (1) or back to main menu (2)
+    if (index == 0)
+    {
+        return printOptionArrow(GEN_MENU_PRESET_ROW,
+                                GEN_MENU_PRESET_ARROW_COL,
+                                boolDelete);
+    }
+    else if (index == 1)
+    {
+        return printOptionArrow(GEN_MENU_NUM_STATES_ROW,
+                                GEN_MENU_NUM_STATES_ARROW_COL,
+                                boolDelete);
+    }
+
+    return printOptionArrow(GEN_MENU_BACK_TO_MAIN_ROW,
+                            GEN_MENU_BACK_TO_MAIN_ARROW_COL,
+                            boolDelete);
+}
+
+/*
+ * LEFT and RIGHT change the option of the arrow and start the automata
+ * again with the new rule
+ */
+int GenerationsAutomaton::updateMenu(CellularAutomata& automata,
+                                     int keys_pressed,
+                                     int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 2) // Back to the main menu
+        {
+            showAutomataTypeMenu();
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(2);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(2);
+    }
+    else if (keys_pressed & (KEY_LEFT | KEY_RIGHT))
+    {
+        int delta = (keys_pressed & KEY_LEFT) ? -1 : 1;
+        bool changed = true;
+
+        if (arrow == 0) // Rule with a name
+        {
+            // A custom rule goes back to the first (or last) one
+            int next = preset + delta;
+
+            if (preset == GENERATIONS_PRESET_CUSTOM)
+            {
+                next = delta > 0 ? 0 : GENERATIONS_NUM_PRESETS - 1;
+            }
+            else if (next < 0)
+            {
+                next = GENERATIONS_NUM_PRESETS - 1;
+            }
+            else if (next >= GENERATIONS_NUM_PRESETS)
+            {
+                next = 0;
+            }
+
+            setPreset(next);
+        }
+        else if (arrow == 1) // Number of states
+        {
+            int numStates = rule.numStates + delta;
+
+            // The birth and the survival are kept
+            if (numStates >= GENERATIONS_MIN_STATES and
+                numStates <= GENERATIONS_MAX_STATES)
+            {
+                rule.numStates = numStates;
+                preset = GENERATIONS_PRESET_CUSTOM;
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else
+        {
+            changed = false;
+        }
+
+        if (changed == true)
+        {
+            printOptions();
+
+            automata.initialize();
+            printPopulation();
+            printNumSteps();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#ifndef GENERATIONSAUTOMATON_H
+#define GENERATIONSAUTOMATON_H
+
+#include <string>
+
+#include "automaton.h"
+#include "generations.h"
+#include "stateplanes.h"
+
+/*
+ * Generations: the game of life with dying states (see GenerationsRule).
+ * The cells are the states, shown with their own palette (see
+ * makeGenerationsPalette()). Its rule is one of the presets or a custom
+ * one changed in the menu.
+ */
+class GenerationsAutomaton : public GridAutomaton
+{
+    private:
+        int preset; // GENERATIONS_PRESET_BRIANS_BRAIN... or custom
+        GenerationsRule rule;
+
+        // The bit planes of the states (see GenerationsStencil)
+        StatePlanes statePlanes;
+
+        int setPreset(int newPreset);
+        int drawInitialState(CellularAutomata& automata);
+
+        int printPreset();
+        int printNumStates();
+        int printRule();
+        int printOptions();
+
+    public:
+        GenerationsAutomaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+        virtual int release();
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
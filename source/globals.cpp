@@ -13,3 +13,7 @@ int displayedMenu = MAIN_MENU;
 int displayedLanguage = EN;
 
 CellularAutomata ca;
+
+StepGovernor governor;
+
+PatternLibrary patternLibrary;
@@ -2,6 +2,8 @@
 #define GLOBALS_H
 
 #include "cellularautomata.h"
+#include "governor.h"
+#include "pattern.h"
 
 /*****************
  *   CONSTANTS   *
@@ -23,8 +25,10 @@
  * 10: Biham-Middleton-Levine traffic model
  * 11: Cyclic Cellular Automata
  * 12: Stepping stone
- * 13: Select colors
- * 14: Select language
+ * 13: Larger than Life
+ * 14: Generations
+ * 15: Select colors
+ * 16: Select language
  */
 #define INITIAL_LANGUAGE_MENU 0
 #define MAIN_MENU 1
@@ -39,8 +43,10 @@
 #define BML_TRAFFIC_MODEL 10
 #define CYCLIC_CELLULAR_AUTOMATA 11
 #define STEPPING_STONE 12
-#define SELECT_COLORS 13
-#define SELECT_LANGUAGE 14
+#define LARGER_THAN_LIFE 13
+#define GENERATIONS 14
+#define SELECT_COLORS 15
+#define SELECT_LANGUAGE 16
 
 /*
  * Constants to define the type of neighborhood
@@ -48,6 +54,22 @@
 #define VON_NEUMANN_NEIGHBORHOOD 0
 #define MOORE_NEIGHBORHOOD 1
 
+/*
+ * Palette indexes of the cells of the automata that run on the grid and are
+ * shown by the 8 bits per pixel framebuffer (see makeCellsPalette())
+ */
+#define CELL_BG 0
+#define CELL_FG 1
+#define CELL_FG2 2
+#define CELL_LINE 3
+#define CELL_NUM_COLORS 4
+
+/*
+ * Palette index of the background of the cyclic cellular automata (the
+ * states use the indexes 0 to CCA_MAX_NUM_STATES - 1)
+ */
+#define CCA_BG_INDEX CCA_MAX_NUM_STATES
+
 /*
  * Constants to define the language of the text of the user interfaze
  */
@@ -64,6 +86,7 @@
 #define FILL_SCREEN_WITH_PULSARS 2
 #define FILL_SCREEN_WITH_PENTADECATHLONS 3
 #define RIP_JOHN_CONWAY 4
+#define PATTERN_LIBRARY 5 // The pattern chosen in the library
 /*
  * Constants to define the different initial states of
  * the Elementary Cellular Automata
@@ -74,11 +97,31 @@
 /*
  * Constants to define the initial values of the Langton's ant
  */
-#define LA_INITIAL_X 127
-#define LA_INITIAL_Y 95
+#define LA_INITIAL_X 255
+#define LA_INITIAL_Y 127
 #define LA_INITIAL_ANGLE 90
 #define LA_INITIAL_NUM_PIXELS 4
 
+/*
+ * Size (in cells) of the universe of the Langton's ant, the wide page of
+ * the 8 bits per pixel framebuffer (one pixel per cell)
+ */
+#define LA_WIDTH 512
+#define LA_HEIGHT 256
+#define LA_MAX_NUM_PIXELS 16
+
+/*
+ * Size (in squares) of the munching squares and the initial zoom (pixels
+ * per square)
+ */
+#define MS_SIZE 64
+#define MS_ZOOM 3
+
+/*
+ * Pixels moved by the view each frame the D-pad is held (with Y)
+ */
+#define VIEW_PAN_STEP 2
+
 /*
  * Constant to define the initial value of the density
  * of the Biham-Middleton-Levine traffic model
@@ -91,6 +134,19 @@
  */
 #define CCA_INITIAL_NUM_STATES 3
 
+/*
+ * Constants for the options of the cyclic cellular automata.
+ * The initial values are the "313" rule (range 1, threshold 3,
+ * 3 states, Moore neighborhood), that forms spirals.
+ * (The maximum values are in cyclicautomata.h)
+ */
+#define CCA_MIN_NUM_STATES 3
+#define CCA_INITIAL_RANGE 1
+#define CCA_INITIAL_THRESHOLD 3
+#define CCA_INITIAL_DIMENSION 2
+#define CCA_1D_INITIAL_RANGE 1
+#define CCA_1D_INITIAL_THRESHOLD 1
+
 /*
  * Constants to define the column where each thing is printed
  */
@@ -99,6 +155,11 @@
 #define POPULATION_COLUMN 0
 #define NUM_STEPS_COLUMN 0
 #define RULE_NUMBER_COLUMN 0
+#define SEED_COLUMN 0
+#define SURVIVING_COLORS_COLUMN 0
+#define FIXATION_STEP_COLUMN 0
+#define BYTES_PRESENTED_COLUMN 0
+#define CYCLE_COLUMN 0
 
 // Initial language selection menu
 #define INITIAL_LANGUAGE_MENU_EN_COL 10
@@ -107,22 +168,8 @@
 #define INITIAL_LANGUAGE_MENU_ARROW_COL 8
 
 // Automata selection menu
-#define AUTOMATA_TYPE_MENU_ECA_COL 2
-#define AUTOMATA_TYPE_MENU_LA_COL 2
-#define AUTOMATA_TYPE_MENU_LHA_COL 2
-#define AUTOMATA_TYPE_MENU_BA_COL 2
-#define AUTOMATA_TYPE_MENU_BHA_COL 2
-#define AUTOMATA_TYPE_MENU_BTA_COL 2
-#define AUTOMATA_TYPE_MENU_CGL_COL 2
-#define AUTOMATA_TYPE_MENU_MS_COL 2
-#define AUTOMATA_TYPE_MENU_BML_COL 2
-#define AUTOMATA_TYPE_MENU_BML_ARROW_COL 0
-#define AUTOMATA_TYPE_MENU_CCA_COL 2
-#define AUTOMATA_TYPE_MENU_CCA_ARROW_COL 0
-#define AUTOMATA_TYPE_MENU_ST_COL 2
-#define AUTOMATA_TYPE_MENU_ST_ARROW_COL 0
-#define AUTOMATA_TYPE_MENU_SELECT_COLORS_COL 2
-#define AUTOMATA_TYPE_MENU_SELECT_LANGUAGE_COL 2
+#define AUTOMATA_TYPE_MENU_COL 2
+#define AUTOMATA_TYPE_MENU_ARROW_COL 0
 
 // Elementary Cellular Automata menu
 #define ECA_MENU_INITIAL_STATE_COL 2
@@ -153,15 +200,54 @@
 #define BML_MENU_BACK_TO_MAIN_ARROW_COL 0
 
 // Cyclic Cellular Automata
+#define CCA_MENU_DIMENSION_COL 2
+#define CCA_MENU_DIMENSION_ARROW_COL 0
 #define CCA_MENU_NUM_STATES_COL 2
 #define CCA_MENU_NUM_STATES_ARROW_COL 0
+#define CCA_MENU_RANGE_COL 2
+#define CCA_MENU_RANGE_ARROW_COL 0
+#define CCA_MENU_THRESHOLD_COL 2
+#define CCA_MENU_THRESHOLD_ARROW_COL 0
+#define CCA_MENU_NEIGHBORHOOD_COL 2
+#define CCA_MENU_NEIGHBORHOOD_ARROW_COL 0
+#define CCA_MENU_MODEL_COL 2
+#define CCA_MENU_MODEL_ARROW_COL 0
 #define CCA_MENU_BACK_TO_MAIN_COL 2
 #define CCA_MENU_BACK_TO_MAIN_ARROW_COL 0
 
 // Stepping stone
+#define ST_MENU_NEIGHBORHOOD_COL 3
+#define ST_MENU_NEIGHBORHOOD_ASTERISK_COL 2
+#define ST_MENU_NEIGHBORHOOD_ARROW_COL 0
 #define ST_MENU_BACK_TO_MAIN_COL 2
 #define ST_MENU_BACK_TO_MAIN_ARROW_COL 0
 
+// Larger than Life
+#define LTL_MENU_PRESET_COL 2
+#define LTL_MENU_PRESET_ARROW_COL 0
+#define LTL_MENU_RANGE_COL 2
+#define LTL_MENU_RANGE_ARROW_COL 0
+#define LTL_MENU_BIRTH_MIN_COL 2
+#define LTL_MENU_BIRTH_MIN_ARROW_COL 0
+#define LTL_MENU_BIRTH_MAX_COL 2
+#define LTL_MENU_BIRTH_MAX_ARROW_COL 0
+#define LTL_MENU_SURVIVAL_MIN_COL 2
+#define LTL_MENU_SURVIVAL_MIN_ARROW_COL 0
+#define LTL_MENU_SURVIVAL_MAX_COL 2
+#define LTL_MENU_SURVIVAL_MAX_ARROW_COL 0
+#define LTL_MENU_RULE_COL 2
+#define LTL_MENU_BACK_TO_MAIN_COL 2
+#define LTL_MENU_BACK_TO_MAIN_ARROW_COL 0
+
+// Generations
+#define GEN_MENU_PRESET_COL 2
+#define GEN_MENU_PRESET_ARROW_COL 0
+#define GEN_MENU_NUM_STATES_COL 2
+#define GEN_MENU_NUM_STATES_ARROW_COL 0
+#define GEN_MENU_RULE_COL 2
+#define GEN_MENU_BACK_TO_MAIN_COL 2
+#define GEN_MENU_BACK_TO_MAIN_ARROW_COL 0
+
 // Color selection
 #define CS_MENU_MAIN_COL 2
 #define CS_MENU_PARTIAL_COLOR_COL 5
@@ -174,6 +260,11 @@
 #define POPULATION_ROW 10
 #define NUM_STEPS_ROW 9
 #define RULE_NUMBER_ROW 9
+#define SEED_ROW 11
+#define SURVIVING_COLORS_ROW 10
+#define FIXATION_STEP_ROW 12
+#define BYTES_PRESENTED_ROW 12
+#define CYCLE_ROW 8
 
 // Initial language selection menu
 #define INITIAL_LANGUAGE_MENU_EN_ROW 13
@@ -183,20 +274,9 @@
 #define INITIAL_LANGUAGE_MENU_EU_ROW 15
 #define INITIAL_LANGUAGE_MENU_EU_ARROW_ROW 15
 
-// Automata selection menu
-#define AUTOMATA_TYPE_MENU_ECA_ROW 8
-#define AUTOMATA_TYPE_MENU_LA_ROW 9
-#define AUTOMATA_TYPE_MENU_LHA_ROW 10
-#define AUTOMATA_TYPE_MENU_BA_ROW 11
-#define AUTOMATA_TYPE_MENU_BHA_ROW 12
-#define AUTOMATA_TYPE_MENU_BTA_ROW 13
-#define AUTOMATA_TYPE_MENU_CGL_ROW 14
-#define AUTOMATA_TYPE_MENU_MS_ROW 15
-#define AUTOMATA_TYPE_MENU_BML_ROW 16
-#define AUTOMATA_TYPE_MENU_CCA_ROW 17
-#define AUTOMATA_TYPE_MENU_ST_ROW 18
-#define AUTOMATA_TYPE_MENU_SELECT_COLORS_ROW 19
-#define AUTOMATA_TYPE_MENU_SELECT_LANGUAGE_ROW 20
+// Automata selection menu (one row per type of automata, in the order of
+// the types: ELEMENTARY_CELLULAR_AUTOMATA in the first row...)
+#define AUTOMATA_TYPE_MENU_FIRST_ROW 8
 
 // Elementary Cellular Automata menu
 #define ECA_MENU_INITIAL_STATE_ROW 12
@@ -240,22 +320,56 @@
 #define CGL_MENU_FILL_SCREEN_WITH_PULSARS_ROW 16
 #define CGL_MENU_FILL_SCREEN_WITH_PENTADECATHLONS_ROW 17
 #define CGL_MENU_RIP_JOHN_CONWAY_ROW 18
+#define CGL_MENU_PATTERN_LIBRARY_ROW 19
 #define CGL_MENU_BACK_TO_MAIN_ROW 20
 
 // Munching squares
 #define MS_MENU_BACK_TO_MAIN_ROW 13
 
+// Help of the zoom and the pan of the view
+#define VIEW_HELP_ROW 22
+#define VIEW_HELP_COL 0
+
+// Speed of the automata (see StepGovernor) and its help
+#define SPEED_ROW 21
+#define SPEED_COL 0
+#define SPEED_HELP_ROW 23
+#define SPEED_HELP_COL 0
+
 // BML traffic model
 #define BML_MENU_RESTART_ROW 13
 #define BML_MENU_DENSITY_ROW 14
 #define BML_MENU_BACK_TO_MAIN_ROW 15
 
 // Cyclic Cellular Automata
-#define CCA_MENU_NUM_STATES_ROW  13
-#define CCA_MENU_BACK_TO_MAIN_ROW 14
+#define CCA_MENU_DIMENSION_ROW 13
+#define CCA_MENU_NUM_STATES_ROW 14
+#define CCA_MENU_RANGE_ROW 15
+#define CCA_MENU_THRESHOLD_ROW 16
+#define CCA_MENU_NEIGHBORHOOD_ROW 17
+#define CCA_MENU_MODEL_ROW 18
+#define CCA_MENU_BACK_TO_MAIN_ROW 20
 
 // Stepping stone
-#define ST_MENU_BACK_TO_MAIN_ROW 13
+#define ST_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW 13
+#define ST_MENU_MOORE_NEIGHBORHOOD_ROW 14
+#define ST_MENU_BACK_TO_MAIN_ROW 16
+
+// Larger than Life (the rule row shows the whole rule, it isn't an option)
+#define LTL_MENU_PRESET_ROW 13
+#define LTL_MENU_RANGE_ROW 14
+#define LTL_MENU_BIRTH_MIN_ROW 15
+#define LTL_MENU_BIRTH_MAX_ROW 16
+#define LTL_MENU_SURVIVAL_MIN_ROW 17
+#define LTL_MENU_SURVIVAL_MAX_ROW 18
+#define LTL_MENU_RULE_ROW 19
+#define LTL_MENU_BACK_TO_MAIN_ROW 20
+
+// Generations (the rule row shows the whole rule, it isn't an option)
+#define GEN_MENU_PRESET_ROW 13
+#define GEN_MENU_NUM_STATES_ROW 14
+#define GEN_MENU_RULE_ROW 15
+#define GEN_MENU_BACK_TO_MAIN_ROW 17
 
 // Color selection
 #define CS_MENU_BG_COLOR_ROW 2
@@ -294,6 +408,13 @@ extern int displayedMenu;
 
 extern CellularAutomata ca;
 
+extern StepGovernor governor;
+
+/*
+ * The patterns of the game of life read from files (see main())
+ */
+extern PatternLibrary patternLibrary;
+
 extern int displayedLanguage;
 
 #endif
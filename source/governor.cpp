@@ -0,0 +1,300 @@
+#include <nds.h>
+#include "governor.h"
+#include "globals.h"
+
+/*
+ * Ticks of the hardware timer in a frame (BUS_CLOCK ticks per second) and
+ * the part of the frame that the steps can use. The rest is for the menus
+ * and the rendered step.
+ */
+#define GOVERNOR_FRAME_TICKS (BUS_CLOCK / 60)
+#define GOVERNOR_BUDGET_TICKS (GOVERNOR_FRAME_TICKS * 3 / 4)
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Returns the ticks of the hardware timer (timers 0 and 1 cascaded, started
+ * by the first call). They wrap around after about two minutes, so only the
+ * differences are used.
+ */
+unsigned int StepGovernor::getTicks()
+{
+    if (timerStarted == false)
+    {
+        cpuStartTiming(0);
+        timerStarted = true;
+    }
+
+    return cpuGetTiming();
+}
+
+/*
+ * Adds the steps to the count of this second, and updates the steps per
+ * second when it ends
+ */
+int StepGovernor::countSteps(int steps)
+{
+    unsigned int elapsed = getTicks() - secondStart;
+
+    stepsThisSecond = stepsThisSecond + steps;
+
+    if (elapsed >= BUS_CLOCK)
+    {
+        stepsPerSecond = (int) (((unsigned long long) stepsThisSecond *
+                                 BUS_CLOCK) / elapsed);
+        stepsThisSecond = 0;
+        secondStart = secondStart + elapsed;
+    }
+
+    return 0;
+}
+
+/*
+ * Runs the steps of this frame a few rows at a time, for the automata with
+ * a resumable step (see CellularAutomata::stepRows()). The rows of each
+ * slice are the ones that fit in what's left of the budget, so a generation
+ * that doesn't fit in a frame goes on in the next ones and the main loop
+ * keeps reading the keys. Returns the number of generations finished.
+ */
+int StepGovernor::runSlices(CellularAutomata& automata, int maxSteps)
+{
+    int steps = 0;
+    bool sliced = false; // At least a slice was calculated in this frame
+
+    unsigned int start = getTicks();
+
+    while (steps < maxSteps)
+    {
+        int rowsLeft = automata.getStepRowsLeft();
+        unsigned int elapsed = getTicks() - start;
+        int rows = rowsLeft;
+
+        // Until a row is measured the first slice is a whole generation
+        if (rowTicks != 0)
+        {
+            rows = elapsed < GOVERNOR_BUDGET_TICKS ?
+                   (GOVERNOR_BUDGET_TICKS - elapsed) / rowTicks : 0;
+        }
+
+        if (rows < 1)
+        {
+            if (sliced == true)
+            {
+                break;
+            }
+
+            // Each frame calculates at least a row
+            rows = 1;
+        }
+
+        if (rows > rowsLeft)
+        {
+            rows = rowsLeft;
+        }
+
+        // Render the generation if this slice finishes it and there's no
+        // time (or permission) for another one after it
+        bool last = rows == rowsLeft and
+                    (steps + 1 == maxSteps or
+                     elapsed + (rows + SCREEN_HEIGHT) * rowTicks >
+                     GOVERNOR_BUDGET_TICKS);
+
+        // The last row of a rendered slice is calculated on its own, so the
+        // rest can be measured without the time of the rendering (that can
+        // wait for the VBlank)
+        int measuredRows = last == true ? rows - 1 : rows;
+
+        if (measuredRows > 0)
+        {
+            unsigned int sliceStart = getTicks();
+
+            automata.stepRows(measuredRows, false);
+
+            unsigned int ticks = (getTicks() - sliceStart) / measuredRows;
+
+            rowTicks = rowTicks == 0 ? ticks : (rowTicks * 7 + ticks) / 8;
+        }
+
+        if (last == true)
+        {
+            automata.stepRows(1, true);
+        }
+
+        sliced = true;
+
+        if (rows == rowsLeft)
+        {
+            ++steps;
+        }
+
+        if (last == true)
+        {
+            break;
+        }
+    }
+
+    return steps;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+StepGovernor::StepGovernor()
+{
+    speed = GOVERNOR_SPEED_1X;
+    paused = false;
+    singleStep = false;
+
+    timerStarted = false;
+    stepTicks = 0;
+    rowTicks = 0;
+
+    secondStart = 0;
+    stepsThisSecond = 0;
+    stepsPerSecond = 0;
+}
+
+/*
+ * Runs the steps of this frame and renders the last one. Returns the
+ * number of steps. When there's nothing to do (paused or finished) it waits
+ * for the VBlank and returns 0, so the caller doesn't wait again.
+ */
+int StepGovernor::runFrame(CellularAutomata& automata)
+{
+    int maxSteps = getMaxStepsPerFrame();
+    int steps = 0;
+
+    if (paused == true)
+    {
+        // Nothing to do until the next frame (a generation started by a
+        // single step, or before pausing, is finished first)
+        if (singleStep == false and automata.isStepInProgress() == false)
+        {
+            countSteps(0);
+            swiWaitForVBlank();
+            return 0;
+        }
+
+        maxSteps = 1;
+        singleStep = false;
+    }
+
+    // The ants at the border of their universe and the automata stopped
+    // by a cycle don't step anymore
+    if (automata.hasFinished() == true)
+    {
+        countSteps(0);
+        swiWaitForVBlank();
+        return 0;
+    }
+
+    if (automata.hasResumableStep() == true)
+    {
+        steps = runSlices(automata, maxSteps);
+        countSteps(steps);
+
+        return steps;
+    }
+
+    unsigned int start = getTicks();
+
+    while (steps < maxSteps)
+    {
+        // The step before may have finished the automata
+        if (automata.hasFinished() == true)
+        {
+            break;
+        }
+
+        // Render this step if there's no time (or permission) for another
+        // one after it
+        bool last = steps + 1 == maxSteps or
+                    getTicks() - start + 2 * stepTicks > GOVERNOR_BUDGET_TICKS;
+
+        unsigned int stepStart = getTicks();
+
+        automata.nextStep(last);
+        ++steps;
+
+        if (last == true)
+        {
+            break;
+        }
+
+        // The rendered step isn't measured: it can wait for the VBlank
+        unsigned int ticks = getTicks() - stepStart;
+
+        stepTicks = stepTicks == 0 ? ticks : (stepTicks * 7 + ticks) / 8;
+    }
+
+    countSteps(steps);
+
+    return steps;
+}
+
+int StepGovernor::setSpeed(int newSpeed)
+{
+    speed = newSpeed;
+
+    return 0;
+}
+
+int StepGovernor::getSpeed()
+{
+    return speed;
+}
+
+/*
+ * Changes to the next speed (1x -> 4x -> max -> 1x ...)
+ */
+int StepGovernor::nextSpeed()
+{
+    speed = (speed + 1) % GOVERNOR_NUM_SPEEDS;
+
+    return 0;
+}
+
+int StepGovernor::getMaxStepsPerFrame()
+{
+    if (speed == GOVERNOR_SPEED_1X)
+    {
+        return 1;
+    }
+    else if (speed == GOVERNOR_SPEED_4X)
+    {
+        return 4;
+    }
+
+    return GOVERNOR_MAX_STEPS_PER_FRAME;
+}
+
+int StepGovernor::togglePause()
+{
+    paused = not paused;
+    singleStep = false;
+
+    return 0;
+}
+
+bool StepGovernor::isPaused()
+{
+    return paused;
+}
+
+/*
+ * While paused, the next frame runs (and renders) one step
+ */
+int StepGovernor::requestSingleStep()
+{
+    if (paused == true)
+    {
+        singleStep = true;
+    }
+
+    return 0;
+}
+
+int StepGovernor::getStepsPerSecond()
+{
+    return stepsPerSecond;
+}
@@ -0,0 +1,71 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include "cellularautomata.h"
+
+/*
+ * Speeds of the governor: the maximum number of steps per frame
+ */
+#define GOVERNOR_SPEED_1X 0
+#define GOVERNOR_SPEED_4X 1
+#define GOVERNOR_SPEED_MAX 2
+#define GOVERNOR_NUM_SPEEDS 3
+
+/*
+ * Steps per frame of the maximum speed. The time budget stops the steps
+ * much earlier except for the cheapest automata.
+ */
+#define GOVERNOR_MAX_STEPS_PER_FRAME 4096
+
+/*
+ * Decides how many steps of the automata run in each frame.
+ *
+ * Each step is timed with a hardware timer (cpuStartTiming()) and the
+ * steps go on while the next one fits in the time budget of the frame,
+ * up to the limit of the speed (1x, 4x or max). Only the last step of the
+ * frame is rendered (see CellularAutomata::nextStep()), the others just
+ * compute the next generation.
+ *
+ * The automata with a resumable step (see CellularAutomata::stepRows())
+ * run in slices of rows instead of whole steps, so a generation that takes
+ * longer than a frame is spread over several frames.
+ *
+ * The automata can be paused, and run step by step while paused.
+ */
+class StepGovernor
+{
+    private:
+        int speed;
+        bool paused;
+        bool singleStep; // A step was requested while paused
+
+        bool timerStarted;
+        unsigned int stepTicks; // Moving average of the ticks of a step
+        unsigned int rowTicks;  // Same for a row of a resumable step
+
+        unsigned int secondStart; // Ticks when the count of steps started
+        int stepsThisSecond;
+        int stepsPerSecond;
+
+        unsigned int getTicks();
+        int countSteps(int steps);
+        int runSlices(CellularAutomata& automata, int maxSteps);
+
+    public:
+        StepGovernor();
+
+        int runFrame(CellularAutomata& automata);
+
+        int setSpeed(int newSpeed);
+        int getSpeed();
+        int nextSpeed();
+        int getMaxStepsPerFrame();
+
+        int togglePause();
+        bool isPaused();
+        int requestSingleStep();
+
+        int getStepsPerSecond();
+};
+
+#endif
@@ -0,0 +1,509 @@
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARM9
+#include <nds.h>
+#endif
+
+#include "grid.h"
+#include "cycles.h"
+
+/*
+ * Rows of the window. On the DS they're in DTCM. On the host each thread
+ * has its own (the soup search runs grids in several threads, see soup.h),
+ * so a grid must be used by the thread that created it.
+ */
+#ifdef ARM9
+static unsigned char windowRows[3][GRID_MAX_WIDTH] DTCM_BSS;
+#else
+static __thread unsigned char windowRows[3][GRID_MAX_WIDTH];
+#endif
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Frees the memory used by the cells
+ */
+int Grid::freeBuffers()
+{
+    delete[] cells;
+    delete[] newCells;
+    delete[] snapshot;
+
+    cells = NULL;
+    newCells = NULL;
+    snapshot = NULL;
+
+    for (int i = 0; i < GRID_NUM_PAGES; ++i)
+    {
+        delete[] dirtyFirst[i];
+        delete[] dirtyLast[i];
+
+        dirtyFirst[i] = NULL;
+        dirtyLast[i] = NULL;
+    }
+
+    return 0;
+}
+
+/*
+ * Copies the row (wrapped around) of the current generation to the row
+ * index of the window
+ */
+int Grid::copyRowToWindow(int row, int index)
+{
+    row = ((row % height) + height) % height;
+
+    memcpy(window[index], cells + row * width, width);
+
+    return 0;
+}
+
+/*
+ * Marks all the rows of the step index (0 to GRID_NUM_PAGES - 1) as
+ * unchanged
+ */
+int Grid::clearDirty(int index)
+{
+    for (int row = 0; row < height; ++row)
+    {
+        dirtyFirst[index][row] = width;
+        dirtyLast[index][row] = -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Copies length bytes of the current generation, starting at offset, to the
+ * framebuffer
+ */
+int Grid::copySpan(unsigned char* framebuffer, int offset, int length)
+{
+#ifdef ARM9
+    DC_FlushRange(cells + offset, length);
+    dmaCopy(cells + offset, framebuffer + offset, length);
+#else
+    memcpy(framebuffer + offset, cells + offset, length);
+#endif
+
+    bytesPresented = bytesPresented + length;
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+Grid::Grid()
+{
+    width = 0;
+    height = 0;
+
+    cells = NULL;
+    newCells = NULL;
+    snapshot = NULL;
+
+    window[0] = windowRows[0];
+    window[1] = windowRows[1];
+    window[2] = windowRows[2];
+    windowRow = -1;
+
+    for (int i = 0; i < GRID_NUM_PAGES; ++i)
+    {
+        dirtyFirst[i] = NULL;
+        dirtyLast[i] = NULL;
+    }
+
+    dirtyCurrent = 0;
+
+    bytesPresented = 0;
+
+    hash = 0;
+    hashChange = 0;
+    snapshotHash = 0;
+}
+
+// Class destructor
+Grid::~Grid()
+{
+    freeBuffers();
+}
+
+/*
+ * Sets the size of the grid (in cells) and allocates the memory for it.
+ * The width can't be bigger than GRID_MAX_WIDTH.
+ */
+int Grid::setSize(int w, int h)
+{
+    if (w > GRID_MAX_WIDTH)
+    {
+        w = GRID_MAX_WIDTH;
+    }
+
+    if (w == width and h == height and cells != NULL)
+    {
+        return 0;
+    }
+
+    freeBuffers();
+
+    width = w;
+    height = h;
+
+    cells = new unsigned char[w * h];
+    newCells = new unsigned char[w * h];
+
+    for (int i = 0; i < GRID_NUM_PAGES; ++i)
+    {
+        dirtyFirst[i] = new int[h];
+        dirtyLast[i] = new int[h];
+    }
+
+    windowRow = -1;
+
+    markAllDirty();
+
+    return 0;
+}
+
+/*
+ * Frees the memory of the cells while another automata runs. setSize()
+ * allocates it again.
+ */
+int Grid::release()
+{
+    freeBuffers();
+
+    width = 0;
+    height = 0;
+    windowRow = -1;
+
+    return 0;
+}
+
+int Grid::getWidth()
+{
+    return width;
+}
+
+int Grid::getHeight()
+{
+    return height;
+}
+
+/*
+ * Returns the cells of the current generation (row by row)
+ */
+unsigned char* Grid::getCells()
+{
+    return cells;
+}
+
+/*
+ * Returns the cells of the next generation (row by row)
+ */
+unsigned char* Grid::getNewCells()
+{
+    return newCells;
+}
+
+/*
+ * Fills the current generation with the cell, before writing the initial
+ * state straight into it (see loadCells())
+ */
+int Grid::clear(Cell cell)
+{
+    memset(cells, cell, width * height);
+
+    return 0;
+}
+
+/*
+ * Finishes loading the initial state written straight into the cells of
+ * the current generation (see getCells(), for example by a PatternReader)
+ */
+int Grid::loadCells()
+{
+    windowRow = -1;
+
+    hash = GenerationHash::hashCells(cells, width, height);
+    hashChange = 0;
+
+    // All the pages of the framebuffer need the whole new state
+    markAllDirty();
+
+    return 0;
+}
+
+/*
+ * Copies the current generation to the next one, for the automata that
+ * only write the cells that change
+ */
+int Grid::copyCellsToNew()
+{
+    memcpy(newCells, cells, width * height);
+
+    return 0;
+}
+
+/*
+ * The next generation becomes the current one
+ */
+int Grid::swap()
+{
+    unsigned char* temp = cells;
+    cells = newCells;
+    newCells = temp;
+
+    windowRow = -1;
+
+    hash = hash + hashChange;
+    hashChange = 0;
+
+    return 0;
+}
+
+/*
+ * Saves a copy of the current generation (the memory is allocated the first
+ * time, and freed when the size changes)
+ */
+int Grid::saveSnapshot()
+{
+    if (snapshot == NULL)
+    {
+        snapshot = new unsigned char[width * height];
+    }
+
+    memcpy(snapshot, cells, width * height);
+    snapshotHash = hash;
+
+    return 0;
+}
+
+/*
+ * The generation saved by saveSnapshot() becomes the current one. All the
+ * pages of the framebuffer need it, so they're marked as changed.
+ */
+int Grid::restoreSnapshot()
+{
+    if (snapshot == NULL)
+    {
+        return 0;
+    }
+
+    memcpy(cells, snapshot, width * height);
+
+    windowRow = -1;
+
+    hash = snapshotHash;
+    hashChange = 0;
+
+    markAllDirty();
+
+    return 0;
+}
+
+/*
+ * Returns true if a generation was saved with saveSnapshot()
+ */
+bool Grid::hasSnapshot()
+{
+    return snapshot != NULL;
+}
+
+/*
+ * Returns the hash of the current generation (see GenerationHash)
+ */
+uint64_t Grid::getHash()
+{
+    return hash;
+}
+
+/*
+ * Adds the change of the hash of the cells written in the next generation
+ * (see GenerationHash::rowChange()), applied by swap()
+ */
+int Grid::addHashChange(uint64_t change)
+{
+    hashChange = hashChange + change;
+
+    return 0;
+}
+
+/*
+ * Copies the cells changed in the last GRID_NUM_PAGES steps (see
+ * markDirty()) from the current generation to the 8 bits per pixel
+ * framebuffer. The spans are
+ * widened to whole words for the DMA, and spans that are contiguous in
+ * memory (whole rows) are copied together.
+ * On the DS the cache is flushed first, because the DMA reads main RAM
+ * directly.
+ */
+int Grid::present(unsigned char* framebuffer)
+{
+    int pendingOffset = 0;
+    int pendingLength = 0;
+
+    bytesPresented = 0;
+
+    for (int row = 0; row < height; ++row)
+    {
+        int first = width;
+        int last = -1;
+
+        for (int i = 0; i < GRID_NUM_PAGES; ++i)
+        {
+            if (dirtyFirst[i][row] < first)
+            {
+                first = dirtyFirst[i][row];
+            }
+
+            if (dirtyLast[i][row] > last)
+            {
+                last = dirtyLast[i][row];
+            }
+        }
+
+        if (first > last)
+        {
+            continue;
+        }
+
+        first = first & ~3;
+        last = last | 3;
+
+        if (last >= width)
+        {
+            last = width - 1;
+        }
+
+        int offset = row * width + first;
+        int length = last - first + 1;
+
+        if (pendingLength != 0 and pendingOffset + pendingLength == offset)
+        {
+            pendingLength = pendingLength + length;
+        }
+        else
+        {
+            if (pendingLength != 0)
+            {
+                copySpan(framebuffer, pendingOffset, pendingLength);
+            }
+
+            pendingOffset = offset;
+            pendingLength = length;
+        }
+    }
+
+    if (pendingLength != 0)
+    {
+        copySpan(framebuffer, pendingOffset, pendingLength);
+    }
+
+    // The changes of this step are previous ones for the next steps, the
+    // oldest ones are forgotten
+    dirtyCurrent = (dirtyCurrent + 1) % GRID_NUM_PAGES;
+    clearDirty(dirtyCurrent);
+
+    return 0;
+}
+
+/*
+ * Marks the cells of the rectangle (clipped to the grid) as changed in the
+ * current step
+ */
+int Grid::markDirty(int column, int row, int w, int h)
+{
+    int lastColumn = column + w - 1;
+
+    if (column < 0)
+    {
+        column = 0;
+    }
+
+    if (lastColumn >= width)
+    {
+        lastColumn = width - 1;
+    }
+
+    for (int i = row < 0 ? 0 : row; i < row + h and i < height; ++i)
+    {
+        if (column < dirtyFirst[dirtyCurrent][i])
+        {
+            dirtyFirst[dirtyCurrent][i] = column;
+        }
+
+        if (lastColumn > dirtyLast[dirtyCurrent][i])
+        {
+            dirtyLast[dirtyCurrent][i] = lastColumn;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Marks all the cells as changed in the current and the previous steps, so
+ * the next GRID_NUM_PAGES calls to present() copy the whole grid (one for
+ * each page)
+ */
+int Grid::markAllDirty()
+{
+    for (int i = 0; i < GRID_NUM_PAGES; ++i)
+    {
+        for (int row = 0; row < height; ++row)
+        {
+            dirtyFirst[i][row] = 0;
+            dirtyLast[i][row] = width - 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Returns the number of bytes copied to the framebuffer by the last call to
+ * present()
+ */
+int Grid::getBytesPresented()
+{
+    return bytesPresented;
+}
+
+/*
+ * Loads the rows row - 1, row and row + 1 of the current generation in the
+ * window (the rows wrap around). If the previous call was for the row
+ * above only the new bottom row is copied.
+ */
+int Grid::loadWindow(int row)
+{
+    if (row == windowRow + 1 and windowRow != -1)
+    {
+        unsigned char* temp = window[0];
+        window[0] = window[1];
+        window[1] = window[2];
+        window[2] = temp;
+
+        copyRowToWindow(row + 1, 2);
+    }
+    else if (row != windowRow)
+    {
+        copyRowToWindow(row - 1, 0);
+        copyRowToWindow(row, 1);
+        copyRowToWindow(row + 1, 2);
+    }
+
+    windowRow = row;
+
+    return 0;
+}
+
+/*
+ * Returns the row of the window at offset (-1, 0 or 1) from the loaded row
+ */
+const unsigned char* Grid::getWindowRow(int offset)
+{
+    return window[offset + 1];
+}
@@ -0,0 +1,121 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <stdint.h>
+
+/*
+ * Maximum width (in cells) of a grid. It's the size of the rows of the
+ * window (see loadWindow()).
+ */
+#define GRID_MAX_WIDTH 256
+
+/*
+ * Number of pages of the framebuffer written in turn by present() (see
+ * FramePipeline)
+ */
+#define GRID_NUM_PAGES 3
+
+/*
+ * The cells of a two dimensional automata, stored in main RAM.
+ *
+ * Each cell is a palette index (see the CELL_* constants of globals.h), so
+ * the automata compare integers instead of colors and the frame can be
+ * shown by an 8 bits per pixel background without any conversion.
+ *
+ * On the DS the framebuffers are in VRAM, that isn't cached, so reading
+ * the neighbors of each cell from them is slow. The automata read and
+ * write the cells of the grid instead (cells: current generation,
+ * newCells: next generation) and only the final frame is copied to VRAM
+ * with present().
+ *
+ * The window keeps copies of three consecutive rows (the row of the cells
+ * being calculated and the rows above and below it) in DTCM, the fastest
+ * memory of the ARM9, so the kernels that read the eight neighbors of each
+ * cell don't depend on the cache.
+ *
+ * The automata mark the cells they change with markDirty() and present()
+ * only copies the changed part of each row. The GRID_NUM_PAGES pages of the
+ * framebuffer are written one step after the other, so the page written by
+ * present() holds the generation of GRID_NUM_PAGES steps ago: the spans of
+ * the last GRID_NUM_PAGES steps are copied.
+ *
+ * A copy of the initial state can be kept with saveSnapshot(), so the
+ * automata that start again when they stop changing only copy it back
+ * (restoreSnapshot()) instead of drawing it again.
+ *
+ * The grid keeps the hash of the current generation (see GenerationHash in
+ * cycles.h), to find the cycles of the automata. The kernels add the
+ * change of the hash of the next generation with addHashChange() and
+ * swap() applies it.
+ *
+ * On the host computer present() is a plain copy, so the same code can be
+ * used in headless runs.
+ */
+class Grid
+{
+    private:
+        int width;
+        int height;
+
+        unsigned char* cells;    // Current generation
+        unsigned char* newCells; // Next generation
+        unsigned char* snapshot; // Saved generation (see saveSnapshot())
+
+        unsigned char* window[3]; // Rows windowRow - 1, windowRow and
+                                  // windowRow + 1
+        int windowRow;
+
+        // First and last column of the cells changed in each row in the
+        // current step (dirtyCurrent) and in the previous ones. Rows
+        // without changes have first > last.
+        int* dirtyFirst[GRID_NUM_PAGES];
+        int* dirtyLast[GRID_NUM_PAGES];
+        int dirtyCurrent;
+
+        int bytesPresented; // Bytes copied by the last present()
+
+        uint64_t hash;         // Of the current generation
+        uint64_t hashChange;   // Of the next generation (see swap())
+        uint64_t snapshotHash; // Of the saved generation
+
+        int freeBuffers();
+        int copyRowToWindow(int row, int index);
+        int clearDirty(int index);
+        int copySpan(unsigned char* framebuffer, int offset, int length);
+
+    public:
+        typedef unsigned char Cell; // A palette index
+
+        Grid();
+        ~Grid();
+
+        int setSize(int w, int h);
+        int release();
+        int getWidth();
+        int getHeight();
+
+        unsigned char* getCells();
+        unsigned char* getNewCells();
+
+        int clear(Cell cell);
+        int loadCells();
+        int copyCellsToNew();
+        int swap();
+        int present(unsigned char* framebuffer);
+
+        int saveSnapshot();
+        int restoreSnapshot();
+        bool hasSnapshot();
+
+        uint64_t getHash();
+        int addHashChange(uint64_t change);
+
+        int markDirty(int column, int row, int w, int h);
+        int markAllDirty();
+        int getBytesPresented();
+
+        int loadWindow(int row);
+        const unsigned char* getWindowRow(int offset);
+};
+
+#endif
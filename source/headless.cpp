@@ -0,0 +1,1714 @@
+/*
+ * Headless runs on the host computer.
+ *
+ * This file isn't part of the DS build (ARM9 is defined by the Makefile).
+ * It's used to replay runs with a given seed and to benchmark the parts of
+ * the simulator that don't depend on libnds. Build it with the host compiler:
+ *
+ *     g++ -O2 -pthread -o headless source/headless.cpp \
+ *         source/random_numbers.cpp source/steppingstone.cpp \
+ *         source/cyclicautomata.cpp source/pipeline.cpp source/cycles.cpp \
+ *         source/pattern.cpp source/grid.cpp source/soup.cpp \
+ *         source/summedarea.cpp source/largerthanlife.cpp \
+ *         source/stateplanes.cpp source/generations.cpp \
+ *         source/chunkeduniverse.cpp source/predecessor.cpp \
+ *         source/fills.cpp
+ *
+ * Usage:
+ *
+ *     headless [--automaton random|stepping-stone|cyclic|pipeline|
+ *                           pattern|library|soup|larger-than-life|
+ *                           generations|unbounded-life|
+ *                           predecessor|fills]
+ *              [--seed <seed>]
+ *              [--stream <stream>] [--count <count>] [--steps <steps>]
+ *              [--neighborhood von-neumann|moore] [--until-fixation]
+ *              [--width <width>] [--height <height>]
+ *              [--states <states>] [--range <range>]
+ *              [--threshold <threshold>]
+ *              [--model cyclic|greenberg-hastings] [--dimension 1|2]
+ *              [--step-us <microseconds>] [--jitter-us <microseconds>]
+ *              [--slice-rows <rows>] [--until-cycle]
+ *              [--max-period <period>] [--pattern <path>]
+ *              [--soups <soups>] [--threads <threads>]
+ *              [--census <path>] [--objects <path>]
+ *              [--rule <rule>] [--margin <cells>] [--parents <path>]
+ *
+ * random: prints the first <count> random numbers of the stream, so two
+ *         runs with the same seed and stream can be compared bit by bit.
+ * stepping-stone: runs <steps> steps of the stepping stone (by default on a
+ *                 grid of the size of the screen) and prints a checksum of
+ *                 the cells, the number of colors left and the time per
+ *                 step. With --until-fixation it stops as soon as only one
+ *                 color is left (<steps> is then the maximum) and prints
+ *                 the time to fixation.
+ * cyclic: runs <steps> steps of the cyclic cellular automata (two
+ *         dimensional by default, one dimensional with --dimension 1) and
+ *         prints a checksum of the cells and the time per step. The two
+ *         dimensional one also prints the first cycle found (its period, up
+ *         to <period>, and the steps before it). With --until-cycle it
+ *         stops there (<steps> is then the maximum).
+ * With --slice-rows the stepping stone and the two dimensional cyclic
+ * cellular automata calculate each generation <rows> rows at a time (as
+ * the DS does when a generation doesn't fit in a frame). The checksums must
+ * be the same as without it.
+ * pipeline: runs <steps> generations through the triple buffering of the
+ *           DS (see pipeline.h) with a simulated VBlank clock. Each
+ *           generation takes <step-us> microseconds plus a random part of
+ *           up to <jitter-us>. It checks that no buffer is written while
+ *           it's displayed or waiting, and that the generations are shown
+ *           in order without gaps, and prints the frames per generation.
+ * pattern: decodes the pattern file <path> (RLE, plaintext or Life 1.06)
+ *          in the center of the grid and prints its name, format, size,
+ *          population and a checksum of the cells.
+ * library: reads the index of the pattern files of the folder <path> (see
+ *          PatternLibrary) and prints it.
+ * soup: runs <soups> random soups of the game of life (see SoupSearch) in
+ *       <threads> threads and prints the most common objects they leave.
+ *       The census is the same for any number of threads. With --census it
+ *       writes the census file, and with --objects a RLE file of each object
+ *       in the folder <path> (to copy them to the pattern library of the
+ *       DS).
+ * larger-than-life: runs <steps> steps of Larger than Life (see
+ *                   largerthanlife.h) from a random grid and prints a
+ *                   checksum of the cells, the population, the first cycle
+ *                   found and the time per step. <rule> is the name of a
+ *                   rule (bosco, majority, waffle, globe or life) or a rule
+ *                   like R5,C0,M1,S34..58,B34..45,NM. With --until-cycle it
+ *                   stops at the first cycle.
+ * generations: the same for Generations (see generations.h). <rule> is the
+ *              name of a rule ("Brian's Brain", "Star Wars", frogs, sticks
+ *              or banners) or a rule like 345/2/4.
+ * unbounded-life: runs <steps> generations of the game of life on an
+ *                 unbounded universe (see ChunkedUniverse) from the pattern
+ *                 file <path> (centered on <width> x <height> cells, but
+ *                 not clipped), or from a random soup of <width> x
+ *                 <height> cells, and prints the population, the chunks, the memory
+ *                 they take and the bounds of the live cells, and the time
+ *                 per step.
+ * fills: draws <steps> random spans, rectangles and pattern blits with the
+ *        fills of the framebuffers (see fills.h) and checks them against
+ *        the same shapes drawn pixel by pixel. It prints the pixels that
+ *        differ and the time per fill.
+ * predecessor: searches up to <count> parents of the pattern file <path>
+ *              (see PredecessorSearch) with <margin> dead cells around it,
+ *              in <threads> threads, printing the progress meanwhile. It
+ *              prints the parents found, or that the pattern is a Garden
+ *              of Eden. The parents are the same for any number of threads.
+ *              With --parents each one is written as a RLE file in the
+ *              folder <path> (to copy them to the pattern library of the
+ *              DS and watch them become the pattern).
+ */
+#ifndef ARM9
+
+#include <algorithm>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "globals.h"
+#include "random_numbers.h"
+#include "steppingstone.h"
+#include "cyclicautomata.h"
+#include "cycles.h"
+#include "pipeline.h"
+#include "fills.h"
+#include "pattern.h"
+#include "soup.h"
+#include "grid.h"
+#include "stencil.h"
+#include "summedarea.h"
+#include "largerthanlife.h"
+#include "generations.h"
+#include "liferule.h"
+#include "chunkeduniverse.h"
+#include "predecessor.h"
+
+/*
+ * Size of the grid of the headless runs (the size of the DS screen)
+ */
+#define HEADLESS_WIDTH 256
+#define HEADLESS_HEIGHT 192
+
+/*
+ * Soups taken at a time by each thread of the soup search, and the most
+ * common objects printed
+ */
+#define HEADLESS_SOUP_BATCH 64
+#define HEADLESS_SOUP_TOP 10
+
+/*
+ * Values of the first row of the parents taken at a time by each thread of
+ * the predecessor search, the microseconds between the checks of its
+ * threads and the seconds between the reports of its progress
+ */
+#define HEADLESS_PREDECESSOR_BATCH 16
+#define HEADLESS_PREDECESSOR_POLL_US 10000
+#define HEADLESS_PREDECESSOR_PROGRESS_SECONDS 1.0
+
+/*
+ * Prints how to use the headless runner
+ */
+static int printUsage(const char* program)
+{
+    fprintf(stderr,
+            "Usage: %s [--automaton random|stepping-stone|cyclic|pipeline|\n"
+            "                       pattern|library|soup|\n"
+            "                       larger-than-life|generations|\n"
+            "                       unbounded-life|predecessor|\n"
+            "                       fills]\n"
+            "       [--seed <seed>] [--stream <stream>] [--count <count>]\n"
+            "       [--steps <steps>] [--neighborhood von-neumann|moore]\n"
+            "       [--until-fixation] [--width <width>] [--height <height>]\n"
+            "       [--states <states>] [--range <range>]\n"
+            "       [--threshold <threshold>]\n"
+            "       [--model cyclic|greenberg-hastings] [--dimension 1|2]\n"
+            "       [--step-us <microseconds>] [--jitter-us <microseconds>]\n"
+            "       [--slice-rows <rows>] [--until-cycle]\n"
+            "       [--max-period <period>] [--pattern <path>]\n"
+            "       [--soups <soups>] [--threads <threads>]\n"
+            "       [--census <path>] [--objects <path>]\n"
+            "       [--rule <rule>] [--margin <cells>] [--parents <path>]\n",
+            program);
+
+    return 0;
+}
+
+/*
+ * Returns the time in seconds (used to measure the time per step)
+ */
+static double getSeconds()
+{
+    return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/*
+ * Returns the wall clock time in seconds (used when several threads run)
+ */
+static double getWallSeconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + (double) now.tv_nsec / 1000000000;
+}
+
+/*
+ * Calculates the FNV-1a hash of the cells (length bytes), used to compare
+ * two runs
+ */
+static uint32_t checksum(const void* cells, int length)
+{
+    const unsigned char* bytes = (const unsigned char*) cells;
+    uint32_t hash = 2166136261u;
+
+    for (int i = 0; i < length; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+/*
+ * Names of the formats of the patterns (PATTERN_FORMAT_*)
+ */
+static const char* patternFormats[] =
+{
+    "unknown",
+    "rle",
+    "plaintext",
+    "life-1.06"
+};
+
+/*
+ * Decodes the pattern file in the center of a width x height grid
+ */
+static int runPattern(const char* path, int width, int height)
+{
+    PatternReader reader;
+    PatternInfo info;
+    unsigned int population = 0;
+
+    if (reader.open(path) == false or reader.readInfo(info) == false)
+    {
+        fprintf(stderr, "Can't read the pattern %s\n", path);
+        return 1;
+    }
+
+    unsigned char* cells = new unsigned char[width * height];
+
+    memset(cells, CELL_BG, width * height);
+
+    double start = getSeconds();
+
+    reader.decode(info, cells, width, height,
+                  (width - info.width) / 2, (height - info.height) / 2,
+                  CELL_FG, population);
+
+    double seconds = getSeconds() - start;
+
+    printf("\"%s\" %s %dx%d population %u checksum %08x\n",
+           info.name.c_str(), patternFormats[info.format],
+           info.width, info.height, population,
+           (unsigned int) checksum(cells, width * height));
+    printf("%.3f ms to decode\n", seconds * 1000);
+
+    delete[] cells;
+
+    return 0;
+}
+
+/*
+ * Prints the index of the pattern files of the folder
+ */
+static int runLibrary(const char* path)
+{
+    PatternLibrary library;
+
+    double start = getSeconds();
+
+    library.open(path);
+
+    double seconds = getSeconds() - start;
+
+    for (int i = 0; i < library.getNumPatterns(); i++)
+    {
+        const PatternInfo& info = library.getInfo(i);
+
+        printf("\"%s\" %s %dx%d\n", info.name.c_str(),
+               patternFormats[info.format], info.width, info.height);
+    }
+
+    printf("%d patterns, %.3f ms to read the index\n",
+           library.getNumPatterns(), seconds * 1000);
+
+    return 0;
+}
+
+/*
+ * A thread of the soup search, with its own census
+ */
+struct SoupWorker
+{
+    pthread_t thread;
+    uint32_t seed;
+    ObjectCensus census;
+};
+
+/*
+ * The next soup to run and the number of soups, shared by the threads
+ */
+static pthread_mutex_t soupMutex = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long soupNext = 0;
+static unsigned long soupCount = 0;
+
+/*
+ * Runs batches of HEADLESS_SOUP_BATCH soups until there are no more (the
+ * SoupSearch is created here, its universes belong to this thread)
+ */
+static void* runSoupWorker(void* argument)
+{
+    SoupWorker* worker = (SoupWorker*) argument;
+    SoupSearch search;
+
+    while (true)
+    {
+        pthread_mutex_lock(&soupMutex);
+
+        unsigned long first = soupNext;
+
+        soupNext = soupNext + HEADLESS_SOUP_BATCH;
+
+        pthread_mutex_unlock(&soupMutex);
+
+        if (first >= soupCount)
+        {
+            break;
+        }
+
+        for (unsigned long soup = first;
+             soup < first + HEADLESS_SOUP_BATCH and soup < soupCount;
+             soup++)
+        {
+            search.run(worker->seed, soup, worker->census);
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Runs soups random soups of the game of life in numThreads threads and
+ * prints (and writes) the census of the objects they leave
+ */
+static int runSoups(uint32_t seed,
+                    unsigned long soups,
+                    int numThreads,
+                    const char* censusPath,
+                    const char* objectsPath)
+{
+    std::vector<SoupWorker*> workers;
+    ObjectCensus census;
+
+    // Filled before the threads use it
+    GenerationHash::columnKeys();
+
+    soupNext = 0;
+    soupCount = soups;
+
+    double start = getWallSeconds();
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        SoupWorker* worker = new SoupWorker();
+
+        worker->seed = seed;
+        workers.push_back(worker);
+
+        pthread_create(&worker->thread, NULL, runSoupWorker, worker);
+    }
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        pthread_join(workers[i]->thread, NULL);
+        census.merge(workers[i]->census);
+
+        delete workers[i];
+    }
+
+    double seconds = getWallSeconds() - start;
+
+    printf("seed %u soups %lu (%lu not stabilized) objects %d\n",
+           (unsigned int) seed, census.getNumSoups(),
+           census.getNumUnstable(), census.getNumObjects());
+
+    if (seconds > 0)
+    {
+        printf("%.0f soups per second in %d threads\n",
+               census.getNumSoups() / seconds, numThreads);
+    }
+
+    std::vector<std::string> codes;
+    std::vector<unsigned long> counts;
+
+    census.getMostCommon(HEADLESS_SOUP_TOP, codes, counts);
+
+    for (size_t i = 0; i < codes.size(); i++)
+    {
+        printf("%s %lu\n", codes[i].c_str(), counts[i]);
+    }
+
+    if (censusPath != NULL and census.write(censusPath, seed) == false)
+    {
+        fprintf(stderr, "Can't write the census %s\n", censusPath);
+        return 1;
+    }
+
+    if (objectsPath != NULL)
+    {
+        int written = census.writeObjects(objectsPath);
+
+        if (written == -1)
+        {
+            fprintf(stderr, "Can't write the objects to %s\n",
+                    objectsPath);
+            return 1;
+        }
+
+        printf("%d objects written to %s\n", written, objectsPath);
+    }
+
+    return 0;
+}
+
+/*
+ * A thread of the predecessor search, with its own search (and its table of
+ * dead ends) and the parents it found
+ */
+struct PredecessorWorker
+{
+    pthread_t thread;
+    PredecessorSearch search;
+    std::vector<PredecessorParent> parents;
+};
+
+/*
+ * The next value of the first row of the parents to search, the values
+ * searched, the parents found and the threads still running, shared by the
+ * threads
+ */
+static pthread_mutex_t predecessorMutex = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t predecessorNext = 0;
+static uint32_t predecessorCount = 0;
+static uint32_t predecessorDone = 0;
+static long predecessorFound = 0;
+static long predecessorMax = 0;
+static int predecessorWorkers = 0;
+
+/*
+ * Searches batches of HEADLESS_PREDECESSOR_BATCH values of the first row
+ * until there are no more or enough parents were found. The values are
+ * taken in order and each one is searched to the end, so the first
+ * predecessorMax parents of the values searched are the ones that a single
+ * thread finds.
+ */
+static void* runPredecessorWorker(void* argument)
+{
+    PredecessorWorker* worker = (PredecessorWorker*) argument;
+
+    while (true)
+    {
+        pthread_mutex_lock(&predecessorMutex);
+
+        uint32_t first = predecessorNext;
+        bool finished = first >= predecessorCount or
+                        predecessorFound >= predecessorMax;
+
+        if (finished == false)
+        {
+            predecessorNext = predecessorNext + HEADLESS_PREDECESSOR_BATCH;
+        }
+
+        pthread_mutex_unlock(&predecessorMutex);
+
+        if (finished == true)
+        {
+            break;
+        }
+
+        for (uint32_t row = first;
+             row < first + HEADLESS_PREDECESSOR_BATCH and
+             row < predecessorCount;
+             row++)
+        {
+            int found = worker->search.run(row, predecessorMax,
+                                           worker->parents);
+
+            pthread_mutex_lock(&predecessorMutex);
+            predecessorFound = predecessorFound + found;
+            predecessorDone = predecessorDone + 1;
+            pthread_mutex_unlock(&predecessorMutex);
+        }
+    }
+
+    pthread_mutex_lock(&predecessorMutex);
+    predecessorWorkers = predecessorWorkers - 1;
+    pthread_mutex_unlock(&predecessorMutex);
+
+    return NULL;
+}
+
+/*
+ * The parents in the order of a search in a single thread
+ */
+static bool isParentBefore(const PredecessorParent& parent,
+                           const PredecessorParent& other)
+{
+    return parent.firstRow < other.firstRow;
+}
+
+/*
+ * Searches up to maxParents parents of the pattern file (with margin dead
+ * cells around it) in numThreads threads, printing the progress, and
+ * prints (and writes) them
+ */
+static int runPredecessors(const char* path,
+                           int margin,
+                           long maxParents,
+                           int numThreads,
+                           const char* parentsPath)
+{
+    PatternReader reader;
+    PatternInfo info;
+    unsigned int population = 0;
+    std::vector<PredecessorWorker*> workers;
+    std::vector<PredecessorParent> parents;
+
+    if (reader.open(path) == false or reader.readInfo(info) == false)
+    {
+        fprintf(stderr, "Can't read the pattern %s\n", path);
+        return 1;
+    }
+
+    int width = info.width + 2 * margin;
+    int height = info.height + 2 * margin;
+
+    if (width > PREDECESSOR_MAX_WIDTH or height > PREDECESSOR_MAX_HEIGHT)
+    {
+        fprintf(stderr, "The pattern and its margin are bigger than %dx%d\n",
+                PREDECESSOR_MAX_WIDTH, PREDECESSOR_MAX_HEIGHT);
+        return 1;
+    }
+
+    std::vector<unsigned char> cells(width * height, CELL_BG);
+
+    reader.decode(info, &cells[0], width, height, margin, margin, CELL_FG,
+                  population);
+
+    printf("\"%s\" %dx%d population %u, target %dx%d\n", info.name.c_str(),
+           info.width, info.height, population, width, height);
+
+    predecessorNext = 0;
+    predecessorDone = 0;
+    predecessorFound = 0;
+    predecessorMax = maxParents;
+    predecessorWorkers = numThreads;
+
+    double start = getWallSeconds();
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        PredecessorWorker* worker = new PredecessorWorker();
+
+        worker->search.setTarget(&cells[0], width, 0, 0, width, height,
+                                 CELL_FG);
+        predecessorCount = worker->search.getNumFirstRows();
+        workers.push_back(worker);
+    }
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        pthread_create(&workers[i]->thread, NULL, runPredecessorWorker,
+                       workers[i]);
+    }
+
+    double lastReport = start;
+
+    // The progress, until every thread is done
+    while (true)
+    {
+        usleep(HEADLESS_PREDECESSOR_POLL_US);
+
+        pthread_mutex_lock(&predecessorMutex);
+
+        int running = predecessorWorkers;
+        uint32_t done = predecessorDone;
+        long found = predecessorFound;
+
+        pthread_mutex_unlock(&predecessorMutex);
+
+        if (running == 0)
+        {
+            break;
+        }
+
+        if (getWallSeconds() - lastReport <
+            HEADLESS_PREDECESSOR_PROGRESS_SECONDS)
+        {
+            continue;
+        }
+
+        lastReport = getWallSeconds();
+
+        fprintf(stderr, "%u of %u first rows (%.1f%%), %ld parents, "
+                "%.0f s\n", done, predecessorCount,
+                done * 100.0 / predecessorCount, found,
+                getWallSeconds() - start);
+    }
+
+    unsigned long numNodes = 0;
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        pthread_join(workers[i]->thread, NULL);
+
+        parents.insert(parents.end(), workers[i]->parents.begin(),
+                       workers[i]->parents.end());
+        numNodes = numNodes + workers[i]->search.getNumNodes();
+    }
+
+    double seconds = getWallSeconds() - start;
+
+    std::stable_sort(parents.begin(), parents.end(), isParentBefore);
+
+    if ((long) parents.size() > maxParents)
+    {
+        parents.resize(maxParents);
+    }
+
+    if (parents.empty() == true)
+    {
+        printf("no parents: it's a Garden of Eden\n");
+    }
+
+    PredecessorSearch& search = workers[0]->search;
+    int parentWidth = search.getParentWidth();
+    int parentHeight = search.getParentHeight();
+    std::vector<unsigned char> parentCells(parentWidth * parentHeight);
+
+    for (size_t i = 0; i < parents.size(); i++)
+    {
+        search.getCells(parents[i], &parentCells[0], 'o', 'b');
+
+        printf("parent %d (%s)\n", (int) i + 1,
+               search.isParent(parents[i]) == true ? "checked" : "WRONG");
+
+        for (int y = 0; y < parentHeight; y++)
+        {
+            printf("%.*s\n", parentWidth, &parentCells[y * parentWidth]);
+        }
+
+        if (parentsPath != NULL)
+        {
+            char number[16];
+
+            snprintf(number, sizeof(number), "%d", (int) i + 1);
+
+            std::string file = std::string(parentsPath) + "/parent" +
+                               number + ".rle";
+            std::string name = "Parent " + std::string(number) + " of " +
+                               (info.name.empty() == true ? path :
+                                                            info.name);
+
+            if (writePattern(file.c_str(), name,
+                             "Found by the predecessor search",
+                             &parentCells[0], parentWidth, parentHeight,
+                             'o') == false)
+            {
+                fprintf(stderr, "Can't write the parent %s\n",
+                        file.c_str());
+            }
+        }
+    }
+
+    printf("%lu nodes in %.3f s in %d threads\n", numNodes, seconds,
+           numThreads);
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        delete workers[i];
+    }
+
+    return 0;
+}
+
+/*
+ * Prints the first count random numbers of the stream
+ */
+static int runRandom(uint32_t seed, uint32_t stream, long count)
+{
+    RandomNumberGenerator rng;
+
+    rng.setSeed(seed, stream);
+
+    printf("seed %u stream %u\n", (unsigned int) seed, (unsigned int) stream);
+
+    for (long i = 0; i < count; i++)
+    {
+        printf("%08x\n", (unsigned int) rng.next());
+    }
+
+    return 0;
+}
+
+/*
+ * Runs the stepping stone (sliceRows rows at a time if it isn't 0)
+ */
+static int runSteppingStone(uint32_t seed,
+                            long steps,
+                            int neighborhood,
+                            bool untilFixation,
+                            int width,
+                            int height,
+                            int sliceRows)
+{
+    RandomNumberGenerator rng;
+    SteppingStone steppingStone;
+    long i = 0;
+
+    // The same stream as the stepping stone of the DS
+    rng.setSeed(seed, STEPPING_STONE);
+
+    steppingStone.setSize(width, height);
+    steppingStone.setTypeOfNeighborhood(neighborhood);
+    steppingStone.initialize(rng);
+
+    printf("seed %u size %dx%d colors %d\n", (unsigned int) seed,
+           width, height, steppingStone.getNumColors());
+
+    double start = getSeconds();
+
+    for (; i < steps; i++)
+    {
+        if (untilFixation == true and steppingStone.isFixated() == true)
+        {
+            break;
+        }
+
+        if (sliceRows > 0)
+        {
+            do
+            {
+                steppingStone.stepRows(rng, sliceRows);
+            }
+            while (steppingStone.getStepRow() != 0);
+        }
+        else
+        {
+            steppingStone.nextStep(rng);
+        }
+    }
+
+    double elapsed = getSeconds() - start;
+
+    printf("steps %ld checksum %08x colors left %d\n", i,
+           (unsigned int) checksum(steppingStone.getCells(),
+                                   width * height * sizeof(unsigned short)),
+           steppingStone.getSurvivingColors());
+
+    if (steppingStone.getFixationStep() != -1)
+    {
+        printf("fixation at step %d\n", steppingStone.getFixationStep());
+    }
+    else
+    {
+        printf("no fixation after %ld steps\n", i);
+    }
+
+    if (i > 0)
+    {
+        printf("%.3f ms per step\n", elapsed * 1000 / i);
+    }
+
+    return 0;
+}
+
+/*
+ * Runs the one dimensional cyclic cellular automata
+ */
+static int runCyclic1D(uint32_t seed,
+                       long steps,
+                       int width,
+                       int states,
+                       int range,
+                       int threshold,
+                       int model)
+{
+    RandomNumberGenerator rng;
+    CyclicAutomata1D cyclicAutomata;
+
+    // The same stream as the cyclic cellular automata of the DS
+    rng.setSeed(seed, CYCLIC_CELLULAR_AUTOMATA);
+
+    cyclicAutomata.setSize(width);
+    cyclicAutomata.setNumStates(states);
+    cyclicAutomata.setRange(range);
+    cyclicAutomata.setThreshold(threshold);
+    cyclicAutomata.setModel(model);
+    cyclicAutomata.initialize(rng);
+
+    double start = getSeconds();
+
+    for (long i = 0; i < steps; i++)
+    {
+        cyclicAutomata.nextStep();
+    }
+
+    double elapsed = getSeconds() - start;
+
+    printf("seed %u steps %ld checksum %08x\n",
+           (unsigned int) seed, steps,
+           (unsigned int) checksum(cyclicAutomata.getCells(), width));
+
+    if (steps > 0)
+    {
+        printf("%.3f ms per step\n", elapsed * 1000 / steps);
+    }
+
+    return 0;
+}
+
+/*
+ * Runs the two dimensional cyclic cellular automata (sliceRows rows at a
+ * time if it isn't 0) looking for cycles of up to maxPeriod steps
+ */
+static int runCyclic(uint32_t seed,
+                     long steps,
+                     int neighborhood,
+                     int width,
+                     int height,
+                     int states,
+                     int range,
+                     int threshold,
+                     int model,
+                     int sliceRows,
+                     bool untilCycle,
+                     int maxPeriod)
+{
+    RandomNumberGenerator rng;
+    CyclicAutomata2D cyclicAutomata;
+    CycleDetector cycles;
+
+    // The same stream as the cyclic cellular automata of the DS
+    rng.setSeed(seed, CYCLIC_CELLULAR_AUTOMATA);
+
+    cyclicAutomata.setSize(width, height);
+    cyclicAutomata.setNumStates(states);
+    cyclicAutomata.setRange(range);
+    cyclicAutomata.setThreshold(threshold);
+    cyclicAutomata.setTypeOfNeighborhood(neighborhood);
+    cyclicAutomata.setModel(model);
+    cyclicAutomata.initialize(rng);
+
+    cycles.setMaxPeriod(maxPeriod);
+    cycles.addGeneration(0, cyclicAutomata.getHash());
+
+    double start = getSeconds();
+    long i;
+
+    for (i = 0; i < steps; i++)
+    {
+        if (sliceRows > 0)
+        {
+            do
+            {
+                cyclicAutomata.stepRows(sliceRows);
+            }
+            while (cyclicAutomata.getStepRow() != 0);
+        }
+        else
+        {
+            cyclicAutomata.nextStep();
+        }
+
+        if (cycles.addGeneration(i + 1, cyclicAutomata.getHash()) == true and
+            untilCycle == true)
+        {
+            i++;
+            break;
+        }
+    }
+
+    double elapsed = getSeconds() - start;
+
+    printf("seed %u steps %ld checksum %08x\n",
+           (unsigned int) seed, i,
+           (unsigned int) checksum(cyclicAutomata.getCells(), width * height));
+
+    if (cycles.hasCycle() == true)
+    {
+        printf("cycle of period %d after %u steps\n", cycles.getPeriod(),
+               cycles.getTransient());
+    }
+    else
+    {
+        printf("no cycle of up to %d steps after %ld steps\n",
+               cycles.getMaxPeriod(), i);
+    }
+
+    if (i > 0)
+    {
+        printf("%.3f ms per step\n", elapsed * 1000 / i);
+    }
+
+    return 0;
+}
+
+/*
+ * Runs Larger than Life on a random grid (on a torus, like the DS) looking
+ * for cycles of up to maxPeriod steps
+ */
+static int runLargerThanLife(uint32_t seed,
+                             long steps,
+                             int width,
+                             int height,
+                             LargerThanLifeRule& rule,
+                             bool untilCycle,
+                             int maxPeriod)
+{
+    RandomNumberGenerator rng;
+    Grid grid;
+    SummedAreaTable table;
+    CycleDetector cycles;
+    char text[LTL_RULE_LENGTH];
+    long population = 0;
+
+    // The same stream and density as Larger than Life on the DS
+    rng.setSeed(seed, LARGER_THAN_LIFE);
+
+    grid.setSize(width, height);
+    grid.clear(CELL_BG);
+
+    unsigned char* cells = grid.getCells();
+
+    for (int i = 0; i < width * height; i++)
+    {
+        if (rng.nextBelow(100) < LTL_INITIAL_DENSITY)
+        {
+            cells[i] = CELL_FG;
+            ++population;
+        }
+    }
+
+    grid.loadCells();
+
+    cycles.setMaxPeriod(maxPeriod);
+    cycles.addGeneration(0, grid.getHash());
+
+    double start = getSeconds();
+    long i;
+
+    for (i = 0; i < steps; i++)
+    {
+        int populationChange;
+
+        SummedAreaStencil<WrapBorder, LargerThanLifeRule>::step(
+            grid, rule, table, populationChange);
+        grid.swap();
+
+        population = population + populationChange;
+
+        if (cycles.addGeneration(i + 1, grid.getHash()) == true and
+            untilCycle == true)
+        {
+            i++;
+            break;
+        }
+    }
+
+    double elapsed = getSeconds() - start;
+
+    formatLargerThanLifeRule(rule, text, sizeof(text));
+
+    printf("rule %s\n", text);
+    printf("seed %u steps %ld checksum %08x population %ld\n",
+           (unsigned int) seed, i,
+           (unsigned int) checksum(grid.getCells(), width * height),
+           population);
+
+    if (cycles.hasCycle() == true)
+    {
+        printf("cycle of period %d after %u steps\n", cycles.getPeriod(),
+               cycles.getTransient());
+    }
+    else
+    {
+        printf("no cycle of up to %d steps after %ld steps\n",
+               cycles.getMaxPeriod(), i);
+    }
+
+    if (i > 0)
+    {
+        printf("%.3f ms per step\n", elapsed * 1000 / i);
+    }
+
+    return 0;
+}
+
+/*
+ * Runs Generations on a random grid (the cells of the border stay dead,
+ * like on the DS) looking for cycles of up to maxPeriod steps
+ */
+static int runGenerations(uint32_t seed,
+                          long steps,
+                          int width,
+                          int height,
+                          GenerationsRule& rule,
+                          bool untilCycle,
+                          int maxPeriod)
+{
+    RandomNumberGenerator rng;
+    Grid grid;
+    StatePlanes states;
+    CycleDetector cycles;
+    char text[GENERATIONS_RULE_LENGTH];
+    long population = 0;
+
+    // The same stream and density as Generations on the DS
+    rng.setSeed(seed, GENERATIONS);
+
+    grid.setSize(width, height);
+    grid.clear(CELL_BG);
+
+    unsigned char* cells = grid.getCells();
+
+    for (int j = 1; j < height - 1; j++)
+    {
+        for (int i = 1; i < width - 1; i++)
+        {
+            if (rng.nextBelow(100) < GENERATIONS_INITIAL_DENSITY)
+            {
+                cells[j * width + i] = CELL_FG;
+                ++population;
+            }
+        }
+    }
+
+    grid.loadCells();
+
+    cycles.setMaxPeriod(maxPeriod);
+    cycles.addGeneration(0, grid.getHash());
+
+    double start = getSeconds();
+    long i;
+
+    for (i = 0; i < steps; i++)
+    {
+        int populationChange;
+
+        GenerationsStencil<MooreNeighborhood, GenerationsRule>::step(
+            grid, rule, states, populationChange);
+        grid.swap();
+
+        population = population + populationChange;
+
+        if (cycles.addGeneration(i + 1, grid.getHash()) == true and
+            untilCycle == true)
+        {
+            i++;
+            break;
+        }
+    }
+
+    double elapsed = getSeconds() - start;
+
+    formatGenerationsRule(rule, text, sizeof(text));
+
+    printf("rule %s\n", text);
+    printf("seed %u steps %ld checksum %08x population %ld\n",
+           (unsigned int) seed, i,
+           (unsigned int) checksum(grid.getCells(), width * height),
+           population);
+
+    if (cycles.hasCycle() == true)
+    {
+        printf("cycle of period %d after %u steps\n", cycles.getPeriod(),
+               cycles.getTransient());
+    }
+    else
+    {
+        printf("no cycle of up to %d steps after %ld steps\n",
+               cycles.getMaxPeriod(), i);
+    }
+
+    if (i > 0)
+    {
+        printf("%.3f ms per step\n", elapsed * 1000 / i);
+    }
+
+    return 0;
+}
+
+/*
+ * Generation written in each buffer of the pipeline run, the last
+ * generation shown and the number of errors found
+ */
+static long pipelineGenerations[PIPELINE_NUM_BUFFERS];
+static long pipelineShown = 0;
+static long pipelineErrors = 0;
+
+/*
+ * Shows a buffer of the pipeline run (called by the simulated VBlank): the
+ * generations must arrive one after the other
+ */
+static int showPipelineBuffer(int buffer)
+{
+    if (pipelineGenerations[buffer] != pipelineShown + 1)
+    {
+        printf("error: generation %ld shown after %ld\n",
+               pipelineGenerations[buffer], pipelineShown);
+        ++pipelineErrors;
+    }
+
+    pipelineShown = pipelineGenerations[buffer];
+
+    return 0;
+}
+
+/*
+ * Runs generations that take stepUs + [0, jitterUs) microseconds through
+ * the pipeline, with a simulated VBlank clock
+ */
+static int runPipeline(uint32_t seed,
+                       long steps,
+                       unsigned long stepUs,
+                       unsigned long jitterUs)
+{
+    RandomNumberGenerator rng;
+    FramePipeline pipeline;
+    VBlankClock clock(&pipeline);
+
+    rng.setSeed(seed, 0);
+
+    pipeline.setClock(&clock);
+    pipeline.start(showPipelineBuffer, 0);
+
+    // The buffer 0 shows the initial state
+    pipelineGenerations[0] = 0;
+    pipelineShown = 0;
+    pipelineErrors = 0;
+
+    for (long generation = 1; generation <= steps; generation++)
+    {
+        int buffer = pipeline.acquire();
+
+        if (buffer == pipeline.getDisplayed())
+        {
+            printf("error: generation %ld written in the displayed buffer\n",
+                   generation);
+            ++pipelineErrors;
+        }
+
+        for (int i = 0; i < pipeline.getQueueLength(); i++)
+        {
+            int waiting = (pipeline.getDisplayed() + 1 + i) %
+                          PIPELINE_NUM_BUFFERS;
+
+            if (buffer == waiting)
+            {
+                printf("error: generation %ld written in a waiting buffer\n",
+                       generation);
+                ++pipelineErrors;
+            }
+        }
+
+        pipelineGenerations[buffer] = generation;
+
+        unsigned long elapsed = stepUs;
+
+        if (jitterUs > 0)
+        {
+            elapsed = elapsed + rng.next() % jitterUs;
+        }
+
+        clock.advance(elapsed);
+        pipeline.submit();
+    }
+
+    // Wait until the last generation is shown
+    while (pipeline.getQueueLength() > 0)
+    {
+        clock.waitForVBlank();
+    }
+
+    if (pipelineShown != steps)
+    {
+        printf("error: generation %ld shown last, not %ld\n",
+               pipelineShown, steps);
+        ++pipelineErrors;
+    }
+
+    printf("seed %u generations %ld frames %lu flips %lu stalls %lu "
+           "errors %ld\n", (unsigned int) seed, steps, pipeline.getFrames(),
+           pipeline.getFlips(), pipeline.getStalls(), pipelineErrors);
+
+    if (steps > 0)
+    {
+        printf("%.3f frames per generation (%.3f ms each)\n",
+               (double) pipeline.getFrames() / steps,
+               (double) clock.getTime() / 1000 / steps);
+    }
+
+    return pipelineErrors == 0 ? 0 : 1;
+}
+
+/*
+ * Pattern of the fills run (the hexagonal lattice, see hexgrid.cpp)
+ */
+static const unsigned char fillsPattern[4 * 8] =
+{
+    0, 0, 0, 0, 1, 1, 1, 0,
+    0, 0, 0, 1, 0, 0, 0, 1,
+    1, 1, 1, 0, 0, 0, 0, 0,
+    0, 0, 0, 1, 0, 0, 0, 1
+};
+
+/*
+ * Draws steps random spans, rectangles and pattern blits (partly outside
+ * the screen) with the fills of fills.h in a 16 bits and an 8 bits per
+ * pixel buffer, and pixel by pixel in two others. Prints the pixels that
+ * differ and the time per fill.
+ */
+static int runFills(uint32_t seed, long steps)
+{
+    RandomNumberGenerator rng;
+    unsigned short* pixels = new unsigned short[SCREEN_WIDTH * SCREEN_HEIGHT];
+    unsigned short* expected =
+        new unsigned short[SCREEN_WIDTH * SCREEN_HEIGHT];
+    unsigned char* indexes = new unsigned char[SCREEN_WIDTH * SCREEN_HEIGHT];
+    unsigned char* expectedIndexes =
+        new unsigned char[SCREEN_WIDTH * SCREEN_HEIGHT];
+    double seconds = 0;
+
+    rng.setSeed(seed, 0);
+
+    fillHalfWords(pixels, 0x7FFF, SCREEN_WIDTH * SCREEN_HEIGHT * 2);
+    fillWords(indexes, 0x01010101u * (uint8_t) CELL_FG,
+              SCREEN_WIDTH * SCREEN_HEIGHT);
+
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+    {
+        expected[i] = 0x7FFF;
+        expectedIndexes[i] = CELL_FG;
+    }
+
+    for (long step = 0; step < steps; step++)
+    {
+        int kind = rng.nextBelow(3);
+        int column = (int) rng.nextBelow(SCREEN_WIDTH + 64) - 32;
+        int row = (int) rng.nextBelow(SCREEN_HEIGHT + 64) - 32;
+        int width = rng.nextBelow(kind == 1 ? 2 * SCREEN_WIDTH : 64);
+        int height = kind == 0 ? 1 : rng.nextBelow(SCREEN_HEIGHT);
+        unsigned short color = rng.next() & 0xFFFF;
+        unsigned char index = rng.next() & 0xFF;
+
+        double start = getSeconds();
+
+        if (kind == 0)
+        {
+            fillSpan(pixels, column, row, width, color);
+            fillSpan(indexes, column, row, width, index);
+        }
+        else if (kind == 1)
+        {
+            fillRect(pixels, column, row, width, height, color);
+        }
+        else
+        {
+            blitPattern(pixels, column, row, width, height, fillsPattern, 8,
+                        4, color);
+        }
+
+        seconds = seconds + getSeconds() - start;
+
+        for (int y = row; y < row + height; y++)
+        {
+            for (int x = column; x < column + width; x++)
+            {
+                if (x < 0 or x >= SCREEN_WIDTH or y < 0 or
+                    y >= SCREEN_HEIGHT)
+                {
+                    continue;
+                }
+
+                if (kind != 2 or
+                    fillsPattern[((y - row) % 4) * 8 + (x - column) % 8] != 0)
+                {
+                    expected[y * SCREEN_WIDTH + x] = color;
+                }
+
+                if (kind == 0)
+                {
+                    expectedIndexes[y * SCREEN_WIDTH + x] = index;
+                }
+            }
+        }
+    }
+
+    long errors = 0;
+
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+    {
+        errors = errors + (pixels[i] != expected[i] ? 1 : 0) +
+                 (indexes[i] != expectedIndexes[i] ? 1 : 0);
+    }
+
+    printf("seed %u fills %ld checksum %08x %08x errors %ld\n",
+           (unsigned int) seed, steps,
+           (unsigned int) checksum(pixels, SCREEN_WIDTH * SCREEN_HEIGHT * 2),
+           (unsigned int) checksum(indexes, SCREEN_WIDTH * SCREEN_HEIGHT),
+           errors);
+
+    if (steps > 0)
+    {
+        printf("%.3f us per fill\n", seconds * 1000000 / steps);
+    }
+
+    delete[] pixels;
+    delete[] expected;
+    delete[] indexes;
+    delete[] expectedIndexes;
+
+    return errors == 0 ? 0 : 1;
+}
+
+/*
+ * Runs the game of life on an unbounded universe from a pattern file (if
+ * path isn't NULL) or from a random soup of width x height cells
+ */
+static int runUnboundedLife(uint32_t seed,
+                            long steps,
+                            int width,
+                            int height,
+                            const char* path)
+{
+    RandomNumberGenerator rng;
+    ChunkedUniverse universe;
+    LifeRule rule;
+    unsigned int population = 0;
+    int minX = 0;
+    int minY = 0;
+    int maxX = 0;
+    int maxY = 0;
+
+    rule.state = CELL_FG;
+
+    if (path != NULL)
+    {
+        PatternReader reader;
+        PatternInfo info;
+
+        if (reader.open(path) == false or reader.readInfo(info) == false)
+        {
+            fprintf(stderr, "Can't read the pattern %s\n", path);
+            return 1;
+        }
+
+        // Straight into the universe, centered on the width x height
+        // window but not clipped to it
+        universe.clear();
+        reader.decode(info, universe,
+                      (width - info.width) / 2, (height - info.height) / 2,
+                      population);
+    }
+    else
+    {
+        unsigned char* cells = new unsigned char[width * height];
+
+        memset(cells, CELL_BG, width * height);
+
+        // The same stream as the game of life on the DS
+        rng.setSeed(seed, CONWAYS_GAME_OF_LIFE);
+
+        for (int i = 0; i < width * height; i++)
+        {
+            if (rng.nextBelow(2) == 0)
+            {
+                cells[i] = CELL_FG;
+            }
+        }
+
+        universe.load(cells, width, height, CELL_FG);
+
+        delete[] cells;
+    }
+
+    long initialPopulation = universe.getPopulation();
+    double start = getSeconds();
+    long i;
+
+    for (i = 0; i < steps; i++)
+    {
+        int populationChange;
+
+        ChunkedStencil<MooreNeighborhood, LifeRule>::step(universe, rule,
+                                                          populationChange);
+        universe.swap();
+    }
+
+    double elapsed = getSeconds() - start;
+
+    printf("seed %u steps %ld population %ld -> %ld hash %016llx\n",
+           (unsigned int) seed, i, initialPopulation,
+           universe.getPopulation(),
+           (unsigned long long) universe.getHash());
+    printf("%d chunks, %ld bytes\n", universe.getNumChunks(),
+           universe.getMemory());
+
+    if (universe.getBounds(minX, minY, maxX, maxY) == true)
+    {
+        printf("bounds (%d, %d) to (%d, %d)\n", minX, minY, maxX, maxY);
+    }
+
+    if (i > 0)
+    {
+        printf("%.3f ms per step\n", elapsed * 1000 / i);
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* automaton = "random";
+    uint32_t seed = 0;
+    uint32_t stream = 0;
+    long count = 16;
+    long steps = 100;
+    int neighborhood = VON_NEUMANN_NEIGHBORHOOD;
+    bool seedGiven = false;
+    bool untilFixation = false;
+    bool untilCycle = false;
+    int maxPeriod = CYCLE_MAX_PERIOD;
+    int width = HEADLESS_WIDTH;
+    int height = HEADLESS_HEIGHT;
+    int states = CCA_INITIAL_NUM_STATES;
+    int range = CCA_INITIAL_RANGE;
+    int threshold = CCA_INITIAL_THRESHOLD;
+    int model = CCA_MODEL_CYCLIC;
+    int dimension = 2;
+    bool neighborhoodGiven = false;
+    bool thresholdGiven = false;
+    unsigned long stepUs = PIPELINE_VBLANK_PERIOD_US / 2;
+    unsigned long jitterUs = 0;
+    int sliceRows = 0;
+    const char* path = NULL;
+    unsigned long soups = 1000;
+    int numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    const char* censusPath = NULL;
+    const char* objectsPath = NULL;
+    const char* ruleText = NULL;
+    int margin = 0;
+    const char* parentsPath = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--automaton") == 0 && i + 1 < argc)
+        {
+            automaton = argv[++i];
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = (uint32_t) strtoul(argv[++i], NULL, 0);
+            seedGiven = true;
+        }
+        else if (strcmp(argv[i], "--stream") == 0 && i + 1 < argc)
+        {
+            stream = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc)
+        {
+            count = strtol(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+        {
+            steps = strtol(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--neighborhood") == 0 && i + 1 < argc)
+        {
+            ++i;
+            neighborhoodGiven = true;
+
+            if (strcmp(argv[i], "moore") == 0)
+            {
+                neighborhood = MOORE_NEIGHBORHOOD;
+            }
+            else
+            {
+                neighborhood = VON_NEUMANN_NEIGHBORHOOD;
+            }
+        }
+        else if (strcmp(argv[i], "--until-fixation") == 0)
+        {
+            untilFixation = true;
+        }
+        else if (strcmp(argv[i], "--until-cycle") == 0)
+        {
+            untilCycle = true;
+        }
+        else if (strcmp(argv[i], "--max-period") == 0 && i + 1 < argc)
+        {
+            maxPeriod = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--width") == 0 && i + 1 < argc)
+        {
+            width = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--height") == 0 && i + 1 < argc)
+        {
+            height = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--states") == 0 && i + 1 < argc)
+        {
+            states = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--range") == 0 && i + 1 < argc)
+        {
+            range = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            threshold = atoi(argv[++i]);
+            thresholdGiven = true;
+        }
+        else if (strcmp(argv[i], "--dimension") == 0 && i + 1 < argc)
+        {
+            dimension = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--step-us") == 0 && i + 1 < argc)
+        {
+            stepUs = strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--jitter-us") == 0 && i + 1 < argc)
+        {
+            jitterUs = strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--slice-rows") == 0 && i + 1 < argc)
+        {
+            sliceRows = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--pattern") == 0 && i + 1 < argc)
+        {
+            path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--soups") == 0 && i + 1 < argc)
+        {
+            soups = strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            numThreads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--census") == 0 && i + 1 < argc)
+        {
+            censusPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc)
+        {
+            objectsPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--rule") == 0 && i + 1 < argc)
+        {
+            ruleText = argv[++i];
+        }
+        else if (strcmp(argv[i], "--margin") == 0 && i + 1 < argc)
+        {
+            margin = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--parents") == 0 && i + 1 < argc)
+        {
+            parentsPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc)
+        {
+            ++i;
+
+            if (strcmp(argv[i], "greenberg-hastings") == 0)
+            {
+                model = CCA_MODEL_GREENBERG_HASTINGS;
+            }
+            else
+            {
+                model = CCA_MODEL_CYCLIC;
+            }
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (width < 1 or height < 1 or numThreads < 1)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (seedGiven == false)
+    {
+        seed = makeRandomSeed();
+    }
+
+    if (strcmp(automaton, "random") == 0)
+    {
+        return runRandom(seed, stream, count);
+    }
+    else if (strcmp(automaton, "stepping-stone") == 0)
+    {
+        return runSteppingStone(seed, steps, neighborhood, untilFixation,
+                                width, height, sliceRows);
+    }
+    else if (strcmp(automaton, "pattern") == 0 && path != NULL)
+    {
+        return runPattern(path, width, height);
+    }
+    else if (strcmp(automaton, "library") == 0 && path != NULL)
+    {
+        return runLibrary(path);
+    }
+    else if (strcmp(automaton, "soup") == 0)
+    {
+        return runSoups(seed, soups, numThreads, censusPath, objectsPath);
+    }
+    else if (strcmp(automaton, "larger-than-life") == 0)
+    {
+        LargerThanLifeRule rule;
+
+        rule.state = CELL_FG;
+        setLargerThanLifePreset(rule, LTL_INITIAL_PRESET);
+
+        // The boundary wraps around once: the box must fit in the grid
+        if ((ruleText != NULL and
+             parseLargerThanLifeRule(ruleText, rule) == false) or
+            width <= 2 * rule.range or height <= 2 * rule.range)
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        return runLargerThanLife(seed, steps, width, height, rule,
+                                 untilCycle, maxPeriod);
+    }
+    else if (strcmp(automaton, "generations") == 0)
+    {
+        GenerationsRule rule;
+
+        rule.state = CELL_FG;
+        setGenerationsPreset(rule, GENERATIONS_INITIAL_PRESET);
+
+        if ((ruleText != NULL and
+             parseGenerationsRule(ruleText, rule) == false) or
+            width > GRID_MAX_WIDTH)
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        return runGenerations(seed, steps, width, height, rule, untilCycle,
+                              maxPeriod);
+    }
+    else if (strcmp(automaton, "unbounded-life") == 0)
+    {
+        return runUnboundedLife(seed, steps, width, height, path);
+    }
+    else if (strcmp(automaton, "predecessor") == 0 && path != NULL &&
+             margin >= 0 && count >= 1)
+    {
+        return runPredecessors(path, margin, count, numThreads,
+                               parentsPath);
+    }
+    else if (strcmp(automaton, "pipeline") == 0)
+    {
+        return runPipeline(seed, steps, stepUs, jitterUs);
+    }
+    else if (strcmp(automaton, "fills") == 0)
+    {
+        return runFills(seed, steps);
+    }
+    else if (strcmp(automaton, "cyclic") == 0 && dimension == 1)
+    {
+        // One neighbor on each side is enough by default
+        if (thresholdGiven == false)
+        {
+            threshold = CCA_1D_INITIAL_THRESHOLD;
+        }
+
+        return runCyclic1D(seed, steps, width, states, range, threshold,
+                           model);
+    }
+    else if (strcmp(automaton, "cyclic") == 0)
+    {
+        // The cyclic cellular automata uses the Moore neighborhood by default
+        if (neighborhoodGiven == false)
+        {
+            neighborhood = MOORE_NEIGHBORHOOD;
+        }
+
+        return runCyclic(seed, steps, neighborhood, width, height,
+                         states, range, threshold, model, sliceRows,
+                         untilCycle, maxPeriod);
+    }
+
+    printUsage(argv[0]);
+
+    return 1;
+}
+
+#endif
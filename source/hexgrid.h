@@ -1,15 +1,58 @@
 #ifndef HEXGRID_H
 #define HEXGRID_H
 
-int hexGridLineOne(int y);
-int hexGridLineTwo(int y);
-int hexGridLineThree(int y);
-
-int drawHexGrid();
+int showHexLattice();
 
 int paintHexCell(int intPosX,
                  int intPosY,
-                 unsigned short color,
-                 unsigned short* framebuffer);
+                 unsigned char index,
+                 unsigned char* framebuffer);
+
+/*
+ * The hexagonal lattice for the stencil engine (see stencil.h).
+ *
+ * The cells are painted with paintHexCell() in two sublattices: the columns
+ * 8, 16, ... of the rows 3, 7, ... and the columns 4, 12, ... of the rows
+ * 5, 9, ... Each cell has 6 neighbors (the neighborhood is ignored):
+ *
+ *       top
+ * top left   top right
+ *       cell
+ * bottom left bottom right
+ *      bottom
+ */
+struct HexagonalLattice
+{
+    static const int numSublattices = 2;
+    static const int rowStep = 4;
+    static const int columnStep = 8;
+
+    static int firstRow(int k) { return k == 0 ? 3 : 5; }
+    static int endRow(int k) { return k == 0 ? 191 : 189; }
+    static int firstColumn(int k) { return k == 0 ? 8 : 4; }
+    static int endColumn(int k) { return k == 0 ? 254 : 252; }
+
+    template <class Neighborhood, typename Cell>
+    static int gather(const Cell* cells, int width, int i, int j, Cell state)
+    {
+        return (cells[width * j + i - 2] == state) +
+               (cells[width * (j - 2) + i] == state) +
+               (cells[width * j + i + 4] == state) +
+               (cells[width * (j + 2) + i - 2] == state) +
+               (cells[width * (j + 4) + i] == state) +
+               (cells[width * (j + 2) + i + 4] == state);
+    }
+
+    static int paint(int i, int j, unsigned char index, unsigned char* cells)
+    {
+        return paintHexCell(i, j, index, cells);
+    }
+
+    template <class Store>
+    static int markDirty(Store& store, int i, int j)
+    {
+        return store.markDirty(i - 1, j, 5, 3);
+    }
+};
 
 #endif
@@ -0,0 +1,378 @@
+#include <string>
+
+#include "i18n.h"
+#include "globals.h"
+
+/*
+ * The strings of text used in the app in the default language (english).
+ *
+ */
+std::string stringRuleNumber = "Rule number";
+std::string stringElementaryCellularAutomata = "Elementary cellular automata";
+// max 30 characters
+std::string stringLangtonsAnt = "Langton's ant"; // max 30 characters
+std::string stringLangtonsHexagonalAnt = "Langton's hexagonal ant";
+std::string stringBooleanAutomata = "Boolean automata";
+std::string stringBooleanHexagonalAutomata = "Boolean hexagonal automata";
+std::string stringBooleanTriangularAutomata = "Boolean triangular automata";
+std::string stringConwaysGameOfLife = "Conway's game of life";
+std::string stringMunchingSquares = "Munching Squares";
+std::string stringBMLtrafficModel = "BML traffic model";
+std::string stringCyclicCellularAutomaton = "Cyclic cellular automaton";
+std::string stringSteppingStone = "Stepping stone";
+std::string stringSelectColors = "Select colors";
+std::string stringBackToMainMenu = "Back to main menu";
+std::string stringPopulation = "Population:";
+std::string stringOneCell = "One cell";
+std::string stringRandom = "Random";
+std::string stringAntsPixels = "Ant's size (pixels)";
+std::string stringNumStates = "Number of states";
+std::string stringVonNeumannNeighborhood = "Von Neumann neighborhood";
+std::string stringMooreNeighborhood = "Moore neighborhood";
+std::string stringNeighborhood = "Neighborhood:";
+std::string stringInitialState ="Initial state:";
+std::string stringAcorn = "Acorn";
+std::string stringFPentomino = "F-Pentomino";
+std::string stringFillScreenWithPulsars = "Fill screen with pulsars";
+std::string stringFillScreenWithPentadecathlons = "Fill with pentadecathlons";
+std::string stringRipJohnConway = "RIP JOHN CONWAY";
+std::string stringPatternLibrary = "Library";
+std::string stringNoPatterns = "(empty)";
+std::string stringBackgroundColor = "Background color:";
+std::string stringForegroundColor = "First foreground color:";
+std::string stringSecondForegroundColor = "Second foreground color:";
+std::string stringLineColor = "Line color:";
+std::string stringRed = "Red";
+std::string stringGreen = "Green";
+std::string stringBlue = "Blue";
+std::string stringSteps = "Steps";
+std::string stringAutomataType = "Automata type";
+std::string stringVersion = "version " + strVersionNumber;
+std::string stringSelectLanguage = "Select language";
+std::string stringEnglish = "English";
+std::string stringEspanol = "Espanol";
+std::string stringEuskara = "Euskara";
+std::string string1234 = "1    2    3    4";
+std::string string5678 = "5    6    7    8";
+std::string string123 = "1    2    3";
+std::string string456 = "4    5    6";
+std::string stringRestart = "Restart";
+std::string stringDensity = "Density";
+std::string stringSeed = "Seed";
+std::string stringColors = "Colors";
+std::string stringFixationStep = "Fixation step";
+std::string stringBytesPresented = "Bytes to VRAM";
+std::string stringViewHelp = "L/R: zoom  Y+pad/touch: pan";
+std::string stringSpeed = "Speed";
+std::string stringPaused = "paused";
+std::string stringStepsPerSecond = "steps/s";
+std::string stringSpeedHelp = "START:pause SELECT:speed X:step";
+std::string stringCycle = "Cycle";
+std::string stringCycleGoOn = "go on";
+std::string stringCycleRestart = "restart";
+std::string stringCycleStop = "stop";
+std::string stringDimension = "Dimension";
+std::string stringRange = "Range";
+std::string stringThreshold = "Threshold";
+std::string stringModel = "Model";
+std::string stringCyclic = "Cyclic";
+std::string stringLargerThanLife = "Larger than Life";
+std::string stringRule = "Rule";
+std::string stringBirth = "Birth";
+std::string stringSurvival = "Survival";
+std::string stringCustom = "custom";
+std::string stringGenerations = "Generations";
+
+/*
+ * Changes the language of the strings of text to the selected language
+ * languageCode is the two letters code for each language
+ * en : english
+ * es : spanish
+ * eu : basque
+ */
+int changeTextLanguage(int language)
+{
+    if (language == EN) // English
+    {
+        stringRuleNumber = "Rule number";
+
+        stringElementaryCellularAutomata = "Elementary cellular automata";
+        // max 30 characters
+        stringLangtonsAnt = "Langton's ant"; // max 30 characters
+        stringLangtonsHexagonalAnt = "Langton's hexagonal ant";
+        // max 30 characters
+        stringBooleanAutomata = "Boolean automata"; // max 30 characters
+        stringBooleanHexagonalAutomata = "Boolean hexagonal automata";
+        // max 30 characters
+        stringBooleanTriangularAutomata = "Boolean triangular automata";
+        // max 30 characters
+        stringConwaysGameOfLife = "Conway's game of life";
+        stringMunchingSquares = "Munching Squares"; // max 30 characters
+        stringBMLtrafficModel = "BML traffic model";
+        stringCyclicCellularAutomaton = "Cyclic cellular automaton";
+        stringSteppingStone = "Stepping stone";
+        stringSelectColors = "Select colors"; // max 30 characters
+        stringBackToMainMenu = "Back to main menu"; // max 30 characters
+        stringPopulation = "Population:";
+
+        stringOneCell = "One cell";
+        stringRandom = "Random";
+
+        stringAntsPixels = "Ant's size (pixels)"; // Max 22 characters
+        stringNumStates = "Number of states";
+        stringVonNeumannNeighborhood = "Von Neumann neighborhood";
+        stringMooreNeighborhood = "Moore neighborhood";
+        stringNeighborhood = "Neighborhood:";
+
+        stringInitialState ="Initial state:";
+        stringAcorn = "Acorn";
+        stringFPentomino = "F-Pentomino";
+        stringFillScreenWithPulsars = "Fill screen with pulsars";
+        stringFillScreenWithPentadecathlons = "Fill with pentadecathlons";
+        stringRipJohnConway = "RIP JOHN CONWAY";
+        stringPatternLibrary = "Library";
+        stringNoPatterns = "(empty)";
+
+        stringBackgroundColor = "Background color:";
+        stringForegroundColor = "First foreground color:";
+        stringSecondForegroundColor = "Second foreground color:";
+        stringLineColor = "Line color:";
+        stringRed = "Red";
+        stringGreen = "Green";
+        stringBlue = "Blue";
+
+        stringSteps = "Steps";
+
+        stringAutomataType = "Automata type";
+
+        stringVersion = "version " + strVersionNumber;
+
+        stringSelectLanguage = "Select language";
+
+        stringRestart = "Restart";
+
+        stringDensity = "Density";
+
+        stringSeed = "Seed";
+
+        stringColors = "Colors";
+
+        stringFixationStep = "Fixation step";
+
+        stringBytesPresented = "Bytes to VRAM";
+        stringViewHelp = "L/R: zoom  Y+pad/touch: pan"; // Max 32 characters
+        stringSpeed = "Speed";
+        stringPaused = "paused";
+        stringStepsPerSecond = "steps/s";
+        stringSpeedHelp = "START:pause SELECT:speed X:step"; // Max 31
+        stringCycle = "Cycle";
+        stringCycleGoOn = "go on";
+        stringCycleRestart = "restart";
+        stringCycleStop = "stop";
+
+        stringDimension = "Dimension";
+        stringRange = "Range";
+        stringThreshold = "Threshold";
+        stringModel = "Model";
+        stringCyclic = "Cyclic";
+
+        stringLargerThanLife = "Larger than Life";
+        stringRule = "Rule";
+        stringBirth = "Birth";
+        stringSurvival = "Survival";
+        stringCustom = "custom";
+
+        stringGenerations = "Generations";
+    }
+    else if (language == ES) // Spanish
+    {
+        stringRuleNumber = "Regla numero"; // It doesn't print 'ú'. Why?
+
+        stringElementaryCellularAutomata = "Automata celular elemental";
+        // max 30 characters
+        stringLangtonsAnt = "Hormiga de Langton"; // max 30 characters
+        stringLangtonsHexagonalAnt = "Hormiga de Langton hexagonal";
+        // max 30 characters
+        stringBooleanAutomata = "Automata booleano"; // max 30 characters
+        stringBooleanHexagonalAutomata = "Automata booleano hexagonal";
+        // max 30 characters
+        stringBooleanTriangularAutomata = "Automata booleano triangular";
+        // max 30 characters
+        stringConwaysGameOfLife = "Juego de la vida de Conway";
+        stringMunchingSquares = "Munching Squares";
+        // max 30 characters
+        stringBMLtrafficModel = "Modelo de trafico BML";
+        stringSelectColors = "Seleccionar colores";
+        // max 30 characters
+        stringCyclicCellularAutomaton = "Automata celular ciclico";
+        stringSteppingStone = "Camino de piedras";
+        stringBackToMainMenu = "Volver al menu principal"; // max 30 characters
+        stringPopulation = "Populacion:";
+
+        stringOneCell = "Una celda";
+        stringRandom = "Aleatorio";
+
+        stringAntsPixels = "Tamano (pixeles)";
+        // It doesn't print 'ñ'. Why?
+        // And "Tamano de la hormiga (pixeles)" is too long. Max 22 characters
+        stringNumStates = "Numero de estados";
+
+        stringVonNeumannNeighborhood = "Vecindad de Von Neumann";
+        stringMooreNeighborhood = "Vecindad de Moore";
+        stringNeighborhood = "Vecindad:";
+
+        stringInitialState ="Estado inicial:";
+        stringAcorn = "Acorn";
+        stringFPentomino = "F-Pentomino";
+        stringFillScreenWithPulsars = "Llenar pantalla de pulsares";
+        stringFillScreenWithPentadecathlons = "Llenar de pentadecatlones";
+        stringRipJohnConway = "DEP JOHN CONWAY";
+        stringPatternLibrary = "Biblioteca";
+        stringNoPatterns = "(vacia)";
+
+        stringBackgroundColor = "Color de fondo:";
+        stringForegroundColor = "Primer color de primer plano:";
+        stringSecondForegroundColor = "Segundo color de primer plano:";
+        stringLineColor = "Color de linea:";
+        stringRed = "Rojo";
+        stringGreen = "Verde";
+        stringBlue = "Azul";
+
+        stringSteps = "Pasos";
+
+        stringAutomataType = "Tipo de automata";
+
+        stringVersion = "version " + strVersionNumber;
+
+        stringSelectLanguage = "Seleccionar lenguaje";
+
+        stringRestart = "Reiniciar";
+
+        stringDensity = "Densidad";
+
+        stringSeed = "Semilla";
+
+        stringColors = "Colores";
+
+        stringFixationStep = "Paso de fijacion";
+
+        stringBytesPresented = "Bytes a la VRAM";
+        stringViewHelp = "L/R: zoom  Y+cruz/tactil: mover";
+        stringSpeed = "Velocidad";
+        stringPaused = "pausa";
+        stringStepsPerSecond = "pasos/s";
+        stringSpeedHelp = "START:pausa SELECT:vel. X:paso";
+        stringCycle = "Ciclo";
+        stringCycleGoOn = "seguir";
+        stringCycleRestart = "reiniciar";
+        stringCycleStop = "parar";
+
+        stringDimension = "Dimension";
+        stringRange = "Rango";
+        stringThreshold = "Umbral";
+        stringModel = "Modelo";
+        stringCyclic = "Ciclico";
+
+        stringLargerThanLife = "Larger than Life";
+        stringRule = "Regla";
+        stringBirth = "Nacimiento";
+        stringSurvival = "Supervivencia";
+        stringCustom = "personalizada";
+
+        stringGenerations = "Generaciones";
+    }
+    else if (language == EU) // Basque
+    {
+        stringRuleNumber = "Arau zenbakia";
+
+        stringElementaryCellularAutomata = "Oinarrizko automata zelularra";
+        // max 30 characters
+        stringLangtonsAnt = "Langton-en inurria"; // max 30 characters
+        stringLangtonsHexagonalAnt = "Langton-en inurri hexagonala";
+        // max 30 characters
+        stringBooleanAutomata = "Automata boolearra"; // max 30 characters
+        stringBooleanHexagonalAutomata = "Automata boolear hexagonala";
+        // max 30 characters
+        stringBooleanTriangularAutomata = "Automata boolear triangularra";
+        // max 30 characters
+        stringConwaysGameOfLife = "Conway-ren biziaren jokoa";
+        stringMunchingSquares = "Munching Squares"; // max 30 characters
+        stringBMLtrafficModel = "BML trafiko eredua";
+        stringCyclicCellularAutomaton = "Automata zelular ziklikoa";
+        stringSteppingStone = "Harri bidea";
+        stringSelectColors = "Hautatu koloreak"; // max 30 characters
+        stringBackToMainMenu = "Itzuli menu nagusira"; // max 30 characters
+        stringPopulation = "Populazioa:";
+
+        stringOneCell = "Gelaxka bat";
+        stringRandom = "Ausazkoa";
+
+        stringAntsPixels = "Tamaina (pixelak)"; // Max 23 characters
+        stringNumStates = "Egoera kopurua";
+        stringVonNeumannNeighborhood = "Von Neumann-en auzoa";
+        stringMooreNeighborhood = "Moore-en auzoa";
+        stringNeighborhood = "Auzoa:";
+
+        stringInitialState ="Hasierako egoera:";
+        stringAcorn = "Acorn";
+        stringFPentomino = "F-Pentomino";
+        stringFillScreenWithPulsars = "Pantaila pulsarekin bete";
+        stringFillScreenWithPentadecathlons = "Pentadekatlonekin bete";
+        stringRipJohnConway = "GB JOHN CONWAY";
+        stringPatternLibrary = "Liburutegia";
+        stringNoPatterns = "(hutsa)";
+
+        stringBackgroundColor = "Atzeko planoaren kolorea:";
+        stringForegroundColor = "Aurreko planoko lehen kolorea:";
+        stringSecondForegroundColor = "Aurreko planoko 2. kolorea:";
+        stringLineColor = "Lerroen kolorea:";
+        stringRed = "Gorria";
+        stringGreen = "Berdea";
+        stringBlue = "Urdina";
+
+        stringSteps = "Pausoak";
+
+        stringAutomataType = "Automata mota";
+
+        stringVersion = strVersionNumber + " bertsioa";
+
+        stringSelectLanguage = "Hautatu hizkuntza";
+
+        stringRestart = "Berrabiarazi";
+
+        stringDensity = "Dentsitatea";
+
+        stringSeed = "Hazia";
+
+        stringColors = "Koloreak";
+
+        stringFixationStep = "Finkapen urratsa";
+
+        stringBytesPresented = "VRAMera byteak";
+        stringViewHelp = "L/R: zoom  Y+gezia/ukitu: mugitu";
+        stringSpeed = "Abiadura";
+        stringPaused = "geldituta";
+        stringStepsPerSecond = "urrats/s";
+        stringSpeedHelp = "START:eten SELECT:abiad. X:bat";
+        stringCycle = "Zikloa";
+        stringCycleGoOn = "jarraitu";
+        stringCycleRestart = "berrabiarazi";
+        stringCycleStop = "gelditu";
+
+        stringDimension = "Dimentsioa";
+        stringRange = "Heina";
+        stringThreshold = "Atalasea";
+        stringModel = "Eredua";
+        stringCyclic = "Ziklikoa";
+
+        stringLargerThanLife = "Larger than Life";
+        stringRule = "Araua";
+        stringBirth = "Jaiotza";
+        stringSurvival = "Biziraupena";
+        stringCustom = "pertsonalizatua";
+
+        stringGenerations = "Belaunaldiak";
+    }
+
+    return 0;
+}
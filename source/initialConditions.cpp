@@ -1,9 +1,23 @@
-#include "framebuffer.h"
-#include "color.h"
+#include <nds.h>
+
+#include "pattern.h"
+
+/*
+ * Functions used to draw initial conditions for the Conway's game of life.
+ *
+ * The patterns are written in RLE and decoded straight into the cells of
+ * the grid (see decodePattern()), that counts their population.
+ */
 
 /*
- * Functions used to draw initial conditions for the Conway's game of life
+ * The patterns, with the top left cell of their bounding box at 0 0
  */
+static const char* pulsarRLE = "x = 5, y = 5\n5o2$b3o2$5o!";
+static const char* fpentominoRLE = "x = 3, y = 3\nb2o$2o$bo!";
+static const char* acornRLE = "x = 7, y = 3\nbo$3bo$2o2b3o!";
+static const char* pentadecathlonRLE = "x = 10, y = 1\n10o!";
+static const char* ripJohnConwayRLE =
+    "x = 7, y = 9\n2b3o$2bobo$2bobo$3bo$ob3o$bobobo$3bo2bo$2bobo$2bobo!";
 
 
 /*
@@ -21,25 +35,24 @@
  *
  * http://www.conwaylife.com/wiki/Pulsar
  */
-int drawPulsar(int intX, int intY)
+int drawPulsar(unsigned char* cells, int intX, int intY, unsigned char cell,
+               unsigned int& population)
 {
-    drawHLine(intX, intY, 5, FG_color, fb);
-    drawHLine(intX + 1, intY + 2, 3, FG_color, fb);
-    drawHLine(intX, intY + 4, 5, FG_color, fb);
-
-    return 0;
+    return decodePattern(pulsarRLE, cells, SCREEN_WIDTH, SCREEN_HEIGHT,
+                         intX, intY, cell, population);
 }
 
 /*
  * Fills the screen with multiple rows and columns of "pulsars".
  */
-int fillScreenWithPulsars()
+int fillScreenWithPulsars(unsigned char* cells, unsigned char cell,
+                          unsigned int& population)
 {
     for (int i = 12; i < 249; i = i + 16)
     {
         for (int j = 12; j < 185; j = j + 16)
         {
-            drawPulsar(i, j);
+            drawPulsar(cells, i, j, cell, population);
         }
     }
 
@@ -63,13 +76,12 @@ int fillScreenWithPulsars()
  *
  * http://www.conwaylife.com/wiki/F-pentomino
  */
-int drawFpentomino(int intX, int intY)
+int drawFpentomino(unsigned char* cells, int intX, int intY,
+                   unsigned char cell, unsigned int& population)
 {
-    drawHLine(intX, intY, 2, FG_color, fb);
-    drawHLine(intX - 1, intY + 1, 2, FG_color, fb);
-    drawHLine(intX, intY + 2, 1, FG_color, fb);
-
-    return 0;
+    // (intX, intY) is the first cell of the top row
+    return decodePattern(fpentominoRLE, cells, SCREEN_WIDTH, SCREEN_HEIGHT,
+                         intX - 1, intY, cell, population);
 }
 
 /*
@@ -84,14 +96,12 @@ int drawFpentomino(int intX, int intY)
  *
  * http://www.conwaylife.com/wiki/Acorn
  */
-int drawAcorn(int intX, int intY)
+int drawAcorn(unsigned char* cells, int intX, int intY, unsigned char cell,
+              unsigned int& population)
 {
-    drawHLine(intX, intY, 1, FG_color, fb);
-    drawHLine(intX + 2, intY + 1, 1, FG_color, fb);
-    drawHLine(intX - 1, intY + 2, 2, FG_color, fb);
-    drawHLine(intX + 3, intY + 2, 3, FG_color, fb);
-
-    return 0;
+    // (intX, intY) is the cell of the top row
+    return decodePattern(acornRLE, cells, SCREEN_WIDTH, SCREEN_HEIGHT,
+                         intX - 1, intY, cell, population);
 }
 
 /*
@@ -115,23 +125,24 @@ int drawAcorn(int intX, int intY)
  *
  * http://www.conwaylife.com/wiki/Pulsar
  */
-int drawPentadecathlon(int intX, int intY)
+int drawPentadecathlon(unsigned char* cells, int intX, int intY,
+                       unsigned char cell, unsigned int& population)
 {
-    drawHLine(intX, intY, 10, FG_color, fb);
-
-    return 0;
+    return decodePattern(pentadecathlonRLE, cells, SCREEN_WIDTH,
+                         SCREEN_HEIGHT, intX, intY, cell, population);
 }
 
 /*
  * Fills the screen with multiple rows and columns of "pentadecathlons".
  */
-int fillScreenWithPentadecathlons()
+int fillScreenWithPentadecathlons(unsigned char* cells, unsigned char cell,
+                                  unsigned int& population)
 {
     for (int i = 11; i < 245; i = i + 17)
     {
         for (int j = 5; j < 191; j = j + 10)
         {
-            drawPentadecathlon(i, j);
+            drawPentadecathlon(cells, i, j, cell, population);
         }
     }
     return 0;
@@ -168,25 +179,10 @@ int fillScreenWithPentadecathlons()
  *           * *
  *
  */
-int drawRIPJohnConway(int intX, int intY)
+int drawRIPJohnConway(unsigned char* cells, int intX, int intY,
+                      unsigned char cell, unsigned int& population)
 {
-   drawHLine(intX, intY, 3, FG_color, fb);
-   drawHLine(intX, intY + 1, 1, FG_color, fb);
-   drawHLine(intX + 2, intY + 1, 1, FG_color, fb);
-   drawHLine(intX, intY + 2, 1, FG_color, fb);
-   drawHLine(intX + 2, intY + 2, 1, FG_color, fb);
-   drawHLine(intX + 1, intY + 3, 1, FG_color, fb);
-   drawHLine(intX - 2, intY + 4, 1, FG_color, fb);
-   drawHLine(intX, intY + 4, 3, FG_color, fb);
-   drawHLine(intX - 1, intY + 5, 1, FG_color, fb);
-   drawHLine(intX + 1, intY + 5, 1, FG_color, fb);
-   drawHLine(intX + 3, intY + 5, 1, FG_color, fb);
-   drawHLine(intX + 1, intY + 6, 1, FG_color, fb);
-   drawHLine(intX + 4, intY + 6, 1, FG_color, fb);
-   drawHLine(intX, intY + 7, 1, FG_color, fb);
-   drawHLine(intX + 2, intY + 7, 1, FG_color, fb);
-   drawHLine(intX, intY + 8, 1, FG_color, fb);
-   drawHLine(intX + 2, intY + 8, 1, FG_color, fb);
-
-    return 0;
+    // (intX, intY) is the first cell of the head
+    return decodePattern(ripJohnConwayRLE, cells, SCREEN_WIDTH,
+                         SCREEN_HEIGHT, intX - 2, intY, cell, population);
 }
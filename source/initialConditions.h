@@ -1,11 +1,18 @@
 #ifndef INITIAL_CONDITIONS_H
 #define INITIAL_CONDITIONS_H
 
-int drawPulsar(int intX, int intY);
-int fillScreenWithPulsars();
-int drawFpentomino(int intX, int intY);
-int drawAcorn(int intX, int intY);
-int drawPentadecathlon(int intX, int intY);
-int fillScreenWithPentadecathlons();
-int drawRIPJohnConway(int intX, int intY);
+int drawPulsar(unsigned char* cells, int intX, int intY, unsigned char cell,
+               unsigned int& population);
+int fillScreenWithPulsars(unsigned char* cells, unsigned char cell,
+                          unsigned int& population);
+int drawFpentomino(unsigned char* cells, int intX, int intY,
+                   unsigned char cell, unsigned int& population);
+int drawAcorn(unsigned char* cells, int intX, int intY, unsigned char cell,
+              unsigned int& population);
+int drawPentadecathlon(unsigned char* cells, int intX, int intY,
+                       unsigned char cell, unsigned int& population);
+int fillScreenWithPentadecathlons(unsigned char* cells, unsigned char cell,
+                                  unsigned int& population);
+int drawRIPJohnConway(unsigned char* cells, int intX, int intY,
+                      unsigned char cell, unsigned int& population);
 #endif
@@ -0,0 +1,430 @@
+#include <nds.h>
+#include <stdio.h>
+
+#include "langtonsant.h"
+#include "cellularautomata.h"
+#include "framebuffer.h"
+#include "hexgrid.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * References:
+ * http://en.wikipedia.org/wiki/Langton%27s_ant
+ * http://mathworld.wolfram.com/LangtonsAnt.html
+ */
+
+/***********************************ANT***************************************/
+
+// Class constructor
+Ant::Ant(int limit, int step)
+{
+    antPosX = 0;
+    antPosY = 0;
+    antAngle = 0;
+    antFinished = false;
+
+    limitAngle = limit;
+    stepAngle = step;
+}
+
+/*
+ * Calculates the new angle of the ant.
+ *
+ * Langton's ant (limitAngle 270, stepAngle 90)
+ * Right ('R'): 0 -> 90 -> 180 -> 270 (limitAngle) -> 0 -> 90 -> ...
+ * Left ('L'): 0 -> 270 (limitAngle) -> 180 -> 90 -> 0 -> 270 -> ...
+ *
+ * Langton's hexagonal ant (limitAngle 300, stepAngle 60)
+ * Right ('R'): 0 -> 60 -> 120 -> 180 -> 240 ->
+ *            300 (limitAngle) -> 0 -> 60 -> ...
+ * Left ('L'): 0 -> 300 (limitAngle) -> 240 ->
+ *           180 -> 120 -> 60 -> 0 -> 300 -> ...
+ */
+int Ant::rotateAnt(unsigned char rotateTo)
+{
+    if (rotateTo == 'R')
+    {
+	if (antAngle < limitAngle)
+	{
+	    antAngle = antAngle + stepAngle;
+	}
+	else
+	{
+	    antAngle = 0;
+	}
+    }
+    else if (rotateTo == 'L')
+    {
+	if (antAngle != 0)
+	{
+	    antAngle = antAngle - stepAngle;
+	}
+	else
+	{
+	    antAngle = limitAngle;
+	}
+    }
+
+    return 0;
+}
+
+/*
+ * Paints the cell where the ant is.
+ * The cell is painted black if it was white
+ * and white if it was black.
+ */
+int Ant::paintAnt(CellularAutomata& automata)
+{
+    if (isCellAlive() == true)
+    {
+        paintCell(CELL_BG);
+        automata.addPopulation(-1); // The population of alive cells decreases
+    }
+    else
+    {
+        paintCell(CELL_FG);
+        automata.addPopulation(1); // The population of alive cells increases
+    }
+
+    return 0;
+}
+
+/*
+ * Moves the ant. It combines 3 functions:
+ * First, depending on the color of the cell, rotates the ant to one side
+ * or the other using rotateAnt().
+ * Next, paints the cell using paintAnt().
+ * Finally, moves the ant to the next cell using forwardAnt().
+ */
+int Ant::nextStep(CellularAutomata& automata)
+{
+    if (isCellAlive() == false)
+    {
+        rotateAnt('R');
+    }
+    else
+    {
+        rotateAnt('L');
+    }
+
+    paintAnt(automata);
+    forwardAnt();
+    automata.countStep();
+
+    // Check if the ant has reached any border of its universe
+    if (isOutside() == true)
+    {
+        antFinished = true;
+    }
+
+    return 0;
+}
+
+bool Ant::hasFinished()
+{
+    return antFinished;
+}
+
+/*
+ * The ant draws its steps straight into the framebuffer, so a frame with
+ * steps waits for the VBlank here (runFrame() waits when the ant is paused
+ * or has finished)
+ */
+int Ant::runFrame(CellularAutomata& automata)
+{
+    if (governor.runFrame(automata) > 0)
+    {
+        printCounters();
+        swiWaitForVBlank();
+    }
+
+    return 0;
+}
+
+/******************************LANGTON'S ANT**********************************/
+
+// Class constructor
+LangtonsAnt::LangtonsAnt() : Ant(270, 90)
+{
+    antNumPixels = LA_INITIAL_NUM_PIXELS;
+}
+
+/*
+ * Prints the number of pixels of the Langton's ant
+ */
+int LangtonsAnt::printAntNumPixels()
+{
+    iprintf("\x1b[%d;%dH%s: < %d > ",
+            LA_MENU_ANT_SIZE_ROW,
+            LA_MENU_ANT_SIZE_COL,
+            stringAntsPixels.c_str(), antNumPixels);
+
+    return 0;
+}
+
+// One pixel per cell
+bool LangtonsAnt::isCellAlive()
+{
+    return indexedFB[antPosY * LA_WIDTH + antPosX] == CELL_FG;
+}
+
+int LangtonsAnt::paintCell(unsigned char index)
+{
+    return setIndexedPixel(indexedFB, LA_WIDTH, antPosX, antPosY, index);
+}
+
+/*
+ * Moves the ant forward to the next cell
+ */
+int LangtonsAnt::forwardAnt()
+{
+    switch (antAngle)
+    {
+	case 0:
+	    antPosX = antPosX + 1;
+	    break;
+	case 90:
+	    antPosY = antPosY - 1;
+	    break;
+	case 180:
+	    antPosX = antPosX - 1;
+	    break;
+	case 270:
+	    antPosY = antPosY + 1;
+	    break;
+    }
+
+    return 0;
+}
+
+/*
+ * The positions are unsigned, so leaving by the left or the top wraps
+ * around to big values
+ */
+bool LangtonsAnt::isOutside()
+{
+    return antPosX >= LA_WIDTH or antPosY >= LA_HEIGHT;
+}
+
+/*
+ * Places the Langton's ant in the middle of its universe, bigger than the
+ * screen
+ */
+int LangtonsAnt::initialize(CellularAutomata& automata)
+{
+    // The ant walks one pixel per cell on a universe bigger than the
+    // screen, the view makes the cells antNumPixels pixels wide
+    showWideIndexedFB();
+    setCellsPalette();
+    cleanWideIndexedFB(CELL_BG);
+    resetView(LA_WIDTH, LA_HEIGHT, antNumPixels * VIEW_ZOOM_ONE);
+
+    antPosX = LA_INITIAL_X;
+    antPosY = LA_INITIAL_Y;
+    antAngle = LA_INITIAL_ANGLE;
+    antFinished = false;
+
+    return 0;
+}
+
+const std::string& LangtonsAnt::getName()
+{
+    return stringLangtonsAnt;
+}
+
+int LangtonsAnt::setDefaults()
+{
+    antNumPixels = LA_INITIAL_NUM_PIXELS;
+
+    return 0;
+}
+
+int LangtonsAnt::printMenu()
+{
+    printAntNumPixels();
+    printString(LA_MENU_BACK_TO_MAIN_ROW,
+                LA_MENU_BACK_TO_MAIN_COL,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+    printString(VIEW_HELP_ROW, VIEW_HELP_COL, stringViewHelp);
+
+    return 0;
+}
+
+int LangtonsAnt::printMenuArrow(int index, bool boolDelete)
+{
+    // The size of the ant (0) or back to main menu (1)
+    if (index == 0)
+    {
+        return printOptionArrow(LA_MENU_ANT_SIZE_ROW, 0, boolDelete);
+    }
+
+    return printOptionArrow(LA_MENU_BACK_TO_MAIN_ROW, 0, boolDelete);
+}
+
+/*
+ * The size of the ant only zooms the view, the ant goes on
+ */
+int LangtonsAnt::updateMenu(CellularAutomata& automata,
+                            int keys_pressed,
+                            int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 1)
+        {
+            // Go back to the selection of the type of automata
+            showAutomataTypeMenu();
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(1);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(1);
+    }
+    else if (keys_pressed & KEY_LEFT)
+    {
+        if (arrow == 0 and antNumPixels > 1)
+        {
+            --antNumPixels;
+            setViewZoom(antNumPixels * VIEW_ZOOM_ONE);
+            printAntNumPixels();
+        }
+    }
+    else if (keys_pressed & KEY_RIGHT)
+    {
+        if (arrow == 0 and antNumPixels < LA_MAX_NUM_PIXELS)
+        {
+            ++antNumPixels;
+            setViewZoom(antNumPixels * VIEW_ZOOM_ONE);
+            printAntNumPixels();
+        }
+    }
+
+    return 0;
+}
+
+/*************************LANGTON'S HEXAGONAL ANT*****************************/
+
+// Class constructor
+HexagonalAnt::HexagonalAnt() : Ant(300, 60)
+{
+}
+
+/*
+ * The cells are palette indexes, the lines of the grid are on their own
+ * layer (see showHexLattice())
+ */
+bool HexagonalAnt::isCellAlive()
+{
+    return indexedFB[antPosY * SCREEN_WIDTH + antPosX] == CELL_FG;
+}
+
+int HexagonalAnt::paintCell(unsigned char index)
+{
+    return paintHexCell(antPosX, antPosY, index, indexedFB);
+}
+
+/*
+ * Moves the ant forward to the next cell
+ */
+int HexagonalAnt::forwardAnt()
+{
+    switch(antAngle)
+    {
+	case 0:
+	    antPosY = antPosY - 4;
+	    break;
+	case 60:
+	    antPosX = antPosX + 4;
+	    antPosY = antPosY - 2;
+	    break;
+	case 120:
+	    antPosX = antPosX + 4;
+	    antPosY = antPosY + 2;
+	    break;
+	case 180:
+	    antPosY = antPosY + 4;
+	    break;
+	case 240:
+	    antPosX = antPosX - 4;
+	    antPosY = antPosY + 2;
+	    break;
+	case 300:
+	    antPosX = antPosX - 4;
+	    antPosY = antPosY - 2;
+	    break;
+    }
+
+    return 0;
+}
+
+/*
+ * The cells of the lattice are 4 pixels wide. The positions are unsigned,
+ * like the ones of the Langton's ant.
+ */
+bool HexagonalAnt::isOutside()
+{
+    return antPosX + 4 > 254 or antPosY + 4 > SCREEN_HEIGHT - 1;
+}
+
+/*
+ * Places the Langton's hexagonal ant in its grid
+ */
+int HexagonalAnt::initialize(CellularAutomata& automata)
+{
+    // The cells are palette indexes of the 8 bits per pixel framebuffer
+    // and the lines of the grid are the lattice over them
+    showIndexedFB();
+    setCellsPalette();
+    cleanIndexedFB(indexedFB, CELL_BG);
+    showHexLattice();
+
+    antPosX = 92;
+    antPosY = 93;
+    antAngle = 0;
+    antFinished = false;
+
+    return 0;
+}
+
+const std::string& HexagonalAnt::getName()
+{
+    return stringLangtonsHexagonalAnt;
+}
+
+int HexagonalAnt::printMenu()
+{
+    printString(LHA_MENU_BACK_TO_MAIN_ROW,
+                LHA_MENU_BACK_TO_MAIN_COL,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+
+    return 0;
+}
+
+int HexagonalAnt::printMenuArrow(int index, bool boolDelete)
+{
+    // Only back to main menu
+    return printOptionArrow(LHA_MENU_BACK_TO_MAIN_ROW, 0, boolDelete);
+}
+
+int HexagonalAnt::updateMenu(CellularAutomata& automata,
+                             int keys_pressed,
+                             int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        // Go back to the selection of the type of automata
+        showAutomataTypeMenu();
+    }
+
+    return 0;
+}
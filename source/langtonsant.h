@@ -0,0 +1,100 @@
+#ifndef LANGTONSANT_H
+#define LANGTONSANT_H
+
+#include <string>
+
+#include "automaton.h"
+
+/*
+ * A Langton's ant: in each step it turns right on a white cell and left on
+ * a black one, flips the color of the cell and moves forward to the next
+ * cell. The cells are palette indexes of the 8 bits per pixel framebuffer.
+ *
+ * The ants only differ in their lattice: the angles they turn (see
+ * rotateAnt()), how their cells are read and painted and where they move.
+ */
+class Ant : public Automaton
+{
+    protected:
+        unsigned short antPosX;
+        unsigned short antPosY;
+        unsigned short antAngle;
+        bool antFinished;
+
+        int limitAngle; // The last angle before 0
+        int stepAngle;  // The angle of a turn
+
+        int rotateAnt(unsigned char rotateTo);
+        int paintAnt(CellularAutomata& automata);
+
+        virtual bool isCellAlive() = 0;
+        virtual int paintCell(unsigned char index) = 0;
+        virtual int forwardAnt() = 0;
+        virtual bool isOutside() = 0;
+
+    public:
+        Ant(int limit, int step);
+
+        virtual int nextStep(CellularAutomata& automata);
+        virtual bool hasFinished();
+
+        virtual int runFrame(CellularAutomata& automata);
+};
+
+/*
+ * The Langton's ant of the square lattice, on a universe bigger than the
+ * screen (LA_WIDTH x LA_HEIGHT cells, one pixel per cell) whose view makes
+ * the cells antNumPixels pixels wide
+ */
+class LangtonsAnt : public Ant
+{
+    private:
+        int antNumPixels;
+
+        int printAntNumPixels();
+
+    protected:
+        virtual bool isCellAlive();
+        virtual int paintCell(unsigned char index);
+        virtual int forwardAnt();
+        virtual bool isOutside();
+
+    public:
+        LangtonsAnt();
+
+        virtual int initialize(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+/*
+ * The Langton's ant of the hexagonal lattice (see showHexLattice())
+ */
+class HexagonalAnt : public Ant
+{
+    protected:
+        virtual bool isCellAlive();
+        virtual int paintCell(unsigned char index);
+        virtual int forwardAnt();
+        virtual bool isOutside();
+
+    public:
+        HexagonalAnt();
+
+        virtual int initialize(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
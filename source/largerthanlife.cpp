@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "largerthanlife.h"
+
+/*
+ * A rule with a name
+ */
+struct LargerThanLifePreset
+{
+    const char* name;
+    int range;
+    bool middle;
+    int survivalMin;
+    int survivalMax;
+    int birthMin;
+    int birthMax;
+};
+
+/*
+ * The rules of LTL_PRESET_BOSCO... (from the rules of Golly and MCell)
+ */
+static const LargerThanLifePreset presets[LTL_NUM_PRESETS] =
+{
+    {"Bosco", 5, true, 34, 58, 34, 45},
+    {"Majority", 4, true, 41, 81, 41, 81},
+    {"Waffle", 7, true, 100, 200, 75, 170},
+    {"Globe", 8, false, 163, 223, 74, 252},
+    {"Life", 1, false, 2, 3, 3, 3}
+};
+
+/*
+ * Sets the range, the middle, the survival and the birth of the rule to
+ * the ones of the preset (LTL_PRESET_BOSCO...)
+ */
+int setLargerThanLifePreset(LargerThanLifeRule& rule, int preset)
+{
+    if (preset < 0 or preset >= LTL_NUM_PRESETS)
+    {
+        return 0;
+    }
+
+    rule.range = presets[preset].range;
+    rule.middle = presets[preset].middle;
+    rule.survivalMin = presets[preset].survivalMin;
+    rule.survivalMax = presets[preset].survivalMax;
+    rule.birthMin = presets[preset].birthMin;
+    rule.birthMax = presets[preset].birthMax;
+
+    return 0;
+}
+
+/*
+ * Returns the name of the preset, NULL for LTL_PRESET_CUSTOM
+ */
+const char* getLargerThanLifePresetName(int preset)
+{
+    if (preset < 0 or preset >= LTL_NUM_PRESETS)
+    {
+        return NULL;
+    }
+
+    return presets[preset].name;
+}
+
+/*
+ * Writes the rule like R5,C0,M1,S34..58,B34..45,NM in text (size bytes)
+ */
+int formatLargerThanLifeRule(const LargerThanLifeRule& rule,
+                             char* text, int size)
+{
+    snprintf(text, size, "R%d,C0,M%d,S%d..%d,B%d..%d,NM", rule.range,
+             rule.middle == true ? 1 : 0, rule.survivalMin,
+             rule.survivalMax, rule.birthMin, rule.birthMax);
+
+    return 0;
+}
+
+/*
+ * Reads a rule like R5,C0,M1,S34..58,B34..45,NM, or the name of a preset
+ * (in any case). Only the two states (C0 or C2) and the Moore neighborhood
+ * are supported. Returns false if it isn't a rule.
+ */
+bool parseLargerThanLifeRule(const char* text, LargerThanLifeRule& rule)
+{
+    int range;
+    int states;
+    int middle;
+    int survivalMin;
+    int survivalMax;
+    int birthMin;
+    int birthMax;
+    char neighborhood[3] = "NM";
+
+    for (int i = 0; i < LTL_NUM_PRESETS; ++i)
+    {
+        if (strcasecmp(text, presets[i].name) == 0)
+        {
+            setLargerThanLifePreset(rule, i);
+            return true;
+        }
+    }
+
+    int read = sscanf(text, "R%d,C%d,M%d,S%d..%d,B%d..%d,%2s", &range,
+                      &states, &middle, &survivalMin, &survivalMax,
+                      &birthMin, &birthMax, neighborhood);
+
+    if (read < 7 or range < LTL_MIN_RANGE or range > LTL_MAX_RANGE or
+        states > 2 or (middle != 0 and middle != 1) or
+        strcmp(neighborhood, "NM") != 0)
+    {
+        return false;
+    }
+
+    rule.range = range;
+    rule.middle = middle == 1;
+    rule.survivalMin = survivalMin;
+    rule.survivalMax = survivalMax;
+    rule.birthMin = birthMin;
+    rule.birthMax = birthMax;
+
+    return true;
+}
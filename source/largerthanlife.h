@@ -0,0 +1,87 @@
+#ifndef LARGERTHANLIFE_H
+#define LARGERTHANLIFE_H
+
+#include "globals.h"
+
+/*
+ * Range of the neighborhood of Larger than Life
+ */
+#define LTL_MIN_RANGE 1
+#define LTL_MAX_RANGE 10
+
+/*
+ * Rules of Larger than Life with a name (see setLargerThanLifePreset()).
+ * LTL_PRESET_CUSTOM is a rule changed in the menu.
+ */
+#define LTL_PRESET_CUSTOM -1
+#define LTL_PRESET_BOSCO 0    // R5,C0,M1,S34..58,B34..45,NM
+#define LTL_PRESET_MAJORITY 1 // R4,C0,M1,S41..81,B41..81,NM
+#define LTL_PRESET_WAFFLE 2   // R7,C0,M1,S100..200,B75..170,NM
+#define LTL_PRESET_GLOBE 3    // R8,C0,M0,S163..223,B74..252,NM
+#define LTL_PRESET_LIFE 4     // R1,C0,M0,S2..3,B3..3,NM
+#define LTL_NUM_PRESETS 5
+
+/*
+ * The rule of a new run and the percentage of live cells of its random
+ * initial state
+ */
+#define LTL_INITIAL_PRESET LTL_PRESET_BOSCO
+#define LTL_INITIAL_DENSITY 50
+
+/*
+ * Longest rule written by formatLargerThanLifeRule()
+ */
+#define LTL_RULE_LENGTH 40
+
+/*
+ * Larger than Life: the game of life with the box of range cells around
+ * each cell (the Moore neighborhood of range range) as its neighborhood. A
+ * live cell survives if the number of live cells of its box is between
+ * survivalMin and survivalMax, and a dead one is born if it's between
+ * birthMin and birthMax. The live cell itself is counted if middle is true.
+ *
+ * The neighbors are counted by SummedAreaStencil (see stencil.h) and the
+ * rules are written like Evans and Golly do: R5,C0,M1,S34..58,B34..45,NM
+ * is the range, 2 states, middle, survival, birth and the neighborhood
+ * (NM: Moore).
+ */
+struct LargerThanLifeRule
+{
+    unsigned char state;
+    int range;
+    bool middle;
+    int birthMin;
+    int birthMax;
+    int survivalMin;
+    int survivalMax;
+
+    unsigned char next(unsigned char cell, int count)
+    {
+        if (cell == state)
+        {
+            count = middle == true ? count : count - 1;
+
+            return count >= survivalMin and count <= survivalMax ?
+                   state : CELL_BG;
+        }
+
+        return count >= birthMin and count <= birthMax and cell == CELL_BG ?
+               state : cell;
+    }
+
+    // The highest count of a cell (the live cells of a full box)
+    int getMaxCount()
+    {
+        int side = 2 * range + 1;
+
+        return middle == true ? side * side : side * side - 1;
+    }
+};
+
+int setLargerThanLifePreset(LargerThanLifeRule& rule, int preset);
+const char* getLargerThanLifePresetName(int preset);
+int formatLargerThanLifeRule(const LargerThanLifeRule& rule,
+                             char* text, int size);
+bool parseLargerThanLifeRule(const char* text, LargerThanLifeRule& rule);
+
+#endif
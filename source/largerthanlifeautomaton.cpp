@@ -0,0 +1,416 @@
+#include <stdio.h>
+
+#include <nds.h>
+
+#include "largerthanlifeautomaton.h"
+#include "cellularautomata.h"
+#include "stencil.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * References:
+ * http://www.conwaylife.com/wiki/Larger_than_Life
+ * http://psoup.math.wisc.edu/mcell/rullex_lgtl.html
+ */
+
+// The rows and the columns of the arrow of the options of the menu
+static const int LTL_MENU_ROWS[] =
+    {LTL_MENU_PRESET_ROW,
+     LTL_MENU_RANGE_ROW,
+     LTL_MENU_BIRTH_MIN_ROW,
+     LTL_MENU_BIRTH_MAX_ROW,
+     LTL_MENU_SURVIVAL_MIN_ROW,
+     LTL_MENU_SURVIVAL_MAX_ROW,
+     LTL_MENU_BACK_TO_MAIN_ROW};
+static const int LTL_MENU_ARROW_COLUMNS[] =
+    {LTL_MENU_PRESET_ARROW_COL,
+     LTL_MENU_RANGE_ARROW_COL,
+     LTL_MENU_BIRTH_MIN_ARROW_COL,
+     LTL_MENU_BIRTH_MAX_ARROW_COL,
+     LTL_MENU_SURVIVAL_MIN_ARROW_COL,
+     LTL_MENU_SURVIVAL_MAX_ARROW_COL,
+     LTL_MENU_BACK_TO_MAIN_ARROW_COL};
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Sets the range, the birth and the survival to the ones of the preset
+ */
+int LargerThanLifeAutomaton::setPreset(int newPreset)
+{
+    setLargerThanLifePreset(rule, newPreset);
+
+    preset = newPreset;
+
+    return 0;
+}
+
+/*
+ * Keeps the counts of the birth and the survival within the highest count
+ * of the range
+ */
+int LargerThanLifeAutomaton::clampCounts()
+{
+    int maxCount = rule.getMaxCount();
+
+    rule.birthMin = rule.birthMin > maxCount ? maxCount : rule.birthMin;
+    rule.birthMax = rule.birthMax > maxCount ? maxCount : rule.birthMax;
+    rule.survivalMin = rule.survivalMin > maxCount ?
+                       maxCount : rule.survivalMin;
+    rule.survivalMax = rule.survivalMax > maxCount ?
+                       maxCount : rule.survivalMax;
+
+    return 0;
+}
+
+/*
+ * Gives life to LTL_INITIAL_DENSITY percent of the cells of the grid, at
+ * random
+ */
+int LargerThanLifeAutomaton::drawInitialState(CellularAutomata& automata)
+{
+    RandomNumberGenerator& rng = automata.getRandomNumbers();
+    unsigned char* cells = grid.getCells();
+    unsigned int population = 0;
+
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; ++i)
+    {
+        if (rng.nextBelow(100) < LTL_INITIAL_DENSITY)
+        {
+            cells[i] = CELL_FG;
+            ++population;
+        }
+    }
+
+    automata.setPopulation(population);
+
+    return 0;
+}
+
+/*
+ * Prints the rule with a name, or custom
+ */
+int LargerThanLifeAutomaton::printPreset()
+{
+    const char* name = getLargerThanLifePresetName(preset);
+
+    // Erase the previous name (the names have different lengths)
+    iprintf("\x1b[%d;%dH%s", LTL_MENU_PRESET_ROW, LTL_MENU_PRESET_COL,
+            "                              ");
+
+    iprintf("\x1b[%d;%dH%s: < %s >",
+            LTL_MENU_PRESET_ROW,
+            LTL_MENU_PRESET_COL,
+            stringRule.c_str(),
+            name == NULL ? stringCustom.c_str() : name);
+
+    return 0;
+}
+
+/*
+ * Prints the range of the neighborhood
+ */
+int LargerThanLifeAutomaton::printRange()
+{
+    iprintf("\x1b[%d;%dH%s: < %d > ",
+            LTL_MENU_RANGE_ROW,
+            LTL_MENU_RANGE_COL,
+            stringRange.c_str(), rule.range);
+
+    return 0;
+}
+
+/*
+ * Prints the counts of live neighbors that give birth to a cell
+ */
+int LargerThanLifeAutomaton::printBirth()
+{
+    iprintf("\x1b[%d;%dH%s min: < %d >   ",
+            LTL_MENU_BIRTH_MIN_ROW,
+            LTL_MENU_BIRTH_MIN_COL,
+            stringBirth.c_str(), rule.birthMin);
+    iprintf("\x1b[%d;%dH%s max: < %d >   ",
+            LTL_MENU_BIRTH_MAX_ROW,
+            LTL_MENU_BIRTH_MAX_COL,
+            stringBirth.c_str(), rule.birthMax);
+
+    return 0;
+}
+
+/*
+ * Prints the counts of live neighbors that keep a cell alive
+ */
+int LargerThanLifeAutomaton::printSurvival()
+{
+    iprintf("\x1b[%d;%dH%s min: < %d >   ",
+            LTL_MENU_SURVIVAL_MIN_ROW,
+            LTL_MENU_SURVIVAL_MIN_COL,
+            stringSurvival.c_str(), rule.survivalMin);
+    iprintf("\x1b[%d;%dH%s max: < %d >   ",
+            LTL_MENU_SURVIVAL_MAX_ROW,
+            LTL_MENU_SURVIVAL_MAX_COL,
+            stringSurvival.c_str(), rule.survivalMax);
+
+    return 0;
+}
+
+/*
+ * Prints the whole rule (R5,C0,M1,S34..58,B34..45,NM)
+ */
+int LargerThanLifeAutomaton::printRule()
+{
+    char text[LTL_RULE_LENGTH];
+
+    formatLargerThanLifeRule(rule, text, sizeof(text));
+
+    iprintf("\x1b[%d;%dH%s", LTL_MENU_RULE_ROW, LTL_MENU_RULE_COL,
+            "                              ");
+    iprintf("\x1b[%d;%dH%s", LTL_MENU_RULE_ROW, LTL_MENU_RULE_COL, text);
+
+    return 0;
+}
+
+/*
+ * Prints all the options of Larger than Life
+ */
+int LargerThanLifeAutomaton::printOptions()
+{
+    printPreset();
+    printRange();
+    printBirth();
+    printSurvival();
+    printRule();
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+LargerThanLifeAutomaton::LargerThanLifeAutomaton()
+{
+    rule.state = CELL_FG;
+
+    setPreset(LTL_INITIAL_PRESET);
+}
+
+/*
+ * Gives life to random cells of the grid
+ */
+int LargerThanLifeAutomaton::initialize(CellularAutomata& automata)
+{
+    // The initial state is written straight into the grid
+    clearGrid();
+
+    drawInitialState(automata);
+
+    startGrid(automata);
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation of Larger than Life. The borders wrap
+ * around, like the ones of the cyclic cellular automata.
+ */
+int LargerThanLifeAutomaton::nextStep(CellularAutomata& automata)
+{
+    int changes;
+    int populationChange;
+
+    automata.countStep();
+
+    changes = SummedAreaStencil<WrapBorder, LargerThanLifeRule>::step(
+                  grid, rule, summedAreaTable, populationChange);
+
+    automata.addPopulation(populationChange);
+
+    // Every cell is dead: start again, like the game of life
+    if (changes == 0 and automata.getPopulation() == 0)
+    {
+        automata.restart();
+    }
+    else
+    {
+        swapGrid(automata);
+    }
+
+    return 0;
+}
+
+/*
+ * Frees the grid and the summed-area table
+ */
+int LargerThanLifeAutomaton::release()
+{
+    GridAutomaton::release();
+
+    return summedAreaTable.release();
+}
+
+const std::string& LargerThanLifeAutomaton::getName()
+{
+    return stringLargerThanLife;
+}
+
+int LargerThanLifeAutomaton::setDefaults()
+{
+    return setPreset(LTL_INITIAL_PRESET);
+}
+
+int LargerThanLifeAutomaton::printMenu()
+{
+    printOptions();
+    printString(LTL_MENU_BACK_TO_MAIN_ROW,
+                LTL_MENU_BACK_TO_MAIN_COL,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+    printString(VIEW_HELP_ROW, VIEW_HELP_COL, stringViewHelp);
+
+    return 0;
+}
+
+int LargerThanLifeAutomaton::printMenuArrow(int index, bool boolDelete)
+{
+    return printOptionArrow(LTL_MENU_ROWS[index],
+                            LTL_MENU_ARROW_COLUMNS[index],
+                            boolDelete);
+}
+
+/*
+ * LEFT and RIGHT change the option of the arrow (the rule becomes a custom
+ * one) and start the automata again with the new rule
+ */
+int LargerThanLifeAutomaton::updateMenu(CellularAutomata& automata,
+                                        int keys_pressed,
+                                        int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 6) // Back to the main menu
+        {
+            showAutomataTypeMenu();
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(6);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(6);
+    }
+    else if (keys_pressed & (KEY_LEFT | KEY_RIGHT))
+    {
+        int delta = (keys_pressed & KEY_LEFT) ? -1 : 1;
+        int maxCount = rule.getMaxCount();
+        bool changed = true;
+
+        if (arrow == 0) // Rule with a name
+        {
+            // A custom rule goes back to the first (or last) one
+            int next = preset + delta;
+
+            if (preset == LTL_PRESET_CUSTOM)
+            {
+                next = delta > 0 ? 0 : LTL_NUM_PRESETS - 1;
+            }
+            else if (next < 0)
+            {
+                next = LTL_NUM_PRESETS - 1;
+            }
+            else if (next >= LTL_NUM_PRESETS)
+            {
+                next = 0;
+            }
+
+            setPreset(next);
+        }
+        else if (arrow == 1) // Range
+        {
+            if (rule.range + delta >= LTL_MIN_RANGE and
+                rule.range + delta <= LTL_MAX_RANGE)
+            {
+                // The counts are kept, up to the new maximum count
+                rule.range = rule.range + delta;
+                clampCounts();
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else if (arrow == 2) // Birth min
+        {
+            if (rule.birthMin + delta >= 1 and
+                rule.birthMin + delta <= rule.birthMax)
+            {
+                rule.birthMin = rule.birthMin + delta;
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else if (arrow == 3) // Birth max
+        {
+            if (rule.birthMax + delta >= rule.birthMin and
+                rule.birthMax + delta <= maxCount)
+            {
+                rule.birthMax = rule.birthMax + delta;
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else if (arrow == 4) // Survival min
+        {
+            if (rule.survivalMin + delta >= 0 and
+                rule.survivalMin + delta <= rule.survivalMax)
+            {
+                rule.survivalMin = rule.survivalMin + delta;
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else if (arrow == 5) // Survival max
+        {
+            if (rule.survivalMax + delta >= rule.survivalMin and
+                rule.survivalMax + delta <= maxCount)
+            {
+                rule.survivalMax = rule.survivalMax + delta;
+            }
+            else
+            {
+                changed = false;
+            }
+        }
+        else
+        {
+            changed = false;
+        }
+
+        if (changed == true)
+        {
+            // Only the presets have a name
+            if (arrow != 0)
+            {
+                preset = LTL_PRESET_CUSTOM;
+            }
+
+            printOptions();
+
+            automata.initialize();
+            printPopulation();
+            printNumSteps();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#ifndef LARGERTHANLIFEAUTOMATON_H
+#define LARGERTHANLIFEAUTOMATON_H
+
+#include <string>
+
+#include "automaton.h"
+#include "largerthanlife.h"
+#include "summedarea.h"
+
+/*
+ * Larger than Life: the game of life with a bigger neighborhood (see
+ * LargerThanLifeRule), on a grid whose borders wrap around. Its rule is
+ * one of the presets or a custom one changed in the menu.
+ */
+class LargerThanLifeAutomaton : public GridAutomaton
+{
+    private:
+        int preset; // LTL_PRESET_BOSCO... or LTL_PRESET_CUSTOM
+        LargerThanLifeRule rule;
+
+        // The counts of the live neighbors (see SummedAreaStencil)
+        SummedAreaTable summedAreaTable;
+
+        int setPreset(int newPreset);
+        int clampCounts();
+        int drawInitialState(CellularAutomata& automata);
+
+        int printPreset();
+        int printRange();
+        int printBirth();
+        int printSurvival();
+        int printRule();
+        int printOptions();
+
+    public:
+        LargerThanLifeAutomaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+        virtual int release();
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
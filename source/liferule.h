@@ -0,0 +1,47 @@
+#ifndef LIFERULE_H
+#define LIFERULE_H
+
+#include <stdint.h>
+
+#include "globals.h"
+
+/*
+ * The rule of the game of life on the stencil engine (see stencil.h), run
+ * by the automata and by the soup search (see soup.h)
+ */
+
+/*
+ * Conway's game of life:
+ * Any live cell with fewer than two live neighbours dies, as if caused by
+ * under-population.
+ * Any live cell with two or three live neighbours lives on to the next
+ * generation.
+ * Any live cell with more than three live neighbours dies, as if by
+ * overcrowding.
+ * Any dead cell with exactly three live neighbours becomes a live cell, as
+ * if by reproduction.
+ */
+struct LifeRule
+{
+    unsigned char state;
+
+    unsigned char next(unsigned char cell, int count)
+    {
+        if (cell == CELL_FG)
+        {
+            return count == 2 or count == 3 ? CELL_FG : CELL_BG;
+        }
+
+        return count == 3 and cell == CELL_BG ? CELL_FG : cell;
+    }
+
+    // The next generation of 32 live (1) or dead cells from the planes of
+    // their counts (see ChunkedStencil): the ones with 3 neighbors and the
+    // live ones with 2
+    uint32_t nextCells(uint32_t cells, const uint32_t* planes)
+    {
+        return planes[1] & ~planes[2] & ~planes[3] & (planes[0] | cells);
+    }
+};
+
+#endif
@@ -17,6 +17,8 @@
 */
 
 #include <nds.h>
+#include <filesystem.h>
+#include <fat.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
@@ -24,8 +26,186 @@
 #include "framebuffer.h"
 #include "color.h"
 #include "cellularautomata.h"
+#include "automata.h"
 #include "globals.h"
 #include "menus.h"
+#include "random_numbers.h"
+
+/*
+ * Returns true if the menu shows an automata drawn one pixel per cell in
+ * the 8 bits per pixel framebuffer, whose view can be zoomed and panned
+ */
+static bool hasView(int menu)
+{
+    return (CellularAutomata::getAutomatonFeatures(menu) &
+            AUTOMATON_VIEW) != 0;
+}
+
+/*
+ * Zooms the view while L (out) or R (in) are held, and pans it with the
+ * D-pad while Y is held or by dragging the stylus on the touch screen
+ */
+static int updateView(int keys_pressed,
+                      int keys_held,
+                      const touchPosition& touch)
+{
+    static int lastTouchX = 0;
+    static int lastTouchY = 0;
+
+    if (keys_held & KEY_R)
+    {
+        zoomView(1);
+    }
+    else if (keys_held & KEY_L)
+    {
+        zoomView(-1);
+    }
+
+    if (keys_held & KEY_Y)
+    {
+        int dx = 0;
+        int dy = 0;
+
+        if (keys_held & KEY_LEFT)
+        {
+            dx = -VIEW_PAN_STEP;
+        }
+        else if (keys_held & KEY_RIGHT)
+        {
+            dx = VIEW_PAN_STEP;
+        }
+
+        if (keys_held & KEY_UP)
+        {
+            dy = -VIEW_PAN_STEP;
+        }
+        else if (keys_held & KEY_DOWN)
+        {
+            dy = VIEW_PAN_STEP;
+        }
+
+        if (dx != 0 or dy != 0)
+        {
+            ca.pan(dx, dy);
+        }
+    }
+
+    // The universe follows the stylus
+    if (keys_pressed & KEY_TOUCH)
+    {
+        lastTouchX = touch.px;
+        lastTouchY = touch.py;
+    }
+    else if (keys_held & KEY_TOUCH)
+    {
+        ca.pan(lastTouchX - touch.px, lastTouchY - touch.py);
+
+        lastTouchX = touch.px;
+        lastTouchY = touch.py;
+    }
+
+    return 0;
+}
+
+/*
+ * Returns true if the number of steps per frame of the automata of the menu
+ * is decided by the governor (see governor.h)
+ */
+static bool hasGovernor(int menu)
+{
+    return (CellularAutomata::getAutomatonFeatures(menu) &
+            AUTOMATON_GOVERNOR) != 0;
+}
+
+/*
+ * Pauses and resumes the automata (START), changes the speed (SELECT) and
+ * runs a single step while paused (X)
+ */
+static int updateGovernor(int keys_pressed)
+{
+    if (keys_pressed & KEY_START)
+    {
+        governor.togglePause();
+    }
+    else if (keys_pressed & KEY_SELECT)
+    {
+        governor.nextSpeed();
+    }
+    else if (keys_pressed & KEY_X)
+    {
+        governor.requestSingleStep();
+    }
+
+    printSpeed();
+
+    return 0;
+}
+
+/*
+ * Returns true if the cycles of the automata of the menu are found (see
+ * cycles.h)
+ */
+static bool hasCycles(int menu)
+{
+    return (CellularAutomata::getAutomatonFeatures(menu) &
+            AUTOMATON_CYCLES) != 0;
+}
+
+/*
+ * Changes what the automata does when it finds a cycle (B): go on, start
+ * again or stop
+ */
+static int updateCycles(int keys_pressed)
+{
+    if (keys_pressed & KEY_B)
+    {
+        ca.nextCycleAction();
+    }
+
+    printCycle();
+
+    return 0;
+}
+
+/*
+ * Starts the automata chosen in the main menu: its menu with the default
+ * settings and a new seed
+ */
+static int startAutomata(int type)
+{
+    Automaton* automaton = CellularAutomata::findAutomaton(type)->automaton;
+
+    ca.setType(type);
+
+    consoleClear();
+    automaton->printTitle();
+
+    displayedMenu = type;
+
+    automaton->setDefaults();
+    automaton->printMenu();
+
+    // Each run starts with a new seed (it's printed below so the run can be
+    // replayed)
+    ca.setSeed(makeRandomSeed());
+
+    ca.initialize();
+
+    // After the initialization: the arrow of the rules of the Elementary
+    // Cellular Automata is drawn in the top screen
+    automaton->resetArrow();
+    automaton->printCounters();
+
+    // The automata that use random numbers
+    if ((CellularAutomata::getAutomatonFeatures(type) & AUTOMATON_SEED) != 0)
+    {
+        printSeed();
+    }
+
+    automaton->printMenuAsterisks();
+
+    return 0;
+}
 
 /*************************** START MAIN FUNCTION *****************************/
 
@@ -40,24 +220,26 @@ int main(void)
     touchPosition touch;
 
     /*
-     * The position of the arrow
-     * Select automata menu: ????
-     * Elementary Cellular Automata:
-     * in the top screen (0-7) and in the bottom screen (8)
-     * Langton's ant: ????
-     * Langton's hexagonal ant: ????
-     * Boolean automata menu: ?????
-     * Boolean Hexagonal Automata menu: ????
-     * Boolean Triangular Automata menu: ????
-     * Conway's game of life: ????
-     * Munching Squares: in the bottom screen (0-2)
-     * Select colors: ????
-     * Select language: ????
+     * The position of the arrow of the initial language selection menu
+     * (EN, ES or EU). The menus of the automata have their own arrow (see
+     * Automaton::updateMenu()).
      */
-    int intArrow = 0;
+    int intArrow = EN;
 
     consoleDemoInit();
 
+    // The pattern library of the game of life: the files of NitroFS (the
+    // nitrofiles folder, inside the .nds), or the ones of the card
+    if (nitroFSInit(NULL) == true)
+    {
+        patternLibrary.open(PATTERN_NITROFS_DIRECTORY);
+    }
+
+    if (patternLibrary.getNumPatterns() == 0 and fatInitDefault() == true)
+    {
+        patternLibrary.open(PATTERN_FAT_DIRECTORY);
+    }
+
     showInitialLanguageSelectionMenu();
 
 /*    printf("This program is free software:\n");
@@ -97,6 +279,28 @@ int main(void)
 	keys_held = keysHeld();
 	keys_released = keysUp();
 
+        if (hasGovernor(displayedMenu) == true)
+        {
+            updateGovernor(keys_pressed);
+        }
+
+        if (hasCycles(displayedMenu) == true)
+        {
+            updateCycles(keys_pressed);
+        }
+
+        if (hasView(displayedMenu) == true)
+        {
+            updateView(keys_pressed, keys_held, touch);
+
+            // While Y is held the D-pad pans, it doesn't move the arrow
+            if (keys_held & KEY_Y)
+            {
+                keys_pressed &= ~(KEY_UP | KEY_DOWN | KEY_LEFT | KEY_RIGHT);
+                keys_released &= ~(KEY_UP | KEY_DOWN | KEY_LEFT | KEY_RIGHT);
+            }
+        }
+
         /*
         * The initial language selection menu
         */
@@ -105,39 +309,38 @@ int main(void)
             if (keys_released & KEY_UP)
             {
                 // Delete previous arrow
-                printMenuArrow(displayedMenu, intArrow, true);
+                printInitialLanguageMenuArrow(intArrow, true);
 
-                if (intArrow != 0)
+                if (intArrow != EN)
                 {
                     intArrow = intArrow - 1;
                 }
                 else
                 {
-                    intArrow = 2;
+                    intArrow = EU;
                 }
                 // Print new arrow
-                printMenuArrow(displayedMenu, intArrow, false);
+                printInitialLanguageMenuArrow(intArrow, false);
             }
             else if (keys_released & KEY_DOWN)
             {
                 // Delete previous arrow
-                printMenuArrow(displayedMenu, intArrow, true);
+                printInitialLanguageMenuArrow(intArrow, true);
 
-                if (intArrow != 2)
+                if (intArrow != EU)
                 {
                     intArrow = intArrow + 1;
                 }
                 else
                 {
-                    intArrow = 0;
+                    intArrow = EN;
                 }
                 // Print new arrow
-                printMenuArrow(displayedMenu, intArrow, false);
+                printInitialLanguageMenuArrow(intArrow, false);
             }
             else if (keys_released & KEY_A)
             {
                 setInitialLanguage(intArrow);
-                //displayedLanguage = intArrow;
 
                 showAutomataTypeMenu();
             }
@@ -150,7 +353,7 @@ int main(void)
             if (keys_released & KEY_UP)
             {
                 // Delete previous arrow
-                printMenuArrow(displayedMenu, automataType, true);
+                printAutomataTypeMenuArrow(automataType, true);
 
                 if (automataType != ELEMENTARY_CELLULAR_AUTOMATA)
                 {
@@ -161,12 +364,12 @@ int main(void)
                     automataType = SELECT_LANGUAGE;
                 }
                 // Print new arrow
-                printMenuArrow(displayedMenu, automataType, false);
+                printAutomataTypeMenuArrow(automataType, false);
             }
             else if (keys_released & KEY_DOWN)
             {
                 // Delete previous arrow
-                printMenuArrow(displayedMenu, automataType, true);
+                printAutomataTypeMenuArrow(automataType, true);
 
                 if (automataType != SELECT_LANGUAGE)
                 {
@@ -178,1421 +381,25 @@ int main(void)
                 }
 
                 // Print new arrow
-                printMenuArrow(displayedMenu, automataType, false);
+                printAutomataTypeMenuArrow(automataType, false);
             }
             else if (keys_released & KEY_A)
             {
-                ca.setType(automataType);
-
-                consoleClear();
-
-                if (automataType != SELECT_COLORS)
-                {
-                    printCredits();
-                }
-
-		printAutomataType(automataType);
-
-                intArrow = 0;
-
-                displayedMenu = automataType;
-
-                if (automataType == LANGTON_ANT)
-                {
-                    ca.setAntNumPixels(LA_INITIAL_NUM_PIXELS);
-                }
-                else if (automataType == BOOLEAN_AUTOMATA)
-                {
-                    // Von Neumann neighborhood (default)
-                    ca.setTypeOfNeighborhood(VON_NEUMANN_NEIGHBORHOOD);
-
-                    ca.setDefaultBooleanRuleValues();
-                }
-                else if (automataType == BOOLEAN_HEXAGONAL_AUTOMATA)
-                {
-                    ca.setDefaultBooleanRuleValues();
-                }
-                else if (automataType == BOOLEAN_TRIANGULAR_AUTOMATA)
-                {
-                    // Von Neumann neighborhood (default)
-                    ca.setTypeOfNeighborhood(VON_NEUMANN_NEIGHBORHOOD);
-
-                    ca.setDefaultBooleanRuleValues();
-                }
-                else if (automataType == CONWAYS_GAME_OF_LIFE)
-                {
-                    ca.setInitialState(ACORN);
-                }
-                else if (automataType == CYCLIC_CELLULAR_AUTOMATA)
-                {
-                    ca.setNumStates(CCA_INITIAL_NUM_STATES);
-                }
-
-                if (automataType != ELEMENTARY_CELLULAR_AUTOMATA)
-                {
-                    printMenuArrow(displayedMenu, intArrow, false);
-                }
-
-                printMenu(displayedMenu);
-
-                ca.initialize();
-
-                if (automataType == ELEMENTARY_CELLULAR_AUTOMATA)
-                {
-                    // The rule number must be printed after
-                    //  the initialization of the automata
-                    printRuleNumber(ca.getRuleNumber());
-
-                    // Draw the arrow in the default position
-                    // (intArrow = 0, top left rule (2^7),
-                    //  set in ca.initialize())
-                    ca.drawArrow(intArrow, line_color);
-                }
-
-                // Include the other types of automata when the population
-                // count for them is implemented
-                if (automataType == ELEMENTARY_CELLULAR_AUTOMATA ||
-                    automataType == LANGTON_ANT ||
-                    automataType == LANGTON_HEXAGONAL_ANT ||
-                    automataType == BOOLEAN_AUTOMATA ||
-                    automataType == BOOLEAN_HEXAGONAL_AUTOMATA ||
-                    automataType == BOOLEAN_TRIANGULAR_AUTOMATA ||
-                    automataType == CONWAYS_GAME_OF_LIFE ||
-                    automataType == BML_TRAFFIC_MODEL)
-                {
-                    printPopulation();
-                }
-
-                if (automataType == ELEMENTARY_CELLULAR_AUTOMATA ||
-                    automataType == BOOLEAN_AUTOMATA ||
-                    automataType == BOOLEAN_HEXAGONAL_AUTOMATA ||
-                    automataType == BOOLEAN_TRIANGULAR_AUTOMATA ||
-                    automataType == CONWAYS_GAME_OF_LIFE ||
-                    automataType == SELECT_LANGUAGE)
-                {
-                    printMenuAsterisks(automataType);
-                }
-            }
-        }
-        /*
-         * The Elementary Cellular Automata menu
-         */
-        else if (displayedMenu == ELEMENTARY_CELLULAR_AUTOMATA)
-        {
-            ca.nextStep();
-            printPopulation();
-
-	    if(keys_released & KEY_A)
-	    {
-	        if (intArrow < 8) // Top screen (Automata rules)
-		{
-		    if(ca.getRuleDown(intArrow) == FG_color)
-		    {
-		        ca.setRuleDown(intArrow, BG_color);
-		    }
-		    else
-		    {
-		        ca.setRuleDown(intArrow, FG_color);
-		    }
-
-		    printRuleNumber(ca.getRuleNumber());
-
-		    ca.drawRule(intArrow);  // Draw the rule that has changed
-
-		    ca.resetECA();
-
-		    printPopulation();
-		}
-		// Initial state: One cell
-		else if (intArrow == 8)
-		{
-		    ca.setInitialStateType(ECA_INITIALIZE_ONE_CELL);
-
-		    ca.resetECA();
-
-		    printPopulation();
-
-		    printAsterisk(ECA_MENU_INITIAL_STATE_ONE_CELL_ROW,
-			      ECA_MENU_INITIAL_STATE_ONE_CELL_ASTERISK_COL);
-		    deleteAsterisk(ECA_MENU_INITIAL_STATE_RANDOM_ROW,
-			      ECA_MENU_INITIAL_STATE_RANDOM_ASTERISK_COL);
-		}
-		// Initial state: Random
-		else if (intArrow == 9)
-		{
-		    ca.setInitialStateType(ECA_INITIALIZE_RANDOM);
-
-		    ca.resetECA();
-
-		    printPopulation();
-
-		    deleteAsterisk(ECA_MENU_INITIAL_STATE_ONE_CELL_ROW,
-			       ECA_MENU_INITIAL_STATE_ONE_CELL_ASTERISK_COL);
-		    printAsterisk(ECA_MENU_INITIAL_STATE_RANDOM_ROW,
-			      ECA_MENU_INITIAL_STATE_RANDOM_ASTERISK_COL);
-		}
-		// Go back to the selection of the type of automata
-		else if (intArrow == 10)
-		{
-		    showAutomataTypeMenu();
-		}
-	    }
-
-	    if(keys_pressed & KEY_RIGHT)
-	    {
-	        if (intArrow < 8)
-		{
-		    ca.drawArrow(intArrow, BG_color);
-
-		    if(intArrow < 7)
-		    {
-			intArrow = intArrow + 1;
-		    }
-		    else
-		    {
-		        intArrow = 0;
-		    }
-
-		    ca.drawArrow(intArrow, line_color);
-		}
-	    }
-	    else if(keys_pressed & KEY_LEFT)
-	    {
-                if (intArrow < 8)
-		{
-		    ca.drawArrow(intArrow, BG_color);
-
-		    if(intArrow > 0)
-		    {
-		        intArrow = intArrow - 1;
-		    }
-		    else
-		    {
-		        intArrow = 7;
-		    }
-
-		    ca.drawArrow(intArrow, line_color);
-                }
-	    }
-	    else if(keys_pressed & KEY_UP)
-	    {
-	        if (intArrow < 8)
-	        {
-	            ca.drawArrow(intArrow, BG_color);
-	        }
-	        else
-	        {
-	            printMenuArrow(displayedMenu, intArrow, true);
-	        }
-
-		if (intArrow == 8)
-		{
-		    intArrow = 4;
-		}
-                else if(intArrow == 9 || intArrow == 10)
-                {
-                    intArrow = intArrow - 1;
-                }
-		else if(intArrow < 4)
-		{
-		    intArrow = 10;
-		}
-		else
-		{
-		    intArrow = intArrow - 4;
-		}
-
-		if (intArrow < 8)
-		{
-		    ca.drawArrow(intArrow, line_color);
-		}
-		else
-		{
-		    printMenuArrow(displayedMenu, intArrow, false);
-		}
-	    }
-	    else if(keys_pressed & KEY_DOWN)
-	    {
-	        if (intArrow < 8)
-	        {
-	            ca.drawArrow(intArrow, BG_color);
-	        }
-	        else
-	        {
-	            printMenuArrow(displayedMenu, intArrow, true);
-	        }
-
-	        if (intArrow == 10)
-	        {
-	            intArrow = 0;
-	        }
-                else if (intArrow == 8 || intArrow == 9)
-                {
-                    intArrow = intArrow + 1;
-                }
-	        else if(intArrow < 4)
-	        {
-	    	    intArrow = intArrow + 4;
-	        }
-	        else
-	        {
-		    intArrow = 8;
-	        }
-
-		if (intArrow < 8)
-		{
-		    ca.drawArrow(intArrow, line_color);
-		}
-		else
-		{
-		    printMenuArrow(displayedMenu, intArrow, false);
-		}
-	    }
-        }
-        /*
-         * Langton's ant menu
-         */
-        else if (displayedMenu == LANGTON_ANT)
-        {
-    	    if (ca.hasFinished() == false)
-    	    {
-    	        ca.nextStep();
-                printNumSteps();
-                printPopulation();
-    	        swiWaitForVBlank();
-    	    }
-
-    	    if(keys_released & KEY_A)
-	    {
-	        if (intArrow == 1)
-	        {
-	            // Go back to the selection of the type of automata
-                    showAutomataTypeMenu();
-                }
-	    }
-	    else if(keys_pressed & KEY_UP)
-	    {
-                // Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-	        // Calculate the next position of the arrow
-	        if (intArrow == 0)
-	        {
-	            intArrow = 1;
-	        }
-	        else
-	        {
-	            intArrow = intArrow - 1;
-	        }
-
-	        // Print the new arrow
-	        printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if(keys_pressed & KEY_DOWN)
-	    {
-                // Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-	        // Calculate the next position of the arrow
-	        if (intArrow == 1)
-	        {
-	            intArrow = 0;
-	        }
-	        else
-	        {
-	            intArrow = intArrow + 1;
-	        }
-
-	        // Print the new arrow
-	        printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if (keys_pressed & KEY_LEFT)
-	    {
-                if (intArrow == 0)
-                {
-                    if (ca.getAntNumPixels() > 1)
-                    {
-                        ca.setAntNumPixels(ca.getAntNumPixels() - 1);
-                        printAntNumPixels();
-                        ca.initialize();
-                        printPopulation();
-                        printNumSteps();
-                    }
-                }
-	    }
-	    else if (keys_pressed & KEY_RIGHT)
-	    {
-                if (intArrow == 0)
-                {
-                    ca.setAntNumPixels(ca.getAntNumPixels() + 1);
-                    printAntNumPixels();
-                    ca.initialize();
-                    printPopulation();
-                    printNumSteps();
-                }
-	    }
-        }
-        /*
-         * Langton's hexagonal ant menu
-         */
-        else if (displayedMenu == LANGTON_HEXAGONAL_ANT)
-        {
-            // If the ant hasn't finished continue with the next step
-    	    if (ca.hasFinished() == false)
-    	    {
-    	        ca.nextStep();
-                printNumSteps();
-                printPopulation();
-    	        swiWaitForVBlank();
-    	    }
-
-    	    if(keys_released & KEY_A)
-	    {
-	        if (intArrow == 0)
-	        {
-	            // Go back to the selection of the type of automata
-                    showAutomataTypeMenu();
-                }
-	    }
-        }
-        /*
-         * Boolean square automata
-         */
-        else if (displayedMenu == BOOLEAN_AUTOMATA)
-        {
-            ca.nextStep();
-            printNumSteps();
-            printPopulation();
-
-       	    if(keys_released & KEY_A)
-	    {
-	        if (intArrow == 14)
-	        {
-	            // Go back to the selection of the type of automata
-                    showAutomataTypeMenu();
-                }
-                else
-                {
-	            if (intArrow == 0)
-	            {
-	                ca.setTypeOfNeighborhood(VON_NEUMANN_NEIGHBORHOOD);
-	            }
-	            else if (intArrow == 1 || intArrow == 2 ||
-                             intArrow == 3 || intArrow == 4)
-	            {
-        	        ca.toggleBooleanRuleValue(VON_NEUMANN_NEIGHBORHOOD,
-                                                  intArrow - 1);
-	            }
-	            else if (intArrow == 5)
-	            {
-	                ca.setTypeOfNeighborhood(MOORE_NEIGHBORHOOD);
-	            }
-	            else if (intArrow == 6 || intArrow == 7 ||
-                             intArrow == 8 || intArrow == 9 ||
-                             intArrow == 10 || intArrow == 11 ||
-                             intArrow == 12 || intArrow == 13)
-	            {
-                        ca.toggleBooleanRuleValue(MOORE_NEIGHBORHOOD,
-                                                  intArrow - 6);
-	            }
-
-	            printMenuAsterisks(BOOLEAN_AUTOMATA);
-                    ca.initialize();
-                }
-            }
-            else if(keys_released & KEY_UP)
-	    {
-               // Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-	        if (intArrow == 0) // Von Neumann -> Back to main menu
-	        {
-	            intArrow = 14;
-	        }
-                // 1, 2, 3, 4 from Von Neumann -> Von Neumann
-	        else if (intArrow == 1 || intArrow == 2 ||
-                         intArrow == 3 || intArrow == 4)
-	        {
-	            intArrow = 0;
-	        }
-	        else if (intArrow == 5) // Moore -> 1 from Von Neumann
-	        {
-	            intArrow = 1;
-	        }
-                // 1, 2, 3, 4 from Moore -> Moore
-	        else if (intArrow == 6 || intArrow == 7 ||
-                         intArrow == 8 || intArrow == 9)
-	        {
-	            intArrow = 5;
-	        }
-                // 5 -> 1, 6 -> 2, 7 -> 3, 8 -> 4 (Moore)
-	        else if (intArrow == 10 || intArrow == 11 ||
-                         intArrow == 12 || intArrow == 13)
-	        {
-	            intArrow = intArrow - 4;
-	        }
-	        else if (intArrow == 14) // Back to main menu -> 5 from Moore
-	        {
-	            intArrow = 10;
-	        }
-
-	        // Print the new arrow
-	        printMenuArrow(displayedMenu, intArrow, false);
-	    }
-            else if(keys_released & KEY_DOWN)
-	    {
-                // Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-		if (intArrow == 0) // Von Neumann -> 1 from Von Neumann
-		{
-		    intArrow = 1;
-		}
-                // 1, 2, 3, 4 from Von Neumann -> Moore
-		else if (intArrow == 1 || intArrow == 2 ||
-                         intArrow == 3 || intArrow == 4)
-		{
-		    intArrow = 5;
-		}
-		else if (intArrow == 5) // Moore -> 1 from Moore
-		{
-		    intArrow = 6;
-		}
-                // 1 -> 5, 2 -> 6, 3 -> 7, 4 -> 8 (Moore)
-		else if (intArrow == 6 || intArrow == 7 ||
-                         intArrow == 8 || intArrow == 9)
-		{
-		    intArrow = intArrow + 4;
-		}
-                // 5, 6, 7, 8 from Moore -> Back to main menu
-		else if (intArrow == 10 || intArrow == 11 ||
-                         intArrow == 12 || intArrow == 13)
-		{
-		    intArrow = 14;
-		}
-                // Back to main menu -> 1 from Von Neumann
-		else if (intArrow == 14)
-		{
-		    intArrow = 0;
-		}
-
-		// Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if (keys_released & KEY_LEFT)
-	    {
-                // Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-                // 1 -> 4 (Von Neumann), 1 -> 4, 5 -> 8 (Moore)
-		if (intArrow == 1 || intArrow == 6 || intArrow == 10)		                   {
-		            intArrow = intArrow + 3;
-		}
-                // 2 -> 1, 3 -> 2, 4 -> 3 (Von Neumann),
-                // 2 -> 1, 3 -> 2, 4 -> 3, 6 -> 5, 7 -> 6, 8 -> 7 (Moore)
-		else if (intArrow == 2 || intArrow == 3 ||
-                         intArrow == 4 || intArrow == 7 ||
-                         intArrow == 8 || intArrow == 9 ||
-                         intArrow == 11 || intArrow == 12 || intArrow == 13)
-		{
-		    intArrow = intArrow - 1;
-		}
-
-		// Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if (keys_released & KEY_RIGHT)
-	    {
-                // Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-                // 4 -> 1 (Von Neumann), 4 -> 1, 8 -> 5 (Moore)
-		if (intArrow == 4 || intArrow == 9 || intArrow == 13)
-		{
-		    intArrow = intArrow - 3;
-		}
-                // 1 -> 2, 2 -> 3, 3 -> 4 (Von Neumann),
-                // 1 -> 2, 2 -> 3, 3 -> 4, 5 -> 6, 6 -> 7, 7 -> 8 (Moore)
-		else if (intArrow == 1 || intArrow == 2 ||
-                         intArrow == 3 || intArrow == 6 ||
-                         intArrow == 7 || intArrow == 8 ||
-                         intArrow == 10 || intArrow == 11 || intArrow == 12)
-		{
-		    intArrow = intArrow + 1;
-		}
-
-		// Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-	    }
-        }
-        /*
-         * Boolean hexagonal automata menu
-         */
-        else if (displayedMenu == BOOLEAN_HEXAGONAL_AUTOMATA)
-        {
-            ca.nextStep();
-
-            printNumSteps();
-            printPopulation();
-
-            if (keys_released & KEY_A)
-	    {
-	        if (intArrow == 0 || intArrow == 1 ||
-                    intArrow == 2 || intArrow == 3 ||
-                    intArrow == 4 || intArrow == 5)
-		{
-                    ca.toggleBooleanRuleValue(MOORE_NEIGHBORHOOD, intArrow);
-
-		    printMenuAsterisks(BOOLEAN_HEXAGONAL_AUTOMATA);
-
-		    ca.initialize();
-		}
-                else if (intArrow == 6)
-		{
-		    // Go back to the selection of the type of automata
-                    showAutomataTypeMenu();
-                }
-	    }
-            else if(keys_released & KEY_UP)
-            {
-                // Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-                // 1, 2, 3-> Back to main menu
-		if (intArrow == 0 or intArrow == 1 or intArrow == 2)
-		{
-		    intArrow = 6;
-		}
-                // 4 -> 1, 5 -> 2, 6 -> 3
-		else if (intArrow == 3 or intArrow == 4 or intArrow == 5)
-		{
-		    intArrow = intArrow - 3;
-		}
-		else if (intArrow == 6) // Back to main menu -> 4
-		{
-		    intArrow = 3;
-                }
-
-                // Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-            }
-            else if(keys_released & KEY_DOWN)
-            {
-                // Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-                // 1 -> 4, 2 -> 5, 3 -> 6
-		if (intArrow == 0 or intArrow == 1 or intArrow == 2)
-		{
-		    intArrow = intArrow + 3;
-		}
-                // 4, 5, 6 -> Back to main menu
-		else if (intArrow == 3 or intArrow == 4 or intArrow == 5)
-		{
-		    intArrow = 6;
-		}
-		else if (intArrow == 6) // Back to main menu -> 1
-		{
-		    intArrow = 0;
-                }
-
-		// Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-            }
-            else if(keys_released & KEY_LEFT)
-            {
-                // Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-		if (intArrow == 0 or intArrow == 3) // 1 -> 3, 4 -> 6
-		{
-		    intArrow = intArrow + 2;
-		}
-                // 2 -> 1, 3 -> 2, 5 -> 4, 6 -> 5
-		else if (intArrow == 1 or intArrow == 2 or
-                         intArrow == 4 or intArrow == 5)
-		{
-		    intArrow = intArrow - 1;
-		}
-
-                // Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-            }
-            else if(keys_released & KEY_RIGHT)
-            {
-                // Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-		if (intArrow == 2 or intArrow == 5) // 3 -> 1, 6 -> 4
-		{
-		    intArrow = intArrow - 2;
-		}
-                // 1 -> 2, 2 -> 3, 4 -> 5, 5 -> 6
-		else if (intArrow == 0 or intArrow == 1 or
-                         intArrow == 3 or intArrow == 4)
-		{
-		    intArrow = intArrow + 1;
-		}
-
-                // Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-            }
-        }
-        /*
-         * Boolean triangular automata menu
-         */
-        else if (displayedMenu == BOOLEAN_TRIANGULAR_AUTOMATA)
-        {
-            ca.nextStep();
-
-            printNumSteps();
-            printPopulation();
-
-       	    if(keys_released & KEY_A)
-	    {
-	        if (intArrow == 13)
-		{
-		    // Go back to the selection of the type of automata
-                    showAutomataTypeMenu();
-                }
-                else
-                {
-		    if (intArrow == 0) // Von Neumann neighborhood
-		    {
-			ca.setTypeOfNeighborhood(VON_NEUMANN_NEIGHBORHOOD);
-		    }
-                    // Von Neumann neighborhood 1, 2, 3
-		    else if (intArrow == 1 || intArrow == 2 || intArrow == 3)
-		    {
-                        ca.toggleBooleanRuleValue(VON_NEUMANN_NEIGHBORHOOD,
-                                                  intArrow - 1);
-		    }
-		    else if (intArrow == 4) // Moore neighborhood
-		    {
-			ca.setTypeOfNeighborhood(MOORE_NEIGHBORHOOD);
-		    }
-                    // Moore neighborhood 1, 2, 3, 4, 5, 6, 7, 8
-		    else if (intArrow == 5 || intArrow == 6 ||
-                             intArrow == 7 || intArrow == 8 ||
-                             intArrow == 9 || intArrow == 10 ||
-                             intArrow == 11 || intArrow == 12)
-		    {
-                        ca.toggleBooleanRuleValue(MOORE_NEIGHBORHOOD,
-                                                  intArrow - 5);
-		    }
-
-		    printMenuAsterisks(BOOLEAN_TRIANGULAR_AUTOMATA);
-		    ca.initialize();
-		}
-            }
-            else if(keys_released & KEY_UP)
-	    {
-                // Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-		if (intArrow == 0) // Von Neumann -> Back to main menu
-		{
-		    intArrow = 13;
-		}
-		// 1, 2, 3 from Von Neumann -> Von Neumann
-		else if (intArrow == 1 || intArrow == 2 || intArrow == 3)
-		{
-		    intArrow = 0;
-		}
-		else if (intArrow == 4) // Moore -> 1 from Von Neumann
-		{
-		    intArrow = 1;
-		}
-		// 1, 2, 3, 4 from Moore -> Moore
-		else if (intArrow == 5 || intArrow == 6 ||
-		         intArrow == 7 || intArrow == 8)
-		{
-		    intArrow = 4;
-		}
-		// 5 -> 1, 6 -> 2, 7 -> 3, 8 -> 4 (Moore)
-		else if (intArrow == 9 || intArrow == 10 ||
-			 intArrow == 11 || intArrow == 12)
-		{
-		    intArrow = intArrow - 4;
-		}
-		// Back to main menu -> 5 from Moore
-		else if (intArrow == 13)
-		{
-		    intArrow = 9;
-		}
-
-		// Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-	    }
-            else if(keys_released & KEY_DOWN)
-	    {
-    		// Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-		if (intArrow == 0) // Von Neumann -> 1 from Von Neumann
-		{
-		    intArrow = 1;
-		}
-		// 1, 2, 3 from Von Neumann -> Moore
-		else if (intArrow == 1 || intArrow == 2 || intArrow == 3)
-		{
-		    intArrow = 4;
-		}
-		else if (intArrow == 4) // Moore -> 1 from Moore
-		{
-		    intArrow = 5;
-		}
-		// 1 -> 5, 2 -> 6, 3 -> 7, 4 -> 8 (Moore)
-		else if (intArrow == 5 || intArrow == 6 ||
-			 intArrow == 7 || intArrow == 8)
-		{
-		    intArrow = intArrow + 4;
-		}
-		// 5, 6, 7, 8 from Moore -> Back to main menu
-		else if (intArrow == 9 || intArrow == 10 ||
-		    intArrow == 11 || intArrow == 12)
-		{
-		    intArrow = 13;
-		}
-		// Back to main menu -> 1 from Von Neumann
-		else if (intArrow == 13)
-		{
-		    intArrow = 0;
-		}
-
-		// Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if (keys_released & KEY_LEFT)
-	    {
-		// Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-		if (intArrow == 1)
-		{
-		    intArrow = 3;
-		}
-		// 1 -> 4 (Von Neumann), 1 -> 4, 5 -> 8 (Moore)
-		else if (intArrow == 5 || intArrow == 9)
-		{
-		    intArrow = intArrow + 3;
-		}
-                // 2 -> 1, 3 -> 2, 4 -> 3 (Von Neumann),
-                // 2 -> 1, 3 -> 2, 4 -> 3, 6 -> 5, 7 -> 6, 8 -> 7 (Moore)
-		else if (intArrow == 2 || intArrow == 3 || intArrow == 6 ||
-			 intArrow == 7 || intArrow == 8 || intArrow == 10 ||
-		         intArrow == 11 || intArrow == 12)
-		{
-		    intArrow = intArrow - 1;
-		}
-
-        // Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if (keys_released & KEY_RIGHT)
-	    {
-		// Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-		if (intArrow == 3)
-		{
-		    intArrow = 1;
-		}
-		// 4 -> 1 (Von Neumann), 4 -> 1, 8 -> 5 (Moore)
-		else if (intArrow == 8 || intArrow == 12)
-		{
-		    intArrow = intArrow - 3;
-		}
-        // 1 -> 2, 2 -> 3, 3 -> 4 (Von Neumann),
-        // 1 -> 2, 2 -> 3, 3 -> 4, 5 -> 6, 6 -> 7, 7 -> 8 (Moore)
-		else if (intArrow == 1 || intArrow == 2 ||
-			 intArrow == 5 || intArrow == 6 ||
-		         intArrow == 7 || intArrow == 9 ||
-		         intArrow == 10 || intArrow == 11)
-		{
-		    intArrow = intArrow + 1;
-		}
-
-		// Print the new arrow
-		printMenuArrow(displayedMenu, intArrow, false);
-	    }
-        }
-        /*
-         * Conway's game of life
-         */
-        else if (displayedMenu == CONWAYS_GAME_OF_LIFE)
-        {
-            ca.nextStep();
-
-            printNumSteps();
-            printPopulation();
-
-    	    if(keys_released & KEY_A)
-	        {
-		        if (intArrow == 5)
-		        {
-		            // Go back to the selection of the type of automata
-                    showAutomataTypeMenu();
-                }
-                else
-                {
-		            if (intArrow == 0)
-	                {
-	                    ca.setInitialState(ACORN);
-	                    ca.initialize();
-	                }
-	                else if (intArrow == 1)
-	                {
-	                    ca.setInitialState(FPENTOMINO);
-	                    ca.initialize();
-	                }
-	                else if (intArrow == 2)
-	                {
-	                    ca.setInitialState(FILL_SCREEN_WITH_PULSARS);
-	                    ca.initialize();
-	                }
-	                else if (intArrow == 3)
-	                {
-	                    ca.setInitialState(FILL_SCREEN_WITH_PENTADECATHLONS);
-	                    ca.initialize();
-	                }
-                    else if (intArrow == 4)
-	                {
-	                    ca.setInitialState(RIP_JOHN_CONWAY);
-	                    ca.initialize();
-	                }
-
-	                printMenuAsterisks(CONWAYS_GAME_OF_LIFE);
-                }
-	        }
-	        else if(keys_pressed & KEY_UP)
-	        {
-	            // Delete the previous arrow
-	            printMenuArrow(displayedMenu, intArrow, true);
-
-	            if (intArrow == 0)
-	            {
-	                intArrow = 5;
-	            }
-	            else
-	            {
-	                intArrow = intArrow - 1;
-	            }
-
-	            // Print the new arrow
-	            printMenuArrow(displayedMenu, intArrow, false);
-	        }
-	        else if(keys_pressed & KEY_DOWN)
-	        {
-		        // Delete the previous arrow
-	            printMenuArrow(displayedMenu, intArrow, true);
-
-	            if (intArrow == 5)
-	            {
-	                intArrow = 0;
-	            }
-	            else
-	            {
-	                intArrow = intArrow + 1;
-	            }
-
-	            // Print the new arrow
-	            printMenuArrow(displayedMenu, intArrow, false);
-	        }
-        }
-        /*
-         * Munching squares menu
-         */
-        else if (displayedMenu == MUNCHING_SQUARES)
-        {
-            ca.nextStep();
-
-            printNumSteps();
-            printPopulation();
-
-            if(keys_released & KEY_A)
-            {
-                if (intArrow == 0)
-                {
-                    // Go back to the selection of the type of automata
-                    showAutomataTypeMenu();
-                }
-            }
-        }
-        /*
-         * BML traffic model
-         */
-        else if (displayedMenu == BML_TRAFFIC_MODEL)
-        {
-            ca.nextStep();
-
-            printNumSteps();
-            printPopulation();
-
-            if(keys_released & KEY_A)
-            {
-                if (intArrow == 0)
-                {
-                    // Restart the automata
-                    ca.initialize();
-                    printPopulation();
-                }
-                else if (intArrow == 2) // Back to main menu
-                {
-                    showAutomataTypeMenu();
-                }
-            }
-            else if (keys_pressed & KEY_UP)
-            {
-                // Delete the previous arrow
-                printMenuArrow(displayedMenu, intArrow, true);
-
-                if (intArrow == 0)
-                {
-                    intArrow = 2;
-                }
-                else
-                {
-                    intArrow = intArrow - 1;
-                }
-
-                // Print the new arrow
-                printMenuArrow(displayedMenu, intArrow, false);
-            }
-            else if (keys_pressed & KEY_DOWN)
-            {
-                // Delete the previous arrow
-                printMenuArrow(displayedMenu, intArrow, true);
-
-                if (intArrow == 2)
-                {
-                    intArrow = 0;
-                }
-                else
-                {
-                    intArrow = intArrow + 1;
-                }
-
-                // Print the new arrow
-                printMenuArrow(displayedMenu, intArrow, false);
-            }
-            else if (keys_pressed & KEY_LEFT)
-            {
-                if (intArrow == 1 && ca.getBMLdensity() > 0)
-                {
-                    ca.setBMLdensity(ca.getBMLdensity() - 1);
-                    printBMLdensity();
-                }
-            }
-            else if (keys_pressed & KEY_RIGHT)
-            {
-                if (intArrow == 1 && ca.getBMLdensity() < 100)
-                {
-                    ca.setBMLdensity(ca.getBMLdensity() + 1);
-                    printBMLdensity();
-                }
+                startAutomata(automataType);
             }
         }
         /*
-         * Cyclic Cellular Automata menu
+         * The menu of the automata (or of the colors or the language): the
+         * object of the registry runs the steps of the frame and answers
+         * the keys (see automaton.h)
          */
-        else if (displayedMenu == CYCLIC_CELLULAR_AUTOMATA) {
-            if (ca.getNumSteps() < 192)
-            {
-		ca.nextStep();
-
-                printNumSteps();
-                printPopulation();
-            }
-            if (keys_released & KEY_A)
-            {
-                if (intArrow == 1) // Back to the main menu
-                {
-                    showAutomataTypeMenu();
-                }
-            }
-            else if(keys_pressed & KEY_UP)
-            {
-                // Delete the previous arrow
-                printMenuArrow(displayedMenu, intArrow, true);
-
-                if (intArrow == 0)
-                {
-                    intArrow = 1;
-                }
-                else
-                {
-                    intArrow = intArrow - 1;
-                }
-
-                // Print the new arrow
-                printMenuArrow(displayedMenu, intArrow, false);
-            }
-            else if(keys_pressed & KEY_DOWN)
-            {
-                // Delete the previous arrow
-		printMenuArrow(displayedMenu, intArrow, true);
-
-                if (intArrow == 1)
-                {
-                    intArrow = 0;
-                }
-                else
-                {
-                    intArrow = intArrow + 1;
-                }
-
-                // Print the new arrow
-                printMenuArrow(displayedMenu, intArrow, false);
-            }
-            else if (keys_pressed & KEY_LEFT)
-            {
-                if (intArrow == 0 && ca.getNumStates() > 3)
-                {
-                    ca.setNumStates(ca.getNumStates() - 1);
-                    printCCANumStates();
-
-                    ca.initialize();
-                    printPopulation();
-                    printNumSteps();
-                }
-            }
-            else if (keys_pressed & KEY_RIGHT)
-            {
-                if (intArrow == 0 && ca.getNumStates() < 4)
-                {
-                    ca.setNumStates(ca.getNumStates() + 1);
-                    printCCANumStates();
-
-                    ca.initialize();
-                    printPopulation();
-                    printNumSteps();
-                }
-            }
-        }
-	/*
-         * Cyclic Cellular Automata menu
-         */
-        else if (displayedMenu == STEPPING_STONE) {
-
-	    ca.nextStep();
-
-	    printNumSteps();
-
-	    if (keys_released & KEY_A)
-            {
-                if (intArrow == 0) // Back to the main menu
-                {
-                    showAutomataTypeMenu();
-                }
-            }
-	}
-        /*
-         * Color selection menu
-         */
-        else if (displayedMenu == SELECT_COLORS)
-        {
-  	    if(keys_released & KEY_A)
-  	    {
-  	        if (intArrow == 12) // Back to main menu
-  	        {
-  	            showAutomataTypeMenu();
-  	        }
-  	    }
-	    else if(keys_pressed & KEY_UP)
-	    {
-		// Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-	        if (intArrow == 0)
-	        {
-	            intArrow = 12;
-	        }
-	        else
-	        {
-	            intArrow = intArrow - 1;
-	        }
-
-	        // Print the new arrow
-	        printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if(keys_pressed & KEY_DOWN)
-	    {
-		// Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-	        if (intArrow == 12)
-	        {
-	            intArrow = 0;
-	        }
-	        else
-	        {
-	            intArrow = intArrow + 1;
-	        }
-
-	        // Print the new arrow
-	        printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if (keys_pressed & KEY_LEFT)
-	    {
-	        if (intArrow == 0)
-	        {
-	            if (BG_R != 0)
-	            {
-	                --BG_R;
-	            }
-	        }
-	        else if (intArrow == 1)
-	        {
-	            if (BG_G != 0)
-	            {
-	                --BG_G;
-	            }
-	        }
-	        else if (intArrow == 2)
-	        {
-	            if (BG_B != 0)
-	            {
-	                --BG_B;
-	            }
-	        }
-	        else if (intArrow == 3)
-	        {
-	            if (FG_R != 0)
-	            {
-	                --FG_R;
-	            }
-	        }
-	        else if (intArrow == 4)
-	        {
-	            if (FG_G != 0)
-	            {
-	                --FG_G;
-	            }
-	        }
-	        else if (intArrow == 5)
-	        {
-	            if (FG_B != 0)
-	            {
-	                --FG_B;
-	            }
-	        }
-                else if (intArrow == 6)
-                {
-                    if (FG_R2 != 0)
-                    {
-                        --FG_R2;
-                    }
-                }
-                else if (intArrow == 7)
-                {
-                    if (FG_G2 != 0)
-                    {
-                        --FG_G2;
-                    }
-                }
-                else if (intArrow == 8)
-                {
-                    if (FG_B2 != 0)
-                    {
-                        --FG_B2;
-                    }
-                }
-	        else if (intArrow == 9)
-	        {
-	            if (line_R != 0)
-	            {
-	                --line_R;
-	            }
-	        }
-	        else if (intArrow == 10)
-	        {
-	            if (line_G != 0)
-	            {
-	                --line_G;
-	            }
-	        }
-	        else if (intArrow == 11)
-	        {
-	            if (line_B != 0)
-	            {
-	                --line_B;
-	            }
-	        }
-
-                printMenu(displayedMenu);
-
-	        BG_color = RGB15(BG_R, BG_G, BG_B);
-	        FG_color = RGB15(FG_R, FG_G, FG_B);
-                FG_color2 = RGB15(FG_R2, FG_G2, FG_B2);
-                line_color = RGB15(line_R, line_G, line_B);
-
-                ca.initialize();
-
-                swiWaitForVBlank();
-	    }
-	    else if (keys_pressed & KEY_RIGHT)
-	    {
-	        if (intArrow == 0)
-	        {
-	            if (BG_R != 31)
-	            {
-	                ++BG_R;
-	            }
-	        }
-	        else if (intArrow == 1)
-	        {
-	            if (BG_G != 31)
-	            {
-	                ++BG_G;
-	            }
-	        }
-	        else if (intArrow == 2)
-	        {
-	            if (BG_B != 31)
-	            {
-	                ++BG_B;
-	            }
-	        }
-	        else if (intArrow == 3)
-	        {
-	            if (FG_R != 31)
-	            {
-	                ++FG_R;
-	            }
-	        }
-	        else if (intArrow == 4)
-	        {
-	            if (FG_G != 31)
-	            {
-	                ++FG_G;
-	            }
-	        }
-	        else if (intArrow == 5)
-	        {
-	            if (FG_B != 31)
-	            {
-	                ++FG_B;
-	            }
-	        }
-
-		if (intArrow == 6)
-                {
-                    if (FG_R2 != 31)
-                    {
-                        ++FG_R2;
-                    }
-                }
-                else if (intArrow == 7)
-                {
-                    if (FG_G2 != 31)
-                    {
-                        ++FG_G2;
-                    }
-                }
-                else if (intArrow == 8)
-                {
-                    if (FG_B2 != 31)
-                    {
-                        ++FG_B2;
-                    }
-                }
-	        else if (intArrow == 9)
-	        {
-	            if (line_R != 31)
-	            {
-	                ++line_R;
-	            }
-	        }
-	        else if (intArrow == 10)
-	        {
-	            if (line_G != 31)
-	            {
-	                ++line_G;
-	            }
-	        }
-	        else if (intArrow == 11)
-	        {
-	            if (line_B != 31)
-	            {
-	                ++line_B;
-	            }
-	        }
-
-                printMenu(displayedMenu);
-
-	        BG_color = RGB15(BG_R, BG_G, BG_B);
-	        FG_color = RGB15(FG_R, FG_G, FG_B);
-                FG_color2 = RGB15(FG_R2, FG_G2, FG_B2);
-                line_color = RGB15(line_R, line_G, line_B);
-
-                ca.initialize();
-
-                swiWaitForVBlank();
-	    }
-        }
-        /*
-         * Language selection menu
-         */
-        else if (displayedMenu == SELECT_LANGUAGE)
+        else
         {
-  	    if(keys_released & KEY_A)
-  	    {
-	        // Change language to english
-  	        if (intArrow == 0)
-  	        {
-  	            setLanguage(EN, intArrow);
-  	        }
-  	        // Change language to spanish
-  	        else if (intArrow == 1)
-  	        {
-  	            setLanguage(ES, intArrow);
-  	        }
-  	        // Change language to basque
-  	        else if (intArrow == 2)
-  	        {
-  	            setLanguage(EU, intArrow);
-  	        }
-  	        // Back to main menu
-  	        else if (intArrow == 3)
-  	        {
-  	            showAutomataTypeMenu();
-  	        }
-  	    }
-	    else if(keys_pressed & KEY_UP)
-	    {
-		// Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-	        if (intArrow == 0)
-	        {
-	            intArrow = 3;
-	        }
-	        else
-	        {
-	            intArrow = intArrow - 1;
-	        }
-
-	        // Print the new arrow
-	        printMenuArrow(displayedMenu, intArrow, false);
-	    }
-	    else if(keys_pressed & KEY_DOWN)
-	    {
-	        // Delete the previous arrow
-	        printMenuArrow(displayedMenu, intArrow, true);
-
-	        if (intArrow == 3)
-	        {
-	            intArrow = 0;
-	        }
-	        else
-	        {
-	            intArrow = intArrow + 1;
-	        }
+            Automaton* automaton =
+                CellularAutomata::findAutomaton(displayedMenu)->automaton;
 
-	        // Print the new arrow
-	        printMenuArrow(displayedMenu, intArrow, false);
-	    }
+            automaton->runFrame(ca);
+            automaton->updateMenu(ca, keys_pressed, keys_released);
         }
     }
 
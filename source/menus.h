@@ -1,26 +1,27 @@
 #ifndef MENUS_H
 #define MENUS_H
 
+#include <string>
+
 int printString(int row, int column, std::string text);
 int printRuleNumber(int intRuleNumber);
 int printPopulation();
-int printAntNumPixels();
-int printBMLdensity();
-int printCCANumStates();
+int printSeed();
+int printBytesPresented(int bytes);
+int printSpeed();
+int printCycle();
 int printCredits();
 int printArrow(int row, int column);
 int deleteArrow(int row, int column);
+int printOptionArrow(int row, int column, bool boolDelete);
 int printAsterisk(int row, int column);
 int deleteAsterisk(int row, int column);
 int printPartialColor(int row, int col, std::string str, int num);
-int printMenu(int intDisplayedMenu);
-int printMenuAsterisks(int intDisplayedMenu);
-int printMenuArrow(int intDisplayedMenu, int index, bool boolDelete);
+int printInitialLanguageMenuArrow(int index, bool boolDelete);
+int printAutomataTypeMenuArrow(int type, bool boolDelete);
 int showInitialLanguageSelectionMenu();
 int showAutomataTypeMenu();
-int printAutomataType(int automataType);
 int printNumSteps();
 int setInitialLanguage(int language);
-int setLanguage(int language, int intArrow);
 
 #endif
@@ -0,0 +1,130 @@
+#include <nds.h>
+
+#include "munchingsquares.h"
+#include "cellularautomata.h"
+#include "framebuffer.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * References:
+ * http://en.wikipedia.org/wiki/Munching_square
+ * http://mathworld.wolfram.com/MunchingSquares.html
+ * http://www.inwap.com/pdp10/hbaker/hakmem/hacks.html#item146
+ */
+
+/*
+ * Cleans the squares of the munching squares
+ */
+int MunchingSquares::initialize(CellularAutomata& automata)
+{
+    // One pixel per square, the view makes them MS_ZOOM pixels wide
+    showIndexedFB();
+    setCellsPalette();
+    cleanIndexedFB(indexedFB, CELL_BG);
+    resetView(MS_SIZE, MS_SIZE, MS_ZOOM * VIEW_ZOOM_ONE);
+
+    return 0;
+}
+
+/*
+ * Draws the next step of the munching squares.
+ * We use a grid of 64 squares height x 64 squares width where each square
+ * is one pixel of the 8 bits per pixel framebuffer. The view zooms it
+ * 3 times: 64 * 3 = 192 pixels (the height of the screen).
+ *
+ * XOR is the logical operator "exclusive disjunction", also called
+ * "exclusive or".
+ * http://en.wikipedia.org/wiki/XOR#Bitwise_operation
+ * XOR is a type of logical disjunction on two operands that results in a
+ * value of true if exactly one of the operands has a value of true.
+ * 1 xor 1 = 0
+ * 1 xor 0 = 1
+ * 0 xor 1 = 1
+ * 0 xor 0 = 0
+ * For example, 1110 xor 1001 = 0111
+ */
+int MunchingSquares::nextStep(CellularAutomata& automata)
+{
+    unsigned int numSteps = automata.getNumSteps();
+
+    if (numSteps < MS_SIZE)
+    {
+        /*
+         * For each combination of i and j where i = 0, 1, ... 63 and
+         * j = 0, 1, ... 63
+         * we check if the value of (i xor j) is smaller than numSteps.
+         * If the result of this comparation is true then we paint the
+         * square of the column i and the row j with the FG color.
+         */
+        for (int i = 0; i < MS_SIZE; i++)
+        {
+            for (int j = 0; j < MS_SIZE; j++)
+            {
+                if (((i xor j) < numSteps) == true)
+                {
+                        setIndexedPixel(indexedFB, SCREEN_WIDTH, i, j,
+                                        CELL_FG);
+                }
+            }
+        }
+        automata.countStep();
+    }
+    else
+    {
+        /*
+         * Paint the framebuffer with the BG color to erase the last step
+         * of the munching squares and start another cycle (the view
+         * stays where the user left it)
+         */
+        cleanIndexedFB(indexedFB, CELL_BG);
+        automata.setNumSteps(0);
+    }
+
+    return 0;
+}
+
+const std::string& MunchingSquares::getName()
+{
+    return stringMunchingSquares;
+}
+
+int MunchingSquares::printMenu()
+{
+    printString(MS_MENU_BACK_TO_MAIN_ROW,
+                MS_MENU_BACK_TO_MAIN_COLUMN,
+                stringBackToMainMenu);
+    printString(VIEW_HELP_ROW, VIEW_HELP_COL, stringViewHelp);
+
+    return 0;
+}
+
+int MunchingSquares::printMenuArrow(int index, bool boolDelete)
+{
+    // Only back to main menu
+    return printOptionArrow(MS_MENU_BACK_TO_MAIN_ROW, 0, boolDelete);
+}
+
+/*
+ * One step per frame, the governor doesn't run it
+ */
+int MunchingSquares::runFrame(CellularAutomata& automata)
+{
+    automata.nextStep();
+
+    return printCounters();
+}
+
+int MunchingSquares::updateMenu(CellularAutomata& automata,
+                                int keys_pressed,
+                                int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        // Go back to the selection of the type of automata
+        showAutomataTypeMenu();
+    }
+
+    return 0;
+}
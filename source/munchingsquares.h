@@ -0,0 +1,30 @@
+#ifndef MUNCHINGSQUARES_H
+#define MUNCHINGSQUARES_H
+
+#include <string>
+
+#include "automaton.h"
+
+/*
+ * The munching squares: MS_SIZE x MS_SIZE squares, one pixel each of the 8
+ * bits per pixel framebuffer, zoomed by the view. The squares whose
+ * column xor row is smaller than the step are painted, and the cycle
+ * starts again after MS_SIZE steps.
+ */
+class MunchingSquares : public Automaton
+{
+    public:
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+
+        virtual int runFrame(CellularAutomata& automata);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
@@ -0,0 +1,985 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <string>
+#include <vector>
+
+#include "pattern.h"
+#include "chunkeduniverse.h"
+
+/*
+ * Longest run of a RLE pattern, bigger counts are cut (the cells are
+ * clipped to the grid anyway, and a universe runs out of chunks long
+ * before)
+ */
+#define PATTERN_MAX_RUN 1000000
+
+/*
+ * Writes a span of length live cells (clipped to the array of cells, if
+ * the target isn't a universe) and adds the ones that were dead to the
+ * population
+ */
+static int writeSpan(const PatternTarget& target,
+                     int column,
+                     int row,
+                     int length,
+                     unsigned int& population)
+{
+    int width = target.width;
+
+    if (target.universe != NULL)
+    {
+        population = population + target.universe->setSpan(column, row,
+                                                            length);
+        return 0;
+    }
+
+    if (row < 0 or row >= target.height)
+    {
+        return 0;
+    }
+
+    if (column < 0)
+    {
+        length = length + column;
+        column = 0;
+    }
+
+    if (length > width - column)
+    {
+        length = width - column;
+    }
+
+    if (length <= 0)
+    {
+        return 0;
+    }
+
+    memset(target.cells + row * width + column, target.cell, length);
+    population = population + length;
+
+    return 0;
+}
+
+/*
+ * Returns true if the row is below the array of cells of the target (a
+ * universe has no bottom)
+ */
+static bool isBelow(const PatternTarget& target, int row)
+{
+    return target.universe == NULL and row >= target.height;
+}
+
+/*
+ * Returns true if the line starts with the text (after the spaces)
+ */
+static bool startsWith(const std::string& line, const char* text)
+{
+    size_t first = line.find_first_not_of(" \t");
+
+    return first != std::string::npos and
+           line.compare(first, strlen(text), text) == 0;
+}
+
+/*
+ * Returns true if the line of a pattern is a comment (# of RLE and Life
+ * 1.06, ! of plaintext)
+ */
+static bool isComment(const std::string& line)
+{
+    return startsWith(line, "#") or startsWith(line, "!");
+}
+
+/*
+ * Returns the text of the line after the prefix, without the spaces around
+ * it
+ */
+static std::string getValue(const std::string& line, const char* prefix)
+{
+    size_t first = line.find_first_not_of(" \t");
+    size_t start = line.find_first_not_of(" \t", first + strlen(prefix));
+    size_t end = line.find_last_not_of(" \t");
+
+    if (start == std::string::npos or end < start)
+    {
+        return "";
+    }
+
+    return line.substr(start, end - start + 1);
+}
+
+/*
+ * Reads the coordinates of a cell of a Life 1.06 pattern from the line.
+ * Returns 1 if it has them, 0 if it isn't a cell and -1 if they're out of
+ * the range of PATTERN_MAX_COORDINATE.
+ */
+static int readCell(const std::string& line, int& x, int& y)
+{
+    const char* text = line.c_str();
+    char* end;
+    long values[2];
+
+    for (int i = 0; i < 2; ++i)
+    {
+        values[i] = strtol(text, &end, 10);
+
+        if (end == text)
+        {
+            return 0;
+        }
+
+        if (values[i] < -PATTERN_MAX_COORDINATE or
+            values[i] > PATTERN_MAX_COORDINATE)
+        {
+            return -1;
+        }
+
+        text = end;
+    }
+
+    x = (int) values[0];
+    y = (int) values[1];
+
+    return 1;
+}
+
+/*
+ * Returns true if the name goes before the other one in the library (the
+ * case doesn't matter)
+ */
+static bool isBefore(const std::string& name, const std::string& other)
+{
+    for (size_t i = 0; i < name.length() and i < other.length(); ++i)
+    {
+        int a = name[i] >= 'A' and name[i] <= 'Z' ? name[i] - 'A' + 'a'
+                                                  : name[i];
+        int b = other[i] >= 'A' and other[i] <= 'Z' ? other[i] - 'A' + 'a'
+                                                    : other[i];
+
+        if (a != b)
+        {
+            return a < b;
+        }
+    }
+
+    return name.length() < other.length();
+}
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Returns the next byte of the pattern, EOF at the end. The files are
+ * read PATTERN_BUFFER_SIZE bytes at a time.
+ */
+int PatternReader::nextChar()
+{
+    if (text != NULL)
+    {
+        if (text[textPosition] == '\0')
+        {
+            return EOF;
+        }
+
+        return (unsigned char) text[textPosition++];
+    }
+
+    if (bufferPosition == bufferLength)
+    {
+        if (file == NULL)
+        {
+            return EOF;
+        }
+
+        bufferLength = fread(buffer, 1, PATTERN_BUFFER_SIZE, file);
+        bufferPosition = 0;
+
+        if (bufferLength <= 0)
+        {
+            bufferLength = 0;
+            return EOF;
+        }
+    }
+
+    return (unsigned char) buffer[bufferPosition++];
+}
+
+/*
+ * Reads the next line (without the end of line). Returns -1 at the end of
+ * the pattern.
+ */
+int PatternReader::readLine(std::string& line)
+{
+    int c;
+
+    line.clear();
+
+    while ((c = nextChar()) != EOF and c != '\n')
+    {
+        if (c != '\r')
+        {
+            line += (char) c;
+        }
+    }
+
+    if (c == EOF and line.empty() == true)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Reads the whole plaintext or Life 1.06 pattern to find its bounding box,
+ * they don't have its size in the header like the RLE ones. The cells
+ * aren't decoded. Returns -1 if a cell of a Life 1.06 pattern is out of
+ * the range of PATTERN_MAX_COORDINATE.
+ */
+int PatternReader::measure(PatternInfo& info)
+{
+    std::string line;
+    int rows = 0;
+    int right = 0;
+    int bottom = 0;
+    bool empty = true;
+
+    rewind();
+
+    while (readLine(line) == 0)
+    {
+        if (isComment(line) == true)
+        {
+            continue;
+        }
+
+        if (info.format == PATTERN_FORMAT_PLAINTEXT)
+        {
+            size_t last = line.find_last_of("O*");
+
+            ++rows;
+
+            if (last != std::string::npos)
+            {
+                if ((int) last + 1 > info.width)
+                {
+                    info.width = last + 1;
+                }
+
+                // The empty rows at the end don't count
+                info.height = rows;
+            }
+        }
+        else
+        {
+            int x;
+            int y;
+            int found = readCell(line, x, y);
+
+            if (found == -1)
+            {
+                return -1;
+            }
+            else if (found == 0)
+            {
+                continue;
+            }
+
+            if (empty == true)
+            {
+                info.left = right = x;
+                info.top = bottom = y;
+                empty = false;
+            }
+
+            info.left = x < info.left ? x : info.left;
+            info.top = y < info.top ? y : info.top;
+            right = x > right ? x : right;
+            bottom = y > bottom ? y : bottom;
+        }
+    }
+
+    // The coordinates are in range, so the size fits in an int
+    if (info.format == PATTERN_FORMAT_LIFE_106 and empty == false)
+    {
+        info.width = right - info.left + 1;
+        info.height = bottom - info.top + 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Decodes the runs of a RLE pattern (b dead, o or any other letter alive,
+ * $ end of row, ! end of pattern) after its header
+ */
+int PatternReader::decodeRLE(const PatternTarget& target,
+                             int column,
+                             int row,
+                             unsigned int& population)
+{
+    std::string line;
+    int count = 0;
+    int x = 0;
+    int y = 0;
+    int c;
+
+    rewind();
+
+    // The comments and the line with the size
+    while (readLine(line) == 0 and isComment(line) == true)
+    {
+    }
+
+    while ((c = nextChar()) != EOF and c != '!')
+    {
+        if (c >= '0' and c <= '9')
+        {
+            if (count < PATTERN_MAX_RUN)
+            {
+                count = count * 10 + (c - '0');
+            }
+
+            continue;
+        }
+
+        if (c == ' ' or c == '\t' or c == '\r' or c == '\n')
+        {
+            continue;
+        }
+
+        int run = count == 0 ? 1 : count;
+
+        count = 0;
+
+        if (c == 'b' or c == '.')
+        {
+            x = x + run;
+        }
+        else if (c == '$')
+        {
+            x = 0;
+            y = y + run;
+
+            // The rest of the rows are below the grid
+            if (isBelow(target, row + y) == true)
+            {
+                break;
+            }
+        }
+        else if ((c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z'))
+        {
+            // The states of two letters (pA, pB...) are alive too
+            if (c >= 'p' and c <= 'y')
+            {
+                nextChar();
+            }
+
+            writeSpan(target, column + x, row + y, run, population);
+
+            x = x + run;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Decodes a plaintext pattern: each line is a row, O (or *) alive and
+ * anything else dead
+ */
+int PatternReader::decodePlaintext(const PatternTarget& target,
+                                   int column,
+                                   int row,
+                                   unsigned int& population)
+{
+    std::string line;
+    int y = 0;
+
+    rewind();
+
+    while (readLine(line) == 0 and isBelow(target, row + y) == false)
+    {
+        if (isComment(line) == true)
+        {
+            continue;
+        }
+
+        size_t start = line.find_first_of("O*");
+
+        while (start != std::string::npos)
+        {
+            size_t end = line.find_first_not_of("O*", start);
+
+            if (end == std::string::npos)
+            {
+                end = line.length();
+            }
+
+            writeSpan(target, column + (int) start, row + y,
+                      (int) (end - start), population);
+
+            start = line.find_first_of("O*", end);
+        }
+
+        ++y;
+    }
+
+    return 0;
+}
+
+/*
+ * Decodes a Life 1.06 pattern: a line with the coordinates of each live
+ * cell
+ */
+int PatternReader::decodeLife106(const PatternTarget& target,
+                                 int column,
+                                 int row,
+                                 unsigned int& population)
+{
+    std::string line;
+
+    rewind();
+
+    while (readLine(line) == 0)
+    {
+        int x;
+        int y;
+
+        // The cells out of range were rejected by readInfo()
+        if (isComment(line) == true or readCell(line, x, y) != 1)
+        {
+            continue;
+        }
+
+        x = column + x;
+        y = row + y;
+
+        // The same cell can be listed twice (the universe only counts
+        // the cells that were dead)
+        if (target.universe != NULL or
+            (x >= 0 and x < target.width and
+             y >= 0 and y < target.height and
+             target.cells[y * target.width + x] != target.cell))
+        {
+            writeSpan(target, x, y, 1, population);
+        }
+    }
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+PatternReader::PatternReader()
+{
+    file = NULL;
+    text = NULL;
+    textPosition = 0;
+
+    bufferLength = 0;
+    bufferPosition = 0;
+}
+
+PatternReader::~PatternReader()
+{
+    close();
+}
+
+/*
+ * Opens a pattern file. Returns false if it can't be read.
+ */
+bool PatternReader::open(const char* path)
+{
+    close();
+
+    file = fopen(path, "rb");
+
+    return file != NULL;
+}
+
+/*
+ * Reads the pattern from a string instead of a file (see decodePattern())
+ */
+int PatternReader::openText(const char* pattern)
+{
+    close();
+
+    text = pattern;
+
+    return 0;
+}
+
+int PatternReader::close()
+{
+    if (file != NULL)
+    {
+        fclose(file);
+        file = NULL;
+    }
+
+    text = NULL;
+    textPosition = 0;
+
+    bufferLength = 0;
+    bufferPosition = 0;
+
+    return 0;
+}
+
+/*
+ * Goes back to the beginning of the pattern
+ */
+int PatternReader::rewind()
+{
+    if (file != NULL)
+    {
+        fseek(file, 0, SEEK_SET);
+    }
+
+    textPosition = 0;
+
+    bufferLength = 0;
+    bufferPosition = 0;
+
+    return 0;
+}
+
+/*
+ * Reads the format, the name and the size of the pattern. The size of the
+ * RLE patterns is in their header, the plaintext and Life 1.06 ones are
+ * read to the end to find it. Returns false if it isn't a pattern or its
+ * size or the coordinates of its cells are bigger than
+ * PATTERN_MAX_COORDINATE.
+ */
+bool PatternReader::readInfo(PatternInfo& info)
+{
+    std::string line;
+
+    info.name = "";
+    info.format = PATTERN_FORMAT_UNKNOWN;
+    info.width = 0;
+    info.height = 0;
+    info.left = 0;
+    info.top = 0;
+
+    rewind();
+
+    while (info.format != PATTERN_FORMAT_RLE and readLine(line) == 0)
+    {
+        if (startsWith(line, "#Life 1.06") == true)
+        {
+            info.format = PATTERN_FORMAT_LIFE_106;
+        }
+        else if (startsWith(line, "#N") == true)
+        {
+            info.name = getValue(line, "#N");
+        }
+        else if (startsWith(line, "!Name:") == true)
+        {
+            info.name = getValue(line, "!Name:");
+            info.format = PATTERN_FORMAT_PLAINTEXT;
+        }
+        else if (isComment(line) == true)
+        {
+            if (startsWith(line, "!") == true)
+            {
+                info.format = PATTERN_FORMAT_PLAINTEXT;
+            }
+        }
+        else if (startsWith(line, "x") == true and
+                 line.find('=') != std::string::npos)
+        {
+            if (sscanf(line.c_str(), " x = %d , y = %d",
+                       &info.width, &info.height) == 2)
+            {
+                info.format = PATTERN_FORMAT_RLE;
+
+                if (info.width < 0 or info.height < 0 or
+                    info.width > PATTERN_MAX_COORDINATE or
+                    info.height > PATTERN_MAX_COORDINATE)
+                {
+                    info.format = PATTERN_FORMAT_UNKNOWN;
+                    break;
+                }
+            }
+        }
+        else if (info.format == PATTERN_FORMAT_UNKNOWN and
+                 line.find_first_not_of(".O* \t") == std::string::npos)
+        {
+            info.format = PATTERN_FORMAT_PLAINTEXT;
+        }
+        else if (info.format != PATTERN_FORMAT_UNKNOWN)
+        {
+            // The first cells of a plaintext or Life 1.06 pattern
+            break;
+        }
+    }
+
+    if ((info.format == PATTERN_FORMAT_PLAINTEXT or
+         info.format == PATTERN_FORMAT_LIFE_106) and measure(info) == -1)
+    {
+        info.format = PATTERN_FORMAT_UNKNOWN;
+    }
+
+    rewind();
+
+    return info.format != PATTERN_FORMAT_UNKNOWN;
+}
+
+/*
+ * Writes the live cells of the pattern to the target with the top left
+ * cell of its bounding box at column, row
+ */
+int PatternReader::decode(const PatternInfo& info,
+                          const PatternTarget& target,
+                          int column,
+                          int row,
+                          unsigned int& population)
+{
+    // The coordinates of Life 1.06 are around 0 0
+    column = column - info.left;
+    row = row - info.top;
+
+    if (info.format == PATTERN_FORMAT_RLE)
+    {
+        decodeRLE(target, column, row, population);
+    }
+    else if (info.format == PATTERN_FORMAT_PLAINTEXT)
+    {
+        decodePlaintext(target, column, row, population);
+    }
+    else if (info.format == PATTERN_FORMAT_LIFE_106)
+    {
+        decodeLife106(target, column, row, population);
+    }
+
+    return 0;
+}
+
+/*
+ * Writes the live cells of the pattern (see readInfo()) in an array of
+ * width x height cells, with the top left cell of its bounding box at
+ * column, row, and adds them to the population. The cells outside of the
+ * array are clipped, the dead ones aren't written.
+ */
+int PatternReader::decode(const PatternInfo& info,
+                          unsigned char* cells,
+                          int width,
+                          int height,
+                          int column,
+                          int row,
+                          unsigned char cell,
+                          unsigned int& population)
+{
+    PatternTarget target;
+
+    target.cells = cells;
+    target.width = width;
+    target.height = height;
+    target.cell = cell;
+    target.universe = NULL;
+
+    return decode(info, target, column, row, population);
+}
+
+/*
+ * Gives life to the live cells of the pattern (see readInfo()) in the
+ * current generation of the universe, with the top left cell of its
+ * bounding box at the cell (column, row), and adds the ones that were dead
+ * to the population. Nothing is clipped: only the cells of the chunks
+ * that don't fit in a full universe are lost.
+ */
+int PatternReader::decode(const PatternInfo& info,
+                          ChunkedUniverse& universe,
+                          int column,
+                          int row,
+                          unsigned int& population)
+{
+    PatternTarget target;
+
+    target.cells = NULL;
+    target.width = 0;
+    target.height = 0;
+    target.cell = 0;
+    target.universe = &universe;
+
+    return decode(info, target, column, row, population);
+}
+
+/*
+ * Reads the headers of the pattern files (.rle, .cells, .lif and .life) of
+ * the folder. The patterns without a name are called like their file.
+ */
+int PatternLibrary::open(const char* directory)
+{
+    PatternReader reader;
+    DIR* dir = opendir(directory);
+    struct dirent* entry;
+
+    paths.clear();
+    infos.clear();
+
+    if (dir == NULL)
+    {
+        return 0;
+    }
+
+    while ((entry = readdir(dir)) != NULL)
+    {
+        std::string fileName = entry->d_name;
+        size_t dot = fileName.find_last_of('.');
+
+        if (dot == std::string::npos or dot == 0)
+        {
+            continue;
+        }
+
+        std::string extension = fileName.substr(dot + 1);
+
+        for (size_t i = 0; i < extension.length(); ++i)
+        {
+            if (extension[i] >= 'A' and extension[i] <= 'Z')
+            {
+                extension[i] = extension[i] - 'A' + 'a';
+            }
+        }
+
+        if (extension != "rle" and extension != "cells" and
+            extension != "lif" and extension != "life")
+        {
+            continue;
+        }
+
+        std::string path = std::string(directory) + "/" + fileName;
+        PatternInfo info;
+
+        if (reader.open(path.c_str()) == false or
+            reader.readInfo(info) == false)
+        {
+            continue;
+        }
+
+        if (info.name.empty() == true)
+        {
+            info.name = fileName.substr(0, dot);
+        }
+
+        // Sorted by name
+        size_t index = 0;
+
+        while (index < infos.size() and
+               isBefore(infos[index].name, info.name) == true)
+        {
+            ++index;
+        }
+
+        paths.insert(paths.begin() + index, path);
+        infos.insert(infos.begin() + index, info);
+    }
+
+    reader.close();
+    closedir(dir);
+
+    return 0;
+}
+
+int PatternLibrary::getNumPatterns()
+{
+    return infos.size();
+}
+
+const PatternInfo& PatternLibrary::getInfo(int index)
+{
+    return infos[index];
+}
+
+/*
+ * Decodes the pattern in the center of an array of width x height cells
+ * (see PatternReader::decode()). Returns false if its file can't be read.
+ */
+bool PatternLibrary::decode(int index,
+                            unsigned char* cells,
+                            int width,
+                            int height,
+                            unsigned char cell,
+                            unsigned int& population)
+{
+    PatternReader reader;
+
+    if (index < 0 or index >= (int) infos.size() or
+        reader.open(paths[index].c_str()) == false)
+    {
+        return false;
+    }
+
+    reader.decode(infos[index], cells, width, height,
+                  (width - infos[index].width) / 2,
+                  (height - infos[index].height) / 2,
+                  cell, population);
+
+    return true;
+}
+
+/*
+ * Decodes the pattern in the universe, centered on a window of width x
+ * height cells whose top left cell is (0, 0), without clipping it to the
+ * window (see PatternReader::decode()). Returns false if its file can't be
+ * read.
+ */
+bool PatternLibrary::decode(int index,
+                            ChunkedUniverse& universe,
+                            int width,
+                            int height,
+                            unsigned int& population)
+{
+    PatternReader reader;
+
+    if (index < 0 or index >= (int) infos.size() or
+        reader.open(paths[index].c_str()) == false)
+    {
+        return false;
+    }
+
+    reader.decode(infos[index], universe,
+                  (width - infos[index].width) / 2,
+                  (height - infos[index].height) / 2,
+                  population);
+
+    return true;
+}
+
+/*
+ * Adds a run of a RLE pattern (the count and the tag) to the line, and
+ * writes the line when it's full
+ */
+static int writeRun(FILE* file, std::string& line, int count, char tag)
+{
+    char run[16];
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    if (count == 1)
+    {
+        snprintf(run, sizeof(run), "%c", tag);
+    }
+    else
+    {
+        snprintf(run, sizeof(run), "%d%c", count, tag);
+    }
+
+    if (line.length() + strlen(run) > PATTERN_LINE_LENGTH)
+    {
+        fprintf(file, "%s\n", line.c_str());
+        line.clear();
+    }
+
+    line += run;
+
+    return 0;
+}
+
+/*
+ * Writes the width x height cells as a RLE pattern file (the cells with the
+ * value cell are alive), so PatternLibrary can read it. Returns false if
+ * the file can't be written.
+ */
+bool writePattern(const char* path,
+                  const std::string& name,
+                  const std::string& comment,
+                  const unsigned char* cells,
+                  int width,
+                  int height,
+                  unsigned char cell)
+{
+    FILE* file = fopen(path, "w");
+    std::string line;
+    int emptyRows = 0;
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    fprintf(file, "#N %s\n", name.c_str());
+
+    if (comment.empty() == false)
+    {
+        fprintf(file, "#C %s\n", comment.c_str());
+    }
+
+    fprintf(file, "x = %d, y = %d, rule = B3/S23\n", width, height);
+
+    for (int y = 0; y < height; ++y)
+    {
+        const unsigned char* row = cells + y * width;
+        int x = 0;
+        bool empty = true;
+
+        while (x < width)
+        {
+            bool alive = row[x] == cell;
+            int run = 1;
+
+            while (x + run < width and (row[x + run] == cell) == alive)
+            {
+                ++run;
+            }
+
+            // The dead cells at the end of the row aren't written
+            if (alive == true or x + run < width)
+            {
+                if (empty == true)
+                {
+                    // The end of the previous rows
+                    writeRun(file, line, emptyRows, '$');
+                    emptyRows = 0;
+                    empty = false;
+                }
+
+                writeRun(file, line, run, alive == true ? 'o' : 'b');
+            }
+
+            x = x + run;
+        }
+
+        ++emptyRows;
+    }
+
+    line += '!';
+    fprintf(file, "%s\n", line.c_str());
+    fclose(file);
+
+    return true;
+}
+
+/*
+ * Decodes a pattern written in the code (see initialConditions.cpp) with
+ * the top left cell of its bounding box at column, row
+ */
+int decodePattern(const char* pattern,
+                  unsigned char* cells,
+                  int width,
+                  int height,
+                  int column,
+                  int row,
+                  unsigned char cell,
+                  unsigned int& population)
+{
+    PatternReader reader;
+    PatternInfo info;
+
+    reader.openText(pattern);
+
+    if (reader.readInfo(info) == true)
+    {
+        reader.decode(info, cells, width, height, column, row, cell,
+                      population);
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+#ifndef PATTERN_H
+#define PATTERN_H
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+/*
+ * Formats of the pattern files
+ */
+#define PATTERN_FORMAT_UNKNOWN 0
+#define PATTERN_FORMAT_RLE 1       // x = 3, y = 3 then b2o$2o$bo!
+#define PATTERN_FORMAT_PLAINTEXT 2 // .cells: a line of . and O per row
+#define PATTERN_FORMAT_LIFE_106 3  // #Life 1.06 then a line "x y" per cell
+
+/*
+ * Bytes of a pattern file read at a time
+ */
+#define PATTERN_BUFFER_SIZE 512
+
+/*
+ * Biggest size and coordinate (from -PATTERN_MAX_COORDINATE) of the cells
+ * of a pattern. The files with bigger ones are rejected, so the size of the
+ * bounding box of a Life 1.06 pattern and the position of its cells in the
+ * grid can't overflow.
+ */
+#define PATTERN_MAX_COORDINATE 1000000
+
+/*
+ * Longest line of the RLE files written by writePattern()
+ */
+#define PATTERN_LINE_LENGTH 70
+
+/*
+ * Folders of the pattern library: in NitroFS (the files of the nitrofiles
+ * folder, inside the .nds) or in the card
+ */
+#define PATTERN_NITROFS_DIRECTORY "nitro:/patterns"
+#define PATTERN_FAT_DIRECTORY "fat:/patterns"
+
+class ChunkedUniverse;
+
+/*
+ * What a pattern is, read from its header (see PatternReader::readInfo())
+ */
+struct PatternInfo
+{
+    std::string name; // #N of RLE, !Name: of plaintext or the file name
+    int format;       // PATTERN_FORMAT_RLE...
+    int width;        // Of its bounding box, in cells
+    int height;
+    int left;         // Coordinates of the top left cell of the bounding
+    int top;          // box (the cells of Life 1.06 are around 0 0)
+};
+
+/*
+ * Where decode() writes the live cells: an array of width x height cells
+ * (universe is NULL) or an unbounded universe (see chunkeduniverse.h)
+ */
+struct PatternTarget
+{
+    unsigned char* cells;
+    int width;
+    int height;
+    unsigned char cell;
+    ChunkedUniverse* universe;
+};
+
+/*
+ * Reads the patterns of the game of life (RLE, plaintext and Life 1.06)
+ * from a file or from a string, a few bytes at a time.
+ *
+ * decode() writes the live cells straight into an array of cells (the
+ * cells of a grid, see grid.h) or into an unbounded universe: each run of
+ * live cells is a single span (memset or a word of a chunk) and the
+ * population is counted while decoding, so nothing is drawn cell by cell
+ * nor counted again afterwards. The array clips the pattern, the universe
+ * keeps all of it.
+ */
+class PatternReader
+{
+    private:
+        FILE* file;
+        const char* text; // The pattern when it isn't read from a file
+        int textPosition;
+
+        char buffer[PATTERN_BUFFER_SIZE];
+        int bufferLength;
+        int bufferPosition;
+
+        int nextChar();
+        int readLine(std::string& line);
+        int measure(PatternInfo& info);
+
+        int decodeRLE(const PatternTarget& target, int column, int row,
+                      unsigned int& population);
+        int decodePlaintext(const PatternTarget& target, int column,
+                            int row, unsigned int& population);
+        int decodeLife106(const PatternTarget& target, int column, int row,
+                          unsigned int& population);
+        int decode(const PatternInfo& info, const PatternTarget& target,
+                   int column, int row, unsigned int& population);
+
+    public:
+        PatternReader();
+        ~PatternReader();
+
+        bool open(const char* path);
+        int openText(const char* pattern);
+        int close();
+        int rewind();
+
+        bool readInfo(PatternInfo& info);
+        int decode(const PatternInfo& info,
+                   unsigned char* cells, int width, int height,
+                   int column, int row, unsigned char cell,
+                   unsigned int& population);
+        int decode(const PatternInfo& info, ChunkedUniverse& universe,
+                   int column, int row, unsigned int& population);
+};
+
+/*
+ * The patterns of a folder.
+ *
+ * open() reads the header of each file once (see PatternReader::readInfo())
+ * and keeps it, sorted by name, so browsing the library only reads the
+ * index. A pattern is only decoded when it's chosen.
+ */
+class PatternLibrary
+{
+    private:
+        std::vector<std::string> paths;
+        std::vector<PatternInfo> infos;
+
+    public:
+        int open(const char* directory);
+        int getNumPatterns();
+        const PatternInfo& getInfo(int index);
+
+        bool decode(int index,
+                    unsigned char* cells, int width, int height,
+                    unsigned char cell, unsigned int& population);
+        bool decode(int index, ChunkedUniverse& universe,
+                    int width, int height, unsigned int& population);
+};
+
+bool writePattern(const char* path, const std::string& name,
+                  const std::string& comment,
+                  const unsigned char* cells, int width, int height,
+                  unsigned char cell);
+int decodePattern(const char* pattern,
+                  unsigned char* cells, int width, int height,
+                  int column, int row, unsigned char cell,
+                  unsigned int& population);
+
+#endif
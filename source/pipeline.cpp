@@ -0,0 +1,300 @@
+#include <stdlib.h>
+
+#ifdef ARM9
+#include <nds.h>
+#endif
+
+#include "pipeline.h"
+
+#ifdef ARM9
+/*
+ * The pipeline whose onVBlank() is called by the VBlank interrupt
+ */
+static FramePipeline* vblankPipeline = NULL;
+
+static void vblankHandler()
+{
+    if (vblankPipeline != NULL)
+    {
+        vblankPipeline->onVBlank();
+    }
+}
+#endif
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Returns true if the buffer is displayed or waits to be displayed
+ */
+bool FramePipeline::isBusy(int buffer)
+{
+    if (buffer == displayed)
+    {
+        return true;
+    }
+
+    for (int i = 0; i < queueLength; ++i)
+    {
+        if (queue[i] == buffer)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Waits until the next VBlank (that calls onVBlank())
+ */
+int FramePipeline::waitForVBlank()
+{
+#ifdef ARM9
+    swiWaitForVBlank();
+#else
+    if (clock != NULL)
+    {
+        clock->waitForVBlank();
+    }
+    else
+    {
+        onVBlank();
+    }
+#endif
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+FramePipeline::FramePipeline()
+{
+    showBuffer = NULL;
+
+    displayed = 0;
+    queueLength = 0;
+    next = 1;
+    running = false;
+
+    frames = 0;
+    flips = 0;
+    stalls = 0;
+
+#ifndef ARM9
+    clock = NULL;
+#endif
+}
+
+/*
+ * Starts the pipeline. The buffer displayedBuffer is on the screen and show
+ * is the function that displays a buffer. It's called from the VBlank
+ * interrupt, in the middle of anything the main loop does, so the screen
+ * must be set up before and show must only write the registers that select
+ * the buffer (see showIndexedFBPage()).
+ */
+int FramePipeline::start(int (*show)(int buffer), int displayedBuffer)
+{
+    stop();
+
+    showBuffer = show;
+
+    displayed = displayedBuffer;
+    queueLength = 0;
+    next = (displayedBuffer + 1) % PIPELINE_NUM_BUFFERS;
+
+    frames = 0;
+    flips = 0;
+    stalls = 0;
+
+    running = true;
+
+#ifdef ARM9
+    vblankPipeline = this;
+    irqSet(IRQ_VBLANK, vblankHandler);
+    irqEnable(IRQ_VBLANK);
+#endif
+
+    return 0;
+}
+
+/*
+ * Stops the pipeline. The buffers waiting in the queue aren't displayed.
+ */
+int FramePipeline::stop()
+{
+#ifdef ARM9
+    if (vblankPipeline == this)
+    {
+        irqSet(IRQ_VBLANK, NULL);
+        vblankPipeline = NULL;
+    }
+#endif
+
+    running = false;
+    queueLength = 0;
+
+    return 0;
+}
+
+bool FramePipeline::isRunning()
+{
+    return running;
+}
+
+/*
+ * Returns the buffer where the next generation must be computed. If it's
+ * still displayed or waiting to be displayed it waits for the VBlanks that
+ * free it.
+ */
+int FramePipeline::acquire()
+{
+    if (running == true and isBusy(next) == true)
+    {
+        ++stalls;
+
+        while (isBusy(next) == true)
+        {
+            waitForVBlank();
+        }
+    }
+
+    return next;
+}
+
+/*
+ * The generation of the buffer returned by acquire() is finished: it will
+ * be displayed by the next VBlank that finds it first in the queue
+ */
+int FramePipeline::submit()
+{
+#ifdef ARM9
+    // The queue is shared with the interrupt handler
+    int savedIME = REG_IME;
+    REG_IME = 0;
+#endif
+
+    queue[queueLength] = next;
+    ++queueLength;
+
+#ifdef ARM9
+    REG_IME = savedIME;
+#endif
+
+    next = (next + 1) % PIPELINE_NUM_BUFFERS;
+
+    return 0;
+}
+
+/*
+ * Called on each VBlank: displays the oldest finished buffer, if there's
+ * one. Otherwise the screen keeps the last generation one more frame.
+ */
+int FramePipeline::onVBlank()
+{
+    ++frames;
+
+    if (running == false or queueLength == 0)
+    {
+        return 0;
+    }
+
+    displayed = queue[0];
+
+    for (int i = 1; i < queueLength; ++i)
+    {
+        queue[i - 1] = queue[i];
+    }
+
+    --queueLength;
+    ++flips;
+
+    if (showBuffer != NULL)
+    {
+        showBuffer(displayed);
+    }
+
+    return 0;
+}
+
+int FramePipeline::getDisplayed()
+{
+    return displayed;
+}
+
+/*
+ * Returns the buffer of the last finished generation (displayed or not)
+ */
+int FramePipeline::getLast()
+{
+    return (next + PIPELINE_NUM_BUFFERS - 1) % PIPELINE_NUM_BUFFERS;
+}
+
+int FramePipeline::getQueueLength()
+{
+    return queueLength;
+}
+
+unsigned long FramePipeline::getFrames()
+{
+    return frames;
+}
+
+unsigned long FramePipeline::getFlips()
+{
+    return flips;
+}
+
+unsigned long FramePipeline::getStalls()
+{
+    return stalls;
+}
+
+#ifndef ARM9
+int FramePipeline::setClock(VBlankClock* vblankClock)
+{
+    clock = vblankClock;
+
+    return 0;
+}
+
+/*********************************CLOCK***************************************/
+
+// Class constructor
+VBlankClock::VBlankClock(FramePipeline* framePipeline)
+{
+    pipeline = framePipeline;
+    now = 0;
+    nextVBlank = PIPELINE_VBLANK_PERIOD_US;
+}
+
+/*
+ * Advances the time, calling the VBlank of the pipeline for each period
+ * that ends
+ */
+int VBlankClock::advance(unsigned long microseconds)
+{
+    now = now + microseconds;
+
+    while (nextVBlank <= now)
+    {
+        nextVBlank = nextVBlank + PIPELINE_VBLANK_PERIOD_US;
+        pipeline->onVBlank();
+    }
+
+    return 0;
+}
+
+/*
+ * Advances the time until the next VBlank (included)
+ */
+int VBlankClock::waitForVBlank()
+{
+    return advance(nextVBlank - now);
+}
+
+unsigned long VBlankClock::getTime()
+{
+    return now;
+}
+#endif
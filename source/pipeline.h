@@ -0,0 +1,108 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+/*
+ * Number of buffers (pages of the framebuffer) of the pipeline
+ */
+#define PIPELINE_NUM_BUFFERS 3
+
+/*
+ * Time between two VBlanks of the DS, in microseconds (59.8261 Hz)
+ */
+#define PIPELINE_VBLANK_PERIOD_US 16715
+
+#ifndef ARM9
+class VBlankClock;
+#endif
+
+/*
+ * Triple buffering of the framebuffer, driven by the VBlank interrupt.
+ *
+ * One buffer is displayed (scanned out), up to two are finished and wait in
+ * a queue to be displayed, and the automata computes the next generation
+ * in the next one. The buffers are used in turn (0, 1, 2, 0, ...), so each
+ * buffer holds the generation of PIPELINE_NUM_BUFFERS steps ago when it's
+ * written again (see Grid::present()).
+ *
+ *     buffer = pipeline.acquire(); // Waits if the buffer is still in use
+ *     ... compute the next generation in the buffer ...
+ *     pipeline.submit();           // Shown by the next free VBlank
+ *
+ * On each VBlank onVBlank() shows the oldest finished buffer, so the
+ * generations are shown in order, each one at least one frame, while the
+ * next ones are computed. acquire() only waits when the automata is two
+ * generations ahead of the screen.
+ *
+ * On the DS onVBlank() is the handler of the VBlank interrupt (irqSet()).
+ * On the host computer there's no interrupt: a VBlankClock calls it, so the
+ * pacing can be tested in headless runs.
+ */
+class FramePipeline
+{
+    private:
+        int (*showBuffer)(int buffer);
+
+        volatile int displayed; // Buffer being scanned out
+        volatile int queue[PIPELINE_NUM_BUFFERS - 1]; // Oldest first
+        volatile int queueLength;
+        int next; // Buffer of the next generation
+        bool running;
+
+        volatile unsigned long frames;  // VBlanks seen
+        volatile unsigned long flips;   // VBlanks that showed a new buffer
+        unsigned long stalls;           // Times acquire() had to wait
+
+#ifndef ARM9
+        VBlankClock* clock;
+#endif
+
+        bool isBusy(int buffer);
+        int waitForVBlank();
+
+    public:
+        FramePipeline();
+
+        int start(int (*show)(int buffer), int displayedBuffer);
+        int stop();
+        bool isRunning();
+
+        int acquire();
+        int submit();
+        int onVBlank();
+
+        int getDisplayed();
+        int getLast();
+        int getQueueLength();
+
+        unsigned long getFrames();
+        unsigned long getFlips();
+        unsigned long getStalls();
+
+#ifndef ARM9
+        int setClock(VBlankClock* vblankClock);
+#endif
+};
+
+#ifndef ARM9
+/*
+ * Simulated VBlank for the host computer: the time advances as the
+ * automata computes (advance()) or waits (waitForVBlank()), and each
+ * PIPELINE_VBLANK_PERIOD_US microseconds the VBlank of the pipeline fires.
+ */
+class VBlankClock
+{
+    private:
+        FramePipeline* pipeline;
+        unsigned long now;       // Microseconds
+        unsigned long nextVBlank;
+
+    public:
+        VBlankClock(FramePipeline* framePipeline);
+
+        int advance(unsigned long microseconds);
+        int waitForVBlank();
+        unsigned long getTime();
+};
+#endif
+
+#endif
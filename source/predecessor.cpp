@@ -0,0 +1,327 @@
+#include <stdlib.h>
+
+#include "predecessor.h"
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Returns the table of the next state of the center of each 3x3 block of
+ * the game of life: the bits 0 to 2 of the index are the row above, 3 to 5
+ * the row of the cell and 6 to 8 the row below (the bit 4 is the cell). It
+ * must be filled before several threads use it (the first search created
+ * fills it).
+ */
+const unsigned char* PredecessorSearch::getNextStates()
+{
+    static unsigned char nextStates[512];
+    static bool filled = false;
+
+    if (filled == false)
+    {
+        for (int block = 0; block < 512; ++block)
+        {
+            bool alive = ((block >> 4) & 1) != 0;
+            int count = __builtin_popcount(block) - (alive == true ? 1 : 0);
+
+            nextStates[block] = count == 3 or (alive == true and count == 2);
+        }
+
+        filled = true;
+    }
+
+    return nextStates;
+}
+
+/*
+ * The entry of the table of dead ends of the search from the row of the
+ * target with the rows of the parent up and middle above it
+ */
+static uint64_t getDeadEndKey(int row, uint32_t up, uint32_t middle)
+{
+    return ((uint64_t) row << 40) | ((uint64_t) up << 20) | middle;
+}
+
+static int getDeadEndIndex(uint64_t key)
+{
+    key = (key ^ (key >> 29)) * 0xBF58476D1CE4E5B9ULL;
+
+    return (int) (key >> 40) & (PREDECESSOR_MEMO_SIZE - 1);
+}
+
+/*
+ * Returns true if the search from the row of the target with the rows of
+ * the parent up and middle found no parent before
+ */
+bool PredecessorSearch::isDeadEnd(int row, uint32_t up, uint32_t middle)
+{
+    uint64_t key = getDeadEndKey(row, up, middle);
+
+    return deadEnds[getDeadEndIndex(key)] == key;
+}
+
+int PredecessorSearch::addDeadEnd(int row, uint32_t up, uint32_t middle)
+{
+    uint64_t key = getDeadEndKey(row, up, middle);
+
+    deadEnds[getDeadEndIndex(key)] = key;
+
+    return 0;
+}
+
+/*
+ * Searches the rows of the parent below the row of the target (its rows
+ * row and row + 1 are known). Returns true when the search has to stop
+ * (maxParents were found).
+ */
+bool PredecessorSearch::searchRows(int row)
+{
+    if (row == height)
+    {
+        PredecessorParent parent;
+
+        parent.firstRow = rows[0];
+        parent.rows = rows;
+        parents->push_back(parent);
+        ++numFound;
+
+        return numFound == maxParents;
+    }
+
+    if (isDeadEnd(row, rows[row], rows[row + 1]) == true)
+    {
+        return false;
+    }
+
+    int found = numFound;
+
+    if (searchColumns(row, 0, false, rows[row], rows[row + 1], 0) == true)
+    {
+        return true;
+    }
+
+    if (numFound == found)
+    {
+        addDeadEnd(row, rows[row], rows[row + 1]);
+    }
+
+    return false;
+}
+
+/*
+ * Chooses the cell of the column of the row of the parent below the row of
+ * the target (down), and the one of the row above it (middle) if it's free
+ * (the first row of the target). When the three columns around a cell of
+ * the target are known, its next state is checked. Returns true when the
+ * search has to stop.
+ */
+bool PredecessorSearch::searchColumns(int row, int column, bool middleFree,
+                                      uint32_t up, uint32_t middle,
+                                      uint32_t down)
+{
+    const unsigned char* nextStates = getNextStates();
+    int choices = middleFree == true ? 4 : 2;
+
+    for (int choice = 0; choice < choices; ++choice)
+    {
+        uint32_t newDown = down | ((uint32_t) (choice & 1) << column);
+        uint32_t newMiddle = middle | ((uint32_t) (choice >> 1) << column);
+
+        ++numNodes;
+
+        // The cell of the target whose right column is this one
+        if (column >= 2)
+        {
+            int x = column - 2;
+            int block = ((up >> x) & 7) | (((newMiddle >> x) & 7) << 3) |
+                        (((newDown >> x) & 7) << 6);
+
+            if (nextStates[block] != ((target[row] >> x) & 1))
+            {
+                continue;
+            }
+        }
+
+        if (column < parentWidth - 1)
+        {
+            if (searchColumns(row, column + 1, middleFree, up, newMiddle,
+                              newDown) == true)
+            {
+                return true;
+            }
+        }
+        else
+        {
+            rows[row + 1] = newMiddle;
+            rows[row + 2] = newDown;
+
+            if (searchRows(row + 1) == true)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+PredecessorSearch::PredecessorSearch()
+{
+    width = 0;
+    height = 0;
+    parentWidth = 0;
+    numNodes = 0;
+    maxParents = 0;
+    parents = NULL;
+    numFound = 0;
+
+    // Filled here, before the threads of the searches use it
+    getNextStates();
+}
+
+/*
+ * Sets the target: the rectangle of w x h cells at (left, top) of the
+ * cells (stride cells per row), alive if they're cell. Returns false if
+ * it's too big (see PREDECESSOR_MAX_WIDTH).
+ */
+bool PredecessorSearch::setTarget(const unsigned char* cells, int stride,
+                                  int left, int top, int w, int h,
+                                  unsigned char cell)
+{
+    if (w < 1 or h < 1 or w > PREDECESSOR_MAX_WIDTH or
+        h > PREDECESSOR_MAX_HEIGHT)
+    {
+        return false;
+    }
+
+    width = w;
+    height = h;
+    parentWidth = w + 2;
+    target.assign(h, 0);
+    rows.assign(h + 2, 0);
+
+    for (int y = 0; y < h; ++y)
+    {
+        const unsigned char* row = cells + (top + y) * stride + left;
+
+        for (int x = 0; x < w; ++x)
+        {
+            if (row[x] == cell)
+            {
+                target[y] = target[y] | (1u << x);
+            }
+        }
+    }
+
+    // The dead ends of another target are wrong
+    deadEnds.assign(PREDECESSOR_MEMO_SIZE, 0);
+
+    return true;
+}
+
+int PredecessorSearch::getWidth()
+{
+    return width;
+}
+
+int PredecessorSearch::getHeight()
+{
+    return height;
+}
+
+int PredecessorSearch::getParentWidth()
+{
+    return parentWidth;
+}
+
+int PredecessorSearch::getParentHeight()
+{
+    return height + 2;
+}
+
+// The values of the first row of a parent (the searches of run())
+uint32_t PredecessorSearch::getNumFirstRows()
+{
+    return 1u << parentWidth;
+}
+
+// The cells chosen until now, a measure of the work done
+unsigned long PredecessorSearch::getNumNodes()
+{
+    return numNodes;
+}
+
+/*
+ * Searches the parents whose first row is firstRow (0 to getNumFirstRows()
+ * - 1) and adds up to max of them to found. Returns the number of parents
+ * found.
+ */
+int PredecessorSearch::run(uint32_t firstRow, int max,
+                           std::vector<PredecessorParent>& found)
+{
+    maxParents = max;
+    parents = &found;
+    numFound = 0;
+
+    rows[0] = firstRow;
+
+    // The first row of the target has two free rows below
+    searchColumns(0, 0, true, firstRow, 0, 0);
+
+    parents = NULL;
+
+    return numFound;
+}
+
+/*
+ * Returns true if the parent becomes the target in one generation
+ */
+bool PredecessorSearch::isParent(const PredecessorParent& parent)
+{
+    const unsigned char* nextStates = getNextStates();
+
+    if ((int) parent.rows.size() != height + 2)
+    {
+        return false;
+    }
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            int block = ((parent.rows[y] >> x) & 7) |
+                        (((parent.rows[y + 1] >> x) & 7) << 3) |
+                        (((parent.rows[y + 2] >> x) & 7) << 6);
+
+            if (nextStates[block] != ((target[y] >> x) & 1))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Writes the cells of the parent (getParentWidth() x getParentHeight(), row
+ * by row) as alive or dead, to show it or write it to a pattern file
+ */
+int PredecessorSearch::getCells(const PredecessorParent& parent,
+                                unsigned char* cells, unsigned char alive,
+                                unsigned char dead)
+{
+    for (int y = 0; y < height + 2; ++y)
+    {
+        for (int x = 0; x < parentWidth; ++x)
+        {
+            bool isAlive = ((parent.rows[y] >> x) & 1) != 0;
+
+            cells[y * parentWidth + x] = isAlive == true ? alive : dead;
+        }
+    }
+
+    return 0;
+}
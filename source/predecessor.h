@@ -0,0 +1,96 @@
+#ifndef PREDECESSOR_H
+#define PREDECESSOR_H
+
+#include <stdint.h>
+#include <vector>
+
+/*
+ * Biggest target of the predecessor search (in cells). Its parents are 2
+ * cells wider and higher, and a row of a parent is a word of up to
+ * PREDECESSOR_MAX_WIDTH + 2 bits.
+ */
+#define PREDECESSOR_MAX_WIDTH 14
+#define PREDECESSOR_MAX_HEIGHT 30
+
+/*
+ * Entries of the table of the dead ends of each search (a power of two).
+ * It's a cache: a new dead end replaces the one in its entry.
+ */
+#define PREDECESSOR_MEMO_SIZE (1 << 18)
+
+/*
+ * A parent of the target: its rows (the bit x of a row is the cell x, 1
+ * alive), from the first one, whose value is the number of the search
+ * that found it (see PredecessorSearch::run())
+ */
+struct PredecessorParent
+{
+    uint32_t firstRow;
+    std::vector<uint32_t> rows;
+};
+
+/*
+ * Searches the predecessors (parents) of a pattern of the game of life: the
+ * patterns that become the target in one generation. Only the cells of
+ * the target are checked, the ones around it can be anything, so a parent
+ * is 2 cells wider and higher than the target. A target without parents
+ * is a Garden of Eden.
+ *
+ * The rows of the parent are chosen from the top, one column at a time:
+ * once the three rows around a row of the target are known up to the
+ * column after a cell of the target, its next state (the entry of its 3x3
+ * block in a table of 512 entries) must be the one of the target, so most
+ * of the rows are discarded after a few columns. The rest of a search only
+ * depends on the last two rows and the row of the target, so the ones
+ * without parents are kept in a table of dead ends and never searched
+ * again.
+ *
+ * The search is split by the value of the first row of the parent: run()
+ * searches the parents with one value, so the values can be shared among
+ * threads (each with its own PredecessorSearch). The parents are found in
+ * the same order for any number of threads.
+ */
+class PredecessorSearch
+{
+    private:
+        int width;  // Of the target
+        int height;
+        std::vector<uint32_t> target; // The rows of the target
+        int parentWidth;
+
+        std::vector<uint32_t> rows;     // The rows of the parent searched
+        std::vector<uint64_t> deadEnds; // See PREDECESSOR_MEMO_SIZE
+        unsigned long numNodes;
+
+        int maxParents;
+        std::vector<PredecessorParent>* parents;
+        int numFound;
+
+        static const unsigned char* getNextStates();
+
+        bool isDeadEnd(int row, uint32_t up, uint32_t middle);
+        int addDeadEnd(int row, uint32_t up, uint32_t middle);
+        bool searchRows(int row);
+        bool searchColumns(int row, int column, bool middleFree,
+                           uint32_t up, uint32_t middle, uint32_t down);
+
+    public:
+        PredecessorSearch();
+
+        bool setTarget(const unsigned char* cells, int stride, int left,
+                       int top, int w, int h, unsigned char cell);
+        int getWidth();
+        int getHeight();
+        int getParentWidth();
+        int getParentHeight();
+        uint32_t getNumFirstRows();
+        unsigned long getNumNodes();
+
+        int run(uint32_t firstRow, int max,
+                std::vector<PredecessorParent>& found);
+        bool isParent(const PredecessorParent& parent);
+        int getCells(const PredecessorParent& parent, unsigned char* cells,
+                     unsigned char alive, unsigned char dead);
+};
+
+#endif
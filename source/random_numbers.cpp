@@ -1,28 +1,332 @@
+#include <stdint.h>
 #include <stdlib.h>
+#include <time.h>
 #include <vector>
-#include <algorithm>
 
-// Improvement: return a pointer to the vector instead of the vector itself
+#include "random_numbers.h"
 
-std::vector<int> get_random_int_vector(int length,
-                                  int lower_limit,
-                                  int upper_limit)
+/*
+ * Mixes a 32 bit value (splitmix32). It's used to spread the bits of the
+ * seed over the whole state of the generator, because xoshiro must not
+ * start from an all-zero state.
+ */
+static uint32_t splitmix32(uint32_t* x)
+{
+    uint32_t z = (*x += 0x9E3779B9);
+
+    z = (z ^ (z >> 16)) * 0x85EBCA6B;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35;
+
+    return z ^ (z >> 16);
+}
+
+static inline uint32_t rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+/*
+ * Advances the state s0 to s3 and returns the next random number. The bulk
+ * draws call it with a copy of the state in local variables, so the
+ * compiler keeps it in registers instead of reading and writing it back
+ * for each number (the buffer they fill could be the state).
+ */
+static inline uint32_t nextRandom(uint32_t& s0, uint32_t& s1, uint32_t& s2,
+                                  uint32_t& s3)
+{
+    const uint32_t result = rotl(s1 * 5, 7) * 9;
+    const uint32_t t = s1 << 9;
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+
+    s2 ^= t;
+
+    s3 = rotl(s3, 11);
+
+    return result;
+}
+
+/*
+ * Advances the state 2^64 numbers. It's used to separate the streams.
+ */
+int RandomNumberGenerator::jump()
+{
+    static const uint32_t JUMP[] = { 0x8764000B, 0xF542D2D3,
+                                     0x6FA035C3, 0x77F2DB5B };
+
+    uint32_t s0 = 0;
+    uint32_t s1 = 0;
+    uint32_t s2 = 0;
+    uint32_t s3 = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        for (int b = 0; b < 32; b++)
+        {
+            if (JUMP[i] & (1u << b))
+            {
+                s0 ^= state[0];
+                s1 ^= state[1];
+                s2 ^= state[2];
+                s3 ^= state[3];
+            }
+            next();
+        }
+    }
+
+    state[0] = s0;
+    state[1] = s1;
+    state[2] = s2;
+    state[3] = s3;
+
+    return 0;
+}
+
+// Class constructor
+RandomNumberGenerator::RandomNumberGenerator()
+{
+    setSeed(0, 0);
+}
+
+/*
+ * Sets the seed and the stream of the generator.
+ * The same pair (seed, stream) always produces the same sequence.
+ */
+int RandomNumberGenerator::setSeed(uint32_t newSeed, uint32_t newStream)
+{
+    uint32_t x = newSeed;
+
+    seed = newSeed;
+    stream = newStream;
+
+    for (int i = 0; i < 4; i++)
+    {
+        state[i] = splitmix32(&x);
+    }
+
+    for (uint32_t i = 0; i < newStream; i++)
+    {
+        jump();
+    }
+
+    return 0;
+}
+
+uint32_t RandomNumberGenerator::getSeed()
+{
+    return seed;
+}
+
+uint32_t RandomNumberGenerator::getStream()
+{
+    return stream;
+}
+
+/*
+ * Returns the next 32 bit random number
+ */
+uint32_t RandomNumberGenerator::next()
+{
+    return nextRandom(state[0], state[1], state[2], state[3]);
+}
+
+/*
+ * Returns a random number between 0 and bound - 1.
+ * It uses a multiplication instead of the modulo operator
+ * (no division, and the high bits are used instead of the low ones).
+ */
+uint32_t RandomNumberGenerator::nextBelow(uint32_t bound)
+{
+    return (uint32_t) (((uint64_t) next() * bound) >> 32);
+}
+
+/*
+ * Fills the buffer with 32 bit random numbers
+ */
+int RandomNumberGenerator::fillInts(uint32_t* buffer, int length)
+{
+    uint32_t s0 = state[0];
+    uint32_t s1 = state[1];
+    uint32_t s2 = state[2];
+    uint32_t s3 = state[3];
+
+    for (int i = 0; i < length; i++)
+    {
+        buffer[i] = nextRandom(s0, s1, s2, s3);
+    }
+
+    state[0] = s0;
+    state[1] = s1;
+    state[2] = s2;
+    state[3] = s3;
+
+    return 0;
+}
+
+/*
+ * Fills the buffer with random numbers between 0 and bound - 1.
+ * Each 32 bit number gives two values of 16 bits and the buffer holds
+ * unsigned shorts, so bound can't be higher than RNG_MAX_SHORT_BOUND (a
+ * higher one is clamped to it).
+ */
+int RandomNumberGenerator::fillIntsBelow(unsigned short* buffer,
+                                         int length,
+                                         uint32_t bound)
+{
+    int i = 0;
+
+    if (bound > RNG_MAX_SHORT_BOUND)
+    {
+        bound = RNG_MAX_SHORT_BOUND;
+    }
+
+    for (; i + 1 < length; i = i + 2)
+    {
+        uint32_t r = next();
+
+        buffer[i] = ((r & 0xFFFF) * bound) >> 16;
+        buffer[i + 1] = ((r >> 16) * bound) >> 16;
+    }
+
+    if (i < length)
+    {
+        buffer[i] = ((next() & 0xFFFF) * bound) >> 16;
+    }
+
+    return 0;
+}
+
+/*
+ * Fills the buffer with numBits random bits packed in 32 bit words
+ * (bit 0 of buffer[0] is the first one). Each bit is 1 with the probability
+ * threshold / RNG_THRESHOLD_ONE (see probabilityToThreshold()) rounded to
+ * RNG_BITS_PRECISION bits.
+ *
+ * The 32 bits of a word are drawn at once from a few random numbers, whose
+ * bits are 1 with the probability 1/2: going through the bits of the
+ * probability from the lowest one set to the highest one, the word is ORed
+ * with a new random number for a 1 and ANDed with it for a 0. So the
+ * probability 0.b1b2...bn takes n - (trailing zeros) random numbers instead
+ * of one for every two bits (a threshold of 1/2 takes only one).
+ */
+int RandomNumberGenerator::fillBits(uint32_t* buffer,
+                                    int numBits,
+                                    uint32_t threshold)
+{
+    int numWords = (numBits + 31) / 32;
+    int shift = 16 - RNG_BITS_PRECISION;
+    uint32_t probability = (threshold + (1u << shift >> 1)) >> shift;
+    uint32_t s0 = state[0];
+    uint32_t s1 = state[1];
+    uint32_t s2 = state[2];
+    uint32_t s3 = state[3];
+
+    for (int w = 0; w < numWords; w++)
+    {
+        uint32_t word = 0;
+
+        if (probability >= (1u << RNG_BITS_PRECISION))
+        {
+            word = 0xFFFFFFFF;
+        }
+        else if (probability != 0)
+        {
+            int bit = __builtin_ctz(probability);
+
+            word = nextRandom(s0, s1, s2, s3);
+
+            for (++bit; bit < RNG_BITS_PRECISION; ++bit)
+            {
+                if (((probability >> bit) & 1) != 0)
+                {
+                    word |= nextRandom(s0, s1, s2, s3);
+                }
+                else
+                {
+                    word &= nextRandom(s0, s1, s2, s3);
+                }
+            }
+        }
+
+        buffer[w] = word;
+    }
+
+    state[0] = s0;
+    state[1] = s1;
+    state[2] = s2;
+    state[3] = s3;
+
+    // Clear the unused bits of the last word
+    if (numBits % 32 != 0)
+    {
+        buffer[numWords - 1] &= (1u << (numBits % 32)) - 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Converts the probability numerator / denominator to the fixed point
+ * threshold used by fillBits()
+ */
+uint32_t probabilityToThreshold(int numerator, int denominator)
+{
+    if (numerator <= 0 or denominator <= 0)
+    {
+        return 0;
+    }
+    else if (numerator >= denominator)
+    {
+        return RNG_THRESHOLD_ONE;
+    }
+
+    return (uint32_t) (((uint64_t) numerator * RNG_THRESHOLD_ONE) /
+                       denominator);
+}
+
+/*
+ * Creates a new seed from the clock.
+ * time() only changes once per second, so a counter is mixed in to get a
+ * different seed each time it's called.
+ */
+uint32_t makeRandomSeed()
+{
+    static uint32_t counter = 0;
+
+    uint32_t x = (uint32_t) time(0) ^ (++counter * 0x632BE5AB);
+
+    return splitmix32(&x);
+}
+
+/*
+ * Returns length different random numbers between lower_limit and
+ * upper_limit - 1 (partial Fisher-Yates shuffle).
+ */
+std::vector<int> get_random_int_vector(RandomNumberGenerator& rng,
+                                       int length,
+                                       int lower_limit,
+                                       int upper_limit)
 {
     std::vector<int> v;
 
-    for(int i = lower_limit; i < upper_limit; i++)
+    for (int i = lower_limit; i < upper_limit; i++)
     {
         v.push_back(i);
     }
 
-    random_shuffle(v.begin(), v.end());
+    for (int i = 0; i < length; i++)
+    {
+        int j = i + rng.nextBelow(v.size() - i);
+
+        int temp = v[i];
+        v[i] = v[j];
+        v[j] = temp;
+    }
 
-    //std::vector<int>::const_iterator first = v.begin() + lower_limit;
-    std::vector<int>::const_iterator first = v.begin();
-    //std::vector<int>::const_iterator last = v.begin() + upper_limit;
-    std::vector<int>::const_iterator last = v.begin() + length;
-    std::vector<int> newVec(first, last);
+    v.resize(length);
 
-    return newVec;
+    return v;
 }
-
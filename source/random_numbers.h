@@ -1,12 +1,69 @@
 #ifndef RANDOM_NUMBERS_H
 #define RANDOM_NUMBERS_H
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <vector>
 
-std::vector<int> get_random_int_vector(int length,
-                                  int lower_limit,
-                                  int upper_limit);
+/*
+ * Fixed-point (Q16) representation of a probability of 1.
+ * A threshold t gives the probability t / RNG_THRESHOLD_ONE.
+ */
+#define RNG_THRESHOLD_ONE 65536
 
+/*
+ * Bits of the probability of the bits of fillBits(): it takes up to this
+ * many random numbers per 32 bits.
+ */
+#define RNG_BITS_PRECISION 8
+
+/*
+ * Highest bound of fillIntsBelow(): its values are 16 bit halves of the
+ * random numbers written to unsigned shorts.
+ */
+#define RNG_MAX_SHORT_BOUND 65536
+
+/*
+ * Seedable pseudorandom number generator (xoshiro128**).
+ *
+ * The same seed and stream always give the same sequence, so a run can be
+ * replayed bit by bit. Each stream is the base sequence advanced by
+ * 2^64 * stream numbers (see jump()), so different streams never overlap
+ * and every automaton (or thread) can have its own one.
+ *
+ * http://prng.di.unimi.it/
+ */
+class RandomNumberGenerator
+{
+    private:
+        uint32_t state[4];
+        uint32_t seed;
+        uint32_t stream;
+
+        int jump();
+
+    public:
+        RandomNumberGenerator();
+
+        int setSeed(uint32_t newSeed, uint32_t newStream);
+        uint32_t getSeed();
+        uint32_t getStream();
+
+        uint32_t next();
+        uint32_t nextBelow(uint32_t bound);
+
+        int fillInts(uint32_t* buffer, int length);
+        int fillIntsBelow(unsigned short* buffer, int length, uint32_t bound);
+        int fillBits(uint32_t* buffer, int numBits, uint32_t threshold);
+};
+
+uint32_t probabilityToThreshold(int numerator, int denominator);
+
+uint32_t makeRandomSeed();
+
+std::vector<int> get_random_int_vector(RandomNumberGenerator& rng,
+                                       int length,
+                                       int lower_limit,
+                                       int upper_limit);
 
 #endif
@@ -0,0 +1,349 @@
+#include <stdio.h>
+
+#include <nds.h>
+
+#include "selectionmenus.h"
+#include "cellularautomata.h"
+#include "framebuffer.h"
+#include "color.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * The rows of the options of the color selection (the last one is back to
+ * main menu) and the partial colors they change
+ */
+static const int CS_MENU_ROWS[] =
+    {CS_MENU_BG_COLOR_R_ROW,
+     CS_MENU_BG_COLOR_G_ROW,
+     CS_MENU_BG_COLOR_B_ROW,
+     CS_MENU_FG_COLOR_R_ROW,
+     CS_MENU_FG_COLOR_G_ROW,
+     CS_MENU_FG_COLOR_B_ROW,
+     CS_MENU_FG2_COLOR_R_ROW,
+     CS_MENU_FG2_COLOR_G_ROW,
+     CS_MENU_FG2_COLOR_B_ROW,
+     CS_MENU_LINE_COLOR_R_ROW,
+     CS_MENU_LINE_COLOR_G_ROW,
+     CS_MENU_LINE_COLOR_B_ROW,
+     CS_MENU_BACK_TO_MAIN_ROW};
+static unsigned short* const CS_MENU_PARTIAL_COLORS[] =
+    {&BG_R, &BG_G, &BG_B,
+     &FG_R, &FG_G, &FG_B,
+     &FG_R2, &FG_G2, &FG_B2,
+     &line_R, &line_G, &line_B};
+
+// The rows of the languages of the language selection (EN, ES and EU) and
+// back to main menu
+static const int LANGUAGE_MENU_ROWS[] = {10, 11, 12, 14};
+
+/******************************COLOR SELECTION********************************/
+
+/*
+ * Draws the two colors of the cells in the menu to select them
+ */
+int ColorSelection::initialize(CellularAutomata& automata)
+{
+    Automaton::initialize(automata);
+
+    drawRectangle(75, 70, 50, 50, FG_color);
+    drawRectangle(75, 130, 50, 50, FG_color2);
+
+    // top (horizontal)
+    for (int i = 65; i < 75; ++i)
+    {
+        drawHLine(60, i, 130, line_color, fb);
+    }
+
+    // bottom (horizontal)
+    for (int i = 125; i < 135; ++i)
+    {
+        drawHLine(60, i, 130, line_color, fb);
+    }
+
+    // left (vertical)
+    for (int i = 60; i < 70; ++i)
+    {
+        drawVLine(i, 65, 70, line_color);
+    }
+
+    // center (vertical)
+    for (int i = 120; i < 130; ++i)
+    {
+        drawVLine(i, 65, 70, line_color);
+    }
+
+    // right (vertical)
+    for (int i = 180; i < 190; ++i)
+    {
+        drawVLine(i, 65, 70, line_color);
+    }
+
+    return 0;
+}
+
+const std::string& ColorSelection::getName()
+{
+    return stringSelectColors;
+}
+
+/*
+ * The options fill the screen: no credits
+ */
+int ColorSelection::printTitle()
+{
+    printf("%s:", stringSelectColors.c_str());
+
+    return 0;
+}
+
+int ColorSelection::printMenu()
+{
+    printString(CS_MENU_BG_COLOR_ROW,
+                CS_MENU_MAIN_COL,
+                stringBackgroundColor);
+    printPartialColor(CS_MENU_BG_COLOR_R_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringRed, BG_R);
+    printPartialColor(CS_MENU_BG_COLOR_G_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringGreen, BG_G);
+    printPartialColor(CS_MENU_BG_COLOR_B_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringBlue, BG_B);
+
+    printString(CS_MENU_FG_COLOR_ROW,
+                CS_MENU_MAIN_COL,
+                stringForegroundColor);
+    printPartialColor(CS_MENU_FG_COLOR_R_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringRed, FG_R);
+    printPartialColor(CS_MENU_FG_COLOR_G_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringGreen, FG_G);
+    printPartialColor(CS_MENU_FG_COLOR_B_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringBlue, FG_B);
+
+    printString(CS_MENU_FG2_COLOR_ROW,
+                CS_MENU_MAIN_COL,
+                stringSecondForegroundColor);
+    printPartialColor(CS_MENU_FG2_COLOR_R_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringRed, FG_R2);
+    printPartialColor(CS_MENU_FG2_COLOR_G_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringGreen, FG_G2);
+    printPartialColor(CS_MENU_FG2_COLOR_B_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringBlue, FG_B2);
+
+    printString(CS_MENU_LINE_COLOR_ROW,
+                CS_MENU_MAIN_COL,
+                stringLineColor);
+    printPartialColor(CS_MENU_LINE_COLOR_R_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringRed, line_R);
+    printPartialColor(CS_MENU_LINE_COLOR_G_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringGreen, line_G);
+    printPartialColor(CS_MENU_LINE_COLOR_B_ROW,
+                      CS_MENU_PARTIAL_COLOR_COL,
+                      stringBlue, line_B);
+
+    printString(CS_MENU_BACK_TO_MAIN_ROW,
+                CS_MENU_MAIN_COL,
+                stringBackToMainMenu);
+
+    return 0;
+}
+
+int ColorSelection::printMenuArrow(int index, bool boolDelete)
+{
+    return printOptionArrow(CS_MENU_ROWS[index], 0, boolDelete);
+}
+
+// No counters
+int ColorSelection::printCounters()
+{
+    return 0;
+}
+
+// Nothing runs, the colors are drawn by initialize()
+int ColorSelection::runFrame(CellularAutomata& automata)
+{
+    return 0;
+}
+
+/*
+ * LEFT and RIGHT change the partial color of the arrow (0 to 31) and draw
+ * the new colors
+ */
+int ColorSelection::updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 12) // Back to main menu
+        {
+            showAutomataTypeMenu();
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(12);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(12);
+    }
+    else if (keys_pressed & (KEY_LEFT | KEY_RIGHT))
+    {
+        if (arrow < 12)
+        {
+            unsigned short* partialColor = CS_MENU_PARTIAL_COLORS[arrow];
+
+            if ((keys_pressed & KEY_LEFT) and *partialColor != 0)
+            {
+                --(*partialColor);
+            }
+            else if ((keys_pressed & KEY_RIGHT) and *partialColor != 31)
+            {
+                ++(*partialColor);
+            }
+        }
+
+        printMenu();
+
+        BG_color = RGB15(BG_R, BG_G, BG_B);
+        FG_color = RGB15(FG_R, FG_G, FG_B);
+        FG_color2 = RGB15(FG_R2, FG_G2, FG_B2);
+        line_color = RGB15(line_R, line_G, line_B);
+
+        automata.initialize();
+
+        swiWaitForVBlank();
+    }
+
+    return 0;
+}
+
+/*****************************LANGUAGE SELECTION******************************/
+
+/*
+ * Changes the language and prints the menu again with it
+ */
+int LanguageSelection::setLanguage(int language)
+{
+    displayedLanguage = language;
+
+    changeTextLanguage(language);
+
+    consoleClear();
+    printTitle();
+    printMenu();
+
+    printMenuArrow(arrow, false);
+    printMenuAsterisks();
+
+    return 0;
+}
+
+/*
+ * The main screen shows the flash screen
+ */
+int LanguageSelection::initialize(CellularAutomata& automata)
+{
+    return showFlash();
+}
+
+const std::string& LanguageSelection::getName()
+{
+    return stringSelectLanguage;
+}
+
+int LanguageSelection::printTitle()
+{
+    printCredits();
+
+    printf("%s:", stringSelectLanguage.c_str());
+
+    return 0;
+}
+
+int LanguageSelection::printMenu()
+{
+    printString(LANGUAGE_MENU_ROWS[EN], 3, stringEnglish);
+    printString(LANGUAGE_MENU_ROWS[ES], 3, stringEspanol);
+    printString(LANGUAGE_MENU_ROWS[EU], 3, stringEuskara);
+
+    printString(LANGUAGE_MENU_ROWS[3], 2, stringBackToMainMenu);
+
+    return 0;
+}
+
+int LanguageSelection::printMenuArrow(int index, bool boolDelete)
+{
+    return printOptionArrow(LANGUAGE_MENU_ROWS[index], 0, boolDelete);
+}
+
+/*
+ * Marks the language shown
+ */
+int LanguageSelection::printMenuAsterisks()
+{
+    for (int language = EN; language <= EU; ++language)
+    {
+        if (language == displayedLanguage)
+        {
+            printAsterisk(LANGUAGE_MENU_ROWS[language], 2);
+        }
+        else
+        {
+            deleteAsterisk(LANGUAGE_MENU_ROWS[language], 2);
+        }
+    }
+
+    return 0;
+}
+
+// No counters
+int LanguageSelection::printCounters()
+{
+    return 0;
+}
+
+// Nothing runs
+int LanguageSelection::runFrame(CellularAutomata& automata)
+{
+    return 0;
+}
+
+int LanguageSelection::updateMenu(CellularAutomata& automata,
+                                  int keys_pressed,
+                                  int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 3) // Back to main menu
+        {
+            showAutomataTypeMenu();
+        }
+        else // English, Spanish or Basque
+        {
+            setLanguage(arrow);
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(3);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(3);
+    }
+
+    return 0;
+}
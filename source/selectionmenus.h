@@ -0,0 +1,60 @@
+#ifndef SELECTIONMENUS_H
+#define SELECTIONMENUS_H
+
+#include <string>
+
+#include "automaton.h"
+
+/*
+ * The menus of the main menu that aren't automata: they only have their
+ * options, nothing runs in each frame
+ */
+
+/*
+ * The selection of the colors: the red, green and blue of the background,
+ * the two foreground colors and the lines (0-11) and back to main menu
+ * (12). The main screen shows the colors chosen.
+ */
+class ColorSelection : public Automaton
+{
+    public:
+        virtual int initialize(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int printTitle();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int printCounters();
+
+        virtual int runFrame(CellularAutomata& automata);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+/*
+ * The selection of the language: English, Spanish and Basque (0-2) and
+ * back to main menu (3)
+ */
+class LanguageSelection : public Automaton
+{
+    private:
+        int setLanguage(int language);
+
+    public:
+        virtual int initialize(CellularAutomata& automata);
+
+        virtual const std::string& getName();
+        virtual int printTitle();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int printMenuAsterisks();
+        virtual int printCounters();
+
+        virtual int runFrame(CellularAutomata& automata);
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
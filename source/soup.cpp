@@ -0,0 +1,1065 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "soup.h"
+#include "stencil.h"
+#include "liferule.h"
+#include "pattern.h"
+
+/*
+ * Digits of the extended Wechsler format (a column of 5 cells each)
+ */
+static const char* wechslerDigits = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/*
+ * A line of the census file (see ObjectCensus::write())
+ */
+struct CensusLine
+{
+    std::string code;
+    unsigned long count;
+};
+
+/*
+ * The most common objects first, then by code
+ */
+static bool isBefore(const CensusLine& line, const CensusLine& other)
+{
+    if (line.count != other.count)
+    {
+        return line.count > other.count;
+    }
+
+    return line.code < other.code;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+ObjectCensus::ObjectCensus()
+{
+    numSoups = 0;
+    numUnstable = 0;
+}
+
+int ObjectCensus::addSoup(bool stabilized)
+{
+    ++numSoups;
+
+    if (stabilized == false)
+    {
+        ++numUnstable;
+    }
+
+    return 0;
+}
+
+/*
+ * Counts the object. The one of the first soup of each code is kept (see
+ * writeObjects()).
+ */
+int ObjectCensus::addObject(const SoupObject& object)
+{
+    std::map<std::string, CensusEntry>::iterator entry =
+        objects.find(object.code);
+
+    if (entry == objects.end())
+    {
+        CensusEntry newEntry;
+
+        newEntry.count = 1;
+        newEntry.shape = object.shape;
+        newEntry.soup = object.soup;
+
+        objects[object.code] = newEntry;
+    }
+    else
+    {
+        ++entry->second.count;
+
+        if (object.soup < entry->second.soup)
+        {
+            entry->second.shape = object.shape;
+            entry->second.soup = object.soup;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Adds the counts of another census (of another thread of the search)
+ */
+int ObjectCensus::merge(const ObjectCensus& other)
+{
+    std::map<std::string, CensusEntry>::const_iterator entry;
+
+    for (entry = other.objects.begin(); entry != other.objects.end();
+         ++entry)
+    {
+        std::map<std::string, CensusEntry>::iterator own =
+            objects.find(entry->first);
+
+        if (own == objects.end())
+        {
+            objects[entry->first] = entry->second;
+        }
+        else
+        {
+            own->second.count = own->second.count + entry->second.count;
+
+            if (entry->second.soup < own->second.soup)
+            {
+                own->second.shape = entry->second.shape;
+                own->second.soup = entry->second.soup;
+            }
+        }
+    }
+
+    numSoups = numSoups + other.numSoups;
+    numUnstable = numUnstable + other.numUnstable;
+
+    return 0;
+}
+
+unsigned long ObjectCensus::getNumSoups()
+{
+    return numSoups;
+}
+
+unsigned long ObjectCensus::getNumUnstable()
+{
+    return numUnstable;
+}
+
+/*
+ * Returns the number of different objects
+ */
+int ObjectCensus::getNumObjects()
+{
+    return objects.size();
+}
+
+/*
+ * Returns the codes and the counts of the number most common objects (all
+ * of them if number is -1), the most common first
+ */
+int ObjectCensus::getMostCommon(int number, std::vector<std::string>& codes,
+                                std::vector<unsigned long>& counts)
+{
+    std::vector<CensusLine> lines;
+    std::map<std::string, CensusEntry>::const_iterator entry;
+
+    for (entry = objects.begin(); entry != objects.end(); ++entry)
+    {
+        CensusLine line;
+
+        line.code = entry->first;
+        line.count = entry->second.count;
+        lines.push_back(line);
+    }
+
+    std::sort(lines.begin(), lines.end(), isBefore);
+
+    codes.clear();
+    counts.clear();
+
+    for (size_t i = 0; i < lines.size() and
+                       (number == -1 or (int) i < number); ++i)
+    {
+        codes.push_back(lines[i].code);
+        counts.push_back(lines[i].count);
+    }
+
+    return 0;
+}
+
+/*
+ * Writes the census: a line with the code and the count of each object,
+ * the most common first. Returns false if the file can't be written.
+ */
+bool ObjectCensus::write(const char* path, uint32_t seed)
+{
+    FILE* file = fopen(path, "w");
+    std::vector<std::string> codes;
+    std::vector<unsigned long> counts;
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    getMostCommon(-1, codes, counts);
+
+    fprintf(file, "# Census of the soup search\n");
+    fprintf(file, "# seed %u, %lu soups (%lu not stabilized)\n",
+            (unsigned int) seed, numSoups, numUnstable);
+
+    for (size_t i = 0; i < codes.size(); ++i)
+    {
+        fprintf(file, "%s %lu\n", codes[i].c_str(), counts[i]);
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+/*
+ * Writes the first object of each code as a RLE file (its code and .rle)
+ * in the folder, so it can be copied to the pattern library of the DS
+ * (see PatternLibrary). Returns the number of files written, or -1 if a
+ * file can't be written (the folder doesn't exist...).
+ */
+int ObjectCensus::writeObjects(const char* directory)
+{
+    std::map<std::string, CensusEntry>::const_iterator entry;
+    int written = 0;
+
+    for (entry = objects.begin(); entry != objects.end(); ++entry)
+    {
+        const SoupShape& shape = entry->second.shape;
+        std::string path = std::string(directory) + "/" + entry->first +
+                           ".rle";
+        char comment[64];
+
+        snprintf(comment, sizeof(comment),
+                 "Found %lu times by the soup search, first in soup %u",
+                 entry->second.count, (unsigned int) entry->second.soup);
+
+        if (writePattern(path.c_str(), entry->first, comment,
+                         &shape.cells[0], shape.width, shape.height,
+                         1) == false)
+        {
+            return -1;
+        }
+
+        ++written;
+    }
+
+    return written;
+}
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * The key of the cell (x, y) in a SoupCells: the row in the high half and
+ * the column in the low half, both offset so the cells around the soup
+ * (even the ones of the spaceships far from it) are positive. The keys of
+ * the cells of a row are consecutive, so the sorted cells are in rows.
+ */
+uint32_t SoupSearch::getKey(int x, int y)
+{
+    return ((uint32_t) (y + 32768) << 16) | (uint32_t) (x + 32768);
+}
+
+int SoupSearch::getX(uint32_t key)
+{
+    return (int) (key & 0xFFFF) - 32768;
+}
+
+int SoupSearch::getY(uint32_t key)
+{
+    return (int) (key >> 16) - 32768;
+}
+
+/*
+ * Writes the live cells of the universe to cells (sorted)
+ */
+int SoupSearch::getCells(ChunkedUniverse& source, SoupCells& cells)
+{
+    int current = source.getCurrent();
+
+    cells.clear();
+
+    for (int i = 0; i < source.getNumChunks(); ++i)
+    {
+        UniverseChunk* chunk = source.getChunk(i);
+
+        for (int r = 0; r < UNIVERSE_CHUNK_SIZE; ++r)
+        {
+            uint32_t bits = chunk->rows[current][r];
+            int y = chunk->y * UNIVERSE_CHUNK_SIZE + r;
+
+            while (bits != 0)
+            {
+                int x = chunk->x * UNIVERSE_CHUNK_SIZE + __builtin_ctz(bits);
+
+                cells.push_back(getKey(x, y));
+                bits = bits & (bits - 1);
+            }
+        }
+    }
+
+    // The chunks aren't in order
+    std::sort(cells.begin(), cells.end());
+
+    return 0;
+}
+
+/*
+ * Copies the cells to the shape (their bounding box), whose upper left
+ * cell is (left, top). Returns false if there are no cells.
+ */
+bool SoupSearch::getShape(const SoupCells& cells, SoupShape& shape,
+                          int& left, int& top)
+{
+    if (cells.empty() == true)
+    {
+        return false;
+    }
+
+    int right = getX(cells[0]);
+
+    left = right;
+    top = getY(cells[0]);
+
+    for (size_t i = 1; i < cells.size(); ++i)
+    {
+        int x = getX(cells[i]);
+
+        left = x < left ? x : left;
+        right = x > right ? x : right;
+    }
+
+    shape.width = right - left + 1;
+    shape.height = getY(cells.back()) - top + 1;
+    shape.cells.assign(shape.width * shape.height, 0);
+
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        shape.cells[(getY(cells[i]) - top) * shape.width +
+                    getX(cells[i]) - left] = 1;
+    }
+
+    return true;
+}
+
+/*
+ * Clears the universe and gives life to the cells
+ */
+int SoupSearch::loadCells(ChunkedUniverse& target, const SoupCells& cells)
+{
+    target.clear();
+
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        target.setCell(getX(cells[i]), getY(cells[i]));
+    }
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation of the universe, and its population
+ */
+int SoupSearch::step(ChunkedUniverse& target, long& population)
+{
+    LifeRule rule;
+    int populationChange;
+
+    rule.state = CELL_FG;
+
+    ChunkedStencil<MooreNeighborhood, LifeRule>::step(target, rule,
+                                                      populationChange);
+    target.swap();
+
+    population = population + populationChange;
+
+    return 0;
+}
+
+/*
+ * Fills the universe with the random soup, at (0, 0)
+ */
+int SoupSearch::fillSoup(uint32_t seed, uint32_t number)
+{
+    universe.clear();
+    population = 0;
+
+    rng.setSeed(seed, number);
+
+    // 32 random bits are two rows
+    for (int y = 0; y < SOUP_SIZE; y = y + 2)
+    {
+        uint32_t bits = rng.next();
+
+        for (int i = 0; i < 2 * SOUP_SIZE; ++i)
+        {
+            if (((bits >> i) & 1) != 0)
+            {
+                universe.setCell(i % SOUP_SIZE, y + i / SOUP_SIZE);
+                ++population;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Splits the live cells of the universe into objects: the cells closer
+ * than 3 cells (that can interact) are in the same object. Returns the
+ * number of objects.
+ */
+int SoupSearch::findObjects()
+{
+    getCells(universe, liveCells);
+
+    labels.assign(liveCells.size(), -1);
+    objectCells.clear();
+    objectStarts.clear();
+
+    for (size_t c = 0; c < liveCells.size(); ++c)
+    {
+        if (labels[c] != -1)
+        {
+            continue;
+        }
+
+        int object = objectStarts.size();
+
+        objectStarts.push_back(objectCells.size());
+        objectCells.push_back(liveCells[c]);
+        labels[c] = object;
+
+        // The cells added are the queue of the search
+        for (size_t i = objectStarts[object]; i < objectCells.size(); ++i)
+        {
+            int x = getX(objectCells[i]);
+            int y = getY(objectCells[i]);
+
+            for (int ny = y - 2; ny <= y + 2; ++ny)
+            {
+                // The cells of the row from x - 2 to x + 2
+                SoupCells::iterator n =
+                    std::lower_bound(liveCells.begin(), liveCells.end(),
+                                     getKey(x - 2, ny));
+
+                for (; n != liveCells.end() and *n <= getKey(x + 2, ny); ++n)
+                {
+                    int index = n - liveCells.begin();
+
+                    if (labels[index] == -1)
+                    {
+                        labels[index] = object;
+                        objectCells.push_back(*n);
+                    }
+                }
+            }
+        }
+    }
+
+    int numObjects = objectStarts.size();
+
+    objectStarts.push_back(objectCells.size());
+
+    return numObjects;
+}
+
+/*
+ * Writes the cells of the object (see findObjects()) to cells (sorted)
+ */
+int SoupSearch::getObject(int object, SoupCells& cells)
+{
+    cells.assign(objectCells.begin() + objectStarts[object],
+                 objectCells.begin() + objectStarts[object + 1]);
+
+    std::sort(cells.begin(), cells.end());
+
+    return 0;
+}
+
+/*
+ * Runs the cells alone until they repeat (up to CYCLE_MAX_PERIOD
+ * generations) and gives them their code (see canonise()), dx and dy are
+ * their movement in a period. If phases isn't NULL it gets the cells of
+ * each phase of the period. Returns false if they don't repeat (the code
+ * is then zz_UNKNOWN, or zz_LARGE for the objects too big to canonise).
+ */
+bool SoupSearch::classify(const SoupCells& cells, SoupObject& result,
+                          int& dx, int& dy, std::vector<SoupCells>* phases)
+{
+    int left;
+    int top;
+
+    result.soup = soup;
+    result.code = "zz_UNKNOWN";
+    dx = 0;
+    dy = 0;
+
+    if (getShape(cells, result.shape, left, top) == false)
+    {
+        return false;
+    }
+
+    if (result.shape.width > SOUP_OBJECT_MAX_SIZE or
+        result.shape.height > SOUP_OBJECT_MAX_SIZE)
+    {
+        result.code = "zz_LARGE";
+        return false;
+    }
+
+    std::vector<SoupShape> shapes;
+    std::vector<SoupCells> cellsOfPhases;
+    long objectPopulation = cells.size();
+
+    loadCells(objectUniverse, cells);
+
+    shapes.push_back(result.shape);
+    cellsOfPhases.push_back(cells);
+
+    for (int period = 1; period <= CYCLE_MAX_PERIOD; ++period)
+    {
+        SoupCells phase;
+        SoupShape shape;
+        int newLeft;
+        int newTop;
+
+        step(objectUniverse, objectPopulation);
+
+        if (objectPopulation == 0)
+        {
+            break;
+        }
+
+        getCells(objectUniverse, phase);
+        getShape(phase, shape, newLeft, newTop);
+
+        // It grows
+        if (shape.width > SOUP_OBJECT_MAX_SIZE or
+            shape.height > SOUP_OBJECT_MAX_SIZE)
+        {
+            break;
+        }
+
+        if (shape.width == shapes[0].width and
+            shape.height == shapes[0].height and
+            shape.cells == shapes[0].cells)
+        {
+            char prefix[16];
+
+            dx = newLeft - left;
+            dy = newTop - top;
+
+            if (dx != 0 or dy != 0)
+            {
+                snprintf(prefix, sizeof(prefix), "xq%d_", period);
+            }
+            else if (period == 1)
+            {
+                snprintf(prefix, sizeof(prefix), "xs%d_",
+                         (int) objectPopulation);
+            }
+            else
+            {
+                snprintf(prefix, sizeof(prefix), "xp%d_", period);
+            }
+
+            result.code = prefix + canonise(shapes);
+
+            if (phases != NULL)
+            {
+                phases->swap(cellsOfPhases);
+            }
+
+            return true;
+        }
+
+        shapes.push_back(shape);
+        cellsOfPhases.push_back(phase);
+    }
+
+    return false;
+}
+
+/*
+ * Returns true if the part of the cluster, run alone from the cells of its
+ * first phase that are in the part, has the cells of the part in every
+ * phase of the cluster (and repeats with it)
+ */
+bool SoupSearch::runsAlone(const SoupCells& part,
+                           const std::vector<SoupCells>& phases)
+{
+    int period = phases.size();
+    long partPopulation;
+    SoupCells expected;
+    SoupCells phase;
+
+    std::set_intersection(phases[0].begin(), phases[0].end(),
+                          part.begin(), part.end(),
+                          std::back_inserter(expected));
+
+    partPopulation = expected.size();
+    loadCells(objectUniverse, expected);
+
+    for (int generation = 1; generation <= period; ++generation)
+    {
+        const SoupCells& cluster = phases[generation % period];
+
+        step(objectUniverse, partPopulation);
+        getCells(objectUniverse, phase);
+
+        expected.clear();
+        std::set_intersection(cluster.begin(), cluster.end(),
+                              part.begin(), part.end(),
+                              std::back_inserter(expected));
+
+        if (phase != expected)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Splits a cluster that repeats in place (its cells in each phase of its
+ * period) into the objects that don't interact: the cells that the cluster
+ * takes in any phase (its envelope) are split into connected parts
+ * (touching cells, diagonals included), then the parts that don't run
+ * alone like in the cluster (see runsAlone()) are joined with the parts
+ * closer than 3 cells, that can change them, until every part runs alone.
+ * Writes the first phase of each object to parts (only one when the
+ * cluster is a single object).
+ */
+int SoupSearch::separate(const std::vector<SoupCells>& phases,
+                         std::vector<SoupCells>& parts)
+{
+    SoupCells envelope;
+
+    parts.clear();
+
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        envelope.insert(envelope.end(), phases[i].begin(), phases[i].end());
+    }
+
+    std::sort(envelope.begin(), envelope.end());
+    envelope.erase(std::unique(envelope.begin(), envelope.end()),
+                   envelope.end());
+
+    // The connected part of each cell of the envelope, and the group
+    // of each part (the parts joined)
+    std::vector<int> partOf(envelope.size(), -1);
+    std::vector<int> groupOf;
+    std::vector<uint32_t> queue;
+
+    for (size_t c = 0; c < envelope.size(); ++c)
+    {
+        if (partOf[c] != -1)
+        {
+            continue;
+        }
+
+        int part = groupOf.size();
+
+        groupOf.push_back(part);
+        partOf[c] = part;
+        queue.assign(1, envelope[c]);
+
+        while (queue.empty() == false)
+        {
+            int x = getX(queue.back());
+            int y = getY(queue.back());
+
+            queue.pop_back();
+
+            for (int ny = y - 1; ny <= y + 1; ++ny)
+            {
+                SoupCells::iterator n =
+                    std::lower_bound(envelope.begin(), envelope.end(),
+                                     getKey(x - 1, ny));
+
+                for (; n != envelope.end() and *n <= getKey(x + 1, ny); ++n)
+                {
+                    int index = n - envelope.begin();
+
+                    if (partOf[index] == -1)
+                    {
+                        partOf[index] = part;
+                        queue.push_back(*n);
+                    }
+                }
+            }
+        }
+    }
+
+    int numGroups = groupOf.size();
+
+    while (numGroups > 1)
+    {
+        std::vector<SoupCells> groups(groupOf.size());
+        std::vector<int> failed;
+
+        for (size_t c = 0; c < envelope.size(); ++c)
+        {
+            groups[groupOf[partOf[c]]].push_back(envelope[c]);
+        }
+
+        for (size_t g = 0; g < groups.size(); ++g)
+        {
+            if (groups[g].empty() == false and
+                runsAlone(groups[g], phases) == false)
+            {
+                failed.push_back(g);
+            }
+        }
+
+        if (failed.empty() == true)
+        {
+            // The first phase of each object
+            for (size_t g = 0; g < groups.size(); ++g)
+            {
+                if (groups[g].empty() == false)
+                {
+                    SoupCells cells;
+
+                    std::set_intersection(phases[0].begin(),
+                                          phases[0].end(),
+                                          groups[g].begin(),
+                                          groups[g].end(),
+                                          std::back_inserter(cells));
+                    parts.push_back(cells);
+                }
+            }
+
+            return 0;
+        }
+
+        int joined = 0;
+
+        // The groups that don't run alone take the ones that can change
+        // them (the first cell that differs has a neighbor of another
+        // group closer than 3 cells)
+        for (size_t f = 0; f < failed.size(); ++f)
+        {
+            const SoupCells& cells = groups[failed[f]];
+
+            for (size_t i = 0; i < cells.size(); ++i)
+            {
+                int x = getX(cells[i]);
+                int y = getY(cells[i]);
+
+                for (int ny = y - 2; ny <= y + 2; ++ny)
+                {
+                    SoupCells::iterator n =
+                        std::lower_bound(envelope.begin(), envelope.end(),
+                                         getKey(x - 2, ny));
+
+                    for (; n != envelope.end() and
+                           *n <= getKey(x + 2, ny); ++n)
+                    {
+                        int group = groupOf[partOf[n - envelope.begin()]];
+
+                        if (group == failed[f])
+                        {
+                            continue;
+                        }
+
+                        // The parts of the group go to the failed one
+                        for (size_t p = 0; p < groupOf.size(); ++p)
+                        {
+                            if (groupOf[p] == group)
+                            {
+                                groupOf[p] = failed[f];
+                            }
+                        }
+
+                        ++joined;
+                    }
+                }
+            }
+        }
+
+        // Nothing else can change them: the cluster is one object
+        if (joined == 0)
+        {
+            break;
+        }
+
+        numGroups = 0;
+
+        for (size_t g = 0; g < groupOf.size(); ++g)
+        {
+            bool used = false;
+
+            for (size_t p = 0; p < groupOf.size(); ++p)
+            {
+                used = used or groupOf[p] == (int) g;
+            }
+
+            numGroups = used == true ? numGroups + 1 : numGroups;
+        }
+    }
+
+    parts.push_back(phases[0]);
+
+    return 0;
+}
+
+/*
+ * Counts and removes the spaceships that leave the ash (small objects far
+ * from the center that move away from it). Returns the number of
+ * spaceships removed.
+ */
+int SoupSearch::removeSpaceships(ObjectCensus& census)
+{
+    int numObjects = findObjects();
+    int center = SOUP_SIZE / 2;
+    int removed = 0;
+    SoupCells remaining;
+
+    for (int object = 0; object < numObjects; ++object)
+    {
+        int size = objectStarts[object + 1] - objectStarts[object];
+        SoupCells cells;
+        SoupObject result;
+        int left;
+        int top;
+        int dx;
+        int dy;
+
+        getObject(object, cells);
+
+        if (size <= SOUP_SPACESHIP_MAX_CELLS)
+        {
+            getShape(cells, result.shape, left, top);
+
+            int x = (2 * left + result.shape.width - 1) / 2 - center;
+            int y = (2 * top + result.shape.height - 1) / 2 - center;
+
+            if ((abs(x) > SOUP_SIZE or abs(y) > SOUP_SIZE) and
+                classify(cells, result, dx, dy, NULL) == true and
+                (dx != 0 or dy != 0) and x * dx + y * dy > 0)
+            {
+                census.addObject(result);
+
+                population = population - size;
+                ++removed;
+
+                continue;
+            }
+        }
+
+        remaining.insert(remaining.end(), cells.begin(), cells.end());
+    }
+
+    // The universe without them
+    if (removed != 0)
+    {
+        loadCells(universe, remaining);
+    }
+
+    return removed;
+}
+
+/*
+ * Counts the objects of the ash of a stabilized soup
+ */
+int SoupSearch::takeCensus(ObjectCensus& census)
+{
+    int numObjects = findObjects();
+
+    for (int object = 0; object < numObjects; ++object)
+    {
+        SoupCells cells;
+        SoupObject result;
+        std::vector<SoupCells> phases;
+        std::vector<SoupCells> parts;
+        int dx;
+        int dy;
+
+        getObject(object, cells);
+
+        // Only the clusters that repeat in place can be split
+        if (classify(cells, result, dx, dy, &phases) == true and
+            dx == 0 and dy == 0)
+        {
+            separate(phases, parts);
+        }
+
+        if (parts.size() <= 1)
+        {
+            census.addObject(result);
+            continue;
+        }
+
+        for (size_t p = 0; p < parts.size(); ++p)
+        {
+            classify(parts[p], result, dx, dy, NULL);
+            census.addObject(result);
+        }
+    }
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+SoupSearch::SoupSearch()
+{
+    population = 0;
+    soup = 0;
+}
+
+/*
+ * Runs the soup number of the seed until it stabilizes and adds its objects
+ * to the census
+ */
+int SoupSearch::run(uint32_t seed, uint32_t number, ObjectCensus& census)
+{
+    bool stabilized = false;
+
+    soup = number;
+    fillSoup(seed, number);
+
+    cycles.reset();
+    cycles.addGeneration(0, universe.getHash());
+
+    for (unsigned int generation = 1;
+         generation <= SOUP_MAX_GENERATIONS;
+         ++generation)
+    {
+        step(universe, population);
+
+        if (population == 0)
+        {
+            stabilized = true;
+            break;
+        }
+
+        // The universe changed: the previous generations don't repeat
+        if (generation % SOUP_SPACESHIP_INTERVAL == 0 and
+            removeSpaceships(census) != 0)
+        {
+            cycles.reset();
+        }
+
+        if (cycles.addGeneration(generation, universe.getHash()) == true)
+        {
+            stabilized = true;
+            break;
+        }
+    }
+
+    census.addSoup(stabilized);
+
+    if (stabilized == true)
+    {
+        takeCensus(census);
+    }
+
+    return 0;
+}
+
+/*
+ * Returns the extended Wechsler format of the shape in one of its 8
+ * orientations (bit 0: mirrored horizontally, bit 1: vertically, bit 2:
+ * transposed): strips of 5 rows separated by z, a digit per column (the
+ * cell of the row i of the strip is the bit i) and the runs of empty
+ * columns shortened (w: 2, x: 3, y and a digit: 4 or more).
+ */
+std::string SoupSearch::encode(const SoupShape& shape, int symmetry)
+{
+    bool transposed = (symmetry & 4) != 0;
+    int width = transposed == true ? shape.height : shape.width;
+    int height = transposed == true ? shape.width : shape.height;
+    std::string code;
+
+    for (int strip = 0; strip * 5 < height; ++strip)
+    {
+        int zeros = 0;
+
+        if (strip != 0)
+        {
+            code += 'z';
+        }
+
+        for (int u = 0; u < width; ++u)
+        {
+            int value = 0;
+
+            for (int i = 0; i < 5 and strip * 5 + i < height; ++i)
+            {
+                int v = strip * 5 + i;
+                int x = transposed == true ? v : u;
+                int y = transposed == true ? u : v;
+
+                if ((symmetry & 1) != 0)
+                {
+                    x = shape.width - 1 - x;
+                }
+
+                if ((symmetry & 2) != 0)
+                {
+                    y = shape.height - 1 - y;
+                }
+
+                value = value | (shape.cells[y * shape.width + x] << i);
+            }
+
+            if (value == 0)
+            {
+                ++zeros;
+                continue;
+            }
+
+            if (zeros == 1)
+            {
+                code += '0';
+            }
+            else if (zeros == 2)
+            {
+                code += 'w';
+            }
+            else if (zeros == 3)
+            {
+                code += 'x';
+            }
+            else if (zeros > 3)
+            {
+                code += 'y';
+                code += wechslerDigits[zeros - 4];
+            }
+
+            zeros = 0;
+            code += wechslerDigits[value];
+        }
+    }
+
+    return code;
+}
+
+/*
+ * Returns the code of the object: the shortest (then the first in
+ * alphabetical order) of the codes of all its phases and orientations
+ */
+std::string SoupSearch::canonise(const std::vector<SoupShape>& phases)
+{
+    std::string best;
+
+    for (size_t phase = 0; phase < phases.size(); ++phase)
+    {
+        for (int symmetry = 0; symmetry < 8; ++symmetry)
+        {
+            std::string code = encode(phases[phase], symmetry);
+
+            if (best.empty() == true or code.length() < best.length() or
+                (code.length() == best.length() and code < best))
+            {
+                best = code;
+            }
+        }
+    }
+
+    return best;
+}
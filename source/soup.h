@@ -0,0 +1,178 @@
+#ifndef SOUP_H
+#define SOUP_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "chunkeduniverse.h"
+#include "cycles.h"
+#include "random_numbers.h"
+
+/*
+ * Side of the random soups, in the unbounded universe where they run (see
+ * ChunkedUniverse)
+ */
+#define SOUP_SIZE 16
+
+/*
+ * Generations of a soup before it's given up as not stabilized
+ */
+#define SOUP_MAX_GENERATIONS 10000
+
+/*
+ * The spaceships that leave the ash are counted and removed every
+ * SOUP_SPACESHIP_INTERVAL generations, so the ash repeats. Only the objects
+ * of up to SOUP_SPACESHIP_MAX_CELLS cells further than SOUP_SIZE cells
+ * from the center are checked.
+ */
+#define SOUP_SPACESHIP_INTERVAL 32
+#define SOUP_SPACESHIP_MAX_CELLS 16
+
+/*
+ * Like apgsearch, the objects bigger than SOUP_OBJECT_MAX_SIZE cells aren't
+ * canonised
+ */
+#define SOUP_OBJECT_MAX_SIZE 40
+
+/*
+ * The live cells of a part of the universe, sorted: each one is the key of
+ * its coordinates (see SoupSearch::getKey())
+ */
+typedef std::vector<uint32_t> SoupCells;
+
+/*
+ * The live cells of an object in its bounding box (row by row, 1 alive)
+ */
+struct SoupShape
+{
+    int width;
+    int height;
+    std::vector<unsigned char> cells;
+};
+
+/*
+ * An object left by a soup, with its code (see SoupSearch::classify())
+ */
+struct SoupObject
+{
+    std::string code; // xs4_33, xp2_7, xq4_153...
+    SoupShape shape;  // The phase found in the soup
+    uint32_t soup;    // The number of the soup
+};
+
+/*
+ * The number of times each object was found, and the one of the first soup
+ * (the same whatever the number of threads of the search)
+ */
+struct CensusEntry
+{
+    unsigned long count;
+    SoupShape shape;
+    uint32_t soup;
+};
+
+/*
+ * The objects left by the soups, by code
+ */
+class ObjectCensus
+{
+    private:
+        std::map<std::string, CensusEntry> objects;
+
+        unsigned long numSoups;
+        unsigned long numUnstable; // Not stabilized in time
+
+    public:
+        ObjectCensus();
+
+        int addSoup(bool stabilized);
+        int addObject(const SoupObject& object);
+        int merge(const ObjectCensus& other);
+
+        unsigned long getNumSoups();
+        unsigned long getNumUnstable();
+        int getNumObjects();
+        int getMostCommon(int number, std::vector<std::string>& codes,
+                          std::vector<unsigned long>& counts);
+
+        bool write(const char* path, uint32_t seed);
+        int writeObjects(const char* directory);
+};
+
+/*
+ * Runs random soups of the game of life until they stabilize and counts the
+ * objects they leave (the ash), like apgsearch.
+ *
+ * Each soup is a random SOUP_SIZE x SOUP_SIZE square (the stream of random
+ * numbers is the number of the soup, so a soup only depends on the seed
+ * and its number) in an unbounded universe. It runs on the chunks of the
+ * universe with the kernel of the game of life (ChunkedStencil and
+ * LifeRule, see stencil.h and liferule.h), 32 cells at a time, until the
+ * hash of the universe repeats (see CycleDetector), meanwhile the
+ * spaceships that escape are counted and removed.
+ *
+ * The ash is split into clusters (live cells closer than 3 cells) and each
+ * one runs alone until it repeats: its period and its movement tell if
+ * it's a still life (xs and the population), an oscillator (xp and the
+ * period) or a spaceship (xq and the period). The rest of the code is the
+ * extended Wechsler format of apgsearch of its smallest phase and
+ * orientation, the same for every phase and orientation of the object.
+ *
+ * A cluster can be several objects that don't interact, like the four
+ * blinkers of a traffic light. Like apgsearch, the cells that the cluster
+ * takes in any phase of its period are split into connected parts, and the
+ * parts that run alone exactly like in the cluster are separate objects
+ * (the rest are joined with the parts next to them, see separate()).
+ *
+ * The universes belong to the thread that creates the SoupSearch.
+ */
+class SoupSearch
+{
+    private:
+        ChunkedUniverse universe;       // The soup
+        ChunkedUniverse objectUniverse; // Where each object runs alone
+        CycleDetector cycles;
+        RandomNumberGenerator rng;
+        long population;
+        uint32_t soup; // The soup that runs
+
+        SoupCells liveCells;          // The cells of the universe
+        std::vector<int> labels;      // The object of each of them
+        SoupCells objectCells;        // The cells of each object, in order
+        std::vector<int> objectStarts;
+
+        static uint32_t getKey(int x, int y);
+        static int getX(uint32_t key);
+        static int getY(uint32_t key);
+        static int getCells(ChunkedUniverse& source, SoupCells& cells);
+        static bool getShape(const SoupCells& cells, SoupShape& shape,
+                             int& left, int& top);
+        static int loadCells(ChunkedUniverse& target,
+                             const SoupCells& cells);
+        static int step(ChunkedUniverse& target, long& population);
+
+        int fillSoup(uint32_t seed, uint32_t number);
+        int findObjects();
+        int getObject(int object, SoupCells& cells);
+        bool classify(const SoupCells& cells, SoupObject& result,
+                      int& dx, int& dy, std::vector<SoupCells>* phases);
+        bool runsAlone(const SoupCells& part,
+                       const std::vector<SoupCells>& phases);
+        int separate(const std::vector<SoupCells>& phases,
+                     std::vector<SoupCells>& parts);
+        int removeSpaceships(ObjectCensus& census);
+        int takeCensus(ObjectCensus& census);
+
+    public:
+        SoupSearch();
+
+        int run(uint32_t seed, uint32_t number, ObjectCensus& census);
+
+        static std::string encode(const SoupShape& shape, int symmetry);
+        static std::string canonise(const std::vector<SoupShape>& phases);
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "stateplanes.h"
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+StatePlanes::StatePlanes()
+{
+    planes = NULL;
+    width = 0;
+    height = 0;
+    numBits = 0;
+    stride = 0;
+    hash = 0;
+    loaded = false;
+}
+
+// Class destructor
+StatePlanes::~StatePlanes()
+{
+    release();
+}
+
+/*
+ * Sets the size of the grid (in cells) and the bits of the states, and
+ * allocates the planes for them. The planes have to be loaded again.
+ */
+int StatePlanes::setSize(int w, int h, int bits)
+{
+    if (w == width and h == height and bits == numBits and planes != NULL)
+    {
+        return 0;
+    }
+
+    release();
+
+    width = w;
+    height = h;
+    numBits = bits;
+    stride = (w + 31) / 32 + 2;
+
+    int size = stride * numBits * h;
+
+    planes = new uint32_t[size];
+
+    // The padding words are never written
+    memset(planes, 0, size * sizeof(uint32_t));
+
+    return 0;
+}
+
+/*
+ * Frees the planes while another automata runs. setSize() allocates them
+ * again.
+ */
+int StatePlanes::release()
+{
+    delete[] planes;
+
+    planes = NULL;
+    width = 0;
+    height = 0;
+    numBits = 0;
+    stride = 0;
+    hash = 0;
+    loaded = false;
+
+    return 0;
+}
+
+int StatePlanes::getNumBits()
+{
+    return numBits;
+}
+
+// Words of cells of a plane (without the padding)
+int StatePlanes::getNumWords()
+{
+    return stride - 2;
+}
+
+/*
+ * Packs the states of the cells (width x height, row by row) whose hash is
+ * cellsHash (see GenerationHash)
+ */
+int StatePlanes::load(const unsigned char* cells, uint64_t cellsHash)
+{
+    int numWords = stride - 2;
+
+    for (int y = 0; y < height; ++y)
+    {
+        const unsigned char* row = cells + y * width;
+
+        for (int k = 0; k < numBits; ++k)
+        {
+            uint32_t* plane = getPlane(y, k);
+
+            for (int w = 0; w < numWords; ++w)
+            {
+                int end = width - 32 * w < 32 ? width - 32 * w : 32;
+                uint32_t bits = 0;
+
+                for (int b = 0; b < end; ++b)
+                {
+                    bits = bits |
+                           ((uint32_t) ((row[32 * w + b] >> k) & 1) << b);
+                }
+
+                plane[1 + w] = bits;
+            }
+        }
+    }
+
+    hash = cellsHash;
+    loaded = true;
+
+    return 0;
+}
+
+/*
+ * Returns true if the planes hold the generation whose hash is cellsHash
+ */
+bool StatePlanes::isCurrent(uint64_t cellsHash)
+{
+    return loaded == true and hash == cellsHash;
+}
+
+/*
+ * Sets the hash of the generation written in the planes by a step
+ */
+int StatePlanes::setHash(uint64_t cellsHash)
+{
+    hash = cellsHash;
+
+    return 0;
+}
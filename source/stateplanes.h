@@ -0,0 +1,55 @@
+#ifndef STATEPLANES_H
+#define STATEPLANES_H
+
+#include <stdint.h>
+
+/*
+ * Most bit planes of StatePlanes: up to 16 states
+ */
+#define STATE_PLANES_MAX_BITS 4
+
+/*
+ * The states of the cells of a grid packed in bit planes: the plane k of a
+ * row has the bit k of the state of each cell, 32 cells per word, like the
+ * counts of BitRows (see stencil.h). A state of 2 to 16 values takes 1 to
+ * 4 bits per cell instead of a byte, and GenerationsStencil calculates the
+ * next state of 32 cells at a time with them.
+ *
+ * Each plane of a row has a word of padding (always 0) before and after its
+ * cells, so the planes can be read like the bit rows. The planes are kept
+ * from one step to the next, and the hash of the generation they hold
+ * tells whether the cells of the grid were changed by someone else (a
+ * restart or a pattern) and have to be packed again (see isCurrent()).
+ */
+class StatePlanes
+{
+    private:
+        uint32_t* planes;
+        int width;    // Of the grid
+        int height;
+        int numBits;  // Planes per row
+        int stride;   // Words of a plane (the cells and the padding)
+        uint64_t hash; // Of the generation in the planes
+        bool loaded;
+
+    public:
+        StatePlanes();
+        ~StatePlanes();
+
+        int setSize(int w, int h, int bits);
+        int release();
+        int getNumBits();
+        int getNumWords();
+
+        int load(const unsigned char* cells, uint64_t cellsHash);
+        bool isCurrent(uint64_t cellsHash);
+        int setHash(uint64_t cellsHash);
+
+        // The plane k of the row y
+        uint32_t* getPlane(int y, int k)
+        {
+            return planes + (y * numBits + k) * stride;
+        }
+};
+
+#endif
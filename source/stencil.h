@@ -0,0 +1,1014 @@
+#ifndef STENCIL_H
+#define STENCIL_H
+
+/*
+ * Stencil engine of the automata whose cells only depend on their
+ * neighbors in the previous generation (the boolean automata, the game of
+ * life and the BML traffic model).
+ *
+ * A step is Stencil<Lattice, Neighborhood, Boundary, Rule>::step(): it
+ * goes over the cells of the lattice row by row (the order of the memory),
+ * gathers the neighbors of each cell with the neighborhood and asks the
+ * rule for its next state. Everything is chosen at compile time, so each
+ * automata gets its own loop without any check of the type of neighborhood
+ * or of the border inside it.
+ *
+ * Lattice: SquareLattice (one pixel per cell, read through the window of
+ * the grid) or a lattice of cells of several pixels, like HexagonalLattice
+ * (hexgrid.h) and TriangularLattice (triangulargrid.h), that gives the
+ * position of the cells and how to gather their neighbors and paint them.
+ *
+ * Neighborhood: gather() sums up the neighbors of a cell in an int that the
+ * rule understands. The Von Neumann and Moore neighborhoods count the
+ * neighbors in the state of the rule, the traffic neighborhoods give the
+ * cells behind and ahead.
+ *
+ * Boundary: how the square lattice handles its border. SkipBorder leaves
+ * the cells of the border as they are, WrapBorder joins the opposite
+ * borders (torus) and ClampBorder repeats the cells of the border outside
+ * of it. The other lattices don't reach their border.
+ *
+ * Rule: a functor with the state counted by the neighborhood (state) and
+ * the next state of a cell, next(cell, neighbors). The cells that reach or
+ * leave the state of the rule change the population.
+ *
+ * Store: the cells (Grid by default) and their type (Store::Cell). Only the
+ * cells that change are written to the next generation, that starts as a
+ * copy of the current one, and they're marked for present(). Their change
+ * of the hash of the generation (see GenerationHash) is added up by rows
+ * and given to the store.
+ *
+ * The rules whose cells never leave their state (the boolean automata) can
+ * use BitSlicedStencil instead on the square lattice: it keeps one bit per
+ * cell and counts the neighbors of 32 cells at a time (see BitRows).
+ *
+ * The rules whose neighborhood is a box of any range (Larger than Life)
+ * use SummedAreaStencil: the neighbors of a cell are counted with 4 reads
+ * of a summed-area table (see summedarea.h) instead of one per neighbor.
+ *
+ * The rules with more than two states whose cells only count the neighbors
+ * in one of them (Generations) use GenerationsStencil: the states are kept
+ * packed in bit planes (see stateplanes.h) and the neighbors are counted
+ * like in BitSlicedStencil.
+ *
+ * The rules of two states on an unbounded square lattice (the game of life
+ * and the square boolean automata) use ChunkedStencil: the live cells are
+ * kept in the bit packed chunks of a ChunkedUniverse (see
+ * chunkeduniverse.h) and the grid is only the window shown on the screen.
+ */
+
+#include <stdint.h>
+
+#include "grid.h"
+#include "cycles.h"
+#include "summedarea.h"
+#include "stateplanes.h"
+#include "chunkeduniverse.h"
+
+/*
+ * Planes of the count of neighbors of BitSlicedStencil: up to 15 neighbors
+ */
+#define STENCIL_COUNT_BITS 4
+
+/**********************************BIT ROWS***********************************/
+
+/*
+ * Rows of one bit per cell (1: the cell is in the state of the rule), 32
+ * cells per word. Word 0 and the last word of a bit row are padding (always
+ * 0), so the neighbors of the first and last words can be read like the
+ * rest.
+ *
+ * The counts of 32 cells are bit sliced: the plane k of the count has the
+ * bit k of the count of each cell. add() adds a word of neighbors to them
+ * with a ripple of half adders, so every cell is counted with the same
+ * instructions and without branches.
+ */
+struct BitRows
+{
+    // The left neighbors of the cells of the word w
+    static uint32_t left(const uint32_t* row, int w)
+    {
+        return (row[w] << 1) | (row[w - 1] >> 31);
+    }
+
+    // The right neighbors of the cells of the word w
+    static uint32_t right(const uint32_t* row, int w)
+    {
+        return (row[w] >> 1) | (row[w + 1] << 31);
+    }
+
+    // Adds a bit to the count of each of the 32 cells
+    static void add(uint32_t* planes, int numPlanes, uint32_t bits)
+    {
+        for (int k = 0; k < numPlanes; ++k)
+        {
+            uint32_t carry = planes[k] & bits;
+
+            planes[k] = planes[k] ^ bits;
+            bits = carry;
+        }
+    }
+
+    /*
+     * Returns the bits of the cells whose count selects an all ones word of
+     * values (one word per count, 1 << STENCIL_COUNT_BITS words). The plane
+     * 0 halves the candidates, then the plane 1... like a tree of
+     * multiplexers.
+     */
+    static uint32_t select(const uint32_t* values, const uint32_t* planes)
+    {
+        uint32_t level[1 << (STENCIL_COUNT_BITS - 1)];
+        int size = 1 << (STENCIL_COUNT_BITS - 1);
+
+        for (int i = 0; i < size; ++i)
+        {
+            level[i] = (values[2 * i] & ~planes[0]) |
+                       (values[2 * i + 1] & planes[0]);
+        }
+
+        for (int k = 1; k < STENCIL_COUNT_BITS; ++k)
+        {
+            size = size / 2;
+
+            for (int i = 0; i < size; ++i)
+            {
+                level[i] = (level[2 * i] & ~planes[k]) |
+                           (level[2 * i + 1] & planes[k]);
+            }
+        }
+
+        return level[0];
+    }
+
+    // Converts a row of cells to bits (1: the cell is in state)
+    template <typename Cell>
+    static void pack(const Cell* cells, int width, Cell state, uint32_t* row)
+    {
+        int numWords = (width + 31) / 32;
+
+        row[0] = 0;
+        row[numWords + 1] = 0;
+
+        for (int w = 0; w < numWords; ++w)
+        {
+            int end = width - 32 * w < 32 ? width - 32 * w : 32;
+            uint32_t bits = 0;
+
+            for (int b = 0; b < end; ++b)
+            {
+                bits = bits | ((uint32_t) (cells[32 * w + b] == state) << b);
+            }
+
+            row[1 + w] = bits;
+        }
+    }
+};
+
+/*********************************BOUNDARIES**********************************/
+
+/*
+ * The cells of the border don't change, so the neighbors of the rest are
+ * always inside
+ */
+struct SkipBorder
+{
+    static int first(int size) { return 1; }
+    static int end(int size) { return size - 1; }
+    static int index(int x, int size) { return x; }
+};
+
+/*
+ * The opposite borders are neighbors
+ */
+struct WrapBorder
+{
+    static int first(int size) { return 0; }
+    static int end(int size) { return size; }
+
+    static int index(int x, int size)
+    {
+        return x < 0 ? x + size : (x >= size ? x - size : x);
+    }
+};
+
+/*
+ * The cells outside of the border are copies of the cells of the border
+ */
+struct ClampBorder
+{
+    static int first(int size) { return 0; }
+    static int end(int size) { return size; }
+
+    static int index(int x, int size)
+    {
+        return x < 0 ? 0 : (x >= size ? size - 1 : x);
+    }
+};
+
+/********************************NEIGHBORHOODS********************************/
+
+/*
+ * Number of the 4 nearest neighbors in state
+ *      x
+ *    x o x
+ *      x
+ */
+struct VonNeumannNeighborhood
+{
+    static const bool moore = false;
+    static const int countBits = 3; // Up to 4 neighbors
+
+    template <typename Cell>
+    static int gather(const Cell* up, const Cell* row, const Cell* down,
+                      int left, int x, int right, Cell state)
+    {
+        return (up[x] == state) + (row[left] == state) +
+               (row[right] == state) + (down[x] == state);
+    }
+
+    // Same for the 32 cells of the word w of the bit rows (see BitRows)
+    static void gatherWord(const uint32_t* up, const uint32_t* row,
+                           const uint32_t* down, int w, uint32_t* planes)
+    {
+        BitRows::add(planes, countBits, up[w]);
+        BitRows::add(planes, countBits, BitRows::left(row, w));
+        BitRows::add(planes, countBits, BitRows::right(row, w));
+        BitRows::add(planes, countBits, down[w]);
+    }
+};
+
+/*
+ * Number of the 8 nearest neighbors in state
+ *    x x x
+ *    x o x
+ *    x x x
+ */
+struct MooreNeighborhood
+{
+    static const bool moore = true;
+    static const int countBits = 4; // Up to 8 neighbors
+
+    template <typename Cell>
+    static int gather(const Cell* up, const Cell* row, const Cell* down,
+                      int left, int x, int right, Cell state)
+    {
+        return (up[left] == state) + (up[x] == state) +
+               (up[right] == state) + (row[left] == state) +
+               (row[right] == state) + (down[left] == state) +
+               (down[x] == state) + (down[right] == state);
+    }
+
+    // Same for the 32 cells of the word w of the bit rows (see BitRows)
+    static void gatherWord(const uint32_t* up, const uint32_t* row,
+                           const uint32_t* down, int w, uint32_t* planes)
+    {
+        BitRows::add(planes, countBits, BitRows::left(up, w));
+        BitRows::add(planes, countBits, up[w]);
+        BitRows::add(planes, countBits, BitRows::right(up, w));
+        BitRows::add(planes, countBits, BitRows::left(row, w));
+        BitRows::add(planes, countBits, BitRows::right(row, w));
+        BitRows::add(planes, countBits, BitRows::left(down, w));
+        BitRows::add(planes, countBits, down[w]);
+        BitRows::add(planes, countBits, BitRows::right(down, w));
+    }
+};
+
+/*
+ * The cell behind (low byte) and ahead (high byte) of a car that moves to
+ * the right
+ */
+struct HorizontalTrafficNeighborhood
+{
+    static const bool moore = false;
+
+    template <typename Cell>
+    static int gather(const Cell* up, const Cell* row, const Cell* down,
+                      int left, int x, int right, Cell state)
+    {
+        return row[left] | (row[right] << 8);
+    }
+};
+
+/*
+ * The cell behind (low byte) and ahead (high byte) of a car that moves
+ * down
+ */
+struct VerticalTrafficNeighborhood
+{
+    static const bool moore = false;
+
+    template <typename Cell>
+    static int gather(const Cell* up, const Cell* row, const Cell* down,
+                      int left, int x, int right, Cell state)
+    {
+        return up[x] | (down[x] << 8);
+    }
+};
+
+/**********************************LATTICES***********************************/
+
+/*
+ * One pixel per cell
+ */
+struct SquareLattice
+{
+};
+
+/***********************************ENGINE************************************/
+
+/*
+ * Lattices of cells of several pixels. The lattice gives the cells of each
+ * of its sublattices (rows firstRow() to endRow(), columns firstColumn() to
+ * endColumn(), every rowStep and columnStep pixels), gathers their
+ * neighbors from the pixel of their position and paints them.
+ */
+template <class Lattice, class Neighborhood, class Boundary, class Rule,
+          class Store = Grid>
+class Stencil
+{
+    public:
+        static int step(Store& store, Rule& rule, int& populationChange)
+        {
+            typedef typename Store::Cell Cell;
+
+            int width = store.getWidth();
+            int changes = 0;
+            uint64_t hashChange = 0;
+
+            populationChange = 0;
+
+            store.copyCellsToNew();
+
+            const Cell* cells = store.getCells();
+            Cell* newCells = store.getNewCells();
+            const uint64_t* keys = GenerationHash::columnKeys();
+
+            for (int k = 0; k < Lattice::numSublattices; ++k)
+            {
+                for (int j = Lattice::firstRow(k);
+                     j < Lattice::endRow(k);
+                     j = j + Lattice::rowStep)
+                {
+                    uint64_t rowChange = 0;
+
+                    for (int i = Lattice::firstColumn(k);
+                         i < Lattice::endColumn(k);
+                         i = i + Lattice::columnStep)
+                    {
+                        Cell cell = cells[width * j + i];
+                        Cell next = rule.next(cell,
+                            Lattice::template gather<Neighborhood>(
+                                cells, width, i, j, rule.state));
+
+                        if (next != cell)
+                        {
+                            Lattice::paint(i, j, next, newCells);
+                            Lattice::markDirty(store, i, j);
+
+                            ++changes;
+                            populationChange = populationChange +
+                                               (next == rule.state) -
+                                               (cell == rule.state);
+                            rowChange = rowChange +
+                                        GenerationHash::rowChange(keys, i,
+                                                                  cell, next);
+                        }
+                    }
+
+                    hashChange = hashChange +
+                                 rowChange * GenerationHash::rowKey(j);
+                }
+            }
+
+            store.addHashChange(hashChange);
+
+            return changes;
+        }
+};
+
+/*
+ * The square lattice: each row is read through the window of the grid
+ * (see Grid::loadWindow()). The columns of the border are the only ones
+ * that need the boundary, the rest read their neighbors directly.
+ */
+template <class Neighborhood, class Boundary, class Rule, class Store>
+class Stencil<SquareLattice, Neighborhood, Boundary, Rule, Store>
+{
+    private:
+        typedef typename Store::Cell Cell;
+
+        /*
+         * Calculates the next state of the cell x of the row j. Returns 1
+         * if it changes.
+         */
+        static int updateCell(Store& store, Rule& rule,
+                              const Cell* up, const Cell* row,
+                              const Cell* down, int left, int x, int right,
+                              int j, Cell* newRow, int& populationChange,
+                              const uint64_t* keys, uint64_t& rowChange)
+        {
+            Cell cell = row[x];
+            Cell next = rule.next(cell,
+                                  Neighborhood::gather(up, row, down,
+                                                       left, x, right,
+                                                       rule.state));
+
+            if (next == cell)
+            {
+                return 0;
+            }
+
+            newRow[x] = next;
+            store.markDirty(x, j, 1, 1);
+
+            populationChange = populationChange + (next == rule.state) -
+                               (cell == rule.state);
+            rowChange = rowChange +
+                        GenerationHash::rowChange(keys, x, cell, next);
+
+            return 1;
+        }
+
+    public:
+        static int step(Store& store, Rule& rule, int& populationChange)
+        {
+            int width = store.getWidth();
+            int height = store.getHeight();
+            int firstColumn = Boundary::first(width);
+            int endColumn = Boundary::end(width);
+            int changes = 0;
+            uint64_t hashChange = 0;
+
+            // Columns read without the boundary
+            int firstInner = firstColumn < 1 ? 1 : firstColumn;
+            int endInner = endColumn > width - 1 ? width - 1 : endColumn;
+
+            populationChange = 0;
+
+            store.copyCellsToNew();
+
+            Cell* newCells = store.getNewCells();
+            const uint64_t* keys = GenerationHash::columnKeys();
+
+            for (int j = Boundary::first(height);
+                 j < Boundary::end(height);
+                 ++j)
+            {
+                // The window wraps around: the rows outside of the border
+                // are replaced by the boundary
+                store.loadWindow(j);
+
+                const Cell* row = store.getWindowRow(0);
+                const Cell* up = Boundary::index(j - 1, height) == j ?
+                                 row : store.getWindowRow(-1);
+                const Cell* down = Boundary::index(j + 1, height) == j ?
+                                   row : store.getWindowRow(1);
+                Cell* newRow = newCells + width * j;
+                uint64_t rowChange = 0;
+
+                if (firstColumn == 0)
+                {
+                    changes = changes +
+                              updateCell(store, rule, up, row, down,
+                                         Boundary::index(-1, width), 0,
+                                         Boundary::index(1, width),
+                                         j, newRow, populationChange,
+                                         keys, rowChange);
+                }
+
+                for (int x = firstInner; x < endInner; ++x)
+                {
+                    changes = changes +
+                              updateCell(store, rule, up, row, down,
+                                         x - 1, x, x + 1,
+                                         j, newRow, populationChange,
+                                         keys, rowChange);
+                }
+
+                if (endColumn == width)
+                {
+                    changes = changes +
+                              updateCell(store, rule, up, row, down,
+                                         Boundary::index(width - 2, width),
+                                         width - 1,
+                                         Boundary::index(width, width),
+                                         j, newRow, populationChange,
+                                         keys, rowChange);
+                }
+
+                hashChange = hashChange +
+                             rowChange * GenerationHash::rowKey(j);
+            }
+
+            store.addHashChange(hashChange);
+
+            return changes;
+        }
+};
+
+/*
+ * The square lattice one bit per cell, for the rules whose cells never
+ * leave the state of the rule (the cells of the border don't change, like
+ * with SkipBorder). The rule gives the cells that reach the state from the
+ * planes of their counts: rule.nextWord(planes) (see BitRows::select()).
+ *
+ * Three bit rows (above, current and below) are kept on the stack, in DTCM
+ * on the DS, and each row of the grid is packed once per step. Only the
+ * cells that change are written back to the cells of the grid.
+ */
+template <class Neighborhood, class Rule, class Store = Grid>
+class BitSlicedStencil
+{
+    private:
+        typedef typename Store::Cell Cell;
+
+        enum { MAX_WORDS = GRID_MAX_WIDTH / 32 + 2 };
+
+    public:
+        static int step(Store& store, Rule& rule, int& populationChange)
+        {
+            uint32_t bitRows[3][MAX_WORDS];
+            uint32_t innerMask[MAX_WORDS]; // The cells that can change
+
+            int width = store.getWidth();
+            int height = store.getHeight();
+            int numWords = (width + 31) / 32;
+            int changes = 0;
+            uint64_t hashChange = 0;
+
+            populationChange = 0;
+
+            store.copyCellsToNew();
+
+            const Cell* cells = store.getCells();
+            Cell* newCells = store.getNewCells();
+            const uint64_t* keys = GenerationHash::columnKeys();
+
+            // Every column but the first and the last one
+            for (int w = 1; w <= numWords; ++w)
+            {
+                innerMask[w] = 0;
+
+                for (int b = 0; b < 32; ++b)
+                {
+                    int x = (w - 1) * 32 + b;
+
+                    if (x > 0 and x < width - 1)
+                    {
+                        innerMask[w] = innerMask[w] | (1u << b);
+                    }
+                }
+            }
+
+            if (height < 3)
+            {
+                return 0;
+            }
+
+            BitRows::pack(cells, width, rule.state, bitRows[0]);
+            BitRows::pack(cells + width, width, rule.state, bitRows[1]);
+
+            for (int j = 1; j < height - 1; ++j)
+            {
+                const uint32_t* up = bitRows[(j - 1) % 3];
+                const uint32_t* row = bitRows[j % 3];
+                uint32_t* down = bitRows[(j + 1) % 3];
+
+                BitRows::pack(cells + width * (j + 1), width, rule.state,
+                              down);
+
+                const Cell* oldRow = cells + width * j;
+                Cell* newRow = newCells + width * j;
+                uint64_t rowChange = 0;
+
+                for (int w = 1; w <= numWords; ++w)
+                {
+                    uint32_t planes[STENCIL_COUNT_BITS] = {0};
+
+                    Neighborhood::gatherWord(up, row, down, w, planes);
+
+                    uint32_t reached = rule.nextWord(planes) & ~row[w] &
+                                       innerMask[w];
+
+                    if (reached == 0)
+                    {
+                        continue;
+                    }
+
+                    int first = (w - 1) * 32 + __builtin_ctz(reached);
+                    int last = (w - 1) * 32 + 31 - __builtin_clz(reached);
+
+                    while (reached != 0)
+                    {
+                        int x = (w - 1) * 32 + __builtin_ctz(reached);
+
+                        newRow[x] = rule.state;
+                        rowChange = rowChange +
+                                    GenerationHash::rowChange(keys, x,
+                                                              oldRow[x],
+                                                              rule.state);
+
+                        reached = reached & (reached - 1);
+                        ++changes;
+                    }
+
+                    store.markDirty(first, j, last - first + 1, 1);
+                }
+
+                hashChange = hashChange +
+                             rowChange * GenerationHash::rowKey(j);
+            }
+
+            store.addHashChange(hashChange);
+
+            populationChange = changes;
+
+            return changes;
+        }
+};
+
+/*
+ * The square lattice with the box of rule.range cells around each cell as
+ * its neighborhood (the cell itself included). The summed-area table of
+ * the cells in the state of the rule is built once per step (the cells
+ * outside of the border come from the boundary, WrapBorder or ClampBorder),
+ * then each cell counts its neighbors with table.count(), so a step costs
+ * the same whatever the range.
+ */
+template <class Boundary, class Rule, class Store = Grid>
+class SummedAreaStencil
+{
+    private:
+        typedef typename Store::Cell Cell;
+
+    public:
+        static int step(Store& store, Rule& rule, SummedAreaTable& table,
+                        int& populationChange)
+        {
+            int width = store.getWidth();
+            int height = store.getHeight();
+            int changes = 0;
+            uint64_t hashChange = 0;
+
+            populationChange = 0;
+
+            table.setSize(width, height, rule.range);
+
+            store.copyCellsToNew();
+
+            const Cell* cells = store.getCells();
+            Cell* newCells = store.getNewCells();
+            const uint64_t* keys = GenerationHash::columnKeys();
+
+            table.template build<Boundary>(cells, rule.state);
+
+            for (int j = 0; j < height; ++j)
+            {
+                const Cell* row = cells + width * j;
+                Cell* newRow = newCells + width * j;
+                uint64_t rowChange = 0;
+
+                for (int x = 0; x < width; ++x)
+                {
+                    Cell cell = row[x];
+                    Cell next = rule.next(cell, table.count(x, j));
+
+                    if (next == cell)
+                    {
+                        continue;
+                    }
+
+                    newRow[x] = next;
+                    store.markDirty(x, j, 1, 1);
+
+                    ++changes;
+                    populationChange = populationChange +
+                                       (next == rule.state) -
+                                       (cell == rule.state);
+                    rowChange = rowChange +
+                                GenerationHash::rowChange(keys, x, cell, next);
+                }
+
+                hashChange = hashChange +
+                             rowChange * GenerationHash::rowKey(j);
+            }
+
+            store.addHashChange(hashChange);
+
+            return changes;
+        }
+};
+
+/*
+ * The square lattice with the states packed in bit planes, for the rules
+ * whose cells count their neighbors in the state of the rule (the firing
+ * cells) and whose states only go up by one (the refractory states of
+ * Generations, see GenerationsRule). The cells of the border don't change,
+ * like with SkipBorder.
+ *
+ * The firing cells of three rows are kept as bit rows on the stack and the
+ * states of 32 cells are updated at a time with the planes of their counts
+ * (see BitRows): the dead ones that are born and the ones that don't
+ * survive add one to their state, and the ones that reach numStates are
+ * dead again. The planes are written in place, and only the cells that
+ * change are written to the cells of the grid, as their state (the palette
+ * of the states gives their colors).
+ */
+template <class Neighborhood, class Rule, class Store = Grid>
+class GenerationsStencil
+{
+    private:
+        typedef typename Store::Cell Cell;
+
+        enum { MAX_WORDS = GRID_MAX_WIDTH / 32 + 2 };
+
+        // The cells of the word w of the row whose state is value
+        static uint32_t match(StatePlanes& states, int y, int w,
+                              int numBits, int value)
+        {
+            uint32_t bits = 0xFFFFFFFF;
+
+            for (int k = 0; k < numBits; ++k)
+            {
+                uint32_t plane = states.getPlane(y, k)[w];
+
+                bits = bits & (((value >> k) & 1) != 0 ? plane : ~plane);
+            }
+
+            return bits;
+        }
+
+        // The firing cells of the row as a bit row
+        static void packFiring(StatePlanes& states, int y, int numWords,
+                               int state, uint32_t* row)
+        {
+            row[0] = 0;
+            row[numWords + 1] = 0;
+
+            for (int w = 1; w <= numWords; ++w)
+            {
+                row[w] = match(states, y, w, states.getNumBits(), state);
+            }
+        }
+
+    public:
+        static int getNumBits(int numStates)
+        {
+            int bits = 1;
+
+            while ((1 << bits) < numStates)
+            {
+                ++bits;
+            }
+
+            return bits;
+        }
+
+        static int step(Store& store, Rule& rule, StatePlanes& states,
+                        int& populationChange)
+        {
+            uint32_t firing[3][MAX_WORDS];
+            uint32_t innerMask[MAX_WORDS]; // The cells that can change
+
+            int width = store.getWidth();
+            int height = store.getHeight();
+            int numBits = getNumBits(rule.numStates);
+            int changes = 0;
+            uint64_t hashChange = 0;
+
+            populationChange = 0;
+
+            states.setSize(width, height, numBits);
+
+            // The cells were changed since the last step (or it's the
+            // first one)
+            if (states.isCurrent(store.getHash()) == false)
+            {
+                states.load(store.getCells(), store.getHash());
+            }
+
+            int numWords = states.getNumWords();
+
+            store.copyCellsToNew();
+
+            const Cell* cells = store.getCells();
+            Cell* newCells = store.getNewCells();
+            const uint64_t* keys = GenerationHash::columnKeys();
+
+            // Every column but the first and the last one
+            for (int w = 1; w <= numWords; ++w)
+            {
+                innerMask[w] = 0;
+
+                for (int b = 0; b < 32; ++b)
+                {
+                    int x = (w - 1) * 32 + b;
+
+                    if (x > 0 and x < width - 1)
+                    {
+                        innerMask[w] = innerMask[w] | (1u << b);
+                    }
+                }
+            }
+
+            if (height < 3)
+            {
+                return 0;
+            }
+
+            packFiring(states, 0, numWords, rule.state, firing[0]);
+            packFiring(states, 1, numWords, rule.state, firing[1]);
+
+            for (int j = 1; j < height - 1; ++j)
+            {
+                const uint32_t* up = firing[(j - 1) % 3];
+                const uint32_t* row = firing[j % 3];
+                uint32_t* down = firing[(j + 1) % 3];
+
+                // Before the row below is written
+                packFiring(states, j + 1, numWords, rule.state, down);
+
+                const Cell* oldRow = cells + width * j;
+                Cell* newRow = newCells + width * j;
+                uint64_t rowChange = 0;
+
+                for (int w = 1; w <= numWords; ++w)
+                {
+                    uint32_t counts[STENCIL_COUNT_BITS] = {0};
+                    uint32_t* planes[STATE_PLANES_MAX_BITS];
+                    uint32_t alive = 0;
+
+                    for (int k = 0; k < numBits; ++k)
+                    {
+                        planes[k] = states.getPlane(j, k);
+                        alive = alive | planes[k][w];
+                    }
+
+                    Neighborhood::gatherWord(up, row, down, w, counts);
+
+                    uint32_t born = ~alive & innerMask[w] &
+                                    BitRows::select(rule.birthTable, counts);
+                    uint32_t survives = row[w] &
+                                        BitRows::select(rule.survivalTable,
+                                                        counts);
+                    uint32_t changed = born |
+                                       (alive & ~survives & innerMask[w]);
+
+                    if (changed == 0)
+                    {
+                        continue;
+                    }
+
+                    // Add one to the states of the changed cells
+                    uint32_t carry = changed;
+
+                    for (int k = 0; k < numBits; ++k)
+                    {
+                        uint32_t plane = planes[k][w];
+
+                        planes[k][w] = plane ^ carry;
+                        carry = plane & carry;
+                    }
+
+                    // The ones that reach numStates are dead
+                    uint32_t dead = changed &
+                                    match(states, j, w, numBits,
+                                          rule.numStates);
+
+                    for (int k = 0; k < numBits; ++k)
+                    {
+                        planes[k][w] = planes[k][w] & ~dead;
+                    }
+
+                    populationChange = populationChange +
+                                       __builtin_popcount(born) -
+                                       __builtin_popcount(row[w] & changed);
+
+                    int first = (w - 1) * 32 + __builtin_ctz(changed);
+                    int last = (w - 1) * 32 + 31 - __builtin_clz(changed);
+
+                    while (changed != 0)
+                    {
+                        int b = __builtin_ctz(changed);
+                        int x = (w - 1) * 32 + b;
+                        Cell next = 0;
+
+                        for (int k = 0; k < numBits; ++k)
+                        {
+                            next = next | (((planes[k][w] >> b) & 1) << k);
+                        }
+
+                        newRow[x] = next;
+                        rowChange = rowChange +
+                                    GenerationHash::rowChange(keys, x,
+                                                              oldRow[x],
+                                                              next);
+
+                        changed = changed & (changed - 1);
+                        ++changes;
+                    }
+
+                    store.markDirty(first, j, last - first + 1, 1);
+                }
+
+                hashChange = hashChange +
+                             rowChange * GenerationHash::rowKey(j);
+            }
+
+            store.addHashChange(hashChange);
+
+            // The planes hold the next generation once the store swaps
+            states.setHash(store.getHash() + hashChange);
+
+            return changes;
+        }
+};
+
+/*******************************CHUNKED STENCIL*******************************/
+
+/*
+ * The square lattice without a border: a step of the chunks of a
+ * ChunkedUniverse, where the cells of two states are bits (1: alive). The
+ * universe is expanded first, so every cell that can be born has a chunk.
+ *
+ * The neighbors of the 32 cells of a row of a chunk are counted like in
+ * BitSlicedStencil, with the row and the ones above and below as bit rows
+ * of three words: the row of the chunk on the west, its own and the one on
+ * the east (0 for the chunks that aren't in the universe). The rule gives
+ * the next generation of the 32 cells from their current one and the
+ * planes of their counts: rule.nextCells(cells, planes). It's written to
+ * the next rows of the chunks, that universe.swap() makes the current ones.
+ */
+template <class Neighborhood, class Rule>
+class ChunkedStencil
+{
+    public:
+        static int step(ChunkedUniverse& universe, Rule& rule,
+                        int& populationChange)
+        {
+            static const uint32_t empty[UNIVERSE_CHUNK_SIZE] = {0};
+
+            int changes = 0;
+
+            populationChange = 0;
+
+            universe.expand();
+
+            int current = universe.getCurrent();
+
+            for (int i = 0; i < universe.getNumChunks(); ++i)
+            {
+                UniverseChunk* chunk = universe.getChunk(i);
+                const uint32_t* around[3][3]; // The chunk and its neighbors
+
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        const uint32_t* rows =
+                            universe.findRows(chunk->x + dx, chunk->y + dy);
+
+                        around[dy + 1][dx + 1] = rows != NULL ? rows : empty;
+                    }
+                }
+
+                uint32_t* next = chunk->rows[1 - current];
+
+                for (int r = 0; r < UNIVERSE_CHUNK_SIZE; ++r)
+                {
+                    uint32_t bitRows[3][3]; // Above, current and below
+
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        int y = r + k - 1;
+                        int side = y < 0 ? 0 :
+                                   (y >= UNIVERSE_CHUNK_SIZE ? 2 : 1);
+
+                        y = y & (UNIVERSE_CHUNK_SIZE - 1);
+
+                        bitRows[k][0] = around[side][0][y];
+                        bitRows[k][1] = around[side][1][y];
+                        bitRows[k][2] = around[side][2][y];
+                    }
+
+                    uint32_t planes[STENCIL_COUNT_BITS] = {0};
+
+                    Neighborhood::gatherWord(bitRows[0], bitRows[1],
+                                             bitRows[2], 1, planes);
+
+                    uint32_t cells = bitRows[1][1];
+                    uint32_t nextCells = rule.nextCells(cells, planes);
+
+                    next[r] = nextCells;
+                    changes = changes + __builtin_popcount(cells ^ nextCells);
+                    populationChange = populationChange +
+                                       __builtin_popcount(nextCells) -
+                                       __builtin_popcount(cells);
+                }
+            }
+
+            return changes;
+        }
+};
+
+#endif
@@ -0,0 +1,430 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "steppingstone.h"
+#include "globals.h"
+#include "random_numbers.h"
+
+/*********************************PRIVATE*************************************/
+
+/*
+ * Frees the memory used by the cells and the random bits
+ */
+int SteppingStone::freeBuffers()
+{
+    delete[] cells;
+    delete[] newCells;
+    delete[] palette;
+    delete[] counts;
+    delete[] updateBits;
+    delete[] neighborBits;
+
+    cells = NULL;
+    newCells = NULL;
+    palette = NULL;
+    counts = NULL;
+    updateBits = NULL;
+    neighborBits = NULL;
+
+    return 0;
+}
+
+/*
+ * Calculates the row y of the next generation.
+ *
+ * The neighbors are read from the previous generation, so during the step
+ * the count of a color can drop to 0 and rise again (when the cell that had
+ * it changes before another one copies it). The number of surviving colors
+ * is correct at the end of the step.
+ *
+ * Von Neumann neighborhood    Moore neighborhood
+ *       0                        7 0 1
+ *     3 o 1                      6 o 2
+ *       2                        5 4 3
+ *
+ * The row is copied as it is, and then only the cells with an update bit
+ * are visited (the lowest bit left of each word of 32 cells each time).
+ * The neighbor is read at its offset from the cell, so only the cells of
+ * the left and right borders test the wrap around.
+ */
+int SteppingStone::nextRow(RandomNumberGenerator& rng, int y)
+{
+    static const int VON_NEUMANN_DX[4] = {0, 1, 0, -1};
+    static const int VON_NEUMANN_DY[4] = {-1, 0, 1, 0};
+    static const int MOORE_DX[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    static const int MOORE_DY[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+    const unsigned short* up = cells + ((y + height - 1) % height) * width;
+    const unsigned short* row = cells + y * width;
+    const unsigned short* down = cells + ((y + 1) % height) * width;
+    const unsigned short* rows[3] = {up, row, down};
+    unsigned short* out = newCells + y * width;
+
+    const int* dx;
+    const int* dy;
+    int bitShift;      // log2 of the neighbor bits of a cell
+    uint32_t neighborMask;
+
+    rng.fillBits(updateBits, width, stepThreshold);
+
+    if (typeOfNeighborhood == MOORE_NEIGHBORHOOD)
+    {
+        // 8 neighbors: 3 bits per cell (in nibbles, 8 cells per word)
+        rng.fillInts(neighborBits, (width + 7) / 8);
+
+        dx = MOORE_DX;
+        dy = MOORE_DY;
+        bitShift = 2;
+        neighborMask = 7;
+    }
+    else
+    {
+        // 4 neighbors: 2 bits per cell (16 cells per word)
+        rng.fillInts(neighborBits, (width + 15) / 16);
+
+        dx = VON_NEUMANN_DX;
+        dy = VON_NEUMANN_DY;
+        bitShift = 1;
+        neighborMask = 3;
+    }
+
+    // Cells per word of neighbor bits: 1 << wordShift
+    int wordShift = 5 - bitShift;
+    int surviving = stepSurvivingColors;
+
+    // Of the neighbor from the cell, in the cells (the rows wrap around)
+    int offsets[8];
+
+    for (int i = 0; i <= (int) neighborMask; ++i)
+    {
+        offsets[i] = (int) (rows[dy[i] + 1] - row) + dx[i];
+    }
+
+    memcpy(out, row, width * sizeof(unsigned short));
+
+    for (int x = 0; x < width; x = x + 32)
+    {
+        uint32_t update = updateBits[x / 32];
+
+        while (update != 0)
+        {
+            int column = x + __builtin_ctz(update);
+            int neighbor = (neighborBits[column >> wordShift] >>
+                            ((column & ((1 << wordShift) - 1)) << bitShift)) &
+                           neighborMask;
+            unsigned short color;
+
+            update = update & (update - 1);
+
+            if (column != 0 and column != width - 1)
+            {
+                color = row[column + offsets[neighbor]];
+            }
+            else
+            {
+                // The borders wrap around
+                int neighborColumn = (column + dx[neighbor] + width) % width;
+
+                color = rows[dy[neighbor] + 1][neighborColumn];
+            }
+
+            /*
+             * Update the histogram. A cell that keeps its color adds one
+             * to its count and takes it away, so the colors aren't
+             * compared (a branch that can't be predicted).
+             */
+            out[column] = color;
+            surviving = surviving + (counts[color]++ == 0 ? 1 : 0);
+            surviving = surviving - (--counts[row[column]] == 0 ? 1 : 0);
+        }
+    }
+
+    stepSurvivingColors = surviving;
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+SteppingStone::SteppingStone()
+{
+    width = 0;
+    height = 0;
+    typeOfNeighborhood = VON_NEUMANN_NEIGHBORHOOD;
+
+    cells = NULL;
+    newCells = NULL;
+    palette = NULL;
+    counts = NULL;
+    updateBits = NULL;
+    neighborBits = NULL;
+
+    numColors = 0;
+    survivingColors = 0;
+    numSteps = 0;
+    fixationStep = -1;
+
+    stepRow = 0;
+    stepThreshold = 0;
+    stepSurvivingColors = 0;
+}
+
+// Class destructor
+SteppingStone::~SteppingStone()
+{
+    freeBuffers();
+}
+
+/*
+ * Sets the size of the grid (in cells) and allocates the memory for it
+ */
+int SteppingStone::setSize(int w, int h)
+{
+    if (w == width and h == height and cells != NULL)
+    {
+        return 0;
+    }
+
+    freeBuffers();
+
+    width = w;
+    height = h;
+    stepRow = 0;
+
+    int maxColors = w * h < STEPPING_STONE_MAX_COLORS ?
+                    w * h : STEPPING_STONE_MAX_COLORS;
+
+    cells = new unsigned short[w * h];
+    newCells = new unsigned short[w * h];
+    palette = new unsigned short[maxColors];
+    counts = new unsigned int[maxColors];
+    updateBits = new uint32_t[(w + 31) / 32];
+    neighborBits = new uint32_t[(w * 4 + 31) / 32];
+
+    return 0;
+}
+
+/*
+ * Frees the memory of the cells and the random bits while another automata runs. setSize()
+ * allocates it again.
+ */
+int SteppingStone::release()
+{
+    freeBuffers();
+
+    width = 0;
+    height = 0;
+    stepRow = 0;
+
+    return 0;
+}
+
+int SteppingStone::getWidth()
+{
+    return width;
+}
+
+int SteppingStone::getHeight()
+{
+    return height;
+}
+
+/*
+ * Sets the neighborhood used to choose the neighbor that gives its color:
+ * VON_NEUMANN_NEIGHBORHOOD (4 neighbors) or MOORE_NEIGHBORHOOD (8 neighbors)
+ */
+int SteppingStone::setTypeOfNeighborhood(int value)
+{
+    typeOfNeighborhood = value;
+
+    return 0;
+}
+
+int SteppingStone::getTypeOfNeighborhood()
+{
+    return typeOfNeighborhood;
+}
+
+/*
+ * Paints each cell with a random RGB15 color.
+ * Each different color gets an index of the palette, in order of appearance.
+ */
+int SteppingStone::initialize(RandomNumberGenerator& rng)
+{
+    // Index + 1 of each RGB15 color (0: the color isn't in the palette yet)
+    unsigned short* indexOfColor = new unsigned short[STEPPING_STONE_MAX_COLORS];
+
+    memset(indexOfColor, 0, STEPPING_STONE_MAX_COLORS * sizeof(unsigned short));
+
+    numColors = 0;
+
+    for (int i = 0; i < width * height; ++i)
+    {
+        // The low 15 bits of a random number are the three 5 bit
+        // components of a random RGB15 color.
+        unsigned short color = rng.next() & 0x7FFF;
+
+        if (indexOfColor[color] == 0)
+        {
+            palette[numColors] = color;
+            counts[numColors] = 0;
+            ++numColors;
+
+            indexOfColor[color] = numColors;
+        }
+
+        cells[i] = indexOfColor[color] - 1;
+        ++counts[cells[i]];
+    }
+
+    delete[] indexOfColor;
+
+    survivingColors = numColors;
+    numSteps = 0;
+    stepRow = 0;
+    fixationStep = survivingColors == 1 ? 0 : -1;
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation
+ */
+int SteppingStone::nextStep(RandomNumberGenerator& rng)
+{
+    // The rest of the generation in progress, or a whole one
+    return stepRows(rng, height - stepRow);
+}
+
+/*
+ * Calculates the next rows of the generation in progress, starting a new
+ * one if there isn't any, so a generation can be spread over several
+ * frames. The cells and the number of surviving colors only change when
+ * the last row is done.
+ *
+ * The probability of a cell being updated is chosen at random when the
+ * generation starts and it's used as a fixed point threshold for the update
+ * bits of the cells. The random numbers are drawn in the same order however
+ * the generation is sliced, so a run is the same with any number of rows
+ * per call.
+ */
+int SteppingStone::stepRows(RandomNumberGenerator& rng, int rows)
+{
+    if (rows < 1)
+    {
+        return 0;
+    }
+
+    if (stepRow == 0)
+    {
+        // A value between 1 and RNG_THRESHOLD_ONE
+        stepThreshold = RNG_THRESHOLD_ONE - (rng.next() >> 16);
+        stepSurvivingColors = survivingColors;
+    }
+
+    int lastRow = stepRow + rows < height ? stepRow + rows : height;
+
+    for (; stepRow < lastRow; ++stepRow)
+    {
+        nextRow(rng, stepRow);
+    }
+
+    if (stepRow < height)
+    {
+        return 0;
+    }
+
+    stepRow = 0;
+
+    unsigned short* temp = cells;
+    cells = newCells;
+    newCells = temp;
+
+    survivingColors = stepSurvivingColors;
+    ++numSteps;
+
+    if (survivingColors == 1 and fixationStep == -1)
+    {
+        fixationStep = numSteps;
+    }
+
+    return 0;
+}
+
+/*
+ * Returns the next row of the generation in progress (see stepRows()), or 0
+ * if there's none in progress
+ */
+int SteppingStone::getStepRow()
+{
+    return stepRow;
+}
+
+/*
+ * Returns the cells of the current generation (palette indexes, row by row)
+ */
+unsigned short* SteppingStone::getCells()
+{
+    return cells;
+}
+
+/*
+ * Returns the RGB15 color of each palette index
+ */
+unsigned short* SteppingStone::getPalette()
+{
+    return palette;
+}
+
+int SteppingStone::getNumColors()
+{
+    return numColors;
+}
+
+/*
+ * Returns the number of cells with the color of the palette index
+ */
+unsigned int SteppingStone::getColorCount(int index)
+{
+    return counts[index];
+}
+
+/*
+ * Returns the number of colors that still have cells
+ */
+int SteppingStone::getSurvivingColors()
+{
+    return survivingColors;
+}
+
+/*
+ * Returns true if only one color is left (it can't change anymore)
+ */
+bool SteppingStone::isFixated()
+{
+    return survivingColors == 1;
+}
+
+/*
+ * Returns the step in which only one color was left, or -1 if there are
+ * still more colors
+ */
+int SteppingStone::getFixationStep()
+{
+    return fixationStep;
+}
+
+/*
+ * Writes the RGB15 color of each cell in out (width * height pixels)
+ */
+int SteppingStone::render(unsigned short* out)
+{
+    for (int i = 0; i < width * height; ++i)
+    {
+        out[i] = palette[cells[i]];
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#ifndef STEPPINGSTONE_H
+#define STEPPINGSTONE_H
+
+#include <stdint.h>
+
+#include "random_numbers.h"
+
+/*
+ * Maximum number of different colors (all the RGB15 colors)
+ */
+#define STEPPING_STONE_MAX_COLORS 32768
+
+/*
+ * The stepping stone automata.
+ *
+ * In each step every cell, with a probability chosen at random for the
+ * whole step, copies the color of one of its neighbors (also chosen at
+ * random). The borders wrap around (torus).
+ *
+ * The cells store an index to the palette of the colors of the initial
+ * state. The number of cells of each color (histogram) is updated when a
+ * cell changes, so the number of surviving colors is always known and the
+ * fixation (only one color left) is detected as soon as it happens.
+ *
+ * The random numbers are drawn in bulk for a whole row: one bit per cell to
+ * decide if the cell is updated and two bits (Von Neumann neighborhood) or
+ * three bits (Moore neighborhood) per cell to choose the neighbor.
+ *
+ * It doesn't depend on libnds, so it can be used in headless runs.
+ */
+class SteppingStone
+{
+    private:
+        int width;
+        int height;
+        int typeOfNeighborhood;
+
+        unsigned short* cells;    // Current generation (palette indexes)
+        unsigned short* newCells; // Next generation
+
+        unsigned short* palette;  // RGB15 color of each index
+        unsigned int* counts;     // Number of cells of each index
+        int numColors;            // Number of colors of the palette
+        int survivingColors;      // Number of colors with cells
+
+        unsigned int numSteps;
+        int fixationStep;         // -1 until only one color is left
+
+        uint32_t* updateBits;     // One bit per cell of a row
+        uint32_t* neighborBits;   // Four bits per cell of a row
+
+        // Generation in progress (see stepRows())
+        int stepRow;              // Next row, 0 if there's none in progress
+        uint32_t stepThreshold;   // Probability of update of its cells
+        int stepSurvivingColors;  // Surviving colors of its rows so far
+
+        int freeBuffers();
+        int nextRow(RandomNumberGenerator& rng, int y);
+
+    public:
+        SteppingStone();
+        ~SteppingStone();
+
+        int setSize(int w, int h);
+        int release();
+        int getWidth();
+        int getHeight();
+
+        int setTypeOfNeighborhood(int value);
+        int getTypeOfNeighborhood();
+
+        int initialize(RandomNumberGenerator& rng);
+        int nextStep(RandomNumberGenerator& rng);
+        int stepRows(RandomNumberGenerator& rng, int rows);
+        int getStepRow();
+
+        unsigned short* getCells();
+        unsigned short* getPalette();
+        int getNumColors();
+        unsigned int getColorCount(int index);
+
+        int getSurvivingColors();
+        bool isFixated();
+        int getFixationStep();
+
+        int render(unsigned short* out);
+};
+
+#endif
@@ -0,0 +1,251 @@
+#include <stdio.h>
+
+#include <nds.h>
+
+#include "steppingstoneautomaton.h"
+#include "cellularautomata.h"
+#include "framebuffer.h"
+#include "globals.h"
+#include "menus.h"
+#include "i18n.h"
+
+/*
+ * References:
+ * http://www.dartmouth.edu/~matc/math5.pattern/FinalProject/Hoke.html
+ */
+
+// Class constructor
+SteppingStoneAutomaton::SteppingStoneAutomaton()
+{
+    typeOfNeighborhood = VON_NEUMANN_NEIGHBORHOOD;
+}
+
+/*
+ * Paints each cell of the stepping stone with a random RGB15 color in the
+ * first page of the 16 bits per pixel framebuffer
+ */
+int SteppingStoneAutomaton::initialize(CellularAutomata& automata)
+{
+    showFB();
+    dmaCopy(fb, fb2, 128 * 1024);
+    showFB2();
+
+    cleanFB(fb);
+    cleanFB(fb2);
+
+    // VRAM_D must be in LCD mode to draw the third framebuffer
+    showFB3();
+    cleanFB(fb3);
+
+    // Paint each cell with a random RGB15 color.
+    steppingStone.setSize(SCREEN_WIDTH, SCREEN_HEIGHT);
+    steppingStone.initialize(automata.getRandomNumbers());
+
+    // The cells are palette indexes in main RAM: write their colors.
+    steppingStone.render(fb);
+
+    showFB();
+    automata.getPipeline().start(showFBPage, 0);
+
+    return 0;
+}
+
+/*
+ * Calculates the next generation of the stepping stone (the rest of the
+ * generation in progress, see stepRows())
+ */
+int SteppingStoneAutomaton::nextStep(CellularAutomata& automata)
+{
+    return stepRows(automata, SCREEN_HEIGHT - getStepRow());
+}
+
+bool SteppingStoneAutomaton::hasResumableStep()
+{
+    return true;
+}
+
+/*
+ * Calculates the next rows of the stepping stone (see
+ * CellularAutomata::stepRows())
+ */
+int SteppingStoneAutomaton::stepRows(CellularAutomata& automata, int rows)
+{
+    if (steppingStone.getStepRow() == 0)
+    {
+        // Only one color is left: nothing can change anymore
+        if (steppingStone.isFixated() == true)
+        {
+            return 0;
+        }
+
+        // The neighborhood can be changed without restarting
+        steppingStone.setTypeOfNeighborhood(typeOfNeighborhood);
+    }
+
+    steppingStone.stepRows(automata.getRandomNumbers(), rows);
+
+    if (steppingStone.getStepRow() != 0)
+    {
+        return 0;
+    }
+
+    automata.countStep();
+
+    // The cells are palette indexes: write their colors
+    if (automata.isStepRendered() == true)
+    {
+        FramePipeline& pipeline = automata.getPipeline();
+
+        steppingStone.render(getFBPage(pipeline.acquire()));
+        pipeline.submit();
+    }
+
+    return 0;
+}
+
+int SteppingStoneAutomaton::getStepRow()
+{
+    return steppingStone.getStepRow();
+}
+
+/*
+ * Frees the cells and the random bits of the stepping stone
+ */
+int SteppingStoneAutomaton::release()
+{
+    return steppingStone.release();
+}
+
+const std::string& SteppingStoneAutomaton::getName()
+{
+    return stringSteppingStone;
+}
+
+/*
+ * Von Neumann neighborhood (default)
+ */
+int SteppingStoneAutomaton::setDefaults()
+{
+    typeOfNeighborhood = VON_NEUMANN_NEIGHBORHOOD;
+
+    return 0;
+}
+
+int SteppingStoneAutomaton::printMenu()
+{
+    printString(ST_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW,
+                ST_MENU_NEIGHBORHOOD_COL,
+                stringVonNeumannNeighborhood);
+    printString(ST_MENU_MOORE_NEIGHBORHOOD_ROW,
+                ST_MENU_NEIGHBORHOOD_COL,
+                stringMooreNeighborhood);
+    printString(ST_MENU_BACK_TO_MAIN_ROW,
+                ST_MENU_BACK_TO_MAIN_COL,
+                stringBackToMainMenu);
+    printSpeed();
+    printString(SPEED_HELP_ROW, SPEED_HELP_COL, stringSpeedHelp);
+
+    return 0;
+}
+
+int SteppingStoneAutomaton::printMenuArrow(int index, bool boolDelete)
+{
+    // Von Neumann (0), Moore (1) or back to main menu (2)
+    if (index == 0)
+    {
+        return printOptionArrow(ST_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW,
+                                ST_MENU_NEIGHBORHOOD_ARROW_COL,
+                                boolDelete);
+    }
+    else if (index == 1)
+    {
+        return printOptionArrow(ST_MENU_MOORE_NEIGHBORHOOD_ROW,
+                                ST_MENU_NEIGHBORHOOD_ARROW_COL,
+                                boolDelete);
+    }
+
+    return printOptionArrow(ST_MENU_BACK_TO_MAIN_ROW,
+                            ST_MENU_BACK_TO_MAIN_ARROW_COL,
+                            boolDelete);
+}
+
+int SteppingStoneAutomaton::printMenuAsterisks()
+{
+    if (typeOfNeighborhood == VON_NEUMANN_NEIGHBORHOOD)
+    {
+        printAsterisk(ST_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW,
+                      ST_MENU_NEIGHBORHOOD_ASTERISK_COL);
+        deleteAsterisk(ST_MENU_MOORE_NEIGHBORHOOD_ROW,
+                       ST_MENU_NEIGHBORHOOD_ASTERISK_COL);
+    }
+    else
+    {
+        deleteAsterisk(ST_MENU_VON_NEUMANN_NEIGHBORHOOD_ROW,
+                       ST_MENU_NEIGHBORHOOD_ASTERISK_COL);
+        printAsterisk(ST_MENU_MOORE_NEIGHBORHOOD_ROW,
+                      ST_MENU_NEIGHBORHOOD_ASTERISK_COL);
+    }
+
+    return 0;
+}
+
+/*
+ * Prints the steps, the number of colors left and, when only one is left,
+ * the step in which it happened
+ */
+int SteppingStoneAutomaton::printCounters()
+{
+    printNumSteps();
+
+    iprintf("\x1b[%d;%dH%s: %d          ", SURVIVING_COLORS_ROW,
+            SURVIVING_COLORS_COLUMN, stringColors.c_str(),
+            steppingStone.getSurvivingColors());
+
+    if (steppingStone.getFixationStep() != -1)
+    {
+        iprintf("\x1b[%d;%dH%s: %d          ", FIXATION_STEP_ROW,
+                FIXATION_STEP_COLUMN, stringFixationStep.c_str(),
+                steppingStone.getFixationStep());
+    }
+    else
+    {
+        iprintf("\x1b[%d;%dH%s", FIXATION_STEP_ROW,
+                FIXATION_STEP_COLUMN, "                                ");
+    }
+
+    return 0;
+}
+
+int SteppingStoneAutomaton::updateMenu(CellularAutomata& automata,
+                                       int keys_pressed,
+                                       int keys_released)
+{
+    if (keys_released & KEY_A)
+    {
+        if (arrow == 0)
+        {
+            // The neighborhood can be changed without restarting
+            typeOfNeighborhood = VON_NEUMANN_NEIGHBORHOOD;
+            printMenuAsterisks();
+        }
+        else if (arrow == 1)
+        {
+            typeOfNeighborhood = MOORE_NEIGHBORHOOD;
+            printMenuAsterisks();
+        }
+        else if (arrow == 2) // Back to the main menu
+        {
+            showAutomataTypeMenu();
+        }
+    }
+    else if (keys_pressed & KEY_UP)
+    {
+        previousOption(2);
+    }
+    else if (keys_pressed & KEY_DOWN)
+    {
+        nextOption(2);
+    }
+
+    return 0;
+}
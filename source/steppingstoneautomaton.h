@@ -0,0 +1,43 @@
+#ifndef STEPPINGSTONEAUTOMATON_H
+#define STEPPINGSTONEAUTOMATON_H
+
+#include <string>
+
+#include "automaton.h"
+#include "steppingstone.h"
+
+/*
+ * The stepping stone: each cell takes the color of a random neighbor, until
+ * only one color is left. Its colors are written in the 16 bits per pixel
+ * framebuffer and its generations can be calculated a few rows at a time
+ * (see stepRows()).
+ */
+class SteppingStoneAutomaton : public Automaton
+{
+    private:
+        int typeOfNeighborhood;
+
+        SteppingStone steppingStone;
+
+    public:
+        SteppingStoneAutomaton();
+
+        virtual int initialize(CellularAutomata& automata);
+        virtual int nextStep(CellularAutomata& automata);
+        virtual bool hasResumableStep();
+        virtual int stepRows(CellularAutomata& automata, int rows);
+        virtual int getStepRow();
+        virtual int release();
+
+        virtual const std::string& getName();
+        virtual int setDefaults();
+        virtual int printMenu();
+        virtual int printMenuArrow(int index, bool boolDelete);
+        virtual int printMenuAsterisks();
+        virtual int printCounters();
+        virtual int updateMenu(CellularAutomata& automata,
+                               int keys_pressed,
+                               int keys_released);
+};
+
+#endif
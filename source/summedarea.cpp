@@ -0,0 +1,72 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "summedarea.h"
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+SummedAreaTable::SummedAreaTable()
+{
+    sums = NULL;
+    width = 0;
+    height = 0;
+    range = 0;
+    stride = 0;
+}
+
+// Class destructor
+SummedAreaTable::~SummedAreaTable()
+{
+    release();
+}
+
+/*
+ * Sets the size of the grid (in cells) and the range of the boxes, and
+ * allocates the table for them
+ */
+int SummedAreaTable::setSize(int w, int h, int r)
+{
+    if (w == width and h == height and r == range and sums != NULL)
+    {
+        return 0;
+    }
+
+    release();
+
+    width = w;
+    height = h;
+    range = r;
+    stride = w + 2 * r + 1;
+
+    int size = stride * (h + 2 * r + 1);
+
+    sums = new uint16_t[size];
+
+    // The first row and column are never written by build()
+    memset(sums, 0, size * sizeof(uint16_t));
+
+    return 0;
+}
+
+/*
+ * Frees the table while another automata runs. setSize() allocates it
+ * again.
+ */
+int SummedAreaTable::release()
+{
+    delete[] sums;
+
+    sums = NULL;
+    width = 0;
+    height = 0;
+    range = 0;
+    stride = 0;
+
+    return 0;
+}
+
+int SummedAreaTable::getRange()
+{
+    return range;
+}
@@ -0,0 +1,98 @@
+#ifndef SUMMEDAREA_H
+#define SUMMEDAREA_H
+
+#include <stdint.h>
+
+/*
+ * Summed-area table (integral image) of the cells of a grid in a state:
+ * the entry (x, y) is the number of cells in the state above and to the
+ * left of it. The cells in any box are then counted with 4 reads, whatever
+ * its size (see count()).
+ *
+ * The table covers the grid and range cells around it, filled by the
+ * boundary of the stencil engine (see SummedAreaStencil in stencil.h), so
+ * the box of range cells around any cell of the grid is inside it. It has
+ * an extra row and column of zeros at the top and at the left, so count()
+ * doesn't check the edges.
+ *
+ * The entries are 16 bits: they wrap around when the table is bigger than
+ * 65535 cells, but the counts are differences of entries, so they're right
+ * as long as a box has less than 65536 cells.
+ */
+class SummedAreaTable
+{
+    private:
+        uint16_t* sums;
+        int width;  // Of the grid
+        int height;
+        int range;  // Cells of the table around the grid
+        int stride; // Entries of a row of the table
+
+    public:
+        SummedAreaTable();
+        ~SummedAreaTable();
+
+        int setSize(int w, int h, int r);
+        int release();
+        int getRange();
+
+        /*
+         * Fills the table with the cells (width x height, row by row) in
+         * the state. Boundary::index() gives the cells outside of the grid
+         * (see stencil.h).
+         */
+        template <class Boundary, typename Cell>
+        void build(const Cell* cells, Cell state)
+        {
+            int tableWidth = width + 2 * range;
+            int tableHeight = height + 2 * range;
+            uint16_t* above = sums + 1;
+
+            for (int y = 0; y < tableHeight; ++y)
+            {
+                const Cell* row =
+                    cells + Boundary::index(y - range, height) * width;
+                uint16_t* sum = sums + (y + 1) * stride + 1;
+                uint16_t rowSum = 0;
+                int x = 0;
+
+                // The columns outside of the grid need the boundary
+                for (; x < range; ++x)
+                {
+                    rowSum = rowSum +
+                             (row[Boundary::index(x - range, width)] == state);
+                    sum[x] = above[x] + rowSum;
+                }
+
+                for (; x < width + range; ++x)
+                {
+                    rowSum = rowSum + (row[x - range] == state);
+                    sum[x] = above[x] + rowSum;
+                }
+
+                for (; x < tableWidth; ++x)
+                {
+                    rowSum = rowSum +
+                             (row[Boundary::index(x - range, width)] == state);
+                    sum[x] = above[x] + rowSum;
+                }
+
+                above = sum;
+            }
+        }
+
+        /*
+         * Returns the number of cells in the state in the box of range
+         * cells around the cell (x, y) of the grid
+         */
+        int count(int x, int y) const
+        {
+            const uint16_t* top = sums + y * stride + x;
+            const uint16_t* bottom = top + (2 * range + 1) * stride;
+
+            return (uint16_t) (bottom[2 * range + 1] - top[2 * range + 1] -
+                               bottom[0] + top[0]);
+        }
+};
+
+#endif
@@ -1,92 +1,63 @@
 #include <nds.h>
 #include "framebuffer.h"
 #include "color.h"
+#include "globals.h"
 
 /*
- * 0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
- * x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x
+ * One cell of the pattern of the triangular grid (6 x 6 pixels), repeated
+ * all over the grid
  */
-int triangularGridLineOne(int y)
+static const unsigned char triangularGridPattern[6 * 6] =
 {
-	for(int i = 0; i < SCREEN_WIDTH - 1; i++)
-	{
-    	fb[SCREEN_WIDTH * y + i] = line_color;
-	}
-	return 0;
-}
-
-/*
- * 0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
- *          x     x           x     x
- */
-int triangularGridLineTwo(int y)
-{
-	for(int i = 3; i < SCREEN_WIDTH - 1; i = i + 6)
-	{
-		fb[SCREEN_WIDTH * y + i] = line_color;
-        fb[SCREEN_WIDTH * y + i + 2] = line_color;
-	}
-	return 0;
-}
+    1, 1, 1, 1, 1, 1,
+    0, 0, 0, 1, 0, 1,
+    1, 0, 1, 0, 0, 0,
+    1, 1, 1, 1, 1, 1,
+    1, 0, 1, 0, 0, 0,
+    0, 0, 0, 1, 0, 1
+};
 
 /*
- * 0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
- * x     x           x     x           x     x
+ *   0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
+ * 0 x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x
+ * 1          x     x           x     x
+ * 2 x     x           x     x           x     x
+ * 3 x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x
+ * 4 x     x           x     x           x     x
+ * 5          x     x           x     x
+ * 6 x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x
+ * 7          x     x           x     x
+ * 8 x     x           x     x           x     x
+ * 9 x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x
+ *
+ * It's shown as the lattice over the cells of the 8 bits per pixel
+ * framebuffer (see showLattice()), so the cells don't hold the lines.
  */
-int triangularGridLineThree(int y)
+int showTriangularLattice()
 {
-	for(int i = 0; i < SCREEN_WIDTH - 1; i = i + 6)
-	{
-		fb[SCREEN_WIDTH * y + i] = line_color;
-		fb[SCREEN_WIDTH * y + i + 2] = line_color;
-	}
-	return 0;
+    // 31 cells high, the last column of the screen is left empty
+    return showLattice(triangularGridPattern, 6, 6, SCREEN_WIDTH - 1, 31 * 6,
+                       CELL_LINE);
 }
 
 /*
- *   0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
- * 0 x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  triangularGridLineOne
- * 1          x     x           x     x              triangularGridLineTwo
- * 2 x     x           x     x           x     x     triangularGridLineThree
- * 3 x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  triangularGridLineOne
- * 4 x     x           x     x           x     x     triangularGridLineThree
- * 5          x     x           x     x              triangularGridLineTwo
- * 6 x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  triangularGridLineOne
- * 7          x     x           x     x              triangularGridLineTwo
- * 8 x     x           x     x           x     x     triangularGridLineThree
- * 9 x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  x  triangularGridLineOne
+ * Draws the triangular cell in the coordinates (intPosX, intPosY) of the
+ * specified 8 bits per pixel framebuffer (or cells of a grid) with the
+ * specified palette index
  */
-int drawTriangularGrid()
+int paintTriangularCell(int intPosX, int intPosY, unsigned char index,
+                        unsigned char* framebuffer)
 {
-    cleanFB(fb);
-    
-	for (int i = 0; i < 31; i++)
-	{
-		triangularGridLineOne(6 * i);
-        triangularGridLineTwo(6 * i + 1);
-		triangularGridLineThree(6 * i + 2);
-		triangularGridLineOne(6 * i + 3);
-		triangularGridLineThree(6 * i + 4);				
-		triangularGridLineTwo(6 * i + 5);
-	}
-	
-    return 0;
-}
-
-int paintTriangularCell(int intPosX, int intPosY, unsigned short color,
-                        unsigned short* framebuffer)
-{
-	if ((intPosX % 2 == 0 and intPosY % 2 == 0) or 
+    if ((intPosX % 2 == 0 and intPosY % 2 == 0) or
         (intPosX % 2 != 0 and intPosY % 2 != 0))
     {
-	    drawHLine(intPosX -1, intPosY, 3, color, framebuffer);
-	    drawHLine(intPosX, intPosY + 1, 1, color, framebuffer);
+        drawHLine(intPosX - 1, intPosY, 3, index, framebuffer);
+        drawHLine(intPosX, intPosY + 1, 1, index, framebuffer);
     }
-    else if ((intPosX % 2 != 0 and intPosY % 2 == 0) or
-             (intPosX % 2 == 0 and intPosY % 2 != 0))
-	{
-	    drawHLine(intPosX, intPosY, 1, color, framebuffer);
-	    drawHLine(intPosX - 1, intPosY + 1, 3, color, framebuffer);
-	}
-	return 0;
+    else
+    {
+        drawHLine(intPosX, intPosY, 1, index, framebuffer);
+        drawHLine(intPosX - 1, intPosY + 1, 3, index, framebuffer);
+    }
+    return 0;
 }
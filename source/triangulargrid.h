@@ -1,12 +1,72 @@
 #ifndef TRIANGULARGRID_H
 #define TRIANGULARGRID_H
 
-int triangularGridLineOne(int y);
-int triangularGridLineTwo(int y);
-int triangularGridLineThree(int y);
+int showTriangularLattice();
+int paintTriangularCell(int intPosX, int intPosY, unsigned char index,
+                        unsigned char* framebuffer);
 
-int drawTriangularGrid();
-int paintTriangularCell(int intPosX, int intPosY, unsigned short color,
-                        unsigned short* framebuffer);
+/*
+ * The triangular lattice for the stencil engine (see stencil.h).
+ *
+ * The cells are painted with paintTriangularCell() every 3 pixels, from
+ * (4, 4). The triangles point up or down depending on the parity of their
+ * position, and only have the neighbor of their flat side:
+ *
+ * Von Neumann neighborhood (3 neighbors)    Moore neighborhood (8 neighbors)
+ *      x                                       x x x
+ *    x o x      or     x o x                   x o x
+ *                        x                     x x x
+ */
+struct TriangularLattice
+{
+    static const int numSublattices = 1;
+    static const int rowStep = 3;
+    static const int columnStep = 3;
+
+    static int firstRow(int k) { return 4; }
+    static int endRow(int k) { return 187; }
+    static int firstColumn(int k) { return 4; }
+    static int endColumn(int k) { return 253; }
+
+    template <class Neighborhood, typename Cell>
+    static int gather(const Cell* cells, int width, int i, int j, Cell state)
+    {
+        // The triangles with the flat side up have the neighbor on top
+        bool flatSideUp = (i % 2) == (j % 2);
+        int count = (cells[width * j + i - 3] == state) +
+                    (cells[width * j + i + 3] == state);
+
+        if (Neighborhood::moore or flatSideUp)
+        {
+            count = count + (cells[width * (j - 2) + i] == state);
+        }
+
+        if (Neighborhood::moore or not flatSideUp)
+        {
+            count = count + (cells[width * (j + 3) + i] == state);
+        }
+
+        if (Neighborhood::moore)
+        {
+            count = count + (cells[width * (j - 2) + i - 3] == state) +
+                            (cells[width * (j - 2) + i + 3] == state) +
+                            (cells[width * (j + 3) + i - 3] == state) +
+                            (cells[width * (j + 3) + i + 3] == state);
+        }
+
+        return count;
+    }
+
+    static int paint(int i, int j, unsigned char index, unsigned char* cells)
+    {
+        return paintTriangularCell(i, j, index, cells);
+    }
+
+    template <class Store>
+    static int markDirty(Store& store, int i, int j)
+    {
+        return store.markDirty(i - 1, j, 3, 2);
+    }
+};
 
 #endif
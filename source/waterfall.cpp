@@ -0,0 +1,172 @@
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARM9
+#include <nds.h>
+#endif
+
+#include "waterfall.h"
+
+/*******************************PRIVATE**************************************/
+
+/*
+ * Copies the rows first to last - 1 (numbers of the rows added, the last
+ * height ones) from the ring to their rows of the page of the framebuffer.
+ * The rows that are contiguous in both rings are copied together.
+ */
+int Waterfall::copyRows(unsigned char* framebuffer, long first, long last)
+{
+    while (first < last)
+    {
+        int source = first % height;
+        int target = first % pageHeight;
+        long count = last - first;
+
+        // Up to the end of either ring
+        if (count > height - source)
+        {
+            count = height - source;
+        }
+
+        if (count > pageHeight - target)
+        {
+            count = pageHeight - target;
+        }
+
+        unsigned char* from = rows + source * width;
+        unsigned char* to = framebuffer + target * width;
+        int length = count * width;
+
+#ifdef ARM9
+        DC_FlushRange(from, length);
+        dmaCopy(from, to, length);
+#else
+        memcpy(to, from, length);
+#endif
+
+        first = first + count;
+    }
+
+    return 0;
+}
+
+/********************************PUBLIC**************************************/
+
+// Class constructor
+Waterfall::Waterfall()
+{
+    width = 0;
+    height = 0;
+    pageHeight = 0;
+
+    rows = NULL;
+    numRows = 0;
+
+    for (int i = 0; i < GRID_NUM_PAGES; ++i)
+    {
+        presentedRows[i] = 0;
+    }
+}
+
+// Class destructor
+Waterfall::~Waterfall()
+{
+    release();
+}
+
+/*
+ * Sets the width of the rows, the rows shown on the screen and the rows of
+ * a page of the framebuffer, and allocates the ring. It's empty after
+ * clear().
+ */
+int Waterfall::setSize(int w, int h, int pageH)
+{
+    if (w != width or h != height or rows == NULL)
+    {
+        delete[] rows;
+        rows = new unsigned char[w * h];
+    }
+
+    width = w;
+    height = h;
+    pageHeight = pageH < h ? h : pageH;
+
+    return clear();
+}
+
+/*
+ * Frees the ring while another automata runs. setSize() allocates it
+ * again.
+ */
+int Waterfall::release()
+{
+    delete[] rows;
+
+    rows = NULL;
+    width = 0;
+    height = 0;
+
+    return clear();
+}
+
+/*
+ * Forgets the rows added. The pages of the framebuffer must be cleaned too:
+ * present() only writes the rows of the ring.
+ */
+int Waterfall::clear()
+{
+    numRows = 0;
+
+    for (int i = 0; i < GRID_NUM_PAGES; ++i)
+    {
+        presentedRows[i] = 0;
+    }
+
+    return 0;
+}
+
+/*
+ * Adds a row (width cells) below the previous ones. Only the last height
+ * rows are kept.
+ */
+int Waterfall::addRow(const unsigned char* row)
+{
+    memcpy(rows + (numRows % height) * width, row, width);
+
+    ++numRows;
+
+    return 0;
+}
+
+// Rows added since clear()
+long Waterfall::getNumRows()
+{
+    return numRows;
+}
+
+/*
+ * Copies the rows that the page (0 to GRID_NUM_PAGES - 1) of the
+ * framebuffer doesn't have yet and returns the row of the page shown at
+ * the top of the screen: 0 until the screen is full, then the row of the
+ * oldest row kept.
+ */
+int Waterfall::present(unsigned char* framebuffer, int page)
+{
+    long first = numRows - height;
+
+    if (first < presentedRows[page])
+    {
+        first = presentedRows[page];
+    }
+
+    copyRows(framebuffer, first, numRows);
+
+    presentedRows[page] = numRows;
+
+    if (numRows <= height)
+    {
+        return 0;
+    }
+
+    return (numRows - height) % pageHeight;
+}
@@ -0,0 +1,52 @@
+#ifndef WATERFALL_H
+#define WATERFALL_H
+
+#include "grid.h"
+
+/*
+ * The rows of a one dimensional automata shown as a waterfall: each
+ * generation is a row below the previous one, and when the screen is full
+ * the rows scroll up.
+ *
+ * The last height rows are kept in a ring in main RAM, so a step only
+ * writes its row there. present() copies to a page of the framebuffer the
+ * rows it doesn't have yet (the ones of the last GRID_NUM_PAGES presented
+ * steps, or of the steps calculated without presenting them), each one in
+ * the row of the page given by its generation modulo pageHeight: the page
+ * is a ring too, and the rows are never moved. The background is scrolled
+ * instead: present() returns the row of the page shown at the top of the
+ * screen (see setIndexedFBPageScroll()).
+ *
+ * On the host computer present() is a plain copy, so the same code can be
+ * used in headless runs.
+ */
+class Waterfall
+{
+    private:
+        int width;
+        int height;     // Rows shown on the screen
+        int pageHeight; // Rows of a page of the framebuffer (>= height)
+
+        unsigned char* rows; // The last height rows, a ring
+        long numRows;        // Rows added since clear()
+
+        // Rows added when each page was presented
+        long presentedRows[GRID_NUM_PAGES];
+
+        int copyRows(unsigned char* framebuffer, long first, long last);
+
+    public:
+        Waterfall();
+        ~Waterfall();
+
+        int setSize(int w, int h, int pageH);
+        int release();
+        int clear();
+
+        int addRow(const unsigned char* row);
+        long getNumRows();
+
+        int present(unsigned char* framebuffer, int page);
+};
+
+#endif